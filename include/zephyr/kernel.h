@@ -1806,6 +1806,14 @@ struct k_timer {
 	/* user-specific data, also used to support legacy features */
 	void *user_data;
 
+#ifdef CONFIG_TIMER_SLACK
+	/* ticks by which each expiry may be deferred */
+	k_ticks_t slack;
+
+	/* tick of the current expiry before applying the slack */
+	k_ticks_t nominal;
+#endif
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_timer)
 
 #ifdef CONFIG_OBJ_CORE_TIMER
@@ -1973,6 +1981,54 @@ void k_timer_init(struct k_timer *timer,
 __syscall void k_timer_start(struct k_timer *timer,
 			     k_timeout_t duration, k_timeout_t period);
 
+/**
+ * @brief Start a timer with slack.
+ *
+ * This works like k_timer_start(), except that each expiry of the timer
+ * may be deferred by up to @a slack, so that it coincides with the expiry
+ * of other timeouts.  With a tickless kernel this saves the system timer
+ * interrupts, and the context switches, that the distinct expiries would
+ * have caused.
+ *
+ * Expiries are deferred to the tick within the allowed window that is
+ * the most aligned, so timers with overlapping windows expire together.
+ * The period of a periodic timer is counted from the expiry it would
+ * have had without slack, so slack does not accumulate.
+ *
+ * @kconfig_dep{CONFIG_TIMER_SLACK}
+ *
+ * @param timer     Address of timer.
+ * @param duration  Initial timer duration.
+ * @param period    Timer period.
+ * @param slack     Maximum deferral of each expiry.
+ */
+__syscall void k_timer_start_slack(struct k_timer *timer, k_timeout_t duration,
+				   k_timeout_t period, k_timeout_t slack);
+
+/**
+ * @brief Timer slack statistics.
+ *
+ * The difference between @a expired and @a expiry_ticks is the number of
+ * system timer wakeups saved by timeouts expiring together.
+ */
+struct k_timer_slack_stats {
+	/** Number of timeouts that expired. */
+	uint64_t expired;
+	/** Number of distinct ticks on which timeouts expired. */
+	uint64_t expiry_ticks;
+	/** Number of expiries deferred by the slack of their timer. */
+	uint64_t deferred;
+};
+
+/**
+ * @brief Get timer slack statistics.
+ *
+ * @kconfig_dep{CONFIG_TIMER_SLACK}
+ *
+ * @param stats Statistics since boot, for all kernel timeouts.
+ */
+void k_timer_slack_stats_get(struct k_timer_slack_stats *stats);
+
 /**
  * @brief Stop a timer.
  *
@@ -2607,6 +2663,28 @@ __syscall int k_futex_wait(struct k_futex *futex, int expected,
  */
 __syscall int k_futex_wake(struct k_futex *futex, bool wake_all);
 
+/**
+ * @brief Wake one thread pending on a futex and move the others to another
+ *
+ * Tests that the supplied futex contains the expected value, and if so,
+ * wakes up the highest priority thread pending on it and moves all the
+ * other ones to @a target, where they stay pending until woken up by
+ * k_futex_wake() on @a target.  A condition variable uses this on
+ * broadcast, so that the threads it releases do not all wake up only to
+ * contend for the same mutex.
+ *
+ * @param futex Futex to wake up pending threads.
+ * @param expected Expected value of the futex, if it is different no
+ *		   thread is woken up or moved.
+ * @param target Futex to move the threads that are not woken up to.
+ * @retval -EACCES Caller does not have access to either futex address.
+ * @retval -EAGAIN If the futex value did not match the expected parameter.
+ * @retval -EINVAL Either futex address not recognized by the kernel.
+ * @retval >=0 Number of threads that were woken up or moved.
+ */
+__syscall int k_futex_requeue(struct k_futex *futex, int expected,
+			      struct k_futex *target);
+
 /** @} */
 #endif
 
@@ -3950,6 +4028,28 @@ int k_work_submit_to_queue(struct k_work_q *queue,
  */
 int k_work_submit(struct k_work *work);
 
+/** @brief Submit several work items to a queue.
+ *
+ * This is equivalent to invoking k_work_submit_to_queue() on each item in
+ * turn, except that the work lock is taken once for the whole array and
+ * the caller reschedules at most once, after all items have been queued.
+ *
+ * @isr_ok
+ *
+ * @param queue pointer to the work queue on which the items should run.
+ * If NULL each item uses the queue from its most recent submission.
+ *
+ * @param works array of pointers to the work items.
+ *
+ * @param count number of entries in @p works.
+ *
+ * @return the number of items that were newly queued.  If no item was
+ * queued and some were rejected, the error code k_work_submit_to_queue()
+ * returned for the first rejected item.
+ */
+int k_work_submit_batch(struct k_work_q *queue, struct k_work **works,
+			size_t count);
+
 /** @brief Wait for last-submitted instance to complete.
  *
  * Resubmissions may occur while waiting, including chained submissions (from
@@ -4064,6 +4164,45 @@ void k_work_queue_start(struct k_work_q *queue,
 			k_thread_stack_t *stack, size_t stack_size,
 			int prio, const struct k_work_queue_config *cfg);
 
+/** @brief Initialize a work queue animated by several threads.
+ *
+ * This works like k_work_queue_start() except that @p num_workers threads
+ * take items from the same queue, so up to @p num_workers distinct items
+ * may be processed concurrently.  A single work item is still never run
+ * by two workers at the same time: a resubmission made while the item is
+ * running is held back until the running instance completes.
+ *
+ * Items are started in submission order, but as they run concurrently
+ * they may complete in any order.
+ *
+ * @kconfig_dep{CONFIG_WORKQUEUE_WORKERS}
+ *
+ * @param queue pointer to the queue structure. It must be initialized
+ *        in zeroed/bss memory or with @ref k_work_queue_init before
+ *        use.
+ *
+ * @param threads array of @p num_workers thread objects used for the
+ *        workers.
+ *
+ * @param stacks stack array of @p num_workers entries defined with
+ *        K_THREAD_STACK_ARRAY_DEFINE() using @p stack_size.
+ *
+ * @param stack_size size of each worker stack area, in bytes.
+ *
+ * @param num_workers number of worker threads, at least 1.
+ *
+ * @param prio initial priority of the worker threads
+ *
+ * @param cfg optional additional configuration parameters.  Pass @c
+ * NULL if not required, to use the defaults documented in
+ * k_work_queue_config.
+ */
+void k_work_queue_start_workers(struct k_work_q *queue,
+				struct k_thread *threads,
+				k_thread_stack_t *stacks, size_t stack_size,
+				size_t num_workers, int prio,
+				const struct k_work_queue_config *cfg);
+
 /** @brief Run work queue using calling thread
  *
  * This will run the work queue forever unless stopped by @ref k_work_queue_stop.
@@ -4580,6 +4719,13 @@ struct k_work_delayable {
 struct z_work_flusher {
 	struct k_work work;
 	struct k_sem sem;
+#if defined(CONFIG_WORKQUEUE_WORKERS)
+	/* On queues with several workers the flusher is not queued; instead
+	 * it tracks the instances of this item that are still to complete,
+	 * using the QUEUED and RUNNING bits of work.flags.
+	 */
+	struct k_work *target;
+#endif /* defined(CONFIG_WORKQUEUE_WORKERS) */
 };
 
 /* Record used to wait for work to complete a cancellation.
@@ -4659,6 +4805,16 @@ struct k_work_queue_config {
 	 * an error will be logged if CONFIG_LOG is enabled.
 	 */
 	uint32_t work_timeout_ms;
+
+#if defined(CONFIG_WORKQUEUE_WORKERS) || defined(__DOXYGEN__)
+	/** Control whether the threads started by
+	 * k_work_queue_start_workers() are pinned to CPUs.
+	 *
+	 * If @c true and CONFIG_SCHED_CPU_MASK is enabled, worker @c i is
+	 * pinned to CPU @c i modulo the number of CPUs.
+	 */
+	bool pin_workers;
+#endif /* defined(CONFIG_WORKQUEUE_WORKERS) */
 };
 
 /** @brief A structure used to hold work until it can be processed. */
@@ -4692,6 +4848,18 @@ struct k_work_q {
 	struct k_work *work;
 	k_timeout_t work_timeout;
 #endif /* defined(CONFIG_WORKQUEUE_WORK_TIMEOUT) */
+
+#if defined(CONFIG_WORKQUEUE_WORKERS)
+	/* Worker threads, if started with k_work_queue_start_workers(). */
+	struct k_thread *workers;
+	uint16_t num_workers;
+
+	/* Number of workers running an item. */
+	uint16_t busy;
+
+	/* Number of workers that have not exited. */
+	uint16_t live;
+#endif /* defined(CONFIG_WORKQUEUE_WORKERS) */
 };
 
 /* Provide the implementation for inline functions declared above */
@@ -5676,12 +5844,25 @@ struct k_mem_slab_info {
 #endif
 };
 
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+struct k_mem_slab_cpu_cache {
+	struct k_spinlock lock;
+	char *free_list;
+	uint32_t count;
+};
+#endif
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
 	char *buffer;
 	char *free_list;
 	struct k_mem_slab_info info;
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	/* Blocks in the CPU caches are counted in info.num_used */
+	struct k_mem_slab_cpu_cache cpu_cache[CONFIG_MP_MAX_NUM_CPUS];
+	bool waiters;
+#endif
 
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mem_slab)
 
@@ -5894,7 +6075,17 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem);
  */
 static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	uint32_t num_used = slab->info.num_used;
+
+	for (unsigned int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		num_used -= slab->cpu_cache[i].count;
+	}
+
+	return num_used;
+#else
 	return slab->info.num_used;
+#endif
 }
 
 /**
@@ -5933,7 +6124,7 @@ static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->info.num_blocks - slab->info.num_used;
+	return slab->info.num_blocks - k_mem_slab_num_used_get(slab);
 }
 
 /**
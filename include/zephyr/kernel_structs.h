@@ -112,19 +112,22 @@ struct _priq_rb {
 };
 
 
-/* Traditional/textbook "multi-queue" structure.  Separate lists for a
- * small number (max 32 here) of fixed priorities.  This corresponds
- * to the original Zephyr scheduler.  RAM requirements are
- * comparatively high, but performance is very fast.  Won't work with
- * features like deadline scheduling which need large priority spaces
- * to represent their requirements.
+/* Traditional/textbook "multi-queue" structure.  Separate lists for
+ * each of the fixed priorities.  This corresponds to the original
+ * Zephyr scheduler.  RAM requirements are comparatively high, but
+ * performance is very fast: a two-level bitmap (one bit per priority,
+ * plus one bit per non-empty bitmap word) finds the best non-empty
+ * list with two bit scans whatever the number of priorities.  Won't
+ * work with features like deadline scheduling which need large
+ * priority spaces to represent their requirements.
+ *
+ * The lists are only initialized once their priority bit gets set, so
+ * an all-zero structure is a valid empty queue.
  */
 struct _priq_mq {
 	sys_dlist_t queues[K_NUM_THREAD_PRIO];
 	unsigned long bitmask[PRIQ_BITMAP_SIZE];
-#ifndef CONFIG_SMP
-	unsigned int cached_queue_index;
-#endif
+	unsigned long group_mask;
 };
 
 struct _ready_q {
@@ -140,6 +143,11 @@ struct _ready_q {
 #elif defined(CONFIG_SCHED_MULTIQ)
 	struct _priq_mq runq;
 #endif
+
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	/* number of threads in runq, used to pick a peer to steal from */
+	unsigned int count;
+#endif
 };
 
 typedef struct _ready_q _ready_q_t;
@@ -157,7 +165,7 @@ struct _cpu {
 	/* one assigned idle thread per CPU */
 	struct k_thread *idle_thread;
 
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_PER_CPU_RUNQ)
 	struct _ready_q ready_q;
 #endif
 
@@ -216,7 +224,7 @@ struct z_kernel {
 	 * ready queue: can be big, keep after small fields, since some
 	 * assembly (e.g. ARC) are limited in the encoding of the offset
 	 */
-#ifndef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if !defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) && !defined(CONFIG_SCHED_PER_CPU_RUNQ)
 	struct _ready_q ready_q;
 #endif
 
@@ -274,7 +282,7 @@ __attribute_const__ struct k_thread *z_smp_current_get(void);
 #endif
 
 /* kernel wait queue record */
-#ifdef CONFIG_WAITQ_SCALABLE
+#if defined(CONFIG_WAITQ_SCALABLE)
 
 typedef struct {
 	struct _priq_rb waitq;
@@ -285,6 +293,14 @@ bool z_priq_rb_lessthan(struct rbnode *a, struct rbnode *b);
 
 #define Z_WAIT_Q_INIT(wait_q) { { { .lessthan_fn = z_priq_rb_lessthan } } }
 
+#elif defined(CONFIG_WAITQ_MULTIQ)
+
+typedef struct {
+	struct _priq_mq waitq;
+} _wait_q_t;
+
+#define Z_WAIT_Q_INIT(wait_q) { }
+
 #else
 
 typedef struct {
@@ -207,6 +207,13 @@ enum ethernet_hw_caps {
 
 	/** TX-Injection supported */
 	ETHERNET_TXINJECTION_MODE	= BIT(20),
+
+	/** TCP segmentation offload supported. TCP packets with a non-zero
+	 * net_pkt_gso_size() are given to the driver whole, and the driver
+	 * splits them into segments of that payload size, and computes the
+	 * TCP checksum of each segment.
+	 */
+	ETHERNET_HW_TSO			= BIT(21),
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -12,6 +12,7 @@
 #ifndef ZEPHYR_INCLUDE_NET_HTTP_SERVER_HPACK_H_
 #define ZEPHYR_INCLUDE_NET_HTTP_SERVER_HPACK_H_
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -104,6 +105,20 @@ enum http_hpack_static_key {
 #define HTTP_SERVER_HUFFMAN_DECODE_BUFFER_SIZE 0
 #endif
 
+#if defined(CONFIG_HTTP_SERVER)
+#define HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE
+#else
+#define HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE 0
+#endif
+
+/* Size accounted for each dynamic table entry on top of its name and value,
+ * RFC7541 ch 4.1.
+ */
+#define HTTP_HPACK_ENTRY_OVERHEAD 32
+
+/* Initial value of SETTINGS_HEADER_TABLE_SIZE, RFC9113 ch 6.5.2. */
+#define HTTP_HPACK_DEFAULT_TABLE_SIZE 4096
+
 /** @endcond */
 
 /** HTTP2 header field with decoding buffer. */
@@ -129,6 +144,60 @@ struct http_hpack_header_buf {
 
 /** @cond INTERNAL_HIDDEN */
 
+struct http_hpack_table_entry {
+	uint16_t offset;
+	uint16_t name_len;
+	uint16_t value_len;
+};
+
+/* HPACK dynamic table, RFC7541 ch 2.3.2. The names and values of the
+ * entries are stored back to back in the data buffer, oldest first.
+ */
+struct http_hpack_table {
+	uint8_t data[HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE];
+	struct http_hpack_table_entry
+		entries[HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE / HTTP_HPACK_ENTRY_OVERHEAD];
+
+	/* Size of the table as defined in RFC7541 ch 4.1. */
+	uint32_t size;
+
+	/* Maximum size of the table currently in effect. */
+	uint32_t max_size;
+
+	/* Largest maximum size a decoder accepts in a size update. */
+	uint32_t limit;
+
+	/* Smallest maximum size to be signaled by an encoder. */
+	uint32_t min_update;
+
+	/* Length of the data in the data buffer. */
+	uint16_t datalen;
+
+	/* Number of entries. */
+	uint16_t count;
+
+	/* The encoder has a size update to signal. */
+	bool size_update;
+};
+
+/* Initialize a dynamic table, max_size is capped to its capacity. A decoder
+ * table accepts size updates up to its capacity.
+ */
+void http_hpack_table_init(struct http_hpack_table *table, uint32_t max_size);
+
+/* Apply the SETTINGS_HEADER_TABLE_SIZE of the peer to an encoder table. */
+void http_hpack_table_set_limit(struct http_hpack_table *table, uint32_t limit);
+
+/* Empty an encoder table and signal it to the peer in the next header block. */
+void http_hpack_table_reset(struct http_hpack_table *table);
+
+int http_hpack_table_decode_header(struct http_hpack_table *table,
+				   const uint8_t *buf, size_t datalen,
+				   struct http_hpack_header_buf *header);
+int http_hpack_table_encode_header(struct http_hpack_table *table,
+				   uint8_t *buf, size_t buflen,
+				   struct http_hpack_header_buf *header);
+
 int http_hpack_huffman_decode(const uint8_t *encoded_buf, size_t encoded_len,
 			      uint8_t *buf, size_t buflen);
 int http_hpack_huffman_encode(const uint8_t *str, size_t str_len,
@@ -29,6 +29,10 @@
 #include <zephyr/net/socket.h>
 #include <zephyr/sys/iterable_sections.h>
 
+#if defined(CONFIG_FILE_SYSTEM)
+#include <zephyr/fs/fs.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -357,15 +361,35 @@ struct http2_stream_ctx {
 	int stream_id; /**< Stream identifier. */
 	enum http2_stream_state stream_state; /**< Stream state. */
 	int window_size; /**< Stream-level window size. */
+	int send_window_size; /**< Stream-level window size of the peer. */
 
 	/** Currently processed resource detail. */
 	struct http_resource_detail *current_detail;
 
+	/** Static resource data left to send in the reply. */
+	const uint8_t *send_data;
+
+	/** Length of the reply body left to send. */
+	size_t send_len;
+
+/** @cond INTERNAL_HIDDEN */
+	/** File the reply body is read from. */
+	IF_ENABLED(CONFIG_FILE_SYSTEM, (struct fs_file_t file));
+/** @endcond */
+
 	/** Flag indicating that headers were sent in the reply. */
 	bool headers_sent : 1;
 
 	/** Flag indicating that END_STREAM flag was sent. */
 	bool end_stream_sent : 1;
+
+	/** Flag indicating that the reply body is sent as the peer flow
+	 *  control windows allow.
+	 */
+	bool send_pending : 1;
+
+	/** Flag indicating that the reply body is read from a file. */
+	bool send_from_file : 1;
 };
 
 /** @brief HTTP/2 frame representation. */
@@ -430,6 +454,15 @@ struct http_client_ctx {
 	/** Connection-level window size. */
 	int window_size;
 
+	/** Connection-level window size of the peer. */
+	int send_window_size;
+
+	/** Initial stream-level window size of the peer. */
+	int peer_initial_window_size;
+
+	/** Maximum DATA frame payload size accepted by the peer. */
+	uint32_t peer_max_frame_size;
+
 	/** Server state for the associated client. */
 	enum http_server_state server_state;
 
@@ -445,6 +478,12 @@ struct http_client_ctx {
 	/** HTTP/2 header parser context. */
 	struct http_hpack_header_buf header_field;
 
+	/** HPACK dynamic table of the header fields received. */
+	struct http_hpack_table decoder_table;
+
+	/** HPACK dynamic table of the header fields sent. */
+	struct http_hpack_table encoder_table;
+
 	/** HTTP/2 streams context. */
 	struct http2_stream_ctx streams[HTTP_SERVER_MAX_STREAMS];
 
@@ -0,0 +1,74 @@
+/** @file
+ * @brief IPv4 network address and port translation (NAPT44)
+ */
+
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_NAPT_H_
+#define ZEPHYR_INCLUDE_NET_NAPT_H_
+
+#include <errno.h>
+
+#include <zephyr/net/net_if.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief IPv4 network address and port translation
+ * @defgroup net_napt Network Address and Port Translation
+ * @since 4.4
+ * @version 0.1.0
+ * @ingroup networking
+ * @{
+ */
+
+#if defined(CONFIG_NET_NAPT44) || defined(__DOXYGEN__)
+/**
+ * @brief Start translating the IPv4 packets forwarded to an interface.
+ *
+ * The TCP, UDP and ICMP echo packets received on any other Ethernet
+ * interface and sent to a host reached through @p iface get the preferred
+ * IPv4 address of @p iface as source address, and a port in the range set by
+ * @kconfig{CONFIG_NET_NAPT44_PORT_BASE}. The replies are translated back and
+ * forwarded to the host that sent the request. The mappings in use are
+ * dropped.
+ *
+ * @param iface Outside interface, which must be an Ethernet one with a
+ *        gateway.
+ *
+ * @return 0 if ok, -EINVAL if the interface cannot be used.
+ */
+int net_napt44_enable(struct net_if *iface);
+
+/**
+ * @brief Stop translating the IPv4 packets, and drop the mappings in use.
+ */
+void net_napt44_disable(void);
+#else
+static inline int net_napt44_enable(struct net_if *iface)
+{
+	ARG_UNUSED(iface);
+
+	return -ENOTSUP;
+}
+
+static inline void net_napt44_disable(void)
+{
+}
+#endif /* CONFIG_NET_NAPT44 */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_NET_NAPT_H_ */
@@ -111,7 +111,9 @@ extern "C" {
 
 #define iovec                     net_iovec
 #define msghdr                    net_msghdr
+#define mmsghdr                   net_mmsghdr
 #define cmsghdr                   net_cmsghdr
+#define sock_extended_err         zsock_extended_err
 #define ALIGN_H(x)                NET_ALIGN_H(x)
 #define ALIGN_D(x)                NET_ALIGN_D(x)
 #define CMSG_LEN(len)             NET_CMSG_LEN(len)
@@ -233,6 +235,10 @@ extern "C" {
 #define SO_SOCKS5                     ZSOCK_SO_SOCKS5
 #define SO_TXTIME                     ZSOCK_SO_TXTIME
 #define SCM_TXTIME                    ZSOCK_SCM_TXTIME
+#define SO_ZEROCOPY                   ZSOCK_SO_ZEROCOPY
+#define SCM_ZEROCOPY                  ZSOCK_SCM_ZEROCOPY
+#define SO_EE_ORIGIN_ZEROCOPY         ZSOCK_SO_EE_ORIGIN_ZEROCOPY
+#define SO_EE_CODE_ZEROCOPY_COPIED    ZSOCK_SO_EE_CODE_ZEROCOPY_COPIED
 #define SOF_TIMESTAMPING_RX_HARDWARE  ZSOCK_SOF_TIMESTAMPING_RX_HARDWARE
 #define SOF_TIMESTAMPING_TX_HARDWARE  ZSOCK_SOF_TIMESTAMPING_TX_HARDWARE
 
@@ -240,15 +246,19 @@ extern "C" {
 #define SHUT_WR   ZSOCK_SHUT_WR
 #define SHUT_RDWR ZSOCK_SHUT_RDWR
 
-#define MSG_PEEK     ZSOCK_MSG_PEEK
-#define MSG_TRUNC    ZSOCK_MSG_TRUNC
-#define MSG_DONTWAIT ZSOCK_MSG_DONTWAIT
-#define MSG_WAITALL  ZSOCK_MSG_WAITALL
+#define MSG_PEEK       ZSOCK_MSG_PEEK
+#define MSG_TRUNC      ZSOCK_MSG_TRUNC
+#define MSG_DONTWAIT   ZSOCK_MSG_DONTWAIT
+#define MSG_WAITALL    ZSOCK_MSG_WAITALL
+#define MSG_WAITFORONE ZSOCK_MSG_WAITFORONE
+#define MSG_ERRQUEUE   ZSOCK_MSG_ERRQUEUE
+#define MSG_ZEROCOPY   ZSOCK_MSG_ZEROCOPY
 
 #define TCP_NODELAY    ZSOCK_TCP_NODELAY
 #define TCP_KEEPIDLE   ZSOCK_TCP_KEEPIDLE
 #define TCP_KEEPINTVL  ZSOCK_TCP_KEEPINTVL
 #define TCP_KEEPCNT    ZSOCK_TCP_KEEPCNT
+#define TCP_CONGESTION ZSOCK_TCP_CONGESTION
 
 #define IP_TOS               ZSOCK_IP_TOS
 #define IP_TTL               ZSOCK_IP_TTL
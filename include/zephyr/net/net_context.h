@@ -290,8 +290,40 @@ __net_socket struct net_context {
 		/** Mutex used by condition variable */
 		struct k_mutex *lock;
 	} cond;
+
+	/** Incremented each time the context is allocated, so that the
+	 * buffers loaned by zsock_recv_zc() are not credited to a later user
+	 * of the context.
+	 */
+	uint32_t generation;
 #endif /* CONFIG_NET_SOCKETS */
 
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+	/** Completion of the zero-copy sends */
+	struct {
+		/** Raised when a zero-copy send completes */
+		struct k_poll_signal signal;
+
+		/** Protects the completion state */
+		struct k_spinlock lock;
+
+		/** Number of the next zero-copy send */
+		uint32_t next;
+
+		/** All the sends before this one are complete */
+		uint32_t done;
+
+		/** First completed send not reported yet */
+		uint32_t reported;
+
+		/** Sends completed out of order, bit n for send done + 1 + n */
+		uint32_t ahead;
+
+		/** Some of the completed sends were copied */
+		bool copied;
+	} zc;
+#endif /* CONFIG_NET_CONTEXT_ZEROCOPY */
+
 #if defined(CONFIG_NET_OFFLOAD)
 	/** context for use by offload drivers */
 	void *offload_context;
@@ -406,6 +438,10 @@ __net_socket struct net_context {
 #if defined(CONFIG_NET_CONTEXT_TIMESTAMPING)
 		/** Enable RX, TX or both timestamps of packets send through sockets. */
 		uint8_t timestamping;
+#endif
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+		/** Allow zero-copy sends */
+		bool zerocopy;
 #endif
 	} options;
 
@@ -1405,6 +1441,7 @@ enum net_context_option {
 	NET_OPT_IPV6_MCAST_LOOP	  = 22, /**< IPV6 multicast loop */
 	NET_OPT_IPV4_MCAST_LOOP	  = 23, /**< IPV4 multicast loop */
 	NET_OPT_RECV_HOPLIMIT     = 24, /**< Receive hop limit information */
+	NET_OPT_ZEROCOPY          = 25, /**< Allow zero-copy sends */
 };
 
 /**
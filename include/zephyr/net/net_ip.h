@@ -261,6 +261,12 @@ struct net_msghdr {
 	int               msg_flags;      /**< Flags on received message */
 };
 
+/** Message struct of zsock_sendmmsg() and zsock_recvmmsg() */
+struct net_mmsghdr {
+	struct net_msghdr msg_hdr; /**< Message */
+	unsigned int      msg_len; /**< Number of bytes sent or received */
+};
+
 /** Control message ancillary data */
 struct net_cmsghdr {
 	net_socklen_t cmsg_len;    /**< Number of bytes, including header */
@@ -317,6 +317,23 @@ struct net_pkt {
 	uint16_t vlan_tci;
 #endif /* CONFIG_NET_VLAN */
 
+#if defined(CONFIG_NET_GSO)
+	/* Payload size of the TCP segments this packet is split into before
+	 * being sent. Zero if the packet is sent as is.
+	 */
+	uint16_t gso_size;
+#endif /* CONFIG_NET_GSO */
+
+#if defined(CONFIG_NET_TC_RX_RSS)
+	/* Flow hash of a received packet, selecting its receive queue. Set
+	 * by the driver from the hash computed by the hardware, or from the
+	 * number of the hardware queue the packet was received on. Computed
+	 * by the stack if not valid.
+	 */
+	uint32_t rx_hash;
+	bool rx_hash_valid;
+#endif /* CONFIG_NET_TC_RX_RSS */
+
 #if defined(CONFIG_NET_PKT_CONTROL_BLOCK)
 	/* Control block which could be used by any layer */
 	union {
@@ -1059,6 +1076,72 @@ static inline void net_pkt_set_ip_reassembled(struct net_pkt *pkt,
 }
 #endif /* CONFIG_NET_IP_FRAGMENT */
 
+#if defined(CONFIG_NET_GSO)
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	return pkt->gso_size;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, uint16_t gso_size)
+{
+	pkt->gso_size = gso_size;
+}
+#else /* CONFIG_NET_GSO */
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0U;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, uint16_t gso_size)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(gso_size);
+}
+#endif /* CONFIG_NET_GSO */
+
+#if defined(CONFIG_NET_TC_RX_RSS)
+static inline uint32_t net_pkt_rx_hash(struct net_pkt *pkt)
+{
+	return pkt->rx_hash;
+}
+
+static inline bool net_pkt_rx_hash_is_valid(struct net_pkt *pkt)
+{
+	return pkt->rx_hash_valid;
+}
+
+/* Any value is a valid hash, so a driver can pass the number of the
+ * hardware queue the packet was received on, queue 0 included.
+ */
+static inline void net_pkt_set_rx_hash(struct net_pkt *pkt, uint32_t hash)
+{
+	pkt->rx_hash = hash;
+	pkt->rx_hash_valid = true;
+}
+#else /* CONFIG_NET_TC_RX_RSS */
+static inline uint32_t net_pkt_rx_hash(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0U;
+}
+
+static inline bool net_pkt_rx_hash_is_valid(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return false;
+}
+
+static inline void net_pkt_set_rx_hash(struct net_pkt *pkt, uint32_t hash)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(hash);
+}
+#endif /* CONFIG_NET_TC_RX_RSS */
+
 static inline uint8_t net_pkt_priority(struct net_pkt *pkt)
 {
 	return pkt->priority;
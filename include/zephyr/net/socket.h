@@ -78,6 +78,12 @@ extern "C" {
 #define ZSOCK_MSG_DONTWAIT 0x40
 /** zsock_recv: block until the full amount of data can be returned */
 #define ZSOCK_MSG_WAITALL 0x100
+/** zsock_recvmsg: Read the completions of zero-copy sends */
+#define ZSOCK_MSG_ERRQUEUE 0x2000
+/** zsock_recvmmsg: Override operation to non-blocking after the first message */
+#define ZSOCK_MSG_WAITFORONE 0x10000
+/** zsock_send: Send the data without copying it, see @c ZSOCK_SO_ZEROCOPY */
+#define ZSOCK_MSG_ZEROCOPY 0x4000000
 /** @} */
 
 /**
@@ -554,6 +560,54 @@ static inline ssize_t zsock_recv(int sock, void *buf, size_t max_len,
 	return zsock_recvfrom(sock, buf, max_len, flags, NULL, NULL);
 }
 
+/**
+ * @brief Send multiple messages on a socket
+ *
+ * @details
+ * Send the @p vlen messages of @p msgvec as if zsock_sendmsg() was called
+ * for each of them, but with the socket looked up and locked only once.
+ * The number of bytes sent for each message is stored in its @c msg_len
+ * field. Sending stops at the first message that cannot be sent.
+ * This function is also exposed as `sendmmsg()`
+ * if @kconfig{CONFIG_POSIX_API} is defined.
+ *
+ * @param sock Socket descriptor
+ * @param msgvec Array of messages
+ * @param vlen Number of messages in @p msgvec
+ * @param flags Flags, as for zsock_sendmsg()
+ *
+ * @return Number of messages sent, or -1 with errno set if the first one
+ *         could not be sent.
+ */
+__syscall int zsock_sendmmsg(int sock, struct net_mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+/**
+ * @brief Receive multiple messages from a socket
+ *
+ * @details
+ * Receive up to @p vlen messages into @p msgvec as if zsock_recvmsg() was
+ * called for each of them, but with the socket looked up and locked only
+ * once. The number of bytes received for each message is stored in its
+ * @c msg_len field. With @c ZSOCK_MSG_WAITFORONE, only the reception of
+ * the first message may block, and the call returns as soon as the socket
+ * queue is drained. The timeout is only checked after each received
+ * message, as on Linux.
+ * This function is also exposed as `recvmmsg()`
+ * if @kconfig{CONFIG_POSIX_API} is defined.
+ *
+ * @param sock Socket descriptor
+ * @param msgvec Array of messages
+ * @param vlen Number of messages in @p msgvec
+ * @param flags Flags, as for zsock_recvmsg(), and @c ZSOCK_MSG_WAITFORONE
+ * @param timeout Timeout in milliseconds, or @c SYS_FOREVER_MS
+ *
+ * @return Number of messages received, or -1 with errno set if no message
+ *         could be received.
+ */
+__syscall int zsock_recvmmsg(int sock, struct net_mmsghdr *msgvec,
+			     unsigned int vlen, int flags, int timeout);
+
 /**
  * @brief Control blocking/non-blocking mode of a socket
  *
@@ -895,6 +949,63 @@ int zsock_send_all(int sock, const void *buf, size_t len, int flags,
 int zsock_sendmsg_all(int sock, const struct net_msghdr *msg, int flags,
 		      k_timeout_t timeout, size_t *sent_len);
 
+/**
+ * @brief Buffers loaned to the application by zsock_recv_zc()
+ */
+struct zsock_zc_loan {
+	/** Number of bytes loaned */
+	size_t len;
+
+	/** @cond INTERNAL_HIDDEN */
+	void *pkt;
+	void *ctx;
+	uint32_t generation;
+	/** @endcond */
+};
+
+/**
+ * @brief Receive data from a socket without copying it
+ *
+ * @details
+ * Instead of copying the received data to a user buffer, the iovecs in
+ * @p iov are set to point to the network buffers holding it. The buffers
+ * are loaned to the caller, and stay allocated from the network buffer
+ * pool until zsock_recv_zc_release() is called for @p loan. For a stream
+ * socket, the receive window is only opened again on release, so holding
+ * loans slows down the peer like a full receive buffer would. A datagram
+ * is always received in full, and the part of it not covered by @p iov
+ * is discarded.
+ * Only the native IP sockets support this call, and it can only be used
+ * from kernel mode.
+ *
+ * @param sock Socket descriptor
+ * @param iov Array of iovecs to fill
+ * @param iovcnt Number of entries in @p iov on entry, number of entries
+ *        filled on return
+ * @param flags Socket flags, only @c ZSOCK_MSG_DONTWAIT is supported
+ * @param src_addr Source address of the data, can be NULL
+ * @param addrlen Length of @p src_addr, value-result argument
+ * @param loan Loan to release once the data is processed
+ *
+ * @return Number of bytes received, 0 at the end of a stream, or -1 with
+ *         errno set on failure. The loan is only taken on success.
+ */
+ssize_t zsock_recv_zc(int sock, struct net_iovec *iov, size_t *iovcnt, int flags,
+		      struct net_sockaddr *src_addr, net_socklen_t *addrlen,
+		      struct zsock_zc_loan *loan);
+
+/**
+ * @brief Release the buffers loaned by zsock_recv_zc()
+ *
+ * @details
+ * The buffers are freed even if the socket was closed in the meantime,
+ * but loans should be released before closing the socket.
+ *
+ * @param sock Socket descriptor the data was received from
+ * @param loan Loan taken by zsock_recv_zc()
+ */
+void zsock_recv_zc_release(int sock, struct zsock_zc_loan *loan);
+
 /**
  * @name Socket level options (ZSOCK_SOL_SOCKET)
  * @{
@@ -969,6 +1080,11 @@ int zsock_sendmsg_all(int sock, const struct net_msghdr *msg, int flags,
 /** Socket TX time (same as SO_TXTIME) */
 #define ZSOCK_SCM_TXTIME ZSOCK_SO_TXTIME
 
+/** Allow sending data without copying it, with the @c ZSOCK_MSG_ZEROCOPY flag */
+#define ZSOCK_SO_ZEROCOPY 62
+/** Completion of zero-copy sends (same as SO_ZEROCOPY) */
+#define ZSOCK_SCM_ZEROCOPY ZSOCK_SO_ZEROCOPY
+
 /** Timestamp generation flags */
 
 /** Request RX timestamps generated by network adapter. */
@@ -983,6 +1099,33 @@ int zsock_sendmsg_all(int sock, const struct net_msghdr *msg, int flags,
 
 /** @} */
 
+/**
+ * @brief Completion of zero-copy sends
+ *
+ * @details
+ * Each send with the @c ZSOCK_MSG_ZEROCOPY flag that queued some data is
+ * numbered, starting from 0. Once the network stack does not reference the
+ * data of some sends anymore, zsock_poll() reports @c ZSOCK_POLLERR, and
+ * zsock_recvmsg() called with @c ZSOCK_MSG_ERRQUEUE returns this structure
+ * in a control message of level @c ZSOCK_SOL_SOCKET and type
+ * @c ZSOCK_SCM_ZEROCOPY. The completed sends are numbered from @c ee_info
+ * to @c ee_data, and the buffers they were given can be reused.
+ */
+struct zsock_extended_err {
+	uint32_t ee_errno;  /**< Always 0 for zero-copy completions */
+	uint8_t ee_origin;  /**< ZSOCK_SO_EE_ORIGIN_ZEROCOPY */
+	uint8_t ee_type;    /**< Unused */
+	uint8_t ee_code;    /**< 0 or ZSOCK_SO_EE_CODE_ZEROCOPY_COPIED */
+	uint8_t ee_pad;     /**< Unused */
+	uint32_t ee_info;   /**< Number of the first completed send */
+	uint32_t ee_data;   /**< Number of the last completed send */
+};
+
+/** The extended error reports the completion of zero-copy sends */
+#define ZSOCK_SO_EE_ORIGIN_ZEROCOPY 5
+/** The data of some of the completed sends was copied */
+#define ZSOCK_SO_EE_CODE_ZEROCOPY_COPIED 1
+
 /**
  * @name TCP level options (NET_IPPROTO_TCP)
  * @{
@@ -996,6 +1139,8 @@ int zsock_sendmsg_all(int sock, const struct net_msghdr *msg, int flags,
 #define ZSOCK_TCP_KEEPINTVL 3
 /** Number of keepalives before dropping connection */
 #define ZSOCK_TCP_KEEPCNT 4
+/** Congestion control algorithm of the connection (string, e.g. "cubic") */
+#define ZSOCK_TCP_CONGESTION 5
 
 /** @} */
 
@@ -1241,6 +1386,10 @@ struct socket_op_vtable {
 			   net_socklen_t *addrlen);
 	int (*getsockname)(void *obj, struct net_sockaddr *addr,
 			   net_socklen_t *addrlen);
+	ssize_t (*recv_zc)(void *obj, struct net_iovec *iov, size_t *iovcnt,
+			   int flags, struct net_sockaddr *src_addr,
+			   net_socklen_t *addrlen, struct zsock_zc_loan *loan);
+	void (*recv_zc_release)(void *obj, struct zsock_zc_loan *loan);
 };
 
 /** @endcond */
@@ -81,12 +81,15 @@ struct net_socket_service_desc {
 	int pev_len;
 	/** Where are my pollfd entries in the global list */
 	int *idx;
+	/** Worker running the service plus one, or 0 if not set */
+	int *worker;
 };
 
 /** @cond INTERNAL_HIDDEN */
 
 #define __z_net_socket_svc_get_name(_svc_id) __z_net_socket_service_##_svc_id
 #define __z_net_socket_svc_get_idx(_svc_id) __z_net_socket_service_idx_##_svc_id
+#define __z_net_socket_svc_get_worker(_svc_id) __z_net_socket_service_worker_##_svc_id
 #define __z_net_socket_svc_get_owner __FILE__ ":" STRINGIFY(__LINE__)
 
 #if CONFIG_NET_SOCKETS_LOG_LEVEL >= LOG_LEVEL_DBG
@@ -97,6 +100,7 @@ struct net_socket_service_desc {
 
 #define __z_net_socket_service_define(_name, _cb, _count, ...) \
 	static int __z_net_socket_svc_get_idx(_name);			\
+	static int __z_net_socket_svc_get_worker(_name);		\
 	static struct net_socket_service_event				\
 			__z_net_socket_svc_get_name(_name)[_count] = {	\
 		[0 ... ((_count) - 1)] = {				\
@@ -110,6 +114,7 @@ struct net_socket_service_desc {
 		.pev = __z_net_socket_svc_get_name(_name),		\
 		.pev_len = (_count),					\
 		.idx = &__z_net_socket_svc_get_idx(_name),		\
+		.worker = &__z_net_socket_svc_get_worker(_name),	\
 	}
 
 /** @endcond */
@@ -118,7 +123,8 @@ struct net_socket_service_desc {
  * @brief Statically define a network socket service.
  *        The user callback is called synchronously for this service meaning that
  *        the service API will wait until the user callback returns before continuing
- *        with next socket service.
+ *        with next socket service. With worker threads, only the services of the
+ *        same worker wait.
  *
  * The socket service can be accessed outside the module where it is defined using:
  *
@@ -177,6 +183,66 @@ static inline int net_socket_service_unregister(const struct net_socket_service_
 	return net_socket_service_register(service, NULL, 0, NULL);
 }
 
+/**
+ * @brief Set the worker thread running a service.
+ *
+ * With @kconfig{CONFIG_NET_SOCKETS_SERVICE_WORKERS} worker threads, the callbacks
+ * of the services are called by the workers instead of the thread polling the
+ * sockets, so that a slow callback only delays the services of its worker. The
+ * services are spread over the workers unless they are given one.
+ *
+ * @param service Pointer to a service description.
+ * @param worker Index of the worker, or -1 to let the service be spread with the
+ *        others.
+ * @retval 0 No error
+ * @retval -EINVAL Invalid service or worker.
+ * @retval -ENOTSUP There are no worker threads.
+ */
+int net_socket_service_set_worker(const struct net_socket_service_desc *service, int worker);
+
+/**
+ * @brief Get the worker thread running a service.
+ *
+ * @param service Pointer to a service description.
+ * @return Index of the worker, always 0 if there are no worker threads.
+ */
+int net_socket_service_get_worker(const struct net_socket_service_desc *service);
+
+/**
+ * Statistics of a thread calling socket service callbacks.
+ */
+struct net_socket_service_stats {
+	/** Number of callbacks called */
+	uint32_t events;
+	/** Number of batches of ready events handed to the thread */
+	uint32_t batches;
+	/** Number of ready events waiting for their callback */
+	uint32_t queue_depth;
+	/** Maximum number of ready events waiting for their callback */
+	uint32_t max_queue_depth;
+	/** Sum of the times from the poll wake up to the callback call */
+	uint64_t latency_sum_us;
+	/** Maximum time from the poll wake up to the callback call */
+	uint32_t latency_max_us;
+	/** Sum of the times spent in the callbacks */
+	uint64_t run_sum_us;
+	/** Maximum time spent in a callback */
+	uint32_t run_max_us;
+};
+
+/**
+ * @brief Get the statistics of a thread calling socket service callbacks.
+ *
+ * Needs @kconfig{CONFIG_NET_SOCKETS_SERVICE_STATS}.
+ *
+ * @param worker Index of the worker, 0 for the thread polling the sockets if
+ *        there are no worker threads.
+ * @param stats Statistics of the thread.
+ * @retval 0 No error
+ * @retval -EINVAL Invalid worker.
+ */
+int net_socket_service_stats_get(int worker, struct net_socket_service_stats *stats);
+
 /**
  * @typedef net_socket_service_cb_t
  * @brief Callback used while iterating over socket services.
@@ -0,0 +1,172 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief public sys_condvar APIs.
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_CONDVAR_H_
+#define ZEPHYR_INCLUDE_SYS_CONDVAR_H_
+
+/*
+ * sys_condvar is a condition variable used together with a sys_mutex.
+ * When user mode is enabled it resides in user memory and is built on a
+ * k_futex, so that signalling it without waiters takes no syscall. When
+ * user mode isn't enabled, sys_condvar behaves like k_condvar.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/mutex.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * sys_condvar structure
+ */
+struct sys_condvar {
+#ifdef CONFIG_USERSPACE
+	struct k_futex seq;
+	atomic_t waiters;
+	struct sys_mutex *mutex;
+#else
+	struct k_condvar kernel_condvar;
+#endif
+};
+
+/**
+ * @defgroup user_condvar_apis User mode condition variable APIs
+ * @ingroup usermode_apis
+ * @{
+ */
+
+/**
+ * @brief Statically define and initialize a sys_condvar
+ *
+ * The condition variable can be accessed outside the module where it is
+ * defined using:
+ *
+ * @code extern struct sys_condvar <name>; @endcode
+ *
+ * Route this to memory domains using K_APP_DMEM().
+ *
+ * @param name Name of the condition variable.
+ */
+#ifdef CONFIG_USERSPACE
+#define SYS_CONDVAR_DEFINE(name) \
+	struct sys_condvar name
+#else
+#define SYS_CONDVAR_DEFINE(name) \
+	struct sys_condvar name = { \
+		.kernel_condvar = Z_CONDVAR_INITIALIZER(name.kernel_condvar) \
+	}
+#endif
+
+#ifdef CONFIG_USERSPACE
+/**
+ * @brief Initialize a condition variable.
+ *
+ * This routine is only necessary to call when the condition variable was
+ * not created with SYS_CONDVAR_DEFINE().
+ *
+ * @param condvar Address of the condition variable.
+ */
+static inline void sys_condvar_init(struct sys_condvar *condvar)
+{
+	atomic_clear(&condvar->seq.val);
+	atomic_clear(&condvar->waiters);
+	condvar->mutex = NULL;
+}
+
+/**
+ * @brief Signal a condition variable.
+ *
+ * Wakes up the highest priority thread waiting on @a condvar, if any.
+ *
+ * @param condvar Address of the condition variable.
+ *
+ * @retval 0 On success.
+ * @retval -EACCES Caller has no access to the condition variable.
+ * @retval -EINVAL Condition variable not recognized by the kernel.
+ */
+int sys_condvar_signal(struct sys_condvar *condvar);
+
+/**
+ * @brief Wake up all threads waiting on a condition variable.
+ *
+ * With CONFIG_SYS_MUTEX_FUTEX, a single thread is woken up and the other
+ * ones are moved to the mutex they waited with, so that they are woken
+ * up one at a time as the mutex gets unlocked.
+ *
+ * @param condvar Address of the condition variable.
+ *
+ * @retval 0 On success.
+ * @retval -EACCES Caller has no access to the condition variable.
+ * @retval -EINVAL Condition variable not recognized by the kernel.
+ */
+int sys_condvar_broadcast(struct sys_condvar *condvar);
+
+/**
+ * @brief Wait on a condition variable.
+ *
+ * Atomically unlocks @a mutex and waits for @a condvar to be signaled,
+ * then locks @a mutex again before returning. The mutex must be locked
+ * once by the caller. All threads waiting on the same condition variable
+ * must use the same mutex.
+ *
+ * @param condvar Address of the condition variable.
+ * @param mutex Address of the mutex.
+ * @param timeout Waiting period for the condition variable,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 On success.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EPERM Caller does not own the mutex.
+ * @retval -EACCES Caller has no access to the condition variable.
+ * @retval -EINVAL Condition variable not recognized by the kernel.
+ */
+int sys_condvar_wait(struct sys_condvar *condvar, struct sys_mutex *mutex,
+		     k_timeout_t timeout);
+#else
+static inline void sys_condvar_init(struct sys_condvar *condvar)
+{
+	k_condvar_init(&condvar->kernel_condvar);
+}
+
+static inline int sys_condvar_signal(struct sys_condvar *condvar)
+{
+	return k_condvar_signal(&condvar->kernel_condvar);
+}
+
+static inline int sys_condvar_broadcast(struct sys_condvar *condvar)
+{
+	(void)k_condvar_broadcast(&condvar->kernel_condvar);
+
+	return 0;
+}
+
+static inline int sys_condvar_wait(struct sys_condvar *condvar,
+				   struct sys_mutex *mutex,
+				   k_timeout_t timeout)
+{
+	return k_condvar_wait(&condvar->kernel_condvar, &mutex->kernel_mutex,
+			      timeout);
+}
+#endif /* CONFIG_USERSPACE */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_CONDVAR_H_ */
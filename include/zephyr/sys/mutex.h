@@ -11,9 +11,10 @@
  * sys_mutex behaves almost exactly like k_mutex, with the added advantage
  * that a sys_mutex instance can reside in user memory.
  *
- * Further enhancements will support locking/unlocking uncontended sys_mutexes
- * with simple atomic ops instead of syscalls, similar to Linux's
- * FUTEX_LOCK_PI and FUTEX_UNLOCK_PI
+ * With CONFIG_SYS_MUTEX_FUTEX, a sys_mutex is built on a k_futex, and is
+ * locked and unlocked with simple atomic ops instead of syscalls when
+ * there is no contention. Such mutexes do not implement priority
+ * inheritance.
  */
 
 #ifdef __cplusplus
@@ -25,13 +26,22 @@ extern "C" {
 #include <zephyr/types.h>
 #include <zephyr/sys_clock.h>
 
+#ifdef CONFIG_SYS_MUTEX_FUTEX
+#include <zephyr/kernel.h>
+
 struct sys_mutex {
-	/* Currently unused, but will be used to store state for fast mutexes
-	 * that can be locked/unlocked with atomic ops if there is no
-	 * contention
-	 */
+	/* 0: unlocked, 1: locked, 2: locked with threads waiting */
+	struct k_futex futex;
+	/* Only written by the owner, and read to detect recursive locking */
+	k_tid_t owner;
+	uint32_t lock_count;
+};
+#else
+struct sys_mutex {
+	/* Unused, the mutex is a kernel object backed by a k_mutex */
 	atomic_t val;
 };
+#endif /* CONFIG_SYS_MUTEX_FUTEX */
 
 /**
  * @defgroup user_mutex_apis User mode mutex APIs
@@ -65,6 +75,14 @@ struct sys_mutex {
  *
  * @param mutex Address of the mutex.
  */
+#ifdef CONFIG_SYS_MUTEX_FUTEX
+static inline void sys_mutex_init(struct sys_mutex *mutex)
+{
+	atomic_clear(&mutex->futex.val);
+	mutex->owner = NULL;
+	mutex->lock_count = 0U;
+}
+#else
 static inline void sys_mutex_init(struct sys_mutex *mutex)
 {
 	ARG_UNUSED(mutex);
@@ -78,6 +96,7 @@ __syscall int z_sys_mutex_kernel_lock(struct sys_mutex *mutex,
 				      k_timeout_t timeout);
 
 __syscall int z_sys_mutex_kernel_unlock(struct sys_mutex *mutex);
+#endif /* CONFIG_SYS_MUTEX_FUTEX */
 
 /**
  * @brief Lock a mutex.
@@ -99,11 +118,14 @@ __syscall int z_sys_mutex_kernel_unlock(struct sys_mutex *mutex);
  * @retval -EACCES Caller has no access to provided mutex address
  * @retval -EINVAL Provided mutex not recognized by the kernel
  */
+#ifdef CONFIG_SYS_MUTEX_FUTEX
+int sys_mutex_lock(struct sys_mutex *mutex, k_timeout_t timeout);
+#else
 static inline int sys_mutex_lock(struct sys_mutex *mutex, k_timeout_t timeout)
 {
-	/* For now, make the syscall unconditionally */
 	return z_sys_mutex_kernel_lock(mutex, timeout);
 }
+#endif /* CONFIG_SYS_MUTEX_FUTEX */
 
 /**
  * @brief Unlock a mutex.
@@ -122,11 +144,14 @@ static inline int sys_mutex_lock(struct sys_mutex *mutex, k_timeout_t timeout)
  *                 locked
  * @retval -EPERM Caller does not own the mutex
  */
+#ifdef CONFIG_SYS_MUTEX_FUTEX
+int sys_mutex_unlock(struct sys_mutex *mutex);
+#else
 static inline int sys_mutex_unlock(struct sys_mutex *mutex)
 {
-	/* For now, make the syscall unconditionally */
 	return z_sys_mutex_kernel_unlock(mutex);
 }
+#endif /* CONFIG_SYS_MUTEX_FUTEX */
 
 #include <zephyr/syscalls/mutex.h>
 
@@ -0,0 +1,81 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief public sys_once APIs.
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_ONCE_H_
+#define ZEPHYR_INCLUDE_SYS_ONCE_H_
+
+/*
+ * sys_once runs an initialization function exactly once, however many
+ * threads try to. Once it has run, sys_once() is a single atomic load. When
+ * user mode is enabled, threads finding the function running wait on a
+ * k_futex.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * sys_once structure
+ */
+struct sys_once {
+#ifdef CONFIG_USERSPACE
+	struct k_futex state;
+#else
+	atomic_t state;
+#endif
+};
+
+/**
+ * @defgroup user_once_apis User mode one-time initialization APIs
+ * @ingroup usermode_apis
+ * @{
+ */
+
+/**
+ * @brief Statically define and initialize a sys_once
+ *
+ * Route this to memory domains using K_APP_DMEM().
+ *
+ * @param name Name of the sys_once.
+ */
+#define SYS_ONCE_DEFINE(name) \
+	struct sys_once name
+
+/**
+ * @brief Run a function once.
+ *
+ * The first thread to call this routine on @a once runs @a init_func.
+ * Threads calling it while @a init_func runs wait for it to return, and
+ * threads calling it afterwards return right away.
+ *
+ * @param once Address of the sys_once.
+ * @param init_func Initialization function.
+ *
+ * @retval 0 The function has run.
+ * @retval -EACCES Caller has no access to the sys_once.
+ * @retval -EINVAL The sys_once is not recognized by the kernel.
+ */
+int sys_once(struct sys_once *once, void (*init_func)(void));
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_ONCE_H_ */
@@ -48,11 +48,40 @@ struct k_p4wq_work {
 	};
 	struct k_thread *thread;
 	struct k_p4wq *queue;
+#ifdef CONFIG_P4WQ_WORK_STEALING
+	uint32_t shard;
+#endif
 };
 
 #define K_P4WQ_QUEUE_PER_THREAD		BIT(0)
 #define K_P4WQ_DELAYED_START		BIT(1)
 #define K_P4WQ_USER_CPU_MASK		BIT(2)
+#define K_P4WQ_WORK_STEALING		BIT(3)
+
+#ifdef CONFIG_P4WQ_WORK_STEALING
+/* Per-CPU part of a work stealing P4 Queue.  Items are queued on the
+ * shard of the CPU that submitted them, and run from the active list
+ * of the CPU whose worker picked them up.
+ */
+struct k_p4wq_shard {
+	struct k_spinlock lock;
+
+	/* Worker threads that went idle on this CPU */
+	_wait_q_t waitq;
+
+	/* Work items submitted from this CPU */
+	struct rbtree queue;
+
+	/* Work items in progress on this CPU */
+	sys_dlist_t active;
+
+	/* Priority and deadline of the best item in the queue, read
+	 * without the lock by workers looking for an item to steal
+	 */
+	atomic_t top_priority;
+	atomic_t top_deadline;
+};
+#endif
 
 /**
  * @brief P4 Queue
@@ -86,6 +115,22 @@ struct k_p4wq {
 	 * and k_p4wq_work is not needed by p4wq anymore
 	 */
 	k_p4wq_done_handler_t done_handler;
+
+#ifdef CONFIG_P4WQ_WORK_STEALING
+	/* Used instead of the fields above with K_P4WQ_WORK_STEALING */
+	struct k_p4wq_shard shards[CONFIG_MP_MAX_NUM_CPUS];
+
+	/* Bumped on every submission, so idle workers notice items
+	 * queued while they were looking for one
+	 */
+	atomic_t seq;
+
+	/* Number of idle worker threads */
+	atomic_t idle;
+
+	/* Number of items in progress */
+	atomic_t nactive;
+#endif
 };
 
 struct k_p4wq_initparam {
@@ -126,6 +171,33 @@ struct k_p4wq_initparam {
 		.done_handler = dn_handler,			\
 	}
 
+/**
+ * @brief Statically initialize a P4 Work Queue with flags
+ *
+ * Same like K_P4WQ_DEFINE but the queue is created with flags, such
+ * as K_P4WQ_WORK_STEALING.
+ *
+ * @param name Symbol name of the struct k_p4wq that will be defined
+ * @param n_threads Number of threads in the work queue pool
+ * @param stack_sz Requested stack size of each thread, in bytes
+ * @param flg Flags
+ */
+#define K_P4WQ_DEFINE_WITH_FLAGS(name, n_threads, stack_sz, flg)	\
+	static K_THREAD_STACK_ARRAY_DEFINE(_p4stacks_##name,		\
+					   n_threads, stack_sz);	\
+	static struct k_thread _p4threads_##name[n_threads];		\
+	static struct k_p4wq name;					\
+	static const STRUCT_SECTION_ITERABLE(k_p4wq_initparam,		\
+					     _init_##name) = {		\
+		.num = n_threads,					\
+		.stack_size = stack_sz,					\
+		.threads = _p4threads_##name,				\
+		.stacks = &(_p4stacks_##name[0][0]),			\
+		.queue = &name,						\
+		.flags = flg,						\
+		.done_handler = NULL,					\
+	}
+
 /**
  * @brief Statically initialize a P4 Work Queue
  *
@@ -182,6 +254,15 @@ struct k_p4wq_initparam {
  * via this function (or statically using K_P4WQ_DEFINE) before any
  * other API calls are made on it.
  *
+ * To make a work stealing queue, set K_P4WQ_WORK_STEALING in the
+ * flags of the queue after initializing it, before adding threads.
+ * Such a queue keeps a queue of pending items per CPU, so that
+ * submissions from and workers on different CPUs do not contend for
+ * one lock.  Idle workers run the best pending item of any CPU, and
+ * a worker is woken for a new item whenever a CPU is free or the item
+ * should preempt a running one.  This requires
+ * CONFIG_P4WQ_WORK_STEALING.
+ *
  * @param queue P4 Queue to initialize
  */
 void k_p4wq_init(struct k_p4wq *queue);
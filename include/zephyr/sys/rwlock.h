@@ -0,0 +1,138 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief public sys_rwlock APIs.
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_RWLOCK_H_
+#define ZEPHYR_INCLUDE_SYS_RWLOCK_H_
+
+/*
+ * sys_rwlock is a lock that can be held by any number of readers, or by a
+ * single writer. When user mode is enabled it resides in user memory and is
+ * built on a k_futex, so that it is taken and released without syscalls when
+ * there is no contention. When user mode isn't enabled, it is built on a
+ * k_mutex and a k_condvar.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * sys_rwlock structure
+ */
+struct sys_rwlock {
+#ifdef CONFIG_USERSPACE
+	/* Number of readers holding the lock, or -1 if a writer holds it */
+	struct k_futex state;
+	atomic_t waiters;
+#else
+	struct k_mutex lock;
+	struct k_condvar cond;
+	int state;
+#endif
+	k_tid_t writer;
+};
+
+/**
+ * @defgroup user_rwlock_apis User mode reader/writer lock APIs
+ * @ingroup usermode_apis
+ * @{
+ */
+
+/**
+ * @brief Statically define and initialize a sys_rwlock
+ *
+ * The lock can be accessed outside the module where it is defined using:
+ *
+ * @code extern struct sys_rwlock <name>; @endcode
+ *
+ * Route this to memory domains using K_APP_DMEM().
+ *
+ * @param name Name of the lock.
+ */
+#ifdef CONFIG_USERSPACE
+#define SYS_RWLOCK_DEFINE(name) \
+	struct sys_rwlock name
+#else
+#define SYS_RWLOCK_DEFINE(name) \
+	struct sys_rwlock name = { \
+		.lock = Z_MUTEX_INITIALIZER(name.lock), \
+		.cond = Z_CONDVAR_INITIALIZER(name.cond), \
+	}
+#endif
+
+/**
+ * @brief Initialize a reader/writer lock.
+ *
+ * This routine is only necessary to call when the lock was not created
+ * with SYS_RWLOCK_DEFINE().
+ *
+ * @param rwlock Address of the lock.
+ */
+void sys_rwlock_init(struct sys_rwlock *rwlock);
+
+/**
+ * @brief Lock a reader/writer lock for reading.
+ *
+ * Waits while a writer holds the lock. Readers are preferred over waiting
+ * writers, so a lock read by overlapping readers may keep writers waiting.
+ *
+ * @param rwlock Address of the lock.
+ * @param timeout Waiting period to lock the lock,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Lock held for reading.
+ * @retval -EBUSY Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+int sys_rwlock_rdlock(struct sys_rwlock *rwlock, k_timeout_t timeout);
+
+/**
+ * @brief Lock a reader/writer lock for writing.
+ *
+ * Waits while the lock is held by readers or by another writer. Unlike
+ * sys_mutex, the lock cannot be taken recursively.
+ *
+ * @param rwlock Address of the lock.
+ * @param timeout Waiting period to lock the lock,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Lock held for writing.
+ * @retval -EBUSY Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+int sys_rwlock_wrlock(struct sys_rwlock *rwlock, k_timeout_t timeout);
+
+/**
+ * @brief Unlock a reader/writer lock.
+ *
+ * Releases the lock held for reading or for writing by the caller.
+ *
+ * @param rwlock Address of the lock.
+ *
+ * @retval 0 Lock released.
+ * @retval -EINVAL The lock was not held.
+ * @retval -EPERM The lock is held for writing by another thread.
+ */
+int sys_rwlock_unlock(struct sys_rwlock *rwlock);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_RWLOCK_H_ */
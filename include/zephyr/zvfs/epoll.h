@@ -0,0 +1,98 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZEPHYR_ZVFS_EPOLL_H_
+#define ZEPHYR_INCLUDE_ZEPHYR_ZVFS_EPOLL_H_
+
+#include <stdint.h>
+
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ZVFS_EPOLL_CLOEXEC 0x80000
+
+#define ZVFS_EPOLL_CTL_ADD 1
+#define ZVFS_EPOLL_CTL_DEL 2
+#define ZVFS_EPOLL_CTL_MOD 3
+
+/* The readiness events have the values of the matching ZVFS_POLL* flags */
+#define ZVFS_EPOLLIN      BIT(0)
+#define ZVFS_EPOLLPRI     BIT(1)
+#define ZVFS_EPOLLOUT     BIT(2)
+#define ZVFS_EPOLLERR     BIT(3)
+#define ZVFS_EPOLLHUP     BIT(4)
+#define ZVFS_EPOLLONESHOT BIT(30)
+#define ZVFS_EPOLLET      BIT(31)
+
+union zvfs_epoll_data {
+	void *ptr;
+	int fd;
+	uint32_t u32;
+	uint64_t u64;
+};
+
+struct zvfs_epoll_event {
+	uint32_t events;
+	union zvfs_epoll_data data;
+};
+
+/**
+ * @brief Create a ZVFS epoll instance
+ *
+ * The returned file descriptor refers to an interest list, to which the
+ * descriptors supporting poll (sockets, eventfds, ...) are added with
+ * @ref zvfs_epoll_ctl. Each of them is registered once with the kernel
+ * object signaling its readiness, and moved to the ready list of the
+ * instance when it is signaled, so that @ref zvfs_epoll_wait only checks
+ * the descriptors which may be ready.
+ *
+ * @param flags 0 or ZVFS_EPOLL_CLOEXEC, which is ignored
+ *
+ * @return New ZVFS epoll file descriptor on success, -1 on error
+ */
+int zvfs_epoll_create(int flags);
+
+/**
+ * @brief Add, modify or remove a descriptor of a ZVFS epoll interest list
+ *
+ * Closing a descriptor removes it from the interest lists it is in.
+ * Edge triggered notification (ZVFS_EPOLLET) is not supported, and the
+ * descriptors handled by an offloaded poll() cannot be added.
+ *
+ * @param epfd ZVFS epoll file descriptor
+ * @param op ZVFS_EPOLL_CTL_ADD, ZVFS_EPOLL_CTL_MOD or ZVFS_EPOLL_CTL_DEL
+ * @param fd File descriptor to watch
+ * @param event Events to watch and data returned with them, ignored by
+ *        ZVFS_EPOLL_CTL_DEL
+ *
+ * @return 0 on success, -1 on error
+ */
+int zvfs_epoll_ctl(int epfd, int op, int fd, struct zvfs_epoll_event *event);
+
+/**
+ * @brief Wait for events on a ZVFS epoll instance
+ *
+ * The descriptors stay in the ready list as long as they are ready (level
+ * triggered), unless they were added with ZVFS_EPOLLONESHOT, in which case
+ * they are disabled until modified with ZVFS_EPOLL_CTL_MOD.
+ *
+ * @param epfd ZVFS epoll file descriptor
+ * @param events Array receiving the events of the ready descriptors
+ * @param maxevents Size of @p events
+ * @param timeout Timeout in milliseconds, -1 to wait forever
+ *
+ * @return Number of ready descriptors, 0 on timeout, -1 on error
+ */
+int zvfs_epoll_wait(int epfd, struct zvfs_epoll_event *events, int maxevents, int timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZEPHYR_ZVFS_EPOLL_H_ */
@@ -78,12 +78,16 @@ int z_impl_k_futex_wait(struct k_futex *futex, int expected,
 		return -EINVAL;
 	}
 
+	key = k_spin_lock(&futex_data->lock);
+
+	/* Test the value under the futex lock, so that a wakeup following
+	 * a change of the value cannot get between the test and the pend.
+	 */
 	if (atomic_get(&futex->val) != (atomic_val_t)expected) {
+		k_spin_unlock(&futex_data->lock, key);
 		return -EAGAIN;
 	}
 
-	key = k_spin_lock(&futex_data->lock);
-
 	ret = z_pend_curr(&futex_data->lock,
 			key, &futex_data->wait_q, timeout);
 	if (ret == -EAGAIN) {
@@ -103,3 +107,57 @@ static inline int z_vrfy_k_futex_wait(struct k_futex *futex, int expected,
 	return z_impl_k_futex_wait(futex, expected, timeout);
 }
 #include <zephyr/syscalls/k_futex_wait_mrsh.c>
+
+int z_impl_k_futex_requeue(struct k_futex *futex, int expected,
+			   struct k_futex *target)
+{
+	k_spinlock_key_t key;
+	int ret = 0;
+	struct k_thread *thread;
+	struct z_futex_data *futex_data;
+	struct z_futex_data *target_data;
+
+	futex_data = k_futex_find_data(futex);
+	target_data = k_futex_find_data(target);
+	if ((futex_data == NULL) || (target_data == NULL)) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&futex_data->lock);
+
+	if (atomic_get(&futex->val) != (atomic_val_t)expected) {
+		k_spin_unlock(&futex_data->lock, key);
+		return -EAGAIN;
+	}
+
+	thread = z_unpend_first_thread(&futex_data->wait_q);
+	if (thread == NULL) {
+		k_spin_unlock(&futex_data->lock, key);
+		return 0;
+	}
+
+	arch_thread_return_value_set(thread, 0);
+	z_ready_thread(thread);
+	ret = 1;
+
+	if (target_data != futex_data) {
+		ret += z_sched_waitq_requeue(&futex_data->wait_q,
+					     &target_data->wait_q);
+	}
+
+	z_reschedule(&futex_data->lock, key);
+
+	return ret;
+}
+
+static inline int z_vrfy_k_futex_requeue(struct k_futex *futex, int expected,
+					 struct k_futex *target)
+{
+	if ((K_SYSCALL_MEMORY_WRITE(futex, sizeof(struct k_futex)) != 0) ||
+	    (K_SYSCALL_MEMORY_WRITE(target, sizeof(struct k_futex)) != 0)) {
+		return -EACCES;
+	}
+
+	return z_impl_k_futex_requeue(futex, expected, target);
+}
+#include <zephyr/syscalls/k_futex_requeue_mrsh.c>
@@ -320,6 +320,21 @@ typedef void (*_waitq_post_walk_cb_t)(int status, void *data);
 int z_sched_waitq_walk(_wait_q_t *wait_q, _waitq_walk_cb_t walk_func,
 		       _waitq_post_walk_cb_t post_func, void *data);
 
+/**
+ * @brief Moves all threads pending on a wait queue to another one
+ *
+ * The threads stay pended, with their timeouts unchanged, and are queued
+ * on @p to in priority order. This lets a primitive wake a single thread
+ * and hand the other ones over to the object they would contend for next,
+ * instead of waking them all at once.
+ *
+ * @param from Wait queue the threads are pending on
+ * @param to   Wait queue to pend the threads on
+ *
+ * @return Number of threads moved
+ */
+int z_sched_waitq_requeue(_wait_q_t *from, _wait_q_t *to);
+
 /** @brief Halt thread cycle usage accounting.
  *
  * Halts the accumulation of thread cycle usage and adds the current
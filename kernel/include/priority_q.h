@@ -42,6 +42,11 @@
 #define _priq_wait_add		z_priq_rb_add
 #define _priq_wait_remove	z_priq_rb_remove
 #define _priq_wait_best		z_priq_rb_best
+/* Multi Queue Wait Queue */
+#elif defined(CONFIG_WAITQ_MULTIQ)
+#define _priq_wait_add		z_priq_mq_add
+#define _priq_wait_remove	z_priq_mq_remove
+#define _priq_wait_best		z_priq_mq_best
 /* Dumb Wait Queue */
 #elif defined(CONFIG_WAITQ_SIMPLE)
 #define _priq_wait_add		z_priq_simple_add
@@ -267,44 +272,39 @@ static ALWAYS_INLINE struct prio_info get_prio_info(int8_t old_prio)
 	return ret;
 }
 
+BUILD_ASSERT(PRIQ_BITMAP_SIZE <= NBITS, "Too many priorities for multiq group mask");
+
+/* Returns the index of the best non-empty queue, the queue must not be
+ * empty.
+ */
 static ALWAYS_INLINE unsigned int z_priq_mq_best_queue_index(struct _priq_mq *pq)
 {
-	unsigned int i = 0;
-
-	do {
-		if (likely(pq->bitmask[i])) {
-			return i * NBITS + TRAILING_ZEROS(pq->bitmask[i]);
-		}
-		i++;
-	} while (i < PRIQ_BITMAP_SIZE);
+	unsigned int i = TRAILING_ZEROS(pq->group_mask);
 
-	return K_NUM_THREAD_PRIO - 1;
+	return i * NBITS + TRAILING_ZEROS(pq->bitmask[i]);
 }
 
 static ALWAYS_INLINE void z_priq_mq_init(struct _priq_mq *q)
 {
-	for (size_t i = 0; i < ARRAY_SIZE(q->queues); i++) {
-		sys_dlist_init(&q->queues[i]);
+	for (size_t i = 0; i < ARRAY_SIZE(q->bitmask); i++) {
+		q->bitmask[i] = 0;
 	}
-
-#ifndef CONFIG_SMP
-	q->cached_queue_index = K_NUM_THREAD_PRIO - 1;
-#endif
+	q->group_mask = 0;
 }
 
 static ALWAYS_INLINE void z_priq_mq_add(struct _priq_mq *pq,
 					struct k_thread *thread)
 {
 	struct prio_info pos = get_prio_info(thread->base.prio);
+	sys_dlist_t *q = &pq->queues[pos.offset_prio];
 
-	sys_dlist_append(&pq->queues[pos.offset_prio], &thread->base.qnode_dlist);
-	pq->bitmask[pos.idx] |= BIT(pos.bit);
-
-#ifndef CONFIG_SMP
-	if (pos.offset_prio < pq->cached_queue_index) {
-		pq->cached_queue_index = pos.offset_prio;
+	if ((pq->bitmask[pos.idx] & BIT(pos.bit)) == 0) {
+		sys_dlist_init(q);
+		pq->bitmask[pos.idx] |= BIT(pos.bit);
+		pq->group_mask |= BIT(pos.idx);
 	}
-#endif
+
+	sys_dlist_append(q, &thread->base.qnode_dlist);
 }
 
 static ALWAYS_INLINE void z_priq_mq_remove(struct _priq_mq *pq,
@@ -315,9 +315,9 @@ static ALWAYS_INLINE void z_priq_mq_remove(struct _priq_mq *pq,
 	sys_dlist_dequeue(&thread->base.qnode_dlist);
 	if (unlikely(sys_dlist_is_empty(&pq->queues[pos.offset_prio]))) {
 		pq->bitmask[pos.idx] &= ~BIT(pos.bit);
-#ifndef CONFIG_SMP
-		pq->cached_queue_index = z_priq_mq_best_queue_index(pq);
-#endif
+		if (pq->bitmask[pos.idx] == 0) {
+			pq->group_mask &= ~BIT(pos.idx);
+		}
 	}
 }
 
@@ -334,19 +334,43 @@ static ALWAYS_INLINE void z_priq_mq_yield(struct _priq_mq *pq)
 
 static ALWAYS_INLINE struct k_thread *z_priq_mq_best(struct _priq_mq *pq)
 {
-#ifdef CONFIG_SMP
-	unsigned int index = z_priq_mq_best_queue_index(pq);
-#else
-	unsigned int index = pq->cached_queue_index;
-#endif
+	if (unlikely(pq->group_mask == 0)) {
+		return NULL;
+	}
 
-	sys_dnode_t *n = sys_dlist_peek_head(&pq->queues[index]);
+	sys_dnode_t *n = sys_dlist_peek_head(&pq->queues[z_priq_mq_best_queue_index(pq)]);
+
+	return CONTAINER_OF(n, struct k_thread, base.qnode_dlist);
+}
+
+/* Returns the thread following @a thread in priority order, or NULL */
+static ALWAYS_INLINE struct k_thread *z_priq_mq_next(struct _priq_mq *pq,
+						     struct k_thread *thread)
+{
+	struct prio_info pos = get_prio_info(thread->base.prio);
+	unsigned int i = pos.idx;
+	unsigned long mask;
+	sys_dnode_t *n;
 
-	if (likely(n != NULL)) {
+	n = sys_dlist_peek_next(&pq->queues[pos.offset_prio], &thread->base.qnode_dlist);
+	if (n != NULL) {
 		return CONTAINER_OF(n, struct k_thread, base.qnode_dlist);
 	}
 
-	return NULL;
+	/* Lower priorities sharing the bitmap word, then the next word */
+	mask = pq->bitmask[i] & ((~0UL << pos.bit) << 1);
+	if (mask == 0) {
+		mask = pq->group_mask & ((~0UL << i) << 1);
+		if (mask == 0) {
+			return NULL;
+		}
+		i = TRAILING_ZEROS(mask);
+		mask = pq->bitmask[i];
+	}
+
+	n = sys_dlist_peek_head(&pq->queues[i * NBITS + TRAILING_ZEROS(mask)]);
+
+	return CONTAINER_OF(n, struct k_thread, base.qnode_dlist);
 }
 #ifdef IAR_SUPPRESS_ALWAYS_INLINE_WARNING_FLAG
 TOOLCHAIN_ENABLE_WARNING(TOOLCHAIN_WARNING_ALWAYS_INLINE)
@@ -36,6 +36,16 @@ static inline void z_init_timeout(struct _timeout *to)
  */
 k_ticks_t z_add_timeout(struct _timeout *to, _timeout_func_t fn, k_timeout_t timeout);
 
+#ifdef CONFIG_TIMER_SLACK
+/* Adds the timeout to the queue, allowing its expiry to be deferred by up
+ * to slack ticks so that it expires together with other timeouts.
+ *
+ * @return Absolute tick value when timeout would expire without slack.
+ */
+k_ticks_t z_add_timeout_slack(struct _timeout *to, _timeout_func_t fn, k_timeout_t timeout,
+			      k_ticks_t slack);
+#endif /* CONFIG_TIMER_SLACK */
+
 int z_abort_timeout(struct _timeout *to);
 
 static inline bool z_is_inactive_timeout(const struct _timeout *to)
@@ -51,7 +51,51 @@ static inline struct k_thread *z_waitq_head(_wait_q_t *w)
 	return (struct k_thread *)rb_get_min(&w->waitq.tree);
 }
 
-#else /* !CONFIG_WAITQ_SCALABLE: */
+#elif defined(CONFIG_WAITQ_MULTIQ)
+
+/**
+ * Walk all threads pending on a wait queue.
+ *
+ * @param wq Wait queue
+ * @param thread_ptr Thread pointer iterator variable
+ *
+ * @warning Do not remove thread from wait queue when using this macro.
+ * Use @ref _WAIT_Q_FOR_EACH_SAFE instead if this is required.
+ */
+#define _WAIT_Q_FOR_EACH(wq, thread_ptr) \
+	for (thread_ptr = z_priq_mq_best(&(wq)->waitq); thread_ptr != NULL; \
+	     thread_ptr = z_priq_mq_next(&(wq)->waitq, thread_ptr))
+
+/**
+ * Walk all threads pending on a wait queue.
+ *
+ * @note The iterator thread may be safely detached from the wait
+ * queue as part of the loop when using this macro.
+ *
+ * @param wq Wait queue
+ * @param thread_ptr Thread pointer iterator variable
+ * @param loop_ptr Thread pointer variable used by loop
+ */
+#define _WAIT_Q_FOR_EACH_SAFE(wq, thread_ptr, loop_ptr) \
+	for (thread_ptr = z_priq_mq_best(&(wq)->waitq), \
+	     loop_ptr = (thread_ptr != NULL) ? \
+			z_priq_mq_next(&(wq)->waitq, thread_ptr) : NULL; \
+	     thread_ptr != NULL; \
+	     thread_ptr = loop_ptr, \
+	     loop_ptr = (thread_ptr != NULL) ? \
+			z_priq_mq_next(&(wq)->waitq, thread_ptr) : NULL)
+
+static inline void z_waitq_init(_wait_q_t *w)
+{
+	z_priq_mq_init(&w->waitq);
+}
+
+static inline struct k_thread *z_waitq_head(_wait_q_t *w)
+{
+	return z_priq_mq_best(&w->waitq);
+}
+
+#else /* !CONFIG_WAITQ_SCALABLE && !CONFIG_WAITQ_MULTIQ: */
 
 /**
  * Walk all threads pending on a wait queue.
@@ -94,7 +138,7 @@ static inline struct k_thread *z_waitq_head(_wait_q_t *w)
 	return (struct k_thread *)sys_dlist_peek_head(&w->waitq);
 }
 
-#endif /* !CONFIG_WAITQ_SCALABLE */
+#endif /* CONFIG_WAITQ_SCALABLE */
 
 #ifdef __cplusplus
 }
@@ -66,6 +66,15 @@ atomic_val_t ipi_mask_create(struct k_thread *thread)
 		}
 	}
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	/* Any of the flagged CPUs would steal the thread, prefer the one
+	 * it last ran on and leave the others alone.
+	 */
+	if ((ipi_mask & BIT(thread->base.cpu)) != 0U) {
+		ipi_mask = BIT(thread->base.cpu);
+	}
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
+
 	return (atomic_val_t)ipi_mask;
 }
 
@@ -33,6 +33,7 @@ static int k_mem_slab_stats_raw(struct k_obj_core *obj_core, void *stats)
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
 	key = k_spin_lock(&slab->lock);
 	memcpy(stats, &slab->info, sizeof(slab->info));
+	((struct k_mem_slab_info *)stats)->num_used = k_mem_slab_num_used_get(slab);
 	k_spin_unlock(&slab->lock, key);
 
 	return 0;
@@ -48,9 +49,8 @@ static int k_mem_slab_stats_query(struct k_obj_core *obj_core, void *stats)
 
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
 	key = k_spin_lock(&slab->lock);
-	ptr->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
-			  slab->info.block_size;
-	ptr->allocated_bytes = slab->info.num_used * slab->info.block_size;
+	ptr->free_bytes = k_mem_slab_num_free_get(slab) * slab->info.block_size;
+	ptr->allocated_bytes = k_mem_slab_num_used_get(slab) * slab->info.block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	ptr->max_allocated_bytes = slab->info.max_used * slab->info.block_size;
 #else
@@ -72,7 +72,7 @@ static int k_mem_slab_stats_reset(struct k_obj_core *obj_core)
 	key = k_spin_lock(&slab->lock);
 
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
-	slab->info.max_used = slab->info.num_used;
+	slab->info.max_used = k_mem_slab_num_used_get(slab);
 #endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
 
 	k_spin_unlock(&slab->lock, key);
@@ -180,6 +180,13 @@ int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	slab->info.num_used = 0U;
 	slab->lock = (struct k_spinlock) {};
 
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	for (unsigned int i = 0; i < ARRAY_SIZE(slab->cpu_cache); i++) {
+		slab->cpu_cache[i] = (struct k_mem_slab_cpu_cache) {};
+	}
+	slab->waiters = false;
+#endif /* CONFIG_MEM_SLAB_PER_CPU_CACHE */
+
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	slab->info.max_used = 0U;
 #endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
@@ -219,13 +226,242 @@ static bool slab_ptr_is_good(struct k_mem_slab *slab, const void *ptr)
 	       ((offset % slab->info.block_size) == 0);
 }
 
+
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+
+/*
+ * Each CPU keeps a cache of free blocks in front of the free list of the
+ * slab, protected by a spinlock of its own that other CPUs only take to
+ * reclaim the cached blocks. Caches are refilled from, and flushed to, the
+ * slab free list in batches of half their depth, under the slab lock.
+ *
+ * Lock ordering: a cache lock may be taken while holding the slab lock,
+ * never the other way around.
+ *
+ * Cached blocks are counted in slab->info.num_used. When the slab free list
+ * runs empty, the allocator reclaims the blocks of all caches before giving
+ * up or waiting. slab->waiters is set, under the slab lock, before doing so
+ * and is checked under the cache lock when freeing a block, so that blocks
+ * freed while threads are waiting bypass the caches and go to the waiters.
+ */
+
+#define CACHE_DEPTH CONFIG_MEM_SLAB_PER_CPU_CACHE_DEPTH
+#define CACHE_BATCH (CACHE_DEPTH / 2)
+
+static struct k_mem_slab_cpu_cache *cache_lock(struct k_mem_slab *slab,
+					       k_spinlock_key_t *key)
+{
+	/* Migrating after reading the CPU id only means that the cache of
+	 * another CPU is used, under its own lock.
+	 */
+	struct k_mem_slab_cpu_cache *cache = &slab->cpu_cache[arch_curr_cpu()->id];
+
+	*key = k_spin_lock(&cache->lock);
+
+	return cache;
+}
+
+/* Detaches the first @a count blocks of a free list */
+static char *detach_blocks(char **free_list, uint32_t count)
+{
+	char *list = *free_list;
+	char **tail = &list;
+
+	for (uint32_t i = 0; i < count; i++) {
+		tail = (char **)*tail;
+	}
+	*free_list = *tail;
+	*tail = NULL;
+
+	return list;
+}
+
+/* Gives blocks back to the slab, handing them to waiting threads first.
+ * Called with the slab lock held, returns true if a thread was readied.
+ */
+static bool release_blocks(struct k_mem_slab *slab, char *list)
+{
+	bool readied = false;
+
+	while (list != NULL) {
+		char *mem = list;
+		struct k_thread *pending_thread = NULL;
+
+		list = *(char **)list;
+
+		if (slab->waiters) {
+			pending_thread = z_unpend_first_thread(&slab->wait_q);
+		}
+
+		if (pending_thread != NULL) {
+			z_thread_return_value_set_with_data(pending_thread, 0, mem);
+			z_ready_thread(pending_thread);
+			readied = true;
+		} else {
+			*(char **)mem = slab->free_list;
+			slab->free_list = mem;
+			slab->info.num_used--;
+		}
+	}
+
+	return readied;
+}
+
+/* Called with the slab lock held, once blocks have been given back */
+static void update_waiters(struct k_mem_slab *slab)
+{
+	if (slab->waiters && (z_waitq_head(&slab->wait_q) == NULL)) {
+		slab->waiters = false;
+	}
+}
+
+/* Reclaims the blocks of all CPU caches, with the slab lock held */
+static bool cache_reclaim(struct k_mem_slab *slab)
+{
+	bool readied = false;
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(slab->cpu_cache); i++) {
+		struct k_mem_slab_cpu_cache *cache = &slab->cpu_cache[i];
+		k_spinlock_key_t key = k_spin_lock(&cache->lock);
+		char *list = cache->free_list;
+
+		cache->free_list = NULL;
+		cache->count = 0U;
+
+		k_spin_unlock(&cache->lock, key);
+
+		readied = release_blocks(slab, list) || readied;
+	}
+
+	return readied;
+}
+
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+static void cache_update_max_used(struct k_mem_slab *slab)
+{
+	if (k_mem_slab_num_used_get(slab) > slab->info.max_used) {
+		k_spinlock_key_t key = k_spin_lock(&slab->lock);
+
+		slab->info.max_used = max(k_mem_slab_num_used_get(slab),
+					  slab->info.max_used);
+
+		k_spin_unlock(&slab->lock, key);
+	}
+}
+#endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
+
+static bool cache_alloc(struct k_mem_slab *slab, void **mem)
+{
+	k_spinlock_key_t key;
+	struct k_mem_slab_cpu_cache *cache = cache_lock(slab, &key);
+
+	if (cache->free_list == NULL) {
+		uint32_t count;
+		char *list;
+
+		k_spin_unlock(&cache->lock, key);
+
+		key = k_spin_lock(&slab->lock);
+		count = min(CACHE_BATCH, slab->info.num_blocks - slab->info.num_used);
+		list = detach_blocks(&slab->free_list, count);
+		slab->info.num_used += count;
+		k_spin_unlock(&slab->lock, key);
+
+		if (list == NULL) {
+			return false;
+		}
+
+		cache = cache_lock(slab, &key);
+		while (list != NULL) {
+			char *next = *(char **)list;
+
+			*(char **)list = cache->free_list;
+			cache->free_list = list;
+			cache->count++;
+			list = next;
+		}
+	}
+
+	*mem = cache->free_list;
+	cache->free_list = *(char **)(cache->free_list);
+	cache->count--;
+	__ASSERT(cache->free_list == NULL || slab_ptr_is_good(slab, cache->free_list),
+		 "slab corruption detected");
+
+	k_spin_unlock(&cache->lock, key);
+
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	cache_update_max_used(slab);
+#endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
+
+	return true;
+}
+
+static bool cache_free(struct k_mem_slab *slab, void *mem)
+{
+	k_spinlock_key_t key;
+	struct k_mem_slab_cpu_cache *cache = cache_lock(slab, &key);
+	char *list = NULL;
+	bool readied;
+
+	if (unlikely(slab->waiters)) {
+		k_spin_unlock(&cache->lock, key);
+		return false;
+	}
+
+	*(char **)mem = cache->free_list;
+	cache->free_list = (char *)mem;
+	cache->count++;
+	if (cache->count > CACHE_DEPTH) {
+		list = detach_blocks(&cache->free_list, cache->count - CACHE_BATCH);
+		cache->count = CACHE_BATCH;
+	}
+
+	k_spin_unlock(&cache->lock, key);
+
+	if (list != NULL) {
+		key = k_spin_lock(&slab->lock);
+		readied = release_blocks(slab, list);
+		update_waiters(slab);
+		if (readied) {
+			z_reschedule(&slab->lock, key);
+		} else {
+			k_spin_unlock(&slab->lock, key);
+		}
+	}
+
+	return true;
+}
+
+#endif /* CONFIG_MEM_SLAB_PER_CPU_CACHE */
+
 int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 {
-	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	k_spinlock_key_t key;
+	bool readied = false;
 	int result;
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
 
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	if (cache_alloc(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, 0);
+
+		return 0;
+	}
+#endif /* CONFIG_MEM_SLAB_PER_CPU_CACHE */
+
+	key = k_spin_lock(&slab->lock);
+
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	if (slab->free_list == NULL) {
+		if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			slab->waiters = true;
+		}
+		readied = cache_reclaim(slab);
+	}
+#endif /* CONFIG_MEM_SLAB_PER_CPU_CACHE */
+
 	if (slab->free_list != NULL) {
 		/* take a free block */
 		*mem = slab->free_list;
@@ -237,9 +473,12 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 			 "slab corruption detected");
 
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
-		slab->info.max_used = max(slab->info.num_used,
+		slab->info.max_used = max(k_mem_slab_num_used_get(slab),
 					  slab->info.max_used);
 #endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+		update_waiters(slab);
+#endif /* CONFIG_MEM_SLAB_PER_CPU_CACHE */
 
 		result = 0;
 	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT) ||
@@ -263,7 +502,11 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, result);
 
-	k_spin_unlock(&slab->lock, key);
+	if (unlikely(readied)) {
+		z_reschedule(&slab->lock, key);
+	} else {
+		k_spin_unlock(&slab->lock, key);
+	}
 
 	return result;
 }
@@ -276,9 +519,17 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
 		return;
 	}
 
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
+
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	if (cache_free(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+		return;
+	}
+#endif /* CONFIG_MEM_SLAB_PER_CPU_CACHE */
+
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
-	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
 	if (unlikely(slab->free_list == NULL) && IS_ENABLED(CONFIG_MULTITHREADING)) {
 		struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
 
@@ -291,6 +542,9 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
 			return;
 		}
 	}
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	slab->waiters = false;
+#endif /* CONFIG_MEM_SLAB_PER_CPU_CACHE */
 	*(char **) mem = slab->free_list;
 	slab->free_list = (char *) mem;
 	slab->info.num_used--;
@@ -308,9 +562,8 @@ int k_mem_slab_runtime_stats_get(struct k_mem_slab *slab, struct sys_memory_stat
 
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
-	stats->allocated_bytes = slab->info.num_used * slab->info.block_size;
-	stats->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
-			    slab->info.block_size;
+	stats->allocated_bytes = k_mem_slab_num_used_get(slab) * slab->info.block_size;
+	stats->free_bytes = k_mem_slab_num_free_get(slab) * slab->info.block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	stats->max_allocated_bytes = slab->info.max_used *
 				     slab->info.block_size;
@@ -332,7 +585,7 @@ int k_mem_slab_runtime_stats_reset_max(struct k_mem_slab *slab)
 
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
-	slab->info.max_used = slab->info.num_used;
+	slab->info.max_used = k_mem_slab_num_used_get(slab);
 
 	k_spin_unlock(&slab->lock, key);
 
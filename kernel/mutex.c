@@ -104,6 +104,57 @@ static bool adjust_owner_prio(struct k_mutex *mutex, int32_t new_prio)
 }
 #endif
 
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+/* Whether the thread is running on a CPU.  Read without the scheduler
+ * lock, so only a hint.
+ */
+static inline bool thread_running(struct k_thread *thread)
+{
+	int cpu = thread->base.cpu;
+
+	return *(struct k_thread * volatile *)&_kernel.cpus[cpu].current == thread;
+}
+
+/* Spin while the mutex is owned by a thread running on another CPU and
+ * nobody pends on it, for at most CONFIG_MUTEX_SPIN_LIMIT_US and never
+ * past the end of the caller's timeout.  A mutex with waiters is handed
+ * over to the first of them on unlock, so there is no point in spinning
+ * then.  Called and returns with the lock held.
+ */
+static k_spinlock_key_t mutex_spin(struct k_mutex *mutex, k_spinlock_key_t key,
+				   k_timepoint_t end)
+{
+	uint32_t start = k_cycle_get_32();
+	uint32_t limit = k_us_to_cyc_ceil32(CONFIG_MUTEX_SPIN_LIMIT_US);
+	k_timeout_t remaining = sys_timepoint_timeout(end);
+	struct k_thread *owner;
+
+	if (!K_TIMEOUT_EQ(remaining, K_FOREVER)) {
+		limit = MIN(limit, k_ticks_to_cyc_floor64(remaining.ticks));
+	}
+
+	while ((mutex->lock_count != 0U) && (mutex->owner != _current) &&
+	       (z_waitq_head(&mutex->wait_q) == NULL) &&
+	       thread_running(mutex->owner)) {
+		owner = mutex->owner;
+
+		k_spin_unlock(&lock, key);
+
+		do {
+			if ((k_cycle_get_32() - start) >= limit) {
+				return k_spin_lock(&lock);
+			}
+			arch_nop();
+		} while ((*(struct k_thread * volatile *)&mutex->owner == owner) &&
+			 thread_running(owner));
+
+		key = k_spin_lock(&lock);
+	}
+
+	return key;
+}
+#endif /* CONFIG_MUTEX_ADAPTIVE_SPIN */
+
 int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 {
 	k_spinlock_key_t key;
@@ -111,6 +162,10 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 	bool resched = false;
 	int new_prio;
 #endif
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+	bool spin = !K_TIMEOUT_EQ(timeout, K_NO_WAIT);
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+#endif
 
 	__ASSERT(!arch_is_in_isr(), "mutexes cannot be used inside ISRs");
 
@@ -118,6 +173,12 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 
 	key = k_spin_lock(&lock);
 
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+	if (spin) {
+		key = mutex_spin(mutex, key, end);
+	}
+#endif /* CONFIG_MUTEX_ADAPTIVE_SPIN */
+
 	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current))) {
 
 #if (CONFIG_PRIORITY_CEILING < K_LOWEST_THREAD_PRIO)
@@ -153,6 +214,20 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		return -EBUSY;
 	}
 
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+	if (spin) {
+		/* Only pend for what is left of the timeout */
+		timeout = sys_timepoint_timeout(end);
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_spin_unlock(&lock, key);
+
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, -EAGAIN);
+
+			return -EAGAIN;
+		}
+	}
+#endif /* CONFIG_MUTEX_ADAPTIVE_SPIN */
+
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_mutex, lock, mutex, timeout);
 
 #if (CONFIG_PRIORITY_CEILING < K_LOWEST_THREAD_PRIO)
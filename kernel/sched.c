@@ -48,9 +48,9 @@ BUILD_ASSERT(CONFIG_NUM_COOP_PRIORITIES >= CONFIG_NUM_METAIRQ_PRIORITIES,
 #ifdef IAR_SUPPRESS_ALWAYS_INLINE_WARNING_FLAG
 TOOLCHAIN_DISABLE_WARNING(TOOLCHAIN_WARNING_ALWAYS_INLINE)
 #endif
-static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
+static ALWAYS_INLINE struct _ready_q *thread_ready_q(struct k_thread *thread)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY)
 	int cpu, m = thread->base.cpu_mask;
 
 	/* Edge case: it's legal per the API to "make runnable" a
@@ -61,20 +61,43 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 	 */
 	cpu = m == 0 ? 0 : u32_count_trailing_zeros(m);
 
-	return &_kernel.cpus[cpu].ready_q.runq;
+	return &_kernel.cpus[cpu].ready_q;
+#elif defined(CONFIG_SCHED_PER_CPU_RUNQ)
+	/* Queue the thread on the CPU it last ran on.  Note that
+	 * base.cpu only changes when the thread is picked to run (after
+	 * it has been dequeued) and the CPU mask can't change while the
+	 * thread is runnable, so a queued thread always maps to the same
+	 * queue.
+	 */
+	int cpu = thread->base.cpu;
+
+#ifdef CONFIG_SCHED_CPU_MASK
+	int m = thread->base.cpu_mask;
+
+	if ((m != 0) && ((m & BIT(cpu)) == 0)) {
+		cpu = u32_count_trailing_zeros(m);
+	}
+#endif /* CONFIG_SCHED_CPU_MASK */
+
+	return &_kernel.cpus[cpu].ready_q;
 #else
 	ARG_UNUSED(thread);
-	return &_kernel.ready_q.runq;
+	return &_kernel.ready_q;
 #endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
 }
 
+static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
+{
+	return &thread_ready_q(thread)->runq;
+}
+
 static ALWAYS_INLINE void *curr_cpu_runq(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_PER_CPU_RUNQ)
 	return &arch_curr_cpu()->ready_q.runq;
 #else
 	return &_kernel.ready_q.runq;
-#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
+#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY || CONFIG_SCHED_PER_CPU_RUNQ */
 }
 
 static ALWAYS_INLINE void runq_add(struct k_thread *thread)
@@ -82,6 +105,9 @@ static ALWAYS_INLINE void runq_add(struct k_thread *thread)
 	__ASSERT_NO_MSG(!z_is_idle_thread_object(thread));
 	__ASSERT_NO_MSG(!is_thread_dummy(thread));
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	thread_ready_q(thread)->count++;
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
 	_priq_run_add(thread_runq(thread), thread);
 }
 
@@ -90,6 +116,9 @@ static ALWAYS_INLINE void runq_remove(struct k_thread *thread)
 	__ASSERT_NO_MSG(!z_is_idle_thread_object(thread));
 	__ASSERT_NO_MSG(!is_thread_dummy(thread));
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	thread_ready_q(thread)->count--;
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
 	_priq_run_remove(thread_runq(thread), thread);
 }
 
@@ -98,9 +127,51 @@ static ALWAYS_INLINE void runq_yield(void)
 	_priq_run_yield(curr_cpu_runq());
 }
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+/* Returns the best thread this CPU can run: the best thread of the
+ * local queue, unless another CPU's queue holds one of higher priority.
+ * When the local queue has nothing better to offer, ties between peers
+ * are broken in favor of the busiest one.
+ */
+static ALWAYS_INLINE struct k_thread *runq_steal(struct k_thread *thread)
+{
+	unsigned int id = _current_cpu->id;
+	unsigned int busiest = 0;
+	bool local = (thread != NULL);
+
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		struct _ready_q *rq = &_kernel.cpus[i].ready_q;
+		struct k_thread *t;
+		int32_t cmp;
+
+		if ((i == id) || (rq->count == 0U)) {
+			continue;
+		}
+
+		t = _priq_run_best(&rq->runq);
+		if (t == NULL) {
+			continue;
+		}
+
+		cmp = (thread == NULL) ? 1 : z_sched_prio_cmp(t, thread);
+		if ((cmp > 0) || ((cmp == 0) && !local && (rq->count > busiest))) {
+			thread = t;
+			busiest = rq->count;
+			local = false;
+		}
+	}
+
+	return thread;
+}
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
+
 static ALWAYS_INLINE struct k_thread *runq_best(void)
 {
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	return runq_steal(_priq_run_best(curr_cpu_runq()));
+#else
 	return _priq_run_best(curr_cpu_runq());
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
 }
 
 /* _current is never in the run queue until context switch on
@@ -993,17 +1064,20 @@ int z_unpend_all(_wait_q_t *wait_q)
 void init_ready_q(struct _ready_q *ready_q)
 {
 	_priq_run_init(&ready_q->runq);
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	ready_q->count = 0U;
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
 }
 
 void z_sched_init(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_PER_CPU_RUNQ)
 	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
 		init_ready_q(&_kernel.cpus[i].ready_q);
 	}
 #else
 	init_ready_q(&_kernel.ready_q);
-#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
+#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY || CONFIG_SCHED_PER_CPU_RUNQ */
 }
 
 void z_impl_k_thread_priority_set(k_tid_t thread, int prio)
@@ -1553,6 +1627,23 @@ int z_sched_wait(struct k_spinlock *lock, k_spinlock_key_t key,
 	return ret;
 }
 
+int z_sched_waitq_requeue(_wait_q_t *from, _wait_q_t *to)
+{
+	struct k_thread *thread;
+	int moved = 0;
+
+	K_SPINLOCK(&_sched_spinlock) {
+		while ((thread = _priq_wait_best(&from->waitq)) != NULL) {
+			_priq_wait_remove(&from->waitq, thread);
+			thread->base.pended_on = to;
+			_priq_wait_add(&to->waitq, thread);
+			moved++;
+		}
+	}
+
+	return moved;
+}
+
 int z_sched_waitq_walk(_wait_q_t *wait_q, _waitq_walk_cb_t walk_func,
 		       _waitq_post_walk_cb_t post_func, void *data)
 {
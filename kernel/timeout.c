@@ -11,12 +11,11 @@
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/drivers/timer/system_timer.h>
 #include <zephyr/sys_clock.h>
+#include <zephyr/sys/math_extras.h>
 #include <zephyr/llext/symbol.h>
 
 static uint64_t curr_tick;
 
-static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
-
 /*
  * The timeout code shall take no locks other than its own (timeout_lock), nor
  * shall it call any other subsystem while holding this lock.
@@ -26,6 +25,295 @@ static struct k_spinlock timeout_lock;
 /* Ticks left to process in the currently-executing sys_clock_announce() */
 static int announce_remaining;
 
+#ifdef CONFIG_TIMER_SLACK
+static struct k_timer_slack_stats slack_stats;
+
+/* Picks the tick in [expiry, expiry + slack] with the most trailing zero
+ * bits.  Timeouts whose windows overlap tend to pick the same tick, so
+ * they expire together.
+ */
+static uint64_t apply_slack(uint64_t expiry, k_ticks_t slack)
+{
+	uint64_t limit = expiry + slack;
+	uint64_t mask = expiry ^ limit;
+
+	if (mask == 0U) {
+		return expiry;
+	}
+
+	mask = BIT64(63 - u64_count_leading_zeros(mask)) - 1U;
+
+	return limit & ~mask;
+}
+#endif /* CONFIG_TIMER_SLACK */
+
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+
+/*
+ * Hierarchical timing wheel.
+ *
+ * Every queued timeout stores its absolute expiry (in wheel ticks) in
+ * dticks.  A timeout is filed at the level given by the most significant
+ * group of WHEEL_BITS bits in which its expiry differs from the current
+ * wheel tick, in the slot indexed by its expiry bits of that group.  All
+ * timeouts of level 0 therefore expire within the current slot span, and
+ * every timeout on level N expires before any timeout on level N+1.
+ * When the wheel tick moves into the span of an occupied slot, that slot
+ * is cascaded into the lower levels.  Timeouts too far out for the wheel
+ * live in a sorted overflow list.
+ *
+ * Insertion and removal are O(1) (except for the overflow list), at the
+ * cost of timeouts expiring on the same tick not being guaranteed to run
+ * in the order they were added.
+ */
+#define WHEEL_BITS   CONFIG_TIMEOUT_WHEEL_LEVEL_BITS
+#define WHEEL_SLOTS  BIT(WHEEL_BITS)
+#define WHEEL_MASK   (WHEEL_SLOTS - 1)
+#define WHEEL_LEVELS CONFIG_TIMEOUT_WHEEL_LEVELS
+
+BUILD_ASSERT(WHEEL_BITS * WHEEL_LEVELS < 64);
+
+static struct {
+	/* Tick up to which the wheel has been advanced */
+	uint64_t tick;
+	/* Cached earliest expiry in the wheel or overflow list */
+	uint64_t next;
+	bool next_valid;
+	/* Non-empty slots of each level. Slot lists are (re)initialized
+	 * when their bit gets set, so they need no static initializer.
+	 */
+	uint64_t bitmap[WHEEL_LEVELS];
+	sys_dlist_t slots[WHEEL_LEVELS][WHEEL_SLOTS];
+	sys_dlist_t overflow;
+	/* Timeouts due at the current tick, not yet handled by
+	 * sys_clock_announce()
+	 */
+	sys_dlist_t expired;
+} wheel = {
+	.next = UINT64_MAX,
+	.next_valid = true,
+	.overflow = SYS_DLIST_STATIC_INIT(&wheel.overflow),
+	.expired = SYS_DLIST_STATIC_INIT(&wheel.expired),
+};
+
+static inline uint64_t expiry_of(const struct _timeout *t)
+{
+	return (uint64_t)t->dticks;
+}
+
+/* Returns the list the timeout with the given expiry belongs to, and its
+ * wheel level and slot if it is filed in the wheel proper.
+ */
+static sys_dlist_t *wheel_list(uint64_t expiry, int *level, int *slot)
+{
+	int l;
+
+	*level = -1;
+	if (expiry <= wheel.tick) {
+		return &wheel.expired;
+	}
+
+	l = (63 - u64_count_leading_zeros(expiry ^ wheel.tick)) / WHEEL_BITS;
+	if (l >= WHEEL_LEVELS) {
+		return &wheel.overflow;
+	}
+
+	*level = l;
+	*slot = (expiry >> (l * WHEEL_BITS)) & WHEEL_MASK;
+
+	return &wheel.slots[l][*slot];
+}
+
+static void wheel_insert(struct _timeout *to)
+{
+	uint64_t expiry = expiry_of(to);
+	int level, slot;
+	sys_dlist_t *list = wheel_list(expiry, &level, &slot);
+
+	if (level >= 0) {
+		if ((wheel.bitmap[level] & BIT64(slot)) == 0U) {
+			wheel.bitmap[level] |= BIT64(slot);
+			sys_dlist_init(list);
+		}
+		sys_dlist_append(list, &to->node);
+	} else if (list == &wheel.overflow) {
+		struct _timeout *t;
+
+		SYS_DLIST_FOR_EACH_CONTAINER(list, t, node) {
+			if (expiry_of(t) > expiry) {
+				sys_dlist_insert(&t->node, &to->node);
+				break;
+			}
+		}
+		if (t == NULL) {
+			sys_dlist_append(list, &to->node);
+		}
+	} else {
+		sys_dlist_append(list, &to->node);
+	}
+
+	if (wheel.next_valid && (expiry < wheel.next)) {
+		wheel.next = expiry;
+	}
+}
+
+static void remove_timeout(struct _timeout *t)
+{
+	uint64_t expiry = expiry_of(t);
+	int level, slot;
+	sys_dlist_t *list = wheel_list(expiry, &level, &slot);
+
+	sys_dlist_remove(&t->node);
+	if ((level >= 0) && sys_dlist_is_empty(list)) {
+		wheel.bitmap[level] &= ~BIT64(slot);
+	}
+	if (expiry == wheel.next) {
+		wheel.next_valid = false;
+	}
+}
+
+static uint64_t wheel_next(void)
+{
+	struct _timeout *t;
+
+	if (wheel.next_valid) {
+		return wheel.next;
+	}
+
+	wheel.next = UINT64_MAX;
+	for (int l = 0; l < WHEEL_LEVELS; l++) {
+		if (wheel.bitmap[l] != 0U) {
+			int slot = u64_count_trailing_zeros(wheel.bitmap[l]);
+
+			if (l == 0) {
+				wheel.next = (wheel.tick & ~(uint64_t)WHEEL_MASK) | slot;
+			} else {
+				SYS_DLIST_FOR_EACH_CONTAINER(&wheel.slots[l][slot], t, node) {
+					wheel.next = min(wheel.next, expiry_of(t));
+				}
+			}
+			break;
+		}
+	}
+
+	if (wheel.next == UINT64_MAX) {
+		t = SYS_DLIST_PEEK_HEAD_CONTAINER(&wheel.overflow, t, node);
+		if (t != NULL) {
+			wheel.next = expiry_of(t);
+		}
+	}
+	wheel.next_valid = true;
+
+	return wheel.next;
+}
+
+/* Moves the wheel to the given tick, which must not be past the earliest
+ * expiry.  Timeouts due at that tick end up on the expired list.
+ */
+static void wheel_advance(uint64_t tick)
+{
+	sys_dnode_t *node;
+
+	wheel.tick = tick;
+	wheel.next_valid = false;
+
+	while ((node = sys_dlist_peek_head(&wheel.overflow)) != NULL) {
+		struct _timeout *t = CONTAINER_OF(node, struct _timeout, node);
+
+		if (((expiry_of(t) ^ tick) >> (WHEEL_LEVELS * WHEEL_BITS)) != 0U) {
+			break;
+		}
+		sys_dlist_remove(node);
+		wheel_insert(t);
+	}
+
+	for (int l = WHEEL_LEVELS - 1; l >= 0; l--) {
+		int slot = (tick >> (l * WHEEL_BITS)) & WHEEL_MASK;
+
+		if ((wheel.bitmap[l] & BIT64(slot)) == 0U) {
+			continue;
+		}
+
+		wheel.bitmap[l] &= ~BIT64(slot);
+		while ((node = sys_dlist_get(&wheel.slots[l][slot])) != NULL) {
+			wheel_insert(CONTAINER_OF(node, struct _timeout, node));
+		}
+	}
+}
+
+/* Queues the timeout to expire dticks ticks after curr_tick, returns true
+ * if it is now the first one to expire.
+ */
+static bool queue_timeout(struct _timeout *to, k_ticks_t dticks)
+{
+	bool is_first = wheel.tick + dticks < wheel_next();
+
+	to->dticks = wheel.tick + dticks;
+	wheel_insert(to);
+
+	return is_first;
+}
+
+static bool is_first_timeout(const struct _timeout *to)
+{
+	return expiry_of(to) == wheel_next();
+}
+
+/* Ticks from curr_tick until the first timeout, or -1 if there is none */
+static k_ticks_t first_timeout_ticks(void)
+{
+	uint64_t next;
+
+	if (!sys_dlist_is_empty(&wheel.expired)) {
+		return 0;
+	}
+
+	next = wheel_next();
+
+	return (next == UINT64_MAX) ? -1 : (k_ticks_t)(next - wheel.tick);
+}
+
+/* must be locked */
+static k_ticks_t timeout_rem(const struct _timeout *timeout)
+{
+	return expiry_of(timeout) - wheel.tick;
+}
+
+/* Dequeues the next timeout due within the given number of ticks and
+ * stores in dt how far it is from the previously dequeued one.
+ */
+static struct _timeout *pop_expired(int32_t ticks, int *dt)
+{
+	sys_dnode_t *node;
+
+	if (sys_dlist_is_empty(&wheel.expired)) {
+		uint64_t next = wheel_next();
+
+		if ((next == UINT64_MAX) || ((int64_t)(next - wheel.tick) > ticks)) {
+			return NULL;
+		}
+
+		*dt = next - wheel.tick;
+		wheel_advance(next);
+	} else {
+		*dt = 0;
+	}
+
+	node = sys_dlist_get(&wheel.expired);
+	__ASSERT_NO_MSG(node != NULL);
+
+	return CONTAINER_OF(node, struct _timeout, node);
+}
+
+static void advance_timeouts(int32_t ticks)
+{
+	wheel_advance(wheel.tick + ticks);
+}
+
+#else /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+
+static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -49,6 +337,87 @@ static void remove_timeout(struct _timeout *t)
 	sys_dlist_remove(&t->node);
 }
 
+/* Queues the timeout to expire dticks ticks after curr_tick, returns true
+ * if it is now the first one to expire.
+ */
+static bool queue_timeout(struct _timeout *to, k_ticks_t dticks)
+{
+	struct _timeout *t;
+
+	to->dticks = dticks;
+	for (t = first(); t != NULL; t = next(t)) {
+		if (t->dticks > to->dticks) {
+			t->dticks -= to->dticks;
+			sys_dlist_insert(&t->node, &to->node);
+			break;
+		}
+		to->dticks -= t->dticks;
+	}
+
+	if (t == NULL) {
+		sys_dlist_append(&timeout_list, &to->node);
+	}
+
+	return to == first();
+}
+
+static bool is_first_timeout(const struct _timeout *to)
+{
+	return to == first();
+}
+
+/* Ticks from curr_tick until the first timeout, or -1 if there is none */
+static k_ticks_t first_timeout_ticks(void)
+{
+	struct _timeout *to = first();
+
+	return (to == NULL) ? -1 : to->dticks;
+}
+
+/* must be locked */
+static k_ticks_t timeout_rem(const struct _timeout *timeout)
+{
+	k_ticks_t ticks = 0;
+
+	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
+		ticks += t->dticks;
+		if (timeout == t) {
+			break;
+		}
+	}
+
+	return ticks;
+}
+
+/* Dequeues the next timeout due within the given number of ticks and
+ * stores in dt how far it is from the previously dequeued one.
+ */
+static struct _timeout *pop_expired(int32_t ticks, int *dt)
+{
+	struct _timeout *t = first();
+
+	if ((t == NULL) || (t->dticks > ticks)) {
+		return NULL;
+	}
+
+	*dt = t->dticks;
+	t->dticks = 0;
+	remove_timeout(t);
+
+	return t;
+}
+
+static void advance_timeouts(int32_t ticks)
+{
+	struct _timeout *t = first();
+
+	if (t != NULL) {
+		t->dticks -= ticks;
+	}
+}
+
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+
 static int32_t elapsed(void)
 {
 	/* While sys_clock_announce() is executing, new relative timeouts will be
@@ -72,20 +441,21 @@ static int32_t elapsed(void)
 
 static int32_t next_timeout(int32_t ticks_elapsed)
 {
-	struct _timeout *to = first();
+	k_ticks_t dticks = first_timeout_ticks();
 	int32_t ret;
 
-	if ((to == NULL) ||
-	    ((int64_t)(to->dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
+	if ((dticks < 0) ||
+	    ((int64_t)(dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
 		ret = SYS_CLOCK_MAX_WAIT;
 	} else {
-		ret = max(0, to->dticks - ticks_elapsed);
+		ret = max(0, dticks - ticks_elapsed);
 	}
 
 	return ret;
 }
 
-k_ticks_t z_add_timeout(struct _timeout *to, _timeout_func_t fn, k_timeout_t timeout)
+static k_ticks_t add_timeout(struct _timeout *to, _timeout_func_t fn, k_timeout_t timeout,
+			     k_ticks_t slack)
 {
 	k_ticks_t ticks = 0;
 
@@ -101,36 +471,35 @@ k_ticks_t z_add_timeout(struct _timeout *to, _timeout_func_t fn, k_timeout_t tim
 	to->fn = fn;
 
 	K_SPINLOCK(&timeout_lock) {
-		struct _timeout *t;
 		int32_t ticks_elapsed;
 		bool has_elapsed = false;
+		k_ticks_t dticks;
 
 		if (Z_IS_TIMEOUT_RELATIVE(timeout)) {
 			ticks_elapsed = elapsed();
 			has_elapsed = true;
-			to->dticks = timeout.ticks + 1 + ticks_elapsed;
-			ticks = curr_tick + to->dticks;
+			dticks = timeout.ticks + 1 + ticks_elapsed;
 		} else {
-			k_ticks_t dticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
-
-			to->dticks = max(1, dticks);
-			ticks = timeout.ticks;
+			dticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
+			dticks = max(1, dticks);
 		}
+		ticks = curr_tick + dticks;
 
-		for (t = first(); t != NULL; t = next(t)) {
-			if (t->dticks > to->dticks) {
-				t->dticks -= to->dticks;
-				sys_dlist_insert(&t->node, &to->node);
-				break;
-			}
-			to->dticks -= t->dticks;
-		}
+#ifdef CONFIG_TIMER_SLACK
+		if (slack > 0) {
+			uint64_t expiry = curr_tick + dticks;
+			uint64_t deferred = apply_slack(expiry, slack);
 
-		if (t == NULL) {
-			sys_dlist_append(&timeout_list, &to->node);
+			if (deferred != expiry) {
+				dticks += deferred - expiry;
+				slack_stats.deferred++;
+			}
 		}
+#else
+		ARG_UNUSED(slack);
+#endif /* CONFIG_TIMER_SLACK */
 
-		if (to == first() && announce_remaining == 0) {
+		if (queue_timeout(to, dticks) && announce_remaining == 0) {
 			if (!has_elapsed) {
 				/* In case of absolute timeout that is first to expire
 				 * elapsed need to be read from the system clock.
@@ -144,13 +513,33 @@ k_ticks_t z_add_timeout(struct _timeout *to, _timeout_func_t fn, k_timeout_t tim
 	return ticks;
 }
 
+k_ticks_t z_add_timeout(struct _timeout *to, _timeout_func_t fn, k_timeout_t timeout)
+{
+	return add_timeout(to, fn, timeout, 0);
+}
+
+#ifdef CONFIG_TIMER_SLACK
+k_ticks_t z_add_timeout_slack(struct _timeout *to, _timeout_func_t fn, k_timeout_t timeout,
+			      k_ticks_t slack)
+{
+	return add_timeout(to, fn, timeout, slack);
+}
+
+void k_timer_slack_stats_get(struct k_timer_slack_stats *stats)
+{
+	K_SPINLOCK(&timeout_lock) {
+		*stats = slack_stats;
+	}
+}
+#endif /* CONFIG_TIMER_SLACK */
+
 int z_abort_timeout(struct _timeout *to)
 {
 	int ret = -EINVAL;
 
 	K_SPINLOCK(&timeout_lock) {
 		if (sys_dnode_is_linked(&to->node)) {
-			bool is_first = (to == first());
+			bool is_first = is_first_timeout(to);
 
 			remove_timeout(to);
 			to->dticks = TIMEOUT_DTICKS_ABORTED;
@@ -164,21 +553,6 @@ int z_abort_timeout(struct _timeout *to)
 	return ret;
 }
 
-/* must be locked */
-static k_ticks_t timeout_rem(const struct _timeout *timeout)
-{
-	k_ticks_t ticks = 0;
-
-	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
-		ticks += t->dticks;
-		if (timeout == t) {
-			break;
-		}
-	}
-
-	return ticks;
-}
-
 k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
 {
 	k_ticks_t ticks = 0;
@@ -237,15 +611,21 @@ void sys_clock_announce(int32_t ticks)
 	announce_remaining = ticks;
 
 	struct _timeout *t;
+	int dt;
+#ifdef CONFIG_TIMER_SLACK
+	bool first_expiry = true;
+#endif /* CONFIG_TIMER_SLACK */
 
-	for (t = first();
-	     (t != NULL) && (t->dticks <= announce_remaining);
-	     t = first()) {
-		int dt = t->dticks;
-
+	while ((t = pop_expired(announce_remaining, &dt)) != NULL) {
 		curr_tick += dt;
-		t->dticks = 0;
-		remove_timeout(t);
+
+#ifdef CONFIG_TIMER_SLACK
+		slack_stats.expired++;
+		if (first_expiry || (dt != 0)) {
+			slack_stats.expiry_ticks++;
+			first_expiry = false;
+		}
+#endif /* CONFIG_TIMER_SLACK */
 
 		k_spin_unlock(&timeout_lock, key);
 		t->fn(t);
@@ -253,10 +633,7 @@ void sys_clock_announce(int32_t ticks)
 		announce_remaining -= dt;
 	}
 
-	if (t != NULL) {
-		t->dticks -= announce_remaining;
-	}
-
+	advance_timeouts(announce_remaining);
 	curr_tick += announce_remaining;
 	announce_remaining = 0;
 
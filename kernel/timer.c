@@ -117,8 +117,24 @@ void z_timer_expiration_handler(struct _timeout *t)
 		 */
 		next = K_TIMEOUT_ABS_TICKS(k_uptime_ticks() + 1 + next.ticks);
 #endif /* CONFIG_TIMEOUT_64BIT */
+#ifdef CONFIG_TIMER_SLACK
+		if (timer->slack > 0) {
+			/* Stride from the expiry without slack, so that
+			 * deferrals do not add up.
+			 */
+			next = K_TIMEOUT_ABS_TICKS(timer->nominal +
+						   timer->period.ticks);
+			timer->nominal = z_add_timeout_slack(&timer->timeout,
+							     z_timer_expiration_handler,
+							     next, timer->slack);
+		} else {
+			z_add_timeout(&timer->timeout, z_timer_expiration_handler,
+				      next);
+		}
+#else
 		z_add_timeout(&timer->timeout, z_timer_expiration_handler,
 			      next);
+#endif /* CONFIG_TIMER_SLACK */
 	}
 
 	/* update timer's status */
@@ -169,6 +185,9 @@ void k_timer_init(struct k_timer *timer,
 	timer->expiry_fn = expiry_fn;
 	timer->stop_fn = stop_fn;
 	timer->status = 0U;
+#ifdef CONFIG_TIMER_SLACK
+	timer->slack = 0;
+#endif
 
 	if (IS_ENABLED(CONFIG_MULTITHREADING)) {
 		z_waitq_init(&timer->wait_q);
@@ -190,10 +209,9 @@ void k_timer_init(struct k_timer *timer,
 }
 
 
-void z_impl_k_timer_start(struct k_timer *timer, k_timeout_t duration,
-			  k_timeout_t period)
+static void timer_start(struct k_timer *timer, k_timeout_t duration,
+			k_timeout_t period, k_ticks_t slack)
 {
-	SYS_PORT_TRACING_OBJ_FUNC(k_timer, start, timer, duration, period);
 
 	/* Acquire spinlock to ensure safety during concurrent calls to
 	 * k_timer_start for scheduling or rescheduling. This is necessary
@@ -233,14 +251,29 @@ void z_impl_k_timer_start(struct k_timer *timer, k_timeout_t duration,
 	timer->period = period;
 	timer->status = 0U;
 
+#ifdef CONFIG_TIMER_SLACK
+	timer->slack = slack;
+	timer->nominal = z_add_timeout_slack(&timer->timeout, z_timer_expiration_handler,
+					     duration, slack);
+#else
+	ARG_UNUSED(slack);
 	z_add_timeout(&timer->timeout, z_timer_expiration_handler,
 		     duration);
+#endif /* CONFIG_TIMER_SLACK */
 
 	z_timer_observer_on_start(timer, duration, period);
 
 	k_spin_unlock(&lock, key);
 }
 
+void z_impl_k_timer_start(struct k_timer *timer, k_timeout_t duration,
+			  k_timeout_t period)
+{
+	SYS_PORT_TRACING_OBJ_FUNC(k_timer, start, timer, duration, period);
+
+	timer_start(timer, duration, period, 0);
+}
+
 #ifdef CONFIG_USERSPACE
 static inline void z_vrfy_k_timer_start(struct k_timer *timer,
 					k_timeout_t duration,
@@ -252,6 +285,31 @@ static inline void z_vrfy_k_timer_start(struct k_timer *timer,
 #include <zephyr/syscalls/k_timer_start_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+#ifdef CONFIG_TIMER_SLACK
+void z_impl_k_timer_start_slack(struct k_timer *timer, k_timeout_t duration,
+				k_timeout_t period, k_timeout_t slack)
+{
+	SYS_PORT_TRACING_OBJ_FUNC(k_timer, start, timer, duration, period);
+
+	__ASSERT(Z_IS_TIMEOUT_RELATIVE(slack), "slack must be a relative timeout");
+
+	timer_start(timer, duration, period,
+		    K_TIMEOUT_EQ(slack, K_FOREVER) ? 0 : slack.ticks);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline void z_vrfy_k_timer_start_slack(struct k_timer *timer,
+					      k_timeout_t duration,
+					      k_timeout_t period,
+					      k_timeout_t slack)
+{
+	K_OOPS(K_SYSCALL_OBJ(timer, K_OBJ_TIMER));
+	z_impl_k_timer_start_slack(timer, duration, period, slack);
+}
+#include <zephyr/syscalls/k_timer_start_slack_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+#endif /* CONFIG_TIMER_SLACK */
+
 void z_impl_k_timer_stop(struct k_timer *timer)
 {
 	SYS_PORT_TRACING_OBJ_FUNC(k_timer, stop, timer);
@@ -411,7 +411,9 @@ static void *z_object_alloc(enum k_objects otype, size_t size)
 		break;
 	/* The following are currently not allowed at all */
 	case K_OBJ_FUTEX:			/* Lives in user memory */
+#ifndef CONFIG_SYS_MUTEX_FUTEX
 	case K_OBJ_SYS_MUTEX:			/* Lives in user memory */
+#endif
 	case K_OBJ_NET_SOCKET:			/* Indeterminate size */
 		LOG_ERR("forbidden object type '%s' requested",
 			otype_to_str(otype));
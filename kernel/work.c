@@ -79,6 +79,69 @@ static inline void init_flusher(struct z_work_flusher *flusher)
 /* List of pending cancellations. */
 static sys_slist_t pending_cancels;
 
+#if defined(CONFIG_WORKQUEUE_WORKERS)
+/* List of flushers waiting on items of queues with several workers. */
+static sys_slist_t pending_flushes;
+
+static inline bool queue_has_workers(const struct k_work_q *queue)
+{
+	return queue->num_workers != 0U;
+}
+
+static inline bool queue_is_worker(const struct k_work_q *queue,
+				   const struct k_thread *thread)
+{
+	return (thread >= queue->workers)
+		&& (thread < &queue->workers[queue->num_workers]);
+}
+
+/* Update the flushers waiting on instances of a work item.
+ *
+ * Flushers that are waiting on any of the @p done states of @p work
+ * replace them with @p next.  Those left waiting on nothing are removed
+ * from pending_flushes and released.
+ *
+ * Invoked with work lock held.
+ *
+ * @param work the work item whose state changed
+ * @param done the K_WORK_QUEUED or K_WORK_RUNNING state that ended
+ * @param next the state that the same instance entered, or zero
+ */
+static void update_flushers_locked(struct k_work *work, uint32_t done,
+				   uint32_t next)
+{
+	struct k_work *wp, *tmp;
+	sys_snode_t *prev = NULL;
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&pending_flushes, wp, tmp, node) {
+		struct z_work_flusher *flusher
+			= CONTAINER_OF(wp, struct z_work_flusher, work);
+		uint32_t flags = flags_get(&wp->flags);
+
+		if ((flusher->target != work) || ((flags & done) == 0U)) {
+			prev = &wp->node;
+			continue;
+		}
+
+		flags = (flags & ~done) | next;
+		flags_set(&wp->flags, flags);
+		if (flags == 0U) {
+			sys_slist_remove(&pending_flushes, prev, &wp->node);
+			k_sem_give(&flusher->sem);
+		} else {
+			prev = &wp->node;
+		}
+	}
+}
+#else
+static inline bool queue_has_workers(const struct k_work_q *queue)
+{
+	ARG_UNUSED(queue);
+
+	return false;
+}
+#endif /* defined(CONFIG_WORKQUEUE_WORKERS) */
+
 /* Initialize a canceler record and add it to the list of pending
  * cancels.
  *
@@ -212,7 +275,13 @@ static inline void queue_remove_locked(struct k_work_q *queue,
 				       struct k_work *work)
 {
 	if (flag_test_and_clear(&work->flags, K_WORK_QUEUED_BIT)) {
+		/* A resubmission held back while the item runs on a
+		 * multi-worker queue is not on the pending list.
+		 */
 		(void)sys_slist_find_and_remove(&queue->pending, &work->node);
+#if defined(CONFIG_WORKQUEUE_WORKERS)
+		update_flushers_locked(work, K_WORK_QUEUED, 0);
+#endif /* defined(CONFIG_WORKQUEUE_WORKERS) */
 	}
 }
 
@@ -266,6 +335,11 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 
 	int ret;
 	bool chained = (_current == queue->thread_id) && !k_is_in_isr();
+#if defined(CONFIG_WORKQUEUE_WORKERS)
+	if (queue_has_workers(queue)) {
+		chained = queue_is_worker(queue, _current) && !k_is_in_isr();
+	}
+#endif /* defined(CONFIG_WORKQUEUE_WORKERS) */
 	bool draining = flag_test(&queue->flags, K_WORK_QUEUE_DRAIN_BIT);
 	bool plugged = flag_test(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT);
 
@@ -282,6 +356,13 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 		ret = -EBUSY;
 	} else if (plugged && !draining) {
 		ret = -EBUSY;
+	} else if (queue_has_workers(queue)
+		   && flag_test(&work->flags, K_WORK_RUNNING_BIT)) {
+		/* Another worker must not pick the item up while it is
+		 * still running.  The worker running it appends it to the
+		 * pending list when the handler returns.
+		 */
+		ret = 1;
 	} else {
 		sys_slist_append(&queue->pending, &work->node);
 		ret = 1;
@@ -422,6 +503,44 @@ int k_work_submit(struct k_work *work)
 	return ret;
 }
 
+int k_work_submit_batch(struct k_work_q *queue, struct k_work **works,
+			size_t count)
+{
+	__ASSERT_NO_MSG((works != NULL) || (count == 0U));
+
+	int queued = 0;
+	int err = 0;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	for (size_t i = 0; i < count; i++) {
+		struct k_work_q *wq = queue;
+
+		__ASSERT_NO_MSG(works[i] != NULL);
+		__ASSERT_NO_MSG(works[i]->handler != NULL);
+
+		int rc = submit_to_queue_locked(works[i], &wq);
+
+		if (rc > 0) {
+			queued++;
+		} else if ((rc < 0) && (err == 0)) {
+			err = rc;
+		} else {
+			/* Already queued, or not the first rejection */
+		}
+	}
+
+	k_spin_unlock(&lock, key);
+
+	/* Each queued item woke at most one idle worker; give them the
+	 * CPU once, after the whole batch is in place.
+	 */
+	if (queued > 0) {
+		z_reschedule_unlocked();
+	}
+
+	return (queued > 0) ? queued : err;
+}
+
 /* Flush the work item if necessary.
  *
  * Flushing is necessary only if the work is either queued or running.
@@ -448,6 +567,22 @@ static bool work_flush_locked(struct k_work *work,
 
 		__ASSERT_NO_MSG(queue != NULL);
 
+#if defined(CONFIG_WORKQUEUE_WORKERS)
+		if (queue_has_workers(queue)) {
+			/* A flusher item behind the work could be run by
+			 * another worker before the work completes, so
+			 * track the outstanding instances instead.
+			 */
+			k_sem_init(&flusher->sem, 0, 1);
+			flusher->target = work;
+			flags_set(&flusher->work.flags, flags_get(&work->flags)
+				  & (K_WORK_QUEUED | K_WORK_RUNNING));
+			sys_slist_append(&pending_flushes, &flusher->work.node);
+
+			return need_flush;
+		}
+#endif /* defined(CONFIG_WORKQUEUE_WORKERS) */
+
 		queue_flusher_locked(queue, work, flusher);
 		notify_queue_locked(queue);
 	}
@@ -648,6 +783,21 @@ static void work_timeout_stop_locked(struct k_work_q *queue)
 }
 #endif /* defined(CONFIG_WORKQUEUE_WORK_TIMEOUT) */
 
+/* Check whether other workers of the queue are running items.
+ *
+ * Invoked with work lock held, by a worker that is not running an item.
+ */
+static inline bool queue_busy_locked(const struct k_work_q *queue)
+{
+#if defined(CONFIG_WORKQUEUE_WORKERS)
+	return queue->busy != 0U;
+#else
+	ARG_UNUSED(queue);
+
+	return false;
+#endif /* defined(CONFIG_WORKQUEUE_WORKERS) */
+}
+
 /* Loop executed by a work queue thread.
  *
  * @param workq_ptr pointer to the work queue structure
@@ -676,6 +826,13 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			work = CONTAINER_OF(node, struct k_work, node);
 			flag_set(&work->flags, K_WORK_RUNNING_BIT);
 			flag_clear(&work->flags, K_WORK_QUEUED_BIT);
+#if defined(CONFIG_WORKQUEUE_WORKERS)
+			if (queue_has_workers(queue)) {
+				queue->busy++;
+				update_flushers_locked(work, K_WORK_QUEUED,
+						       K_WORK_RUNNING);
+			}
+#endif /* defined(CONFIG_WORKQUEUE_WORKERS) */
 
 			/* Static code analysis tool can raise a false-positive violation
 			 * in the line below that 'work' is checked for null after being
@@ -690,6 +847,11 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			 * This means that if node is not NULL, then work will not be NULL.
 			 */
 			handler = work->handler;
+		} else if (queue_busy_locked(queue)) {
+			/* Other workers are still running items: the last
+			 * of them to finish handles draining and stopping.
+			 */
+			;
 		} else if (flag_test_and_clear(&queue->flags,
 					       K_WORK_QUEUE_DRAIN_BIT)) {
 			/* Not busy and draining: move threads waiting for
@@ -705,6 +867,14 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 		} else if (flag_test(&queue->flags, K_WORK_QUEUE_STOP_BIT)) {
 			/* User has requested that the queue stop. Clear the status flags and exit.
 			 */
+#if defined(CONFIG_WORKQUEUE_WORKERS)
+			if (queue_has_workers(queue) && (--queue->live != 0U)) {
+				/* Pass the request on to the next worker. */
+				(void)notify_queue_locked(queue);
+				k_spin_unlock(&lock, key);
+				return;
+			}
+#endif /* defined(CONFIG_WORKQUEUE_WORKERS) */
 			flags_set(&queue->flags, 0);
 			k_spin_unlock(&lock, key);
 			return;
@@ -755,7 +925,24 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			finalize_cancel_locked(work);
 		}
 
+#if defined(CONFIG_WORKQUEUE_WORKERS)
+		if (queue_has_workers(queue)) {
+			update_flushers_locked(work, K_WORK_RUNNING, 0);
+
+			/* Queue any resubmission held back while it ran. */
+			if (flag_test(&work->flags, K_WORK_QUEUED_BIT)) {
+				sys_slist_append(&queue->pending, &work->node);
+			}
+
+			if (--queue->busy == 0U) {
+				flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+			}
+		} else {
+			flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+		}
+#else
 		flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+#endif /* defined(CONFIG_WORKQUEUE_WORKERS) */
 		yield = !flag_test(&queue->flags, K_WORK_QUEUE_NO_YIELD_BIT);
 		k_spin_unlock(&lock, key);
 
@@ -804,6 +991,9 @@ void k_work_queue_run(struct k_work_q *queue, const struct k_work_queue_config *
 	sys_slist_init(&queue->pending);
 	z_waitq_init(&queue->notifyq);
 	z_waitq_init(&queue->drainq);
+#if defined(CONFIG_WORKQUEUE_WORKERS)
+	queue->num_workers = 0U;
+#endif /* defined(CONFIG_WORKQUEUE_WORKERS) */
 	queue->thread_id = _current;
 	flags_set(&queue->flags, flags);
 	work_queue_main(queue, NULL, NULL);
@@ -831,6 +1021,10 @@ void k_work_queue_start(struct k_work_q *queue,
 		flags |= K_WORK_QUEUE_NO_YIELD;
 	}
 
+#if defined(CONFIG_WORKQUEUE_WORKERS)
+	queue->num_workers = 0U;
+#endif /* defined(CONFIG_WORKQUEUE_WORKERS) */
+
 	/* It hasn't actually been started yet, but all the state is in place
 	 * so we can submit things and once the thread gets control it's ready
 	 * to roll.
@@ -863,6 +1057,70 @@ void k_work_queue_start(struct k_work_q *queue,
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, start, queue);
 }
 
+#if defined(CONFIG_WORKQUEUE_WORKERS)
+void k_work_queue_start_workers(struct k_work_q *queue,
+				struct k_thread *threads,
+				k_thread_stack_t *stacks, size_t stack_size,
+				size_t num_workers, int prio,
+				const struct k_work_queue_config *cfg)
+{
+	__ASSERT_NO_MSG(queue);
+	__ASSERT_NO_MSG(threads);
+	__ASSERT_NO_MSG(stacks);
+	__ASSERT_NO_MSG((num_workers > 0U) && (num_workers <= UINT16_MAX));
+	__ASSERT_NO_MSG(!flag_test(&queue->flags, K_WORK_QUEUE_STARTED_BIT));
+
+	uint32_t flags = K_WORK_QUEUE_STARTED;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work_queue, start, queue);
+
+	sys_slist_init(&queue->pending);
+	z_waitq_init(&queue->notifyq);
+	z_waitq_init(&queue->drainq);
+
+	if ((cfg != NULL) && cfg->no_yield) {
+		flags |= K_WORK_QUEUE_NO_YIELD;
+	}
+
+	queue->workers = threads;
+	queue->num_workers = (uint16_t)num_workers;
+	queue->busy = 0U;
+	queue->live = (uint16_t)num_workers;
+	flags_set(&queue->flags, flags);
+
+	for (size_t i = 0; i < num_workers; i++) {
+		struct k_thread *thread = &threads[i];
+
+		(void)k_thread_create(thread,
+				      &stacks[i * K_THREAD_STACK_LEN(stack_size)],
+				      stack_size, work_queue_main, queue, NULL, NULL,
+				      prio, 0, K_FOREVER);
+
+		if ((cfg != NULL) && (cfg->name != NULL)) {
+			k_thread_name_set(thread, cfg->name);
+		}
+
+		if ((cfg != NULL) && (cfg->essential)) {
+			thread->base.user_options |= K_ESSENTIAL;
+		}
+
+#if defined(CONFIG_SCHED_CPU_MASK)
+		if ((cfg != NULL) && cfg->pin_workers) {
+			(void)k_thread_cpu_pin(thread, (int)(i % arch_num_cpus()));
+		}
+#endif /* defined(CONFIG_SCHED_CPU_MASK) */
+	}
+
+	queue->thread_id = &threads[0];
+
+	for (size_t i = 0; i < num_workers; i++) {
+		k_thread_start(&threads[i]);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, start, queue);
+}
+#endif /* defined(CONFIG_WORKQUEUE_WORKERS) */
+
 int k_work_queue_drain(struct k_work_q *queue,
 		       bool plug)
 {
@@ -925,6 +1183,12 @@ int k_work_queue_stop(struct k_work_q *queue, k_timeout_t timeout)
 		return -ENOTSUP;
 	}
 
+#if defined(CONFIG_WORKQUEUE_WORKERS)
+	if (queue_has_workers(queue) && z_is_thread_essential(queue->thread_id)) {
+		return -ENOTSUP;
+	}
+#endif /* defined(CONFIG_WORKQUEUE_WORKERS) */
+
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
 	if (!flag_test(&queue->flags, K_WORK_QUEUE_STARTED_BIT)) {
@@ -943,7 +1207,25 @@ int k_work_queue_stop(struct k_work_q *queue, k_timeout_t timeout)
 	notify_queue_locked(queue);
 	k_spin_unlock(&lock, key);
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_work_queue, stop, queue, timeout);
-	if (k_thread_join(queue->thread_id, timeout)) {
+
+	int rc;
+
+#if defined(CONFIG_WORKQUEUE_WORKERS)
+	if (queue_has_workers(queue)) {
+		k_timepoint_t end = sys_timepoint_calc(timeout);
+
+		rc = 0;
+		for (size_t i = 0; (rc == 0) && (i < queue->num_workers); i++) {
+			rc = k_thread_join(&queue->workers[i], sys_timepoint_timeout(end));
+		}
+	} else {
+		rc = k_thread_join(queue->thread_id, timeout);
+	}
+#else
+	rc = k_thread_join(queue->thread_id, timeout);
+#endif /* defined(CONFIG_WORKQUEUE_WORKERS) */
+
+	if (rc != 0) {
 		key = k_spin_lock(&lock);
 		flag_clear(&queue->flags, K_WORK_QUEUE_STOP_BIT);
 		k_spin_unlock(&lock, key);
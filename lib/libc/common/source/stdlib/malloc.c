@@ -15,6 +15,7 @@
 #include <zephyr/sys/mutex.h>
 #endif
 #include <zephyr/sys/sys_heap.h>
+#include <zephyr/sys/heap_listener.h>
 #include <zephyr/sys/libc-hooks.h>
 #include <zephyr/types.h>
 #ifdef CONFIG_MMU
@@ -137,16 +138,274 @@ malloc_unlock(void)
 #define malloc_unlock()
 #endif
 
+#ifdef CONFIG_SYS_HEAP_LISTENER
+/* Allocations and frees are reported to HEAP_ID_LIBC listeners with the
+ * usable size of the block, which does not change until it is freed, so
+ * that the allocated and freed totals balance on every path.
+ */
+static void notify_alloc(void *mem)
+{
+	if (mem != NULL) {
+		heap_listener_notify_alloc(HEAP_ID_LIBC, mem,
+					   sys_heap_usable_size(&z_malloc_heap, mem));
+	}
+}
+
+static void notify_free(void *mem)
+{
+	if (mem != NULL) {
+		heap_listener_notify_free(HEAP_ID_LIBC, mem,
+					  sys_heap_usable_size(&z_malloc_heap, mem));
+	}
+}
+#else
+#define notify_alloc(mem) (void)(mem)
+#define notify_free(mem) (void)(mem)
+#endif /* CONFIG_SYS_HEAP_LISTENER */
+
+#ifdef CONFIG_COMMON_LIBC_MALLOC_CACHE
+
+/*
+ * Per-CPU caches of small blocks, with one list per power of two size
+ * class. Cached blocks remain allocated from z_malloc_heap, which lets
+ * malloc() and free() of small sizes be served from the cache of the
+ * current CPU without taking z_malloc_heap_mutex. A cache is refilled
+ * from the heap, and drained back to it, in batches of half its depth.
+ */
+
+#define CACHE_MIN_SHIFT	4
+#define CACHE_MAX_SHIFT	LOG2CEIL(CONFIG_COMMON_LIBC_MALLOC_CACHE_MAX_SIZE)
+#define CACHE_CLASSES	(CACHE_MAX_SHIFT - CACHE_MIN_SHIFT + 1)
+#define CACHE_DEPTH	CONFIG_COMMON_LIBC_MALLOC_CACHE_DEPTH
+#define CACHE_BATCH	(CACHE_DEPTH / 2)
+
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_COMMON_LIBC_MALLOC_CACHE_MAX_SIZE),
+	     "CONFIG_COMMON_LIBC_MALLOC_CACHE_MAX_SIZE must be a power of two");
+BUILD_ASSERT(BIT(CACHE_MIN_SHIFT) >= sizeof(void *));
+
+struct malloc_cache {
+	struct k_spinlock lock;
+	void *head[CACHE_CLASSES];
+	uint16_t count[CACHE_CLASSES];
+};
+
+static struct malloc_cache malloc_cache[CONFIG_MP_MAX_NUM_CPUS];
+
+static struct malloc_cache *cache_lock(k_spinlock_key_t *key)
+{
+	struct malloc_cache *cache = &malloc_cache[0];
+
+#ifdef CONFIG_SMP
+	/* Migrating after reading the CPU id only means that the cache of
+	 * another CPU is used, under its own lock.
+	 */
+	cache = &malloc_cache[arch_curr_cpu()->id];
+#endif
+	*key = k_spin_lock(&cache->lock);
+
+	return cache;
+}
+
+static inline size_t cache_class_size(unsigned int cls)
+{
+	return BIT(cls + CACHE_MIN_SHIFT);
+}
+
+/* Returns a detached list of @a count blocks, to be freed to the heap */
+static void *cache_detach(struct malloc_cache *cache, unsigned int cls,
+			  unsigned int count)
+{
+	void *list = cache->head[cls];
+	void **tail = &list;
+
+	for (unsigned int i = 0; i < count; i++) {
+		tail = (void **)*tail;
+	}
+	cache->head[cls] = *tail;
+	cache->count[cls] -= count;
+	*tail = NULL;
+
+	return list;
+}
+
+static void cache_release(void *list)
+{
+	while (list != NULL) {
+		void *next = *(void **)list;
+
+		sys_heap_free(&z_malloc_heap, list);
+		list = next;
+	}
+}
+
+/* Returns the blocks held by all caches to the heap, with the heap
+ * locked. Returns the number of blocks released.
+ */
+static size_t cache_flush(void)
+{
+	size_t released = 0;
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(malloc_cache); i++) {
+		struct malloc_cache *cache = &malloc_cache[i];
+
+		for (unsigned int cls = 0; cls < CACHE_CLASSES; cls++) {
+			k_spinlock_key_t key = k_spin_lock(&cache->lock);
+			unsigned int count = cache->count[cls];
+			void *list = cache_detach(cache, cls, count);
+
+			k_spin_unlock(&cache->lock, key);
+
+			cache_release(list);
+			released += count;
+		}
+	}
+
+	return released;
+}
+
+static void *heap_alloc(size_t align, size_t size)
+{
+	void *ret = sys_heap_aligned_alloc(&z_malloc_heap, align, size);
+
+	/* Memory held by the caches may be what is missing */
+	if (ret == NULL && size != 0 && cache_flush() != 0) {
+		ret = sys_heap_aligned_alloc(&z_malloc_heap, align, size);
+	}
+
+	return ret;
+}
+
+static void *cache_refill(unsigned int cls)
+{
+	size_t size = cache_class_size(cls);
+	unsigned int count = 0;
+	void *list = NULL;
+	void *tail = NULL;
+	void *ret;
+
+	malloc_lock();
+
+	ret = heap_alloc(__alignof__(z_max_align_t), size);
+	while (ret != NULL && count < CACHE_BATCH - 1) {
+		void *mem = sys_heap_aligned_alloc(&z_malloc_heap,
+						   __alignof__(z_max_align_t),
+						   size);
+
+		if (mem == NULL) {
+			break;
+		}
+		*(void **)mem = list;
+		list = mem;
+		if (tail == NULL) {
+			tail = mem;
+		}
+		count++;
+	}
+
+	malloc_unlock();
+
+	if (count != 0) {
+		k_spinlock_key_t key;
+		struct malloc_cache *cache = cache_lock(&key);
+
+		*(void **)tail = cache->head[cls];
+		cache->head[cls] = list;
+		cache->count[cls] += count;
+
+		k_spin_unlock(&cache->lock, key);
+	}
+
+	return ret;
+}
+
+static void *cache_alloc(size_t size)
+{
+	unsigned int cls = (size <= BIT(CACHE_MIN_SHIFT)) ? 0 :
+		LOG2CEIL(size) - CACHE_MIN_SHIFT;
+	k_spinlock_key_t key;
+	struct malloc_cache *cache = cache_lock(&key);
+	void *ret = cache->head[cls];
+
+	if (ret != NULL) {
+		cache->head[cls] = *(void **)ret;
+		cache->count[cls]--;
+	}
+
+	k_spin_unlock(&cache->lock, key);
+
+	if (ret == NULL) {
+		ret = cache_refill(cls);
+	}
+
+	return ret;
+}
+
+static bool cache_free(void *ptr)
+{
+	/* The size of an allocated chunk only changes through operations
+	 * on that chunk, so reading it does not need the heap lock.
+	 */
+	size_t usable = sys_heap_usable_size(&z_malloc_heap, ptr);
+	unsigned int cls;
+	k_spinlock_key_t key;
+	struct malloc_cache *cache;
+	void *list = NULL;
+
+	if (usable < BIT(CACHE_MIN_SHIFT) ||
+	    usable >= 2 * CONFIG_COMMON_LIBC_MALLOC_CACHE_MAX_SIZE ||
+	    !IS_ALIGNED(ptr, __alignof__(z_max_align_t))) {
+		return false;
+	}
+
+	cls = MIN(LOG2(usable) - CACHE_MIN_SHIFT, CACHE_CLASSES - 1);
+
+	cache = cache_lock(&key);
+
+	*(void **)ptr = cache->head[cls];
+	cache->head[cls] = ptr;
+	cache->count[cls]++;
+	if (cache->count[cls] > CACHE_DEPTH) {
+		list = cache_detach(cache, cls, cache->count[cls] - CACHE_BATCH);
+	}
+
+	k_spin_unlock(&cache->lock, key);
+
+	if (list != NULL) {
+		malloc_lock();
+		cache_release(list);
+		malloc_unlock();
+	}
+
+	return true;
+}
+
+#else
+#define heap_alloc(align, size) sys_heap_aligned_alloc(&z_malloc_heap, align, size)
+#endif /* CONFIG_COMMON_LIBC_MALLOC_CACHE */
+
 void *malloc(size_t size)
 {
+#ifdef CONFIG_COMMON_LIBC_MALLOC_CACHE
+	if (size != 0 && size <= CONFIG_COMMON_LIBC_MALLOC_CACHE_MAX_SIZE) {
+		void *ret = cache_alloc(size);
+
+		if (ret == NULL) {
+			errno = ENOMEM;
+		}
+		notify_alloc(ret);
+
+		return ret;
+	}
+#endif /* CONFIG_COMMON_LIBC_MALLOC_CACHE */
+
 	malloc_lock();
 
-	void *ret = sys_heap_aligned_alloc(&z_malloc_heap,
-					   __alignof__(z_max_align_t),
-					   size);
+	void *ret = heap_alloc(__alignof__(z_max_align_t), size);
+
 	if (ret == NULL && size != 0) {
 		errno = ENOMEM;
 	}
+	notify_alloc(ret);
 
 	malloc_unlock();
 
@@ -157,12 +416,11 @@ void *aligned_alloc(size_t alignment, size_t size)
 {
 	malloc_lock();
 
-	void *ret = sys_heap_aligned_alloc(&z_malloc_heap,
-					   alignment,
-					   size);
+	void *ret = heap_alloc(alignment, size);
 	if (ret == NULL && size != 0) {
 		errno = ENOMEM;
 	}
+	notify_alloc(ret);
 
 	malloc_unlock();
 
@@ -242,6 +500,9 @@ void *realloc(void *ptr, size_t requested_size)
 {
 	malloc_lock();
 
+#ifdef CONFIG_SYS_HEAP_LISTENER
+	size_t old_size = (ptr != NULL) ? sys_heap_usable_size(&z_malloc_heap, ptr) : 0;
+#endif
 	void *ret = sys_heap_aligned_realloc(&z_malloc_heap, ptr,
 					     __alignof__(z_max_align_t),
 					     requested_size);
@@ -250,6 +511,16 @@ void *realloc(void *ptr, size_t requested_size)
 		errno = ENOMEM;
 	}
 
+#ifdef CONFIG_SYS_HEAP_LISTENER
+	/* Reported as a free of the old block and an allocation of the new
+	 * one, unless the old block is left untouched on failure.
+	 */
+	if (ptr != NULL && (ret != NULL || requested_size == 0)) {
+		heap_listener_notify_free(HEAP_ID_LIBC, ptr, old_size);
+	}
+	notify_alloc(ret);
+#endif
+
 	malloc_unlock();
 
 	return ret;
@@ -257,6 +528,14 @@ void *realloc(void *ptr, size_t requested_size)
 
 void free(void *ptr)
 {
+	notify_free(ptr);
+
+#ifdef CONFIG_COMMON_LIBC_MALLOC_CACHE
+	if (ptr != NULL && cache_free(ptr)) {
+		return;
+	}
+#endif /* CONFIG_COMMON_LIBC_MALLOC_CACHE */
+
 	malloc_lock();
 	sys_heap_free(&z_malloc_heap, ptr);
 	malloc_unlock();
@@ -274,6 +553,25 @@ int malloc_runtime_stats_get(struct sys_memory_stats *stats)
 
 	malloc_unlock();
 
+#ifdef CONFIG_COMMON_LIBC_MALLOC_CACHE
+	/* Blocks held by the caches are free from the application's
+	 * point of view.
+	 */
+	for (unsigned int i = 0; ret == 0 && i < ARRAY_SIZE(malloc_cache); i++) {
+		struct malloc_cache *cache = &malloc_cache[i];
+		k_spinlock_key_t key = k_spin_lock(&cache->lock);
+
+		for (unsigned int cls = 0; cls < CACHE_CLASSES; cls++) {
+			size_t cached = cache->count[cls] * cache_class_size(cls);
+
+			stats->allocated_bytes -= cached;
+			stats->free_bytes += cached;
+		}
+
+		k_spin_unlock(&cache->lock, key);
+	}
+#endif /* CONFIG_COMMON_LIBC_MALLOC_CACHE */
+
 	return ret;
 }
 
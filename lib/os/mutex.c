@@ -6,9 +6,11 @@
 
 #include <zephyr/kernel.h>
 #include <zephyr/sys/mutex.h>
+#include <zephyr/sys/condvar.h>
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/kernel_structs.h>
 
+#ifndef CONFIG_SYS_MUTEX_FUTEX
 static struct k_mutex *get_k_mutex(struct sys_mutex *mutex)
 {
 	struct k_object *obj;
@@ -72,3 +74,178 @@ static inline int z_vrfy_z_sys_mutex_kernel_unlock(struct sys_mutex *mutex)
 	return z_impl_z_sys_mutex_kernel_unlock(mutex);
 }
 #include <zephyr/syscalls/z_sys_mutex_kernel_unlock_mrsh.c>
+#else
+#define SYS_MUTEX_UNLOCKED   0
+#define SYS_MUTEX_LOCKED     1
+#define SYS_MUTEX_CONTENDED  2
+
+/* Lock a mutex known to be contended. The futex is left marked as
+ * contended, so that the unlock wakes up any other waiter, which may
+ * cost a useless wakeup once the last waiter got the mutex.
+ */
+static int mutex_lock_contended(struct sys_mutex *mutex, k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	int ret;
+
+	while (atomic_set(&mutex->futex.val, SYS_MUTEX_CONTENDED) !=
+	       SYS_MUTEX_UNLOCKED) {
+		ret = k_futex_wait(&mutex->futex, SYS_MUTEX_CONTENDED,
+				   sys_timepoint_timeout(end));
+		if (ret == -ETIMEDOUT) {
+			return -EAGAIN;
+		}
+		if ((ret != 0) && (ret != -EAGAIN)) {
+			return ret;
+		}
+	}
+
+	mutex->owner = k_current_get();
+	mutex->lock_count = 1U;
+
+	return 0;
+}
+
+int sys_mutex_lock(struct sys_mutex *mutex, k_timeout_t timeout)
+{
+	k_tid_t self = k_current_get();
+
+	if (likely(atomic_cas(&mutex->futex.val, SYS_MUTEX_UNLOCKED,
+			      SYS_MUTEX_LOCKED))) {
+		mutex->owner = self;
+		mutex->lock_count = 1U;
+		return 0;
+	}
+
+	/* Only the owner can find itself there */
+	if (mutex->owner == self) {
+		mutex->lock_count++;
+		return 0;
+	}
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		return -EBUSY;
+	}
+
+	return mutex_lock_contended(mutex, timeout);
+}
+
+int sys_mutex_unlock(struct sys_mutex *mutex)
+{
+	int ret;
+
+	if (mutex->owner != k_current_get()) {
+		return (atomic_get(&mutex->futex.val) == SYS_MUTEX_UNLOCKED) ?
+		       -EINVAL : -EPERM;
+	}
+
+	if (mutex->lock_count > 1U) {
+		mutex->lock_count--;
+		return 0;
+	}
+
+	mutex->owner = NULL;
+	mutex->lock_count = 0U;
+
+	if (atomic_set(&mutex->futex.val, SYS_MUTEX_UNLOCKED) ==
+	    SYS_MUTEX_CONTENDED) {
+		ret = k_futex_wake(&mutex->futex, false);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+#endif /* CONFIG_SYS_MUTEX_FUTEX */
+
+int sys_condvar_wait(struct sys_condvar *condvar, struct sys_mutex *mutex,
+		     k_timeout_t timeout)
+{
+	atomic_val_t seq;
+	int ret;
+
+	/* Count ourselves as a waiter before sampling the sequence, so that
+	 * a signal bumping it after that always sees us waiting.
+	 */
+	condvar->mutex = mutex;
+	(void)atomic_inc(&condvar->waiters);
+	seq = atomic_get(&condvar->seq.val);
+
+	ret = sys_mutex_unlock(mutex);
+	if (ret != 0) {
+		(void)atomic_dec(&condvar->waiters);
+		return ret;
+	}
+
+	ret = k_futex_wait(&condvar->seq, seq, timeout);
+	(void)atomic_dec(&condvar->waiters);
+
+#ifdef CONFIG_SYS_MUTEX_FUTEX
+	/* We may have been moved to the mutex futex by a broadcast, in which
+	 * case other threads may be pending on it too.
+	 */
+	(void)mutex_lock_contended(mutex, K_FOREVER);
+#else
+	(void)sys_mutex_lock(mutex, K_FOREVER);
+#endif /* CONFIG_SYS_MUTEX_FUTEX */
+
+	switch (ret) {
+	case -ETIMEDOUT:
+		return -EAGAIN;
+	case -EAGAIN:
+		/* Signaled between unlocking the mutex and pending */
+		return 0;
+	default:
+		return ret;
+	}
+}
+
+int sys_condvar_signal(struct sys_condvar *condvar)
+{
+	int ret;
+
+	(void)atomic_inc(&condvar->seq.val);
+
+	if (atomic_get(&condvar->waiters) == 0) {
+		return 0;
+	}
+
+	ret = k_futex_wake(&condvar->seq, false);
+
+	return (ret < 0) ? ret : 0;
+}
+
+int sys_condvar_broadcast(struct sys_condvar *condvar)
+{
+	atomic_val_t seq;
+	int ret;
+
+	seq = atomic_inc(&condvar->seq.val) + 1;
+
+	if (atomic_get(&condvar->waiters) == 0) {
+		return 0;
+	}
+
+#ifdef CONFIG_SYS_MUTEX_FUTEX
+	struct sys_mutex *mutex = condvar->mutex;
+
+	/* Wake up one waiter, and move the other ones to the mutex they all
+	 * need next: each of them is woken up in turn as the mutex is
+	 * unlocked, instead of all contending for it at once.
+	 */
+	if (mutex != NULL) {
+		ret = k_futex_requeue(&condvar->seq, seq, &mutex->futex);
+		if (ret != -EAGAIN) {
+			return (ret < 0) ? ret : 0;
+		}
+		/* Raced with another signal, wake up everybody */
+	}
+#else
+	ARG_UNUSED(seq);
+#endif /* CONFIG_SYS_MUTEX_FUTEX */
+
+	ret = k_futex_wake(&condvar->seq, true);
+
+	return (ret < 0) ? ret : 0;
+}
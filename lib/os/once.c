@@ -0,0 +1,85 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/sys/once.h>
+
+#define SYS_ONCE_INIT     0
+#define SYS_ONCE_RUNNING  1
+#define SYS_ONCE_WAITING  2
+#define SYS_ONCE_DONE     3
+
+#ifdef CONFIG_USERSPACE
+int sys_once(struct sys_once *once, void (*init_func)(void))
+{
+	atomic_val_t state;
+	int ret;
+
+	if (likely(atomic_get(&once->state.val) == SYS_ONCE_DONE)) {
+		return 0;
+	}
+
+	if (atomic_cas(&once->state.val, SYS_ONCE_INIT, SYS_ONCE_RUNNING)) {
+		init_func();
+
+		if (atomic_set(&once->state.val, SYS_ONCE_DONE) ==
+		    SYS_ONCE_WAITING) {
+			ret = k_futex_wake(&once->state, true);
+			return (ret < 0) ? ret : 0;
+		}
+
+		return 0;
+	}
+
+	for (;;) {
+		state = atomic_get(&once->state.val);
+		if (state == SYS_ONCE_DONE) {
+			return 0;
+		}
+
+		/* Let the running thread know that it has to wake us up */
+		if ((state == SYS_ONCE_RUNNING) &&
+		    !atomic_cas(&once->state.val, SYS_ONCE_RUNNING,
+				SYS_ONCE_WAITING)) {
+			continue;
+		}
+
+		ret = k_futex_wait(&once->state, SYS_ONCE_WAITING, K_FOREVER);
+		if ((ret != 0) && (ret != -EAGAIN)) {
+			return ret;
+		}
+	}
+}
+#else
+/* Shared by all sys_once, only used while an initialization function runs */
+static K_MUTEX_DEFINE(once_lock);
+static K_CONDVAR_DEFINE(once_cond);
+
+int sys_once(struct sys_once *once, void (*init_func)(void))
+{
+	if (likely(atomic_get(&once->state) == SYS_ONCE_DONE)) {
+		return 0;
+	}
+
+	if (atomic_cas(&once->state, SYS_ONCE_INIT, SYS_ONCE_RUNNING)) {
+		init_func();
+
+		(void)k_mutex_lock(&once_lock, K_FOREVER);
+		(void)atomic_set(&once->state, SYS_ONCE_DONE);
+		(void)k_condvar_broadcast(&once_cond);
+		(void)k_mutex_unlock(&once_lock);
+
+		return 0;
+	}
+
+	(void)k_mutex_lock(&once_lock, K_FOREVER);
+	while (atomic_get(&once->state) != SYS_ONCE_DONE) {
+		(void)k_condvar_wait(&once_cond, &once_lock, K_FOREVER);
+	}
+	(void)k_mutex_unlock(&once_lock);
+
+	return 0;
+}
+#endif /* CONFIG_USERSPACE */
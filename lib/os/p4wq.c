@@ -120,6 +120,279 @@ static FUNC_NORETURN void p4wq_loop(void *p0, void *p1, void *p2)
 	}
 }
 
+#ifdef CONFIG_P4WQ_WORK_STEALING
+
+/* top_priority of a shard with no queued items */
+#define SHARD_EMPTY INT32_MAX
+
+static inline bool is_stealing(struct k_p4wq *queue)
+{
+	return (queue->flags & K_P4WQ_WORK_STEALING) != 0U;
+}
+
+/* Must be called with the shard lock held */
+static void shard_update_top(struct k_p4wq_shard *shard)
+{
+	struct rbnode *r = rb_get_max(&shard->queue);
+
+	if (r == NULL) {
+		atomic_set(&shard->top_priority, SHARD_EMPTY);
+	} else {
+		struct k_p4wq_work *w
+			= CONTAINER_OF(r, struct k_p4wq_work, rbnode);
+
+		atomic_set(&shard->top_deadline, w->deadline);
+		atomic_set(&shard->top_priority, w->priority);
+	}
+}
+
+/* Like item_lessthan(), on the hints published by the shards */
+static inline bool hint_lessthan(int32_t apri, int32_t adl,
+				 int32_t bpri, int32_t bdl)
+{
+	if (apri > bpri) {
+		return true;
+	} else if ((apri == bpri) && (adl != bdl)) {
+		return adl - bdl > 0;
+	} else {
+		;
+	}
+	return false;
+}
+
+/* Dequeue the best item queued on any CPU, preferring the shard of
+ * @p cpu when it is as good as the others.  Returns NULL if all
+ * shards are empty.
+ */
+static struct k_p4wq_work *shard_take(struct k_p4wq *queue, unsigned int cpu)
+{
+	unsigned int num_cpus = arch_num_cpus();
+
+	while (true) {
+		struct k_p4wq_shard *best = NULL;
+		int32_t best_pri = SHARD_EMPTY;
+		int32_t best_dl = 0;
+
+		for (unsigned int i = 0; i < num_cpus; i++) {
+			struct k_p4wq_shard *shard
+				= &queue->shards[(cpu + i) % num_cpus];
+			int32_t pri = atomic_get(&shard->top_priority);
+			int32_t dl = atomic_get(&shard->top_deadline);
+
+			if ((pri != SHARD_EMPTY) &&
+			    ((best == NULL) ||
+			     hint_lessthan(best_pri, best_dl, pri, dl))) {
+				best = shard;
+				best_pri = pri;
+				best_dl = dl;
+			}
+		}
+
+		if (best == NULL) {
+			return NULL;
+		}
+
+		k_spinlock_key_t k = k_spin_lock(&best->lock);
+		struct rbnode *r = rb_get_max(&best->queue);
+
+		if (r != NULL) {
+			rb_remove(&best->queue, r);
+			shard_update_top(best);
+		}
+
+		k_spin_unlock(&best->lock, k);
+
+		if (r != NULL) {
+			return CONTAINER_OF(r, struct k_p4wq_work, rbnode);
+		}
+
+		/* Another worker got there first, look again */
+	}
+}
+
+static FUNC_NORETURN void p4wq_steal_loop(void *p0, void *p1, void *p2)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	struct k_p4wq *queue = p0;
+
+	while (true) {
+		atomic_val_t seq = atomic_get(&queue->seq);
+		unsigned int cpu = arch_curr_cpu()->id;
+		struct k_p4wq_shard *shard = &queue->shards[cpu];
+		struct k_p4wq_work *w = shard_take(queue, cpu);
+		k_spinlock_key_t k = k_spin_lock(&shard->lock);
+
+		if (w == NULL) {
+			/* Go idle, unless something was submitted since
+			 * we looked.  Submitters check for idle workers
+			 * after bumping seq, so one of the two sides
+			 * always sees the other.
+			 */
+			atomic_inc(&queue->idle);
+			if (atomic_get(&queue->seq) != seq) {
+				atomic_dec(&queue->idle);
+				k_spin_unlock(&shard->lock, k);
+			} else {
+				/* The thread waking us decrements idle */
+				z_pend_curr(&shard->lock, k, &shard->waitq,
+					    K_FOREVER);
+			}
+			continue;
+		}
+
+		w->thread = _current;
+		w->shard = cpu;
+		sys_dlist_append(&shard->active, &w->dlnode);
+		atomic_inc(&queue->nactive);
+		set_prio(_current, w);
+		thread_clear_requeued(_current);
+
+		k_spin_unlock(&shard->lock, k);
+
+		w->handler(w);
+
+		k = k_spin_lock(&shard->lock);
+
+		/* Remove from the active list only if it
+		 * wasn't resubmitted already
+		 */
+		if (!thread_was_requeued(_current)) {
+			sys_dlist_remove(&w->dlnode);
+			atomic_dec(&queue->nactive);
+			w->thread = NULL;
+
+			k_spin_unlock(&shard->lock, k);
+
+			if (queue->done_handler) {
+				queue->done_handler(w);
+			} else {
+				k_sem_give(&w->done_sem);
+			}
+		} else {
+			k_spin_unlock(&shard->lock, k);
+		}
+	}
+}
+
+/* Check whether fewer running items than CPUs would be preferred to
+ * @p item, so a worker must be woken to preempt one of them.
+ */
+static bool steal_should_preempt(struct k_p4wq *queue,
+				 struct k_p4wq_work *item)
+{
+	uint32_t n_beaten_by = 0, active_target = arch_num_cpus();
+
+	if (atomic_get(&queue->nactive) < active_target) {
+		return true;
+	}
+
+	for (unsigned int i = 0; i < active_target; i++) {
+		struct k_p4wq_shard *shard = &queue->shards[i];
+		k_spinlock_key_t k = k_spin_lock(&shard->lock);
+		struct k_p4wq_work *wi;
+
+		SYS_DLIST_FOR_EACH_CONTAINER(&shard->active, wi, dlnode) {
+			if (!item_lessthan(wi, item)) {
+				n_beaten_by++;
+			}
+		}
+
+		k_spin_unlock(&shard->lock, k);
+	}
+
+	return n_beaten_by < active_target;
+}
+
+static void p4wq_steal_submit(struct k_p4wq *queue, struct k_p4wq_work *item)
+{
+	unsigned int cpu = arch_curr_cpu()->id;
+	struct k_p4wq_shard *shard;
+	k_spinlock_key_t k;
+
+	item->deadline += k_cycle_get_32();
+
+	/* Resubmission from within handler?  Remove from active list */
+	if (item->thread == _current) {
+		shard = &queue->shards[item->shard];
+		k = k_spin_lock(&shard->lock);
+		sys_dlist_remove(&item->dlnode);
+		atomic_dec(&queue->nactive);
+		thread_set_requeued(_current);
+		item->thread = NULL;
+		k_spin_unlock(&shard->lock, k);
+	} else {
+		k_sem_init(&item->done_sem, 0, 1);
+	}
+	__ASSERT_NO_MSG(item->thread == NULL);
+
+	shard = &queue->shards[cpu];
+	k = k_spin_lock(&shard->lock);
+	rb_insert(&shard->queue, &item->rbnode);
+	item->queue = queue;
+	item->shard = cpu;
+	if (rb_get_max(&shard->queue) == &item->rbnode) {
+		shard_update_top(shard);
+	}
+	k_spin_unlock(&shard->lock, k);
+
+	atomic_inc(&queue->seq);
+
+	/* Busy workers pick the item up when they finish, in priority
+	 * order.  Wake an idle one only if a CPU is free for it or it
+	 * should preempt a running item, starting with this CPU.
+	 */
+	if ((atomic_get(&queue->idle) == 0) ||
+	    !steal_should_preempt(queue, item)) {
+		return;
+	}
+
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		shard = &queue->shards[(cpu + i) % num_cpus];
+		k = k_spin_lock(&shard->lock);
+
+		struct k_thread *th = z_unpend_first_thread(&shard->waitq);
+
+		if (th != NULL) {
+			atomic_dec(&queue->idle);
+			set_prio(th, item);
+			z_ready_thread(th);
+			z_reschedule(&shard->lock, k);
+			return;
+		}
+
+		k_spin_unlock(&shard->lock, k);
+	}
+}
+
+static bool p4wq_steal_cancel(struct k_p4wq *queue, struct k_p4wq_work *item)
+{
+	struct k_p4wq_shard *shard = &queue->shards[item->shard];
+	k_spinlock_key_t k = k_spin_lock(&shard->lock);
+	bool ret = rb_contains(&shard->queue, &item->rbnode);
+
+	if (ret) {
+		rb_remove(&shard->queue, &item->rbnode);
+		shard_update_top(shard);
+	}
+
+	k_spin_unlock(&shard->lock, k);
+
+	if (ret) {
+		if (queue->done_handler) {
+			queue->done_handler(item);
+		} else {
+			k_sem_give(&item->done_sem);
+		}
+	}
+
+	return ret;
+}
+
+#endif /* CONFIG_P4WQ_WORK_STEALING */
+
 /* Must be called to regain ownership of the work item */
 int k_p4wq_wait(struct k_p4wq_work *work, k_timeout_t timeout)
 {
@@ -136,14 +409,33 @@ void k_p4wq_init(struct k_p4wq *queue)
 	z_waitq_init(&queue->waitq);
 	queue->queue.lessthan_fn = rb_lessthan;
 	sys_dlist_init(&queue->active);
+
+#ifdef CONFIG_P4WQ_WORK_STEALING
+	for (int i = 0; i < ARRAY_SIZE(queue->shards); i++) {
+		struct k_p4wq_shard *shard = &queue->shards[i];
+
+		z_waitq_init(&shard->waitq);
+		shard->queue.lessthan_fn = rb_lessthan;
+		sys_dlist_init(&shard->active);
+		atomic_set(&shard->top_priority, SHARD_EMPTY);
+	}
+#endif
 }
 
 void k_p4wq_add_thread(struct k_p4wq *queue, struct k_thread *thread,
 			k_thread_stack_t *stack,
 			size_t stack_size)
 {
+	k_thread_entry_t entry = p4wq_loop;
+
+#ifdef CONFIG_P4WQ_WORK_STEALING
+	if (is_stealing(queue)) {
+		entry = p4wq_steal_loop;
+	}
+#endif
+
 	k_thread_create(thread, stack, stack_size,
-			p4wq_loop, queue, NULL, NULL,
+			entry, queue, NULL, NULL,
 			K_HIGHEST_THREAD_PRIO, 0,
 			queue->flags & K_P4WQ_DELAYED_START ? K_FOREVER : K_NO_WAIT);
 }
@@ -226,6 +518,13 @@ SYS_INIT(static_init, APPLICATION, 99);
 
 void k_p4wq_submit(struct k_p4wq *queue, struct k_p4wq_work *item)
 {
+#ifdef CONFIG_P4WQ_WORK_STEALING
+	if (is_stealing(queue)) {
+		p4wq_steal_submit(queue, item);
+		return;
+	}
+#endif
+
 	k_spinlock_key_t k = k_spin_lock(&queue->lock);
 
 	/* Input is a delta time from now (to match
@@ -303,6 +602,12 @@ out:
 
 bool k_p4wq_cancel(struct k_p4wq *queue, struct k_p4wq_work *item)
 {
+#ifdef CONFIG_P4WQ_WORK_STEALING
+	if (is_stealing(queue)) {
+		return p4wq_steal_cancel(queue, item);
+	}
+#endif
+
 	k_spinlock_key_t k = k_spin_lock(&queue->lock);
 	bool ret = rb_contains(&queue->queue, &item->rbnode);
 
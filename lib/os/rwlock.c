@@ -0,0 +1,209 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/sys/rwlock.h>
+
+#define SYS_RWLOCK_WRITER (-1)
+
+#ifdef CONFIG_USERSPACE
+void sys_rwlock_init(struct sys_rwlock *rwlock)
+{
+	atomic_clear(&rwlock->state.val);
+	atomic_clear(&rwlock->waiters);
+	rwlock->writer = NULL;
+}
+
+/* Wait for the state of the lock to change from the given value */
+static int rwlock_wait(struct sys_rwlock *rwlock, atomic_val_t state,
+		       k_timepoint_t end)
+{
+	int ret;
+
+	(void)atomic_inc(&rwlock->waiters);
+	ret = k_futex_wait(&rwlock->state, state, sys_timepoint_timeout(end));
+	(void)atomic_dec(&rwlock->waiters);
+
+	if (ret == -ETIMEDOUT) {
+		return -EAGAIN;
+	}
+
+	return (ret == -EAGAIN) ? 0 : ret;
+}
+
+int sys_rwlock_rdlock(struct sys_rwlock *rwlock, k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	atomic_val_t state;
+	int ret;
+
+	for (;;) {
+		state = atomic_get(&rwlock->state.val);
+		if (state >= 0) {
+			if (atomic_cas(&rwlock->state.val, state, state + 1)) {
+				return 0;
+			}
+			continue;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return -EBUSY;
+		}
+
+		ret = rwlock_wait(rwlock, state, end);
+		if (ret != 0) {
+			return ret;
+		}
+	}
+}
+
+int sys_rwlock_wrlock(struct sys_rwlock *rwlock, k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	atomic_val_t state;
+	int ret;
+
+	for (;;) {
+		if (atomic_cas(&rwlock->state.val, 0, SYS_RWLOCK_WRITER)) {
+			rwlock->writer = k_current_get();
+			return 0;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return -EBUSY;
+		}
+
+		state = atomic_get(&rwlock->state.val);
+		if (state == 0) {
+			continue;
+		}
+
+		/* Readers only wake us up once the last of them leaves */
+		ret = rwlock_wait(rwlock, state, end);
+		if (ret != 0) {
+			return ret;
+		}
+	}
+}
+
+int sys_rwlock_unlock(struct sys_rwlock *rwlock)
+{
+	atomic_val_t state = atomic_get(&rwlock->state.val);
+	int ret;
+
+	if (state == SYS_RWLOCK_WRITER) {
+		if (rwlock->writer != k_current_get()) {
+			return -EPERM;
+		}
+		rwlock->writer = NULL;
+		(void)atomic_set(&rwlock->state.val, 0);
+	} else if (state > 0) {
+		if (atomic_dec(&rwlock->state.val) != 1) {
+			return 0;
+		}
+	} else {
+		return -EINVAL;
+	}
+
+	/* Waiters count themselves before checking the state, so they
+	 * cannot miss the change made above.
+	 */
+	if (atomic_get(&rwlock->waiters) != 0) {
+		ret = k_futex_wake(&rwlock->state, true);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+#else
+void sys_rwlock_init(struct sys_rwlock *rwlock)
+{
+	k_mutex_init(&rwlock->lock);
+	k_condvar_init(&rwlock->cond);
+	rwlock->state = 0;
+	rwlock->writer = NULL;
+}
+
+/* Lock the lock, waiting while it is held by a writer, or by anybody when
+ * locking for writing. Returns with the mutex of the lock unlocked.
+ */
+static int rwlock_lock(struct sys_rwlock *rwlock, bool write,
+		       k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	int ret;
+
+	ret = k_mutex_lock(&rwlock->lock, timeout);
+	if (ret != 0) {
+		return ret;
+	}
+
+	while ((rwlock->state < 0) || (write && (rwlock->state != 0))) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			ret = -EBUSY;
+			break;
+		}
+
+		ret = k_condvar_wait(&rwlock->cond, &rwlock->lock,
+				     sys_timepoint_timeout(end));
+		if (ret != 0) {
+			break;
+		}
+	}
+
+	if (ret == 0) {
+		if (write) {
+			rwlock->state = SYS_RWLOCK_WRITER;
+			rwlock->writer = k_current_get();
+		} else {
+			rwlock->state++;
+		}
+	}
+
+	(void)k_mutex_unlock(&rwlock->lock);
+
+	return ret;
+}
+
+int sys_rwlock_rdlock(struct sys_rwlock *rwlock, k_timeout_t timeout)
+{
+	return rwlock_lock(rwlock, false, timeout);
+}
+
+int sys_rwlock_wrlock(struct sys_rwlock *rwlock, k_timeout_t timeout)
+{
+	return rwlock_lock(rwlock, true, timeout);
+}
+
+int sys_rwlock_unlock(struct sys_rwlock *rwlock)
+{
+	int ret = 0;
+
+	(void)k_mutex_lock(&rwlock->lock, K_FOREVER);
+
+	if (rwlock->state == SYS_RWLOCK_WRITER) {
+		if (rwlock->writer != k_current_get()) {
+			ret = -EPERM;
+		} else {
+			rwlock->writer = NULL;
+			rwlock->state = 0;
+		}
+	} else if (rwlock->state > 0) {
+		rwlock->state--;
+	} else {
+		ret = -EINVAL;
+	}
+
+	if ((ret == 0) && (rwlock->state == 0)) {
+		(void)k_condvar_broadcast(&rwlock->cond);
+	}
+
+	(void)k_mutex_unlock(&rwlock->lock);
+
+	return ret;
+}
+#endif /* CONFIG_USERSPACE */
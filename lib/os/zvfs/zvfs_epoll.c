@@ -0,0 +1,594 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/bitarray.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys/fdtable.h>
+#include <zephyr/sys/slist.h>
+#include <zephyr/zvfs/epoll.h>
+
+/* Sockets need up to 3 events (data, zero-copy completions and send window),
+ * plus one for the TLS handshake.
+ */
+#define ZVFS_EPOLL_ITEM_EVENTS 4
+
+#define ZVFS_EPOLL_POLL_EVENTS                                                                     \
+	(ZVFS_EPOLLIN | ZVFS_EPOLLPRI | ZVFS_EPOLLOUT | ZVFS_EPOLLERR | ZVFS_EPOLLHUP)
+
+BUILD_ASSERT(ZVFS_EPOLLIN == ZVFS_POLLIN && ZVFS_EPOLLPRI == ZVFS_POLLPRI &&
+	     ZVFS_EPOLLOUT == ZVFS_POLLOUT && ZVFS_EPOLLERR == ZVFS_POLLERR &&
+	     ZVFS_EPOLLHUP == ZVFS_POLLHUP);
+
+struct zvfs_epoll;
+
+struct zvfs_epoll_item {
+	/* Node in the interest list of the instance */
+	sys_dnode_t node;
+	/* Node in the ready list of the instance */
+	sys_snode_t ready_node;
+	struct zvfs_epoll *ep;
+	/* Triggered when one of the events becomes ready */
+	struct k_work_poll work;
+	struct k_poll_event events[ZVFS_EPOLL_ITEM_EVENTS];
+	struct zvfs_epoll_event event;
+	int fd;
+	/* Protected by epoll_lock */
+	bool queued;
+	/* Set once a ZVFS_EPOLLONESHOT event is reported */
+	bool disabled;
+};
+
+struct zvfs_epoll {
+	sys_dlist_t items;
+	/* Protected by epoll_lock */
+	sys_slist_t ready;
+	/* Given when an item is added to the ready list */
+	struct k_sem ready_sem;
+	int fd;
+	bool in_use;
+};
+
+int zvfs_poll_internal(struct zvfs_pollfd *fds, int nfds, k_timeout_t timeout);
+
+SYS_BITARRAY_DEFINE_STATIC(epolls_bitarray, CONFIG_ZVFS_EPOLL_MAX);
+static struct zvfs_epoll epolls[CONFIG_ZVFS_EPOLL_MAX];
+
+SYS_BITARRAY_DEFINE_STATIC(epoll_items_bitarray, CONFIG_ZVFS_EPOLL_MAX_ITEMS);
+static struct zvfs_epoll_item epoll_items[CONFIG_ZVFS_EPOLL_MAX_ITEMS];
+static atomic_t epoll_items_used;
+
+/* The interest lists are protected by the mutex of the epoll descriptor, the
+ * ready lists are also updated by the triggered work items.
+ */
+static struct k_spinlock epoll_lock;
+
+static const struct fd_op_vtable zvfs_epoll_fd_vtable;
+
+static void epoll_item_queue(struct zvfs_epoll_item *item)
+{
+	k_spinlock_key_t key;
+	bool queued;
+
+	key = k_spin_lock(&epoll_lock);
+
+	queued = !item->queued;
+	if (queued) {
+		item->queued = true;
+		sys_slist_append(&item->ep->ready, &item->ready_node);
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+
+	if (queued) {
+		k_sem_give(&item->ep->ready_sem);
+	}
+}
+
+static void epoll_item_triggered(struct k_work *work)
+{
+	struct k_work_poll *twork = CONTAINER_OF(work, struct k_work_poll, work);
+
+	epoll_item_queue(CONTAINER_OF(twork, struct zvfs_epoll_item, work));
+}
+
+/* Register the item with the kernel objects signaling the readiness of its
+ * descriptor, or queue it if it is already ready.
+ */
+static int epoll_item_arm(struct zvfs_epoll_item *item)
+{
+	struct zvfs_pollfd pfd = {
+		.fd = item->fd,
+		.events = item->event.events & ZVFS_EPOLL_POLL_EVENTS,
+	};
+	struct k_poll_event *pev = item->events;
+	const struct fd_op_vtable *vtable;
+	struct k_mutex *lock;
+	void *obj;
+	int ret;
+
+	if (item->disabled) {
+		return 0;
+	}
+
+	obj = zvfs_get_fd_obj_and_vtable(item->fd, &vtable, &lock);
+	if (obj == NULL) {
+		return -EBADF;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+	ret = zvfs_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_POLL_PREPARE, &pfd, &pev,
+				      item->events + ARRAY_SIZE(item->events));
+	k_mutex_unlock(lock);
+
+	if (ret == -EXDEV) {
+		/* Offloaded descriptors can only be polled all together */
+		return -EPERM;
+	}
+
+	if (ret == -EALREADY) {
+		epoll_item_queue(item);
+		return 0;
+	}
+
+	if (ret < 0) {
+		/* Some implementations return -1 and set errno */
+		return ret == -1 ? -errno : ret;
+	}
+
+	if (pev == item->events) {
+		/* Nothing to wait for */
+		return 0;
+	}
+
+	/* If an event is ready already, the work is submitted right away */
+	return k_work_poll_submit(&item->work, item->events, pev - item->events, K_FOREVER);
+}
+
+static void epoll_item_disarm(struct zvfs_epoll_item *item)
+{
+	struct k_work_sync sync;
+	k_spinlock_key_t key;
+
+	/* The work cannot be cancelled once triggered, wait for it instead */
+	if (k_work_poll_cancel(&item->work) != 0) {
+		(void)k_work_flush(&item->work.work, &sync);
+	}
+
+	key = k_spin_lock(&epoll_lock);
+	if (item->queued) {
+		item->queued = false;
+		(void)sys_slist_find_and_remove(&item->ep->ready, &item->ready_node);
+	}
+	k_spin_unlock(&epoll_lock, key);
+}
+
+static struct zvfs_epoll_item *epoll_item_alloc(struct zvfs_epoll *ep, int fd,
+						const struct zvfs_epoll_event *event)
+{
+	struct zvfs_epoll_item *item;
+	size_t offset;
+
+	if (sys_bitarray_alloc(&epoll_items_bitarray, 1, &offset) < 0) {
+		return NULL;
+	}
+
+	item = &epoll_items[offset];
+	*item = (struct zvfs_epoll_item){
+		.ep = ep,
+		.event = *event,
+		.fd = fd,
+	};
+
+	k_work_poll_init(&item->work, epoll_item_triggered);
+	sys_dlist_append(&ep->items, &item->node);
+	atomic_inc(&epoll_items_used);
+
+	return item;
+}
+
+static void epoll_item_free(struct zvfs_epoll_item *item)
+{
+	int err;
+
+	epoll_item_disarm(item);
+	sys_dlist_remove(&item->node);
+	atomic_dec(&epoll_items_used);
+
+	err = sys_bitarray_free(&epoll_items_bitarray, 1, item - epoll_items);
+	__ASSERT(err == 0, "sys_bitarray_free() failed: %d", err);
+}
+
+static struct zvfs_epoll_item *epoll_item_find(struct zvfs_epoll *ep, int fd)
+{
+	struct zvfs_epoll_item *item;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&ep->items, item, node) {
+		if (item->fd == fd) {
+			return item;
+		}
+	}
+
+	return NULL;
+}
+
+static int epoll_item_check(struct zvfs_epoll_item *item)
+{
+	struct zvfs_pollfd pfd = {
+		.fd = item->fd,
+		.events = item->event.events & ZVFS_EPOLL_POLL_EVENTS,
+	};
+
+	if (zvfs_poll_internal(&pfd, 1, K_NO_WAIT) < 0) {
+		return ZVFS_EPOLLERR;
+	}
+
+	if (pfd.revents & ZVFS_POLLNVAL) {
+		return ZVFS_EPOLLERR;
+	}
+
+	return pfd.revents;
+}
+
+/* Report the ready items, with the mutex of the epoll descriptor held. Only
+ * the items of the ready list are checked: the ones which turn out not to be
+ * ready are armed again, the ones which are reported are queued again, so
+ * that they are reported as long as they stay ready.
+ */
+static int epoll_collect(struct zvfs_epoll *ep, struct zvfs_epoll_event *events, int maxevents)
+{
+	struct zvfs_epoll_item *item;
+	sys_slist_t reported;
+	k_spinlock_key_t key;
+	sys_slist_t ready;
+	sys_snode_t *node;
+	int revents;
+	int count = 0;
+	int ret;
+
+	sys_slist_init(&reported);
+
+	key = k_spin_lock(&epoll_lock);
+	ready = ep->ready;
+	sys_slist_init(&ep->ready);
+	k_spin_unlock(&epoll_lock, key);
+
+	while (count < maxevents && (node = sys_slist_get(&ready)) != NULL) {
+		item = CONTAINER_OF(node, struct zvfs_epoll_item, ready_node);
+
+		key = k_spin_lock(&epoll_lock);
+		item->queued = false;
+		k_spin_unlock(&epoll_lock, key);
+
+		revents = item->disabled ? 0 : epoll_item_check(item);
+		if (revents == 0) {
+			ret = epoll_item_arm(item);
+			if (ret < 0) {
+				/* Let the application know it cannot be watched */
+				revents = ZVFS_EPOLLERR;
+			} else {
+				continue;
+			}
+		}
+
+		events[count].events = revents;
+		events[count].data = item->event.data;
+		count++;
+
+		if (item->event.events & ZVFS_EPOLLONESHOT) {
+			item->disabled = true;
+			continue;
+		}
+
+		key = k_spin_lock(&epoll_lock);
+		item->queued = true;
+		k_spin_unlock(&epoll_lock, key);
+
+		sys_slist_append(&reported, &item->ready_node);
+	}
+
+	/* Keep the ready list order: the items not checked for lack of space
+	 * first, then the ones queued meanwhile, then the reported ones.
+	 */
+	key = k_spin_lock(&epoll_lock);
+	sys_slist_merge_slist(&ready, &ep->ready);
+	sys_slist_merge_slist(&ready, &reported);
+	ep->ready = ready;
+	k_spin_unlock(&epoll_lock, key);
+
+	return count;
+}
+
+static struct zvfs_epoll *epoll_get(int epfd, struct k_mutex **lock)
+{
+	const struct fd_op_vtable *vtable;
+	struct zvfs_epoll *ep;
+
+	ep = zvfs_get_fd_obj_and_vtable(epfd, &vtable, lock);
+	if (ep == NULL) {
+		return NULL;
+	}
+
+	if (vtable != &zvfs_epoll_fd_vtable) {
+		errno = EINVAL;
+		return NULL;
+	}
+
+	return ep;
+}
+
+static ssize_t zvfs_epoll_read_op(void *obj, void *buf, size_t sz)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buf);
+	ARG_UNUSED(sz);
+
+	errno = EINVAL;
+	return -1;
+}
+
+static ssize_t zvfs_epoll_write_op(void *obj, const void *buf, size_t sz)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buf);
+	ARG_UNUSED(sz);
+
+	errno = EINVAL;
+	return -1;
+}
+
+static int zvfs_epoll_close_op(void *obj)
+{
+	struct zvfs_epoll *ep = obj;
+	struct zvfs_epoll_item *item;
+	struct zvfs_epoll_item *next;
+	int err;
+
+	/* note: zvfs_close() has already taken the mutex */
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&ep->items, item, next, node) {
+		epoll_item_free(item);
+	}
+
+	ep->in_use = false;
+
+	/* Wake up the threads waiting on the instance, they fail with EBADF */
+	k_sem_give(&ep->ready_sem);
+
+	err = sys_bitarray_free(&epolls_bitarray, 1, ep - epolls);
+	__ASSERT(err == 0, "sys_bitarray_free() failed: %d", err);
+
+	return 0;
+}
+
+static int zvfs_epoll_ioctl_op(void *obj, unsigned int request, va_list args)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(request);
+	ARG_UNUSED(args);
+
+	/* An epoll instance cannot be watched by poll() or by another one */
+	errno = EOPNOTSUPP;
+	return -1;
+}
+
+static const struct fd_op_vtable zvfs_epoll_fd_vtable = {
+	.read = zvfs_epoll_read_op,
+	.write = zvfs_epoll_write_op,
+	.close = zvfs_epoll_close_op,
+	.ioctl = zvfs_epoll_ioctl_op,
+};
+
+/* Called by zvfs_close() before the descriptor is closed */
+void zvfs_epoll_fd_closed(int fd)
+{
+	struct zvfs_epoll_item *item;
+	struct k_mutex *lock;
+
+	if (atomic_get(&epoll_items_used) == 0) {
+		return;
+	}
+
+	ARRAY_FOR_EACH_PTR(epolls, ep) {
+		if (!ep->in_use) {
+			continue;
+		}
+
+		if (ep->fd == fd || epoll_get(ep->fd, &lock) != ep) {
+			continue;
+		}
+
+		(void)k_mutex_lock(lock, K_FOREVER);
+
+		item = ep->in_use ? epoll_item_find(ep, fd) : NULL;
+		if (item != NULL) {
+			epoll_item_free(item);
+		}
+
+		k_mutex_unlock(lock);
+	}
+}
+
+/*
+ * Public-facing API
+ */
+
+int zvfs_epoll_create(int flags)
+{
+	struct zvfs_epoll *ep;
+	size_t offset;
+	int fd;
+
+	if (flags & ~ZVFS_EPOLL_CLOEXEC) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (sys_bitarray_alloc(&epolls_bitarray, 1, &offset) < 0) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	ep = &epolls[offset];
+
+	fd = zvfs_reserve_fd();
+	if (fd < 0) {
+		sys_bitarray_free(&epolls_bitarray, 1, offset);
+		return -1;
+	}
+
+	sys_dlist_init(&ep->items);
+	sys_slist_init(&ep->ready);
+	k_sem_init(&ep->ready_sem, 0, 1);
+	ep->fd = fd;
+	ep->in_use = true;
+
+	zvfs_finalize_fd(fd, ep, &zvfs_epoll_fd_vtable);
+
+	return fd;
+}
+
+int zvfs_epoll_ctl(int epfd, int op, int fd, struct zvfs_epoll_event *event)
+{
+	const struct fd_op_vtable *vtable;
+	struct zvfs_epoll_item *item;
+	struct k_mutex *lock;
+	struct zvfs_epoll *ep;
+	int ret = 0;
+
+	ep = epoll_get(epfd, &lock);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (zvfs_get_fd_obj_and_vtable(fd, &vtable, NULL) == NULL) {
+		return -1;
+	}
+
+	if (fd == epfd || vtable == &zvfs_epoll_fd_vtable) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (op != ZVFS_EPOLL_CTL_DEL) {
+		if (event == NULL) {
+			errno = EFAULT;
+			return -1;
+		}
+
+		if (event->events & ZVFS_EPOLLET) {
+			errno = EINVAL;
+			return -1;
+		}
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	item = epoll_item_find(ep, fd);
+
+	switch (op) {
+	case ZVFS_EPOLL_CTL_ADD:
+		if (item != NULL) {
+			ret = -EEXIST;
+			break;
+		}
+
+		item = epoll_item_alloc(ep, fd, event);
+		if (item == NULL) {
+			ret = -ENOSPC;
+			break;
+		}
+
+		ret = epoll_item_arm(item);
+		if (ret < 0) {
+			epoll_item_free(item);
+		}
+
+		break;
+
+	case ZVFS_EPOLL_CTL_MOD:
+		if (item == NULL) {
+			ret = -ENOENT;
+			break;
+		}
+
+		epoll_item_disarm(item);
+		item->event = *event;
+		item->disabled = false;
+		ret = epoll_item_arm(item);
+		break;
+
+	case ZVFS_EPOLL_CTL_DEL:
+		if (item == NULL) {
+			ret = -ENOENT;
+			break;
+		}
+
+		epoll_item_free(item);
+		break;
+
+	default:
+		ret = -EINVAL;
+		break;
+	}
+
+	k_mutex_unlock(lock);
+
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	return 0;
+}
+
+int zvfs_epoll_wait(int epfd, struct zvfs_epoll_event *events, int maxevents, int timeout)
+{
+	struct k_mutex *lock;
+	struct zvfs_epoll *ep;
+	k_timepoint_t end;
+	int ret;
+
+	if (maxevents <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (events == NULL) {
+		errno = EFAULT;
+		return -1;
+	}
+
+	ep = epoll_get(epfd, &lock);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	end = sys_timepoint_calc(timeout < 0 ? K_FOREVER : K_MSEC(timeout));
+
+	while (true) {
+		(void)k_mutex_lock(lock, K_FOREVER);
+
+		if (ep->in_use) {
+			ret = epoll_collect(ep, events, maxevents);
+		} else {
+			errno = EBADF;
+			ret = -1;
+		}
+
+		k_mutex_unlock(lock);
+
+		if (ret != 0) {
+			return ret;
+		}
+
+		if (k_sem_take(&ep->ready_sem, sys_timepoint_timeout(end)) != 0) {
+			return 0;
+		}
+	}
+}
@@ -26,6 +26,10 @@
 #include <zephyr/sys/atomic.h>
 #include <zephyr/fs/fs.h>
 
+#if defined(CONFIG_ZVFS_EPOLL)
+void zvfs_epoll_fd_closed(int fd);
+#endif
+
 K_MEM_SLAB_DEFINE(file_desc_slab, sizeof(struct fs_file_t), ZVFS_OPEN_SIZE, 4);
 
 struct fd_entry {
@@ -408,6 +412,10 @@ int zvfs_close(int fd)
 		return -1;
 	}
 
+	if (IS_ENABLED(CONFIG_ZVFS_EPOLL)) {
+		zvfs_epoll_fd_closed(fd);
+	}
+
 	(void)k_mutex_lock(&fdtable[fd].lock, K_FOREVER);
 	if (fdtable[fd].vtable->close != NULL) {
 		/* close() is optional - e.g. stdinout_fd_op_vtable */
@@ -73,7 +73,8 @@ from collections import OrderedDict
 #
 #  - The first item is None, or the name of a Kconfig that
 #    indicates the presence of this object's definition in case it is not
-#    available in all configurations.
+#    available in all configurations. A name prefixed with "!" indicates
+#    that the object is only present when that Kconfig is disabled.
 #
 #  - The second item is a boolean indicating whether it is permissible for
 #    the object to be located in user-accessible memory.
@@ -105,7 +106,7 @@ kobjects = OrderedDict(
         ("device", (None, False, False)),
         ("NET_SOCKET", (None, False, False)),
         ("net_if", (None, False, False)),
-        ("sys_mutex", (None, True, False)),
+        ("sys_mutex", ("!CONFIG_SYS_MUTEX_FUTEX", True, False)),
         ("k_futex", (None, True, False)),
         ("k_condvar", (None, False, True)),
         ("k_event", ("CONFIG_EVENTS", False, True)),
@@ -122,6 +123,23 @@ kobjects = OrderedDict(
 )
 
 
+def kobject_dep_met(dep, syms):
+    if dep is None:
+        return True
+
+    if dep.startswith("!"):
+        return dep[1:] not in syms
+
+    return dep in syms
+
+
+def kobject_dep_guard(dep):
+    if dep.startswith("!"):
+        return f"#ifndef {dep[1:]}\n"
+
+    return f"#ifdef {dep}\n"
+
+
 def kobject_to_enum(kobj):
     if kobj.startswith("k_") or kobj.startswith("z_"):
         name = kobj[2:]
@@ -534,6 +552,10 @@ def find_kobjects(elf, syms):
     if not elf.has_dwarf_info():
         sys.exit("ELF file has no DWARF information")
 
+    # Structures of types not enabled in this image are not kernel objects
+    for kobj in [kobj for kobj, (dep, _, _) in kobjects.items() if not kobject_dep_met(dep, syms)]:
+        del kobjects[kobj]
+
     app_smem_start = syms["_app_smem_start"]
     app_smem_end = syms["_app_smem_end"]
 
@@ -933,7 +955,7 @@ def write_kobj_types_output(fp):
             continue
 
         if dep:
-            fp.write(f"#ifdef {dep}\n")
+            fp.write(kobject_dep_guard(dep))
 
         fp.write(f"{kobject_to_enum(kobj)},\n")
 
@@ -954,7 +976,7 @@ def write_kobj_otype_output(fp):
             continue
 
         if dep:
-            fp.write(f"#ifdef {dep}\n")
+            fp.write(kobject_dep_guard(dep))
 
         fp.write(f'case {kobject_to_enum(kobj)}: ret = "{kobj}"; break;\n')
         if dep:
@@ -975,7 +997,7 @@ def write_kobj_size_output(fp):
             continue
 
         if dep:
-            fp.write(f"#ifdef {dep}\n")
+            fp.write(kobject_dep_guard(dep))
 
         fp.write(f'case {kobject_to_enum(kobj)}: ret = sizeof(struct {kobj}); break;\n')
         if dep:
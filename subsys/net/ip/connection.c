@@ -18,6 +18,7 @@ LOG_MODULE_REGISTER(net_conn, CONFIG_NET_CONN_LOG_LEVEL);
 
 #include <errno.h>
 #include <zephyr/sys/util.h>
+#include <zephyr/sys/hash_function.h>
 
 #include <zephyr/net/net_core.h>
 #include <zephyr/net/net_pkt.h>
@@ -113,6 +114,108 @@ void conn_register_debug(struct net_conn *conn,
 
 static K_MUTEX_DEFINE(conn_lock);
 
+#if defined(CONFIG_NET_CONN_HASH)
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_NET_CONN_HASH_BUCKETS),
+	     "CONFIG_NET_CONN_HASH_BUCKETS must be a power of two");
+
+/** Local port, remote port and remote address all specified */
+#define NET_CONN_CONNECTED (NET_CONN_LOCAL_PORT_SPEC | \
+			    NET_CONN_REMOTE_PORT_SPEC | \
+			    NET_CONN_REMOTE_ADDR_SPEC)
+
+/* UDP and TCP handlers are split in three sets, according to the part of
+ * a packet they look at, so that net_conn_input() only needs to look at
+ * one bucket of each set:
+ * - connected handlers, hashed on protocol, ports and remote address,
+ * - handlers bound to a local port, hashed on protocol and local port,
+ * - handlers accepting any local port.
+ * Handlers of other families are never matched by net_conn_input().
+ */
+static sys_slist_t conn_connected[CONFIG_NET_CONN_HASH_BUCKETS];
+static sys_slist_t conn_bound[CONFIG_NET_CONN_HASH_BUCKETS];
+static sys_slist_t conn_wildcard;
+
+struct conn_hash_key {
+	uint16_t proto;
+	uint16_t local_port;
+	uint16_t remote_port;
+	uint8_t remote_addr[sizeof(struct net_in6_addr)];
+};
+
+/* Ports are in network byte order, remote_addr may be NULL */
+static uint32_t conn_hash(uint16_t proto, uint16_t local_port,
+			  uint16_t remote_port, const uint8_t *remote_addr,
+			  size_t addr_len)
+{
+	struct conn_hash_key key = {
+		.proto = proto,
+		.local_port = local_port,
+		.remote_port = remote_port,
+	};
+
+	if (remote_addr != NULL) {
+		memcpy(key.remote_addr, remote_addr, addr_len);
+	}
+
+	return sys_hash32(&key, sizeof(key)) &
+		(CONFIG_NET_CONN_HASH_BUCKETS - 1);
+}
+
+static sys_slist_t *conn_hash_list(struct net_conn *conn)
+{
+	uint16_t local_port = net_sin(&conn->local_addr)->sin_port;
+	uint16_t remote_port = net_sin(&conn->remote_addr)->sin_port;
+
+	if (conn->family != NET_AF_INET && conn->family != NET_AF_INET6 &&
+	    conn->family != NET_AF_UNSPEC) {
+		return NULL;
+	}
+
+	if ((conn->flags & NET_CONN_LOCAL_PORT_SPEC) == 0) {
+		return &conn_wildcard;
+	}
+
+	if ((conn->flags & NET_CONN_CONNECTED) == NET_CONN_CONNECTED) {
+		if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		    conn->remote_addr.sa_family == NET_AF_INET6) {
+			return &conn_connected[conn_hash(
+				conn->proto, local_port, remote_port,
+				net_sin6(&conn->remote_addr)->sin6_addr.s6_addr,
+				sizeof(struct net_in6_addr))];
+		} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
+			   conn->remote_addr.sa_family == NET_AF_INET) {
+			return &conn_connected[conn_hash(
+				conn->proto, local_port, remote_port,
+				net_sin(&conn->remote_addr)->sin_addr.s4_addr,
+				sizeof(struct net_in_addr))];
+		}
+	}
+
+	return &conn_bound[conn_hash(conn->proto, local_port, 0, NULL, 0)];
+}
+
+/* Must be called with conn_lock held */
+static void conn_hash_add(struct net_conn *conn)
+{
+	conn->hash_list = conn_hash_list(conn);
+	if (conn->hash_list != NULL) {
+		sys_slist_prepend(conn->hash_list, &conn->hash_node);
+	}
+}
+
+/* Must be called with conn_lock held */
+static void conn_hash_remove(struct net_conn *conn)
+{
+	if (conn->hash_list != NULL) {
+		sys_slist_find_and_remove(conn->hash_list, &conn->hash_node);
+		conn->hash_list = NULL;
+	}
+}
+#else
+#define conn_hash_add(...)
+#define conn_hash_remove(...)
+#endif /* CONFIG_NET_CONN_HASH */
+
 static struct net_conn *conn_get_unused(void)
 {
 	sys_snode_t *node;
@@ -138,6 +241,7 @@ static void conn_set_used(struct net_conn *conn)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_prepend(&conn_used, &conn->node);
+	conn_hash_add(conn);
 	k_mutex_unlock(&conn_lock);
 }
 
@@ -463,6 +567,7 @@ int net_conn_unregister(struct net_conn_handle *handle)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_find_and_remove(&conn_used, &conn->node);
+	conn_hash_remove(conn);
 	k_mutex_unlock(&conn_lock);
 
 	conn_set_unused(conn);
@@ -489,15 +594,24 @@ int net_conn_update(struct net_conn_handle *handle,
 		return -ENOENT;
 	}
 
+	k_mutex_lock(&conn_lock, K_FOREVER);
+
+	/* The new addresses may move the connection to another lookup list */
+	conn_hash_remove(conn);
+
 	net_conn_change_callback(conn, cb, user_data);
 
 	ret = net_conn_change_local(conn, local_addr, local_port);
 	if (ret < 0) {
-		return ret;
+		goto out;
 	}
 
 	ret = net_conn_change_remote(conn, remote_addr, remote_port);
 
+out:
+	conn_hash_add(conn);
+	k_mutex_unlock(&conn_lock);
+
 	return ret;
 }
 
@@ -844,6 +958,140 @@ enum net_verdict net_conn_can_input(struct net_pkt *pkt, uint8_t proto)
 }
 #endif /* defined(CONFIG_NET_SOCKETS_CAN) */
 
+struct conn_input_match {
+	struct net_conn *best_match;
+	int16_t best_rank;
+	bool is_mcast_pkt;
+	bool mcast_pkt_delivered;
+};
+
+/* Match a candidate connection against a received UDP or TCP packet,
+ * keeping track of the best match, or delivering multicast packets to
+ * every match. Must be called with conn_lock held.
+ */
+static int conn_input_check(struct net_conn *conn, struct net_pkt *pkt,
+			    union net_ip_header *ip_hdr, uint8_t proto,
+			    union net_proto_header *proto_hdr,
+			    uint16_t src_port, uint16_t dst_port,
+			    struct conn_input_match *match)
+{
+	uint8_t pkt_family = net_pkt_family(pkt);
+
+	/* Is the candidate connection matching the packet's interface? */
+	if (!is_iface_matching(conn, pkt)) {
+		return 0; /* wrong interface */
+	}
+
+	/* Is the candidate connection matching the packet's protocol family? */
+	if (conn->family != NET_AF_UNSPEC && conn->family != pkt_family) {
+		if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
+			if (!(conn->family == NET_AF_INET6 && pkt_family == NET_AF_INET &&
+			      !conn->v6only && conn->type != NET_SOCK_RAW)) {
+				return 0;
+			}
+		} else {
+			return 0; /* wrong protocol family */
+		}
+
+		/* We might have a match for v4-to-v6 mapping, check more */
+	}
+
+	/* Is the candidate connection matching the packet's protocol within the family? */
+	if (conn->proto != proto) {
+		return 0; /* wrong protocol */
+	}
+
+	/* Apply protocol-specific matching criteria... */
+	uint8_t conn_family = conn->family;
+
+	if ((IS_ENABLED(CONFIG_NET_UDP) || IS_ENABLED(CONFIG_NET_TCP)) &&
+	    (conn_family == NET_AF_INET || conn_family == NET_AF_INET6 ||
+	     conn_family == NET_AF_UNSPEC)) {
+		/* Is the candidate connection matching the packet's TCP/UDP
+		 * address and port?
+		 */
+		if ((conn->flags & NET_CONN_REMOTE_PORT_SPEC) != 0 &&
+		    net_sin(&conn->remote_addr)->sin_port != src_port) {
+			return 0; /* wrong remote port */
+		}
+
+		if ((conn->flags & NET_CONN_LOCAL_PORT_SPEC) != 0 &&
+		    net_sin(&conn->local_addr)->sin_port != dst_port) {
+			return 0; /* wrong local port */
+		}
+
+		if ((conn->flags & NET_CONN_REMOTE_ADDR_SET) != 0 &&
+		    !conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
+			return 0; /* wrong remote address */
+		}
+
+		if ((conn->flags & NET_CONN_LOCAL_ADDR_SET) != 0 &&
+		    !conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
+
+			/* Check if we could do a v4-mapping-to-v6 and the IPv6 socket
+			 * has no IPV6_V6ONLY option set and if the local IPV6 address
+			 * is unspecified, then we could accept a connection from IPv4
+			 * address by mapping it to IPv6 address.
+			 */
+			if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
+				if (!(conn->family == NET_AF_INET6 &&
+				      pkt_family == NET_AF_INET &&
+				      !conn->v6only &&
+				      net_ipv6_is_addr_unspecified(
+					      &net_sin6(&conn->local_addr)->sin6_addr))) {
+					return 0; /* wrong local address */
+				}
+			} else {
+				return 0; /* wrong local address */
+			}
+
+			/* We might have a match for v4-to-v6 mapping,
+			 * continue with rank checking.
+			 */
+		}
+
+		if (match->best_rank < NET_CONN_RANK(conn->flags)) {
+			struct net_if *pkt_iface = net_pkt_iface(pkt);
+			struct net_pkt *mcast_pkt;
+
+			if (!match->is_mcast_pkt) {
+				match->best_rank = NET_CONN_RANK(conn->flags);
+				match->best_match = conn;
+
+				return 0; /* found a match - but maybe not yet the best */
+			}
+
+			/* If we have a multicast packet, and we found
+			 * a match, then deliver the packet immediately
+			 * to the handler. As there might be several
+			 * sockets interested about these, we need to
+			 * clone the received pkt.
+			 */
+
+			NET_DBG("[%p] mcast match found cb %p ud %p", conn, conn->cb,
+				conn->user_data);
+
+			mcast_pkt = net_pkt_clone(
+				pkt, K_MSEC(CONFIG_NET_CONN_PACKET_CLONE_TIMEOUT));
+			if (!mcast_pkt) {
+				return -ENOMEM;
+			}
+
+			if (conn->cb(conn, mcast_pkt, ip_hdr, proto_hdr, conn->user_data) ==
+			    NET_DROP) {
+				net_stats_update_per_proto_drop(pkt_iface, proto);
+				net_pkt_unref(mcast_pkt);
+			} else {
+				net_stats_update_per_proto_recv(pkt_iface, proto);
+			}
+
+			match->mcast_pkt_delivered = true;
+		}
+	}
+
+	return 0;
+}
+
 enum net_verdict net_conn_input(struct net_pkt *pkt,
 				union net_ip_header *ip_hdr,
 				uint8_t proto,
@@ -884,10 +1132,11 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		" family %d", net_proto2str(net_pkt_family(pkt), proto), pkt,
 		net_ntohs(src_port), net_ntohs(dst_port), net_pkt_family(pkt));
 
-	struct net_conn *best_match = NULL;
-	int16_t best_rank = -1;
-	bool is_mcast_pkt = false;
-	bool mcast_pkt_delivered = false;
+	struct conn_input_match match = {
+		.best_match = NULL,
+		.best_rank = -1,
+	};
+	struct net_conn *best_match;
 	bool is_bcast_pkt = false;
 	struct net_conn *conn;
 	net_conn_cb_t cb = NULL;
@@ -898,131 +1147,57 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 	 */
 	if (IS_ENABLED(CONFIG_NET_IPV4) && pkt_family == NET_AF_INET) {
 		if (net_ipv4_is_addr_mcast_raw(ip_hdr->ipv4->dst)) {
-			is_mcast_pkt = true;
+			match.is_mcast_pkt = true;
 		} else if (net_if_ipv4_is_addr_bcast_raw(pkt_iface,
 							 ip_hdr->ipv4->dst)) {
 			is_bcast_pkt = true;
 		}
 	} else if (IS_ENABLED(CONFIG_NET_IPV6) && pkt_family == NET_AF_INET6) {
-		is_mcast_pkt = net_ipv6_is_addr_mcast_raw(ip_hdr->ipv6->dst);
+		match.is_mcast_pkt = net_ipv6_is_addr_mcast_raw(ip_hdr->ipv6->dst);
 	}
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
-		/* Is the candidate connection matching the packet's interface? */
-		if (!is_iface_matching(conn, pkt)) {
-			continue; /* wrong interface */
-		}
+#if defined(CONFIG_NET_CONN_HASH)
+	const uint8_t *src_addr = NULL;
+	size_t src_addr_len = 0;
 
-		/* Is the candidate connection matching the packet's protocol family? */
-		if (conn->family != NET_AF_UNSPEC && conn->family != pkt_family) {
-			if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
-				if (!(conn->family == NET_AF_INET6 && pkt_family == NET_AF_INET &&
-				      !conn->v6only && conn->type != NET_SOCK_RAW)) {
-					continue;
-				}
-			} else {
-				continue; /* wrong protocol family */
-			}
-
-			/* We might have a match for v4-to-v6 mapping, check more */
-		}
-
-		/* Is the candidate connection matching the packet's protocol within the family? */
-		if (conn->proto != proto) {
-			continue; /* wrong protocol */
-		}
-
-		/* Apply protocol-specific matching criteria... */
-		uint8_t conn_family = conn->family;
-
-		if ((IS_ENABLED(CONFIG_NET_UDP) || IS_ENABLED(CONFIG_NET_TCP)) &&
-		    (conn_family == NET_AF_INET || conn_family == NET_AF_INET6 ||
-		     conn_family == NET_AF_UNSPEC)) {
-			/* Is the candidate connection matching the packet's TCP/UDP
-			 * address and port?
-			 */
-			if ((conn->flags & NET_CONN_REMOTE_PORT_SPEC) != 0 &&
-			    net_sin(&conn->remote_addr)->sin_port != src_port) {
-				continue; /* wrong remote port */
-			}
-
-			if ((conn->flags & NET_CONN_LOCAL_PORT_SPEC) != 0 &&
-			    net_sin(&conn->local_addr)->sin_port != dst_port) {
-				continue; /* wrong local port */
-			}
-
-			if ((conn->flags & NET_CONN_REMOTE_ADDR_SET) != 0 &&
-			    !conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
-				continue; /* wrong remote address */
-			}
-
-			if ((conn->flags & NET_CONN_LOCAL_ADDR_SET) != 0 &&
-			    !conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
-
-				/* Check if we could do a v4-mapping-to-v6 and the IPv6 socket
-				 * has no IPV6_V6ONLY option set and if the local IPV6 address
-				 * is unspecified, then we could accept a connection from IPv4
-				 * address by mapping it to IPv6 address.
-				 */
-				if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
-					if (!(conn->family == NET_AF_INET6 &&
-					      pkt_family == NET_AF_INET &&
-					      !conn->v6only &&
-					      net_ipv6_is_addr_unspecified(
-						      &net_sin6(&conn->local_addr)->sin6_addr))) {
-						continue; /* wrong local address */
-					}
-				} else {
-					continue; /* wrong local address */
-				}
-
-				/* We might have a match for v4-to-v6 mapping,
-				 * continue with rank checking.
-				 */
-			}
-
-			if (best_rank < NET_CONN_RANK(conn->flags)) {
-				struct net_pkt *mcast_pkt;
-
-				if (!is_mcast_pkt) {
-					best_rank = NET_CONN_RANK(conn->flags);
-					best_match = conn;
-
-					continue; /* found a match - but maybe not yet the best */
-				}
-
-				/* If we have a multicast packet, and we found
-				 * a match, then deliver the packet immediately
-				 * to the handler. As there might be several
-				 * sockets interested about these, we need to
-				 * clone the received pkt.
-				 */
-
-				NET_DBG("[%p] mcast match found cb %p ud %p", conn, conn->cb,
-					conn->user_data);
-
-				mcast_pkt = net_pkt_clone(
-					pkt, K_MSEC(CONFIG_NET_CONN_PACKET_CLONE_TIMEOUT));
-				if (!mcast_pkt) {
-					k_mutex_unlock(&conn_lock);
-					goto drop;
-				}
-
-				if (conn->cb(conn, mcast_pkt, ip_hdr, proto_hdr, conn->user_data) ==
-				    NET_DROP) {
-					net_stats_update_per_proto_drop(pkt_iface, proto);
-					net_pkt_unref(mcast_pkt);
-				} else {
-					net_stats_update_per_proto_recv(pkt_iface, proto);
-				}
+	if (IS_ENABLED(CONFIG_NET_IPV6) && pkt_family == NET_AF_INET6) {
+		src_addr = ip_hdr->ipv6->src;
+		src_addr_len = sizeof(struct net_in6_addr);
+	} else if (IS_ENABLED(CONFIG_NET_IPV4) && pkt_family == NET_AF_INET) {
+		src_addr = ip_hdr->ipv4->src;
+		src_addr_len = sizeof(struct net_in_addr);
+	}
 
-				mcast_pkt_delivered = true;
+	/* Only these lists can hold handlers accepting this packet */
+	sys_slist_t *lists[] = {
+		&conn_connected[conn_hash(proto, dst_port, src_port,
+					  src_addr, src_addr_len)],
+		&conn_bound[conn_hash(proto, dst_port, 0, NULL, 0)],
+		&conn_wildcard,
+	};
+
+	ARRAY_FOR_EACH(lists, i) {
+		SYS_SLIST_FOR_EACH_CONTAINER(lists[i], conn, hash_node) {
+			if (conn_input_check(conn, pkt, ip_hdr, proto, proto_hdr,
+					     src_port, dst_port, &match) < 0) {
+				k_mutex_unlock(&conn_lock);
+				goto drop;
 			}
 		}
-	} /* loop end */
+	}
+#else
+	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
+		if (conn_input_check(conn, pkt, ip_hdr, proto, proto_hdr,
+				     src_port, dst_port, &match) < 0) {
+			k_mutex_unlock(&conn_lock);
+			goto drop;
+		}
+	}
+#endif /* CONFIG_NET_CONN_HASH */
 
+	best_match = match.best_match;
 	if (best_match != NULL) {
 		cb = best_match->cb;
 		user_data = best_match->user_data;
@@ -1030,7 +1205,7 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 
 	k_mutex_unlock(&conn_lock);
 
-	if (is_mcast_pkt && mcast_pkt_delivered) {
+	if (match.is_mcast_pkt && match.mcast_pkt_delivered) {
 		/* As one or more multicast packets
 		 * have already been delivered in the loop above,
 		 * we shall not call the callback again here.
@@ -1056,7 +1231,7 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 	NET_DBG("No match found.");
 
 	if ((pkt_family == NET_AF_INET || pkt_family == NET_AF_INET6) &&
-	    !(is_mcast_pkt || is_bcast_pkt)) {
+	    !(match.is_mcast_pkt || is_bcast_pkt)) {
 		if (IS_ENABLED(CONFIG_NET_TCP) && proto == NET_IPPROTO_TCP &&
 		    IS_ENABLED(CONFIG_NET_TCP_REJECT_CONN_WITH_RST)) {
 			net_tcp_reply_rst(pkt);
@@ -1095,4 +1270,13 @@ void net_conn_init(void)
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
 	}
+
+#if defined(CONFIG_NET_CONN_HASH)
+	for (i = 0; i < CONFIG_NET_CONN_HASH_BUCKETS; i++) {
+		sys_slist_init(&conn_connected[i]);
+		sys_slist_init(&conn_bound[i]);
+	}
+
+	sys_slist_init(&conn_wildcard);
+#endif /* CONFIG_NET_CONN_HASH */
 }
@@ -54,6 +54,14 @@ struct net_conn {
 	/** Internal slist node */
 	sys_snode_t node;
 
+#if defined(CONFIG_NET_CONN_HASH)
+	/** Internal slist node in the lookup hash tables */
+	sys_snode_t hash_node;
+
+	/** Lookup list the connection is in, if any */
+	sys_slist_t *hash_list;
+#endif
+
 	/** Remote socket address */
 	struct net_sockaddr remote_addr;
 
@@ -302,6 +302,10 @@ static inline void nbr_free(struct net_nbr *nbr)
 	net_ipv6_nbr_data(nbr)->reachable = 0;
 	net_ipv6_nbr_data(nbr)->reachable_timeout = 0;
 
+	if (nbr->idx != NET_NBR_LLADDR_UNKNOWN) {
+		net_fastpath_flush_lladdr(nbr->iface, net_nbr_get_lladdr(nbr->idx));
+	}
+
 	net_nbr_unref(nbr);
 	net_nbr_unlink(nbr, NULL);
 }
@@ -669,6 +673,7 @@ struct net_nbr *net_ipv6_nbr_add(struct net_if *iface,
 		if (memcmp(cached_lladdr->addr, lladdr->addr, lladdr->len)) {
 			dbg_update_neighbor_lladdr(lladdr, cached_lladdr, addr);
 
+			net_fastpath_flush_lladdr(iface, cached_lladdr);
 			net_linkaddr_set(cached_lladdr, (uint8_t *)lladdr->addr,
 					 lladdr->len);
 
@@ -855,9 +860,10 @@ enum net_verdict net_ipv6_prepare_for_send(struct net_pkt *pkt)
 
 #if defined(CONFIG_NET_IPV6_FRAGMENT)
 	/* If we have already fragmented the packet, the fragment id will
-	 * contain a proper value and we can skip other checks.
+	 * contain a proper value and we can skip other checks. A TCP
+	 * super-segment is split into segments, not fragments.
 	 */
-	if (net_pkt_ipv6_fragment_id(pkt) == 0U) {
+	if (net_pkt_ipv6_fragment_id(pkt) == 0U && net_pkt_gso_size(pkt) == 0U) {
 		size_t pkt_len = net_pkt_get_len(pkt);
 		uint16_t mtu;
 
@@ -1777,6 +1783,7 @@ static inline bool handle_na_neighbor(struct net_pkt *pkt,
 			dbg_update_neighbor_lladdr_raw(
 				lladdr.addr, cached_lladdr, na_tgt);
 
+			net_fastpath_flush_lladdr(net_pkt_iface(pkt), cached_lladdr);
 			net_linkaddr_set(cached_lladdr, lladdr.addr,
 					 cached_lladdr->len);
 		}
@@ -1821,6 +1828,7 @@ static inline bool handle_na_neighbor(struct net_pkt *pkt,
 			dbg_update_neighbor_lladdr_raw(
 				lladdr.addr, cached_lladdr, na_tgt);
 
+			net_fastpath_flush_lladdr(net_pkt_iface(pkt), cached_lladdr);
 			net_linkaddr_set(cached_lladdr, lladdr.addr,
 					 cached_lladdr->len);
 		}
@@ -635,6 +635,13 @@ int net_context_get(net_sa_family_t family, enum net_sock_type type, uint16_t pr
 
 		k_mutex_init(&contexts[i].lock);
 
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+		k_poll_signal_init(&contexts[i].zc.signal);
+#endif
+#if defined(CONFIG_NET_SOCKETS)
+		contexts[i].generation++;
+#endif
+
 		contexts[i].flags |= NET_CONTEXT_IN_USE;
 		*context = &contexts[i];
 
@@ -1956,6 +1963,20 @@ static int get_context_recv_hoplimit(struct net_context *context,
 #endif
 }
 
+static int get_context_zerocopy(struct net_context *context,
+				void *value, uint32_t *len)
+{
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+	return get_bool_option(context->options.zerocopy, value, len);
+#else
+	ARG_UNUSED(context);
+	ARG_UNUSED(value);
+	ARG_UNUSED(len);
+
+	return -ENOTSUP;
+#endif
+}
+
 static int get_context_addr_preferences(struct net_context *context,
 					void *value, uint32_t *len)
 {
@@ -2157,6 +2178,46 @@ static int context_write_data(struct net_pkt *pkt, const void *buf,
 	return ret;
 }
 
+/* Same as context_write_data(), but the data is referenced by buffers
+ * appended to net_pkt instead of being copied.
+ */
+static int context_attach_data(struct net_pkt *pkt, struct net_buf *zc_send,
+			       const void *buf, int buf_len,
+			       const struct net_msghdr *msghdr)
+{
+	struct net_buf *frag;
+
+	if (msghdr) {
+		int i;
+
+		for (i = 0; i < msghdr->msg_iovlen && buf_len > 0; i++) {
+			int len = MIN(msghdr->msg_iov[i].iov_len, buf_len);
+
+			if (len == 0) {
+				continue;
+			}
+
+			frag = net_zc_tx_buf_get(zc_send, msghdr->msg_iov[i].iov_base,
+						 len, PKT_WAIT_TIME);
+			if (frag == NULL) {
+				return -ENOBUFS;
+			}
+
+			net_pkt_append_buffer(pkt, frag);
+			buf_len -= len;
+		}
+	} else if (buf_len > 0) {
+		frag = net_zc_tx_buf_get(zc_send, buf, buf_len, PKT_WAIT_TIME);
+		if (frag == NULL) {
+			return -ENOBUFS;
+		}
+
+		net_pkt_append_buffer(pkt, frag);
+	}
+
+	return 0;
+}
+
 static int context_setup_udp_packet(struct net_context *context,
 				    net_sa_family_t family,
 				    struct net_pkt *pkt,
@@ -2164,7 +2225,8 @@ static int context_setup_udp_packet(struct net_context *context,
 				    size_t len,
 				    const struct net_msghdr *msg,
 				    const struct net_sockaddr *dst_addr,
-				    net_socklen_t addrlen)
+				    net_socklen_t addrlen,
+				    struct net_buf *zc_send)
 {
 	int ret = -EINVAL;
 	uint16_t dst_port = 0U;
@@ -2202,7 +2264,12 @@ static int context_setup_udp_packet(struct net_context *context,
 		return ret;
 	}
 
-	ret = context_write_data(pkt, buf, len, msg);
+	if (zc_send != NULL) {
+		ret = context_attach_data(pkt, zc_send, buf, len, msg);
+	} else {
+		ret = context_write_data(pkt, buf, len, msg);
+	}
+
 	if (ret) {
 		return ret;
 	}
@@ -2390,9 +2457,12 @@ static int context_sendto(struct net_context *context,
 			  net_context_send_cb_t cb,
 			  k_timeout_t timeout,
 			  void *user_data,
+			  int flags,
 			  bool sendto)
 {
 	const struct net_msghdr *msghdr = NULL;
+	struct net_buf *zc_send = NULL;
+	struct net_buf *zc_data = NULL;
 	struct net_if *iface = NULL;
 	struct net_pkt *pkt = NULL;
 	net_sa_family_t family;
@@ -2682,20 +2752,44 @@ static int context_sendto(struct net_context *context,
 	context->send_cb = cb;
 	context->user_data = user_data;
 
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+	if ((flags & ZSOCK_MSG_ZEROCOPY) && context->options.zerocopy) {
+		zc_send = net_zc_tx_start(context);
+		if (zc_send == NULL) {
+			return -ENOBUFS;
+		}
+
+		/* An offloaded stack gets a copy of the data */
+		if (!net_if_is_ip_offloaded(net_context_get_iface(context))) {
+			zc_data = zc_send;
+		}
+	}
+#else
+	ARG_UNUSED(flags);
+#endif
+
 	if (IS_ENABLED(CONFIG_NET_TCP) &&
 	    net_context_get_proto(context) == NET_IPPROTO_TCP &&
 	    !net_if_is_ip_offloaded(net_context_get_iface(context))) {
 		goto skip_alloc;
 	}
 
-	pkt = context_alloc_pkt(context, family, len, PKT_WAIT_TIME);
+	/* Zero-copy data is appended to the packet instead of being written */
+	pkt = context_alloc_pkt(context, family, zc_data != NULL ? 0 : len,
+				PKT_WAIT_TIME);
 	if (!pkt) {
 		NET_ERR("Failed to allocate net_pkt");
-		return -ENOBUFS;
+		ret = -ENOBUFS;
+		goto fail;
+	}
+
+	if (zc_data != NULL) {
+		tmp_len = len;
+	} else {
+		tmp_len = net_pkt_available_payload_buffer(
+					pkt, net_context_get_proto(context));
 	}
 
-	tmp_len = net_pkt_available_payload_buffer(
-				pkt, net_context_get_proto(context));
 	if (tmp_len < len) {
 		if (net_context_get_type(context) == NET_SOCK_DGRAM ||
 		    net_context_get_type(context) == NET_SOCK_RAW) {
@@ -2762,7 +2856,7 @@ skip_alloc:
 	} else if (IS_ENABLED(CONFIG_NET_UDP) &&
 	    net_context_get_proto(context) == NET_IPPROTO_UDP) {
 		ret = context_setup_udp_packet(context, family, pkt, buf, len, msghdr,
-					       dst_addr, addrlen);
+					       dst_addr, addrlen, zc_data);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -2773,7 +2867,7 @@ skip_alloc:
 	} else if (IS_ENABLED(CONFIG_NET_TCP) &&
 		   net_context_get_proto(context) == NET_IPPROTO_TCP) {
 
-		ret = net_tcp_queue(context, buf, len, msghdr);
+		ret = net_tcp_queue(context, buf, len, msghdr, zc_data);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -2828,12 +2922,16 @@ skip_alloc:
 		goto fail;
 	}
 
+	net_zc_tx_finish(context, zc_send, true, zc_data == NULL);
+
 	return len;
 fail:
 	if (pkt != NULL) {
 		net_pkt_unref(pkt);
 	}
 
+	net_zc_tx_finish(context, zc_send, false, false);
+
 	return ret;
 }
 
@@ -2955,7 +3053,7 @@ int net_context_send(struct net_context *context,
 	}
 
 	ret = context_sendto(context, buf, len, &context->remote,
-			     addrlen, cb, timeout, user_data, false);
+			     addrlen, cb, timeout, user_data, 0, false);
 unlock:
 	k_mutex_unlock(&context->lock);
 
@@ -2974,7 +3072,7 @@ int net_context_sendmsg(struct net_context *context,
 	k_mutex_lock(&context->lock, K_FOREVER);
 
 	ret = context_sendto(context, msghdr, 0, NULL, 0,
-			     cb, timeout, user_data, true);
+			     cb, timeout, user_data, flags, true);
 
 	k_mutex_unlock(&context->lock);
 
@@ -2995,7 +3093,7 @@ int net_context_sendto(struct net_context *context,
 	k_mutex_lock(&context->lock, K_FOREVER);
 
 	ret = context_sendto(context, buf, len, dst_addr, addrlen,
-			     cb, timeout, user_data, true);
+			     cb, timeout, user_data, 0, true);
 
 	k_mutex_unlock(&context->lock);
 
@@ -3794,6 +3892,27 @@ static int set_context_recv_hoplimit(struct net_context *context,
 #endif
 }
 
+static int set_context_zerocopy(struct net_context *context,
+				const void *value, uint32_t len)
+{
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+	if ((net_context_get_type(context) == NET_SOCK_DGRAM &&
+	     net_context_get_proto(context) == NET_IPPROTO_UDP) ||
+	    (net_context_get_type(context) == NET_SOCK_STREAM &&
+	     net_context_get_proto(context) == NET_IPPROTO_TCP)) {
+		return set_bool_option(&context->options.zerocopy, value, len);
+	}
+
+	return -ENOTSUP;
+#else
+	ARG_UNUSED(context);
+	ARG_UNUSED(value);
+	ARG_UNUSED(len);
+
+	return -ENOTSUP;
+#endif
+}
+
 static int set_context_addr_preferences(struct net_context *context,
 					const void *value, uint32_t len)
 {
@@ -4021,6 +4140,9 @@ int net_context_set_option(struct net_context *context,
 	case NET_OPT_RECV_HOPLIMIT:
 		ret = set_context_recv_hoplimit(context, value, len);
 		break;
+	case NET_OPT_ZEROCOPY:
+		ret = set_context_zerocopy(context, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&context->lock);
@@ -4115,6 +4237,9 @@ int net_context_get_option(struct net_context *context,
 	case NET_OPT_RECV_HOPLIMIT:
 		ret = get_context_recv_hoplimit(context, value, len);
 		break;
+	case NET_OPT_ZEROCOPY:
+		ret = get_context_zerocopy(context, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&context->lock);
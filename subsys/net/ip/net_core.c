@@ -493,6 +493,10 @@ static void net_rx(struct net_if *iface, struct net_pkt *pkt)
 	net_stats_update_bytes_recv(iface, pkt_len);
 	conn_mgr_if_used(iface);
 
+	if (net_fastpath_input(pkt) == NET_OK) {
+		return;
+	}
+
 	if (IS_ENABLED(CONFIG_NET_LOOPBACK)) {
 #ifdef CONFIG_NET_L2_DUMMY
 		if (net_if_l2(iface) == &NET_L2_GET_NAME(DUMMY)) {
@@ -0,0 +1,277 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Fast path forwarding. Once net_route_packet() has forwarded an IPv6
+ * packet between two Ethernet interfaces, its flow is remembered with the
+ * egress interface and the link layer address of the next hop. The next
+ * packets of the flow are then forwarded as soon as they are received: their
+ * hop limit is decremented and they are queued to the egress interface,
+ * which writes the new Ethernet header, without going through the IP input
+ * processing and the route lookup. The IPv4 packets translated by NAPT44 are
+ * forwarded the same way.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_fastpath, CONFIG_NET_FASTPATH_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <string.h>
+
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/ethernet_bridge.h>
+#include <zephyr/sys/hash_function.h>
+
+#include "net_private.h"
+
+#if defined(CONFIG_NET_ROUTING)
+struct fastpath_flow_key {
+	struct net_if *iface;
+	uint8_t src[NET_IPV6_ADDR_SIZE];
+	uint8_t dst[NET_IPV6_ADDR_SIZE];
+};
+
+struct fastpath_flow {
+	/* Ingress interface and addresses, the interface is NULL if unused */
+	struct fastpath_flow_key key;
+	struct net_if *iface;
+	struct net_eth_addr lladdr;
+	uint32_t last_used;
+};
+
+static struct fastpath_flow flows[CONFIG_NET_FASTPATH_FLOW_COUNT];
+static struct k_spinlock flows_lock;
+#endif /* CONFIG_NET_ROUTING */
+
+static bool is_ethernet(struct net_if *iface)
+{
+	return iface != NULL && net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET);
+}
+
+enum net_verdict net_fastpath_send(struct net_pkt *pkt, struct net_if *iface,
+				   uint8_t family, uint16_t ptype,
+				   const struct net_eth_addr *lladdr, size_t len)
+{
+	net_buf_pull(pkt->buffer, sizeof(struct net_eth_hdr));
+
+	/* Remove the padding of short Ethernet frames */
+	if (net_pkt_get_len(pkt) > len && net_pkt_update_length(pkt, len) < 0) {
+		net_pkt_unref(pkt);
+		return NET_OK;
+	}
+
+	net_pkt_set_family(pkt, family);
+	net_pkt_set_ll_proto_type(pkt, ptype);
+	net_pkt_set_orig_iface(pkt, net_pkt_iface(pkt));
+	net_pkt_set_iface(pkt, iface);
+	net_pkt_set_forwarding(pkt, true);
+
+	(void)net_linkaddr_copy(net_pkt_lladdr_src(pkt), net_if_get_link_addr(iface));
+
+	/* Without a next hop, the IPv4 destination is resolved by ARP */
+	if (lladdr != NULL) {
+		(void)net_linkaddr_set(net_pkt_lladdr_dst(pkt), lladdr->addr,
+				       sizeof(struct net_eth_addr));
+	} else {
+		net_pkt_lladdr_dst(pkt)->len = 0U;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	net_if_try_queue_tx(iface, pkt, K_NO_WAIT);
+
+	return NET_OK;
+}
+
+#if defined(CONFIG_NET_ROUTING)
+static bool flow_is_expired(struct fastpath_flow *flow, uint32_t now)
+{
+	return now - flow->last_used > CONFIG_NET_FASTPATH_FLOW_TIMEOUT * MSEC_PER_SEC;
+}
+
+static struct fastpath_flow *flow_slot(const struct fastpath_flow_key *key)
+{
+	return &flows[sys_hash32(key, sizeof(*key)) % CONFIG_NET_FASTPATH_FLOW_COUNT];
+}
+
+static void flow_key_init(struct fastpath_flow_key *key, struct net_if *iface,
+			  const struct net_ipv6_hdr *hdr)
+{
+	key->iface = iface;
+	memcpy(key->src, hdr->src, sizeof(key->src));
+	memcpy(key->dst, hdr->dst, sizeof(key->dst));
+}
+
+static bool flow_get(const struct fastpath_flow_key *key, struct net_if **iface,
+		     struct net_eth_addr *lladdr)
+{
+	struct fastpath_flow *flow = flow_slot(key);
+	k_spinlock_key_t lock = k_spin_lock(&flows_lock);
+	uint32_t now = k_uptime_get_32();
+	bool found = false;
+
+	if (flow->key.iface == NULL || memcmp(&flow->key, key, sizeof(*key)) != 0) {
+		goto out;
+	}
+
+	if (flow_is_expired(flow, now)) {
+		flow->key.iface = NULL;
+		goto out;
+	}
+
+	flow->last_used = now;
+	*iface = flow->iface;
+	*lladdr = flow->lladdr;
+	found = true;
+
+out:
+	k_spin_unlock(&flows_lock, lock);
+
+	return found;
+}
+
+void net_fastpath_learn(struct net_pkt *pkt, const struct net_linkaddr *lladdr)
+{
+	struct net_ipv6_hdr *hdr = NET_IPV6_HDR(pkt);
+	struct fastpath_flow_key key;
+	struct fastpath_flow *flow;
+	k_spinlock_key_t lock;
+
+	if (net_pkt_family(pkt) != NET_AF_INET6 ||
+	    !is_ethernet(net_pkt_orig_iface(pkt)) || !is_ethernet(net_pkt_iface(pkt)) ||
+	    lladdr->len != sizeof(struct net_eth_addr) ||
+	    pkt->frags->len < sizeof(struct net_ipv6_hdr) ||
+	    hdr->nexthdr == NET_IPV6_NEXTHDR_HBHO) {
+		return;
+	}
+
+	flow_key_init(&key, net_pkt_orig_iface(pkt), hdr);
+	flow = flow_slot(&key);
+
+	lock = k_spin_lock(&flows_lock);
+
+	flow->key = key;
+	flow->iface = net_pkt_iface(pkt);
+	memcpy(&flow->lladdr, lladdr->addr, sizeof(flow->lladdr));
+	flow->last_used = k_uptime_get_32();
+
+	k_spin_unlock(&flows_lock, lock);
+
+	NET_DBG("Flow %s -> %s from iface %d to %d",
+		net_sprint_ipv6_addr(hdr->src), net_sprint_ipv6_addr(hdr->dst),
+		net_if_get_by_iface(key.iface), net_if_get_by_iface(net_pkt_iface(pkt)));
+}
+
+void net_fastpath_flush(const struct net_in6_addr *prefix, uint8_t prefix_len)
+{
+	k_spinlock_key_t lock = k_spin_lock(&flows_lock);
+
+	ARRAY_FOR_EACH(flows, i) {
+		if (net_ipv6_is_prefix(flows[i].key.dst, prefix->s6_addr, prefix_len)) {
+			flows[i].key.iface = NULL;
+		}
+	}
+
+	k_spin_unlock(&flows_lock, lock);
+}
+
+void net_fastpath_flush_lladdr(struct net_if *iface, const struct net_linkaddr *lladdr)
+{
+	k_spinlock_key_t lock;
+
+	if (lladdr->len != sizeof(struct net_eth_addr)) {
+		return;
+	}
+
+	lock = k_spin_lock(&flows_lock);
+
+	ARRAY_FOR_EACH(flows, i) {
+		if (flows[i].key.iface != NULL && flows[i].iface == iface &&
+		    memcmp(&flows[i].lladdr, lladdr->addr, sizeof(flows[i].lladdr)) == 0) {
+			flows[i].key.iface = NULL;
+		}
+	}
+
+	k_spin_unlock(&flows_lock, lock);
+}
+
+static enum net_verdict fastpath_ipv6(struct net_pkt *pkt, size_t len)
+{
+	struct net_ipv6_hdr *hdr;
+	struct fastpath_flow_key key;
+	struct net_eth_addr lladdr;
+	struct net_if *iface;
+	size_t ip_len;
+
+	if (pkt->buffer->len < sizeof(struct net_eth_hdr) + sizeof(struct net_ipv6_hdr)) {
+		return NET_CONTINUE;
+	}
+
+	hdr = (struct net_ipv6_hdr *)(pkt->buffer->data + sizeof(struct net_eth_hdr));
+	ip_len = sizeof(struct net_ipv6_hdr) + net_ntohs(hdr->len);
+
+	/* The packets whose hop limit expires and the ones whose options
+	 * must be processed by every router are left to the slow path.
+	 */
+	if ((hdr->vtc & 0xf0) != 0x60 || ip_len > len || hdr->hop_limit <= 1U ||
+	    hdr->nexthdr == NET_IPV6_NEXTHDR_HBHO) {
+		return NET_CONTINUE;
+	}
+
+	flow_key_init(&key, net_pkt_iface(pkt), hdr);
+
+	if (!flow_get(&key, &iface, &lladdr) || !net_if_is_up(iface)) {
+		return NET_CONTINUE;
+	}
+
+	hdr->hop_limit--;
+
+	return net_fastpath_send(pkt, iface, NET_AF_INET6, NET_ETH_PTYPE_IPV6, &lladdr, ip_len);
+}
+#else
+static inline enum net_verdict fastpath_ipv6(struct net_pkt *pkt, size_t len)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(len);
+
+	return NET_CONTINUE;
+}
+#endif /* CONFIG_NET_ROUTING */
+
+enum net_verdict net_fastpath_input(struct net_pkt *pkt)
+{
+	struct net_if *iface = net_pkt_iface(pkt);
+	struct net_buf *buf = pkt->buffer;
+	struct net_eth_hdr *hdr;
+	size_t len;
+
+	if (buf == NULL || net_pkt_is_l2_processed(pkt) || !is_ethernet(iface) ||
+	    net_pkt_vlan_tag(pkt) != NET_VLAN_TAG_UNSPEC ||
+	    net_eth_iface_is_bridged(net_if_l2_data(iface)) ||
+	    buf->len < sizeof(struct net_eth_hdr)) {
+		return NET_CONTINUE;
+	}
+
+	hdr = (struct net_eth_hdr *)buf->data;
+
+	/* Only the frames sent to the router itself can be forwarded */
+	if (memcmp(&hdr->dst, net_if_get_link_addr(iface)->addr, sizeof(hdr->dst)) != 0) {
+		return NET_CONTINUE;
+	}
+
+	len = net_pkt_get_len(pkt) - sizeof(struct net_eth_hdr);
+
+	switch (net_ntohs(hdr->type)) {
+	case NET_ETH_PTYPE_IPV6:
+		return fastpath_ipv6(pkt, len);
+	case NET_ETH_PTYPE_IP:
+		return net_napt44_input(pkt, len);
+	default:
+		return NET_CONTINUE;
+	}
+}
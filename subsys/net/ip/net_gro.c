@@ -0,0 +1,316 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Generic receive offload. The in-order TCP segments of a connection that
+ * wait in a receive traffic class queue are merged into the first of them,
+ * which then goes through the L2, IP and TCP input code alone.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tc, CONFIG_NET_TC_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <string.h>
+
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/ethernet.h>
+
+#include "net_private.h"
+#include "tcp_internal.h"
+
+/* Headers of a segment, all of them held by the first buffer of the frame */
+struct gro_seg {
+	struct net_eth_hdr *eth;
+	union {
+		struct net_ipv4_hdr *ipv4;
+		struct net_ipv6_hdr *ipv6;
+	};
+	struct tcphdr *th;
+	net_sa_family_t family;
+	uint16_t ip_hdr_len;
+	uint16_t hdr_len;
+	uint16_t data_len;
+};
+
+static bool gro_parse(struct net_pkt *pkt, struct gro_seg *seg)
+{
+	struct net_buf *buf = pkt->buffer;
+	size_t frame_len = net_pkt_get_len(pkt);
+	size_t ip_len;
+	size_t tcp_len;
+	uint8_t *ip;
+
+	if (net_if_l2(net_pkt_iface(pkt)) != &NET_L2_GET_NAME(ETHERNET) ||
+	    net_pkt_is_loopback(pkt) ||
+	    buf->len < sizeof(struct net_eth_hdr) + sizeof(struct net_ipv4_hdr)) {
+		return false;
+	}
+
+	seg->eth = (struct net_eth_hdr *)buf->data;
+	ip = buf->data + sizeof(struct net_eth_hdr);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) &&
+	    seg->eth->type == net_htons(NET_ETH_PTYPE_IP)) {
+		seg->ipv4 = (struct net_ipv4_hdr *)ip;
+
+		/* No options and no fragments */
+		if (seg->ipv4->vhl != 0x45 || seg->ipv4->proto != NET_IPPROTO_TCP ||
+		    (sys_get_be16(seg->ipv4->offset) &
+		     (NET_IPV4_MORE_FRAG_MASK | NET_IPV4_FRAGH_OFFSET_MASK)) != 0U) {
+			return false;
+		}
+
+		seg->family = NET_AF_INET;
+		seg->ip_hdr_len = sizeof(struct net_ipv4_hdr);
+		ip_len = net_ntohs(seg->ipv4->len);
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		   seg->eth->type == net_htons(NET_ETH_PTYPE_IPV6) &&
+		   buf->len >= sizeof(struct net_eth_hdr) + sizeof(struct net_ipv6_hdr)) {
+		seg->ipv6 = (struct net_ipv6_hdr *)ip;
+
+		/* No extension headers */
+		if ((seg->ipv6->vtc & 0xf0) != 0x60 ||
+		    seg->ipv6->nexthdr != NET_IPPROTO_TCP) {
+			return false;
+		}
+
+		seg->family = NET_AF_INET6;
+		seg->ip_hdr_len = sizeof(struct net_ipv6_hdr);
+		ip_len = sizeof(struct net_ipv6_hdr) + net_ntohs(seg->ipv6->len);
+	} else {
+		return false;
+	}
+
+	if (buf->len < sizeof(struct net_eth_hdr) + seg->ip_hdr_len + sizeof(struct tcphdr)) {
+		return false;
+	}
+
+	seg->th = (struct tcphdr *)(ip + seg->ip_hdr_len);
+	tcp_len = th_off(seg->th) * 4U;
+	seg->hdr_len = sizeof(struct net_eth_hdr) + seg->ip_hdr_len + tcp_len;
+
+	/* A padded frame or a truncated packet is left to the IP input */
+	if (tcp_len < sizeof(struct tcphdr) || buf->len < seg->hdr_len ||
+	    frame_len != sizeof(struct net_eth_hdr) + ip_len ||
+	    ip_len < seg->ip_hdr_len + tcp_len) {
+		return false;
+	}
+
+	seg->data_len = ip_len - seg->ip_hdr_len - tcp_len;
+
+	return true;
+}
+
+/* Tell if next carries the data following the data_len bytes held by pkt */
+static bool gro_can_merge(struct net_pkt *pkt, struct gro_seg *seg,
+			  struct net_pkt *next, struct gro_seg *next_seg,
+			  size_t ip_len, uint32_t data_len)
+{
+	uint8_t flags = th_flags(next_seg->th);
+
+	if (net_pkt_iface(next) != net_pkt_iface(pkt) ||
+	    net_pkt_priority(next) != net_pkt_priority(pkt) ||
+	    net_pkt_vlan_tci(next) != net_pkt_vlan_tci(pkt) ||
+	    next_seg->family != seg->family ||
+	    next_seg->hdr_len != seg->hdr_len ||
+	    next_seg->data_len == 0U ||
+	    ip_len + next_seg->data_len > CONFIG_NET_GRO_MAX_SIZE ||
+	    (flags != ACK && flags != (ACK | PSH))) {
+		return false;
+	}
+
+	if (memcmp(next_seg->eth, seg->eth, sizeof(struct net_eth_hdr)) != 0) {
+		return false;
+	}
+
+	if (seg->family == NET_AF_INET) {
+		if (next_seg->ipv4->tos != seg->ipv4->tos ||
+		    next_seg->ipv4->ttl != seg->ipv4->ttl ||
+		    memcmp(next_seg->ipv4->offset, seg->ipv4->offset,
+			   sizeof(seg->ipv4->offset)) != 0 ||
+		    memcmp(next_seg->ipv4->src, seg->ipv4->src,
+			   2 * NET_IPV4_ADDR_SIZE) != 0) {
+			return false;
+		}
+	} else {
+		/* Version, traffic class and flow label */
+		if (memcmp(next_seg->ipv6, seg->ipv6, 4) != 0 ||
+		    next_seg->ipv6->hop_limit != seg->ipv6->hop_limit ||
+		    memcmp(next_seg->ipv6->src, seg->ipv6->src,
+			   2 * NET_IPV6_ADDR_SIZE) != 0) {
+			return false;
+		}
+	}
+
+	/* Same ports, acknowledgment, window and options, and the data
+	 * starting right after the held one.
+	 */
+	return th_sport(next_seg->th) == th_sport(seg->th) &&
+	       th_dport(next_seg->th) == th_dport(seg->th) &&
+	       th_ack(next_seg->th) == th_ack(seg->th) &&
+	       th_win(next_seg->th) == th_win(seg->th) &&
+	       th_seq(next_seg->th) == th_seq(seg->th) + data_len &&
+	       memcmp(next_seg->th + 1, seg->th + 1,
+		      th_off(seg->th) * 4U - sizeof(struct tcphdr)) == 0;
+}
+
+/* Verify the checksums the IP and TCP input code would otherwise verify,
+ * as they do not hold for the merged packet.
+ */
+static bool gro_chksum_ok(struct net_pkt *pkt, struct gro_seg *seg)
+{
+	struct net_if *iface = net_pkt_iface(pkt);
+	enum net_if_checksum_type type;
+	bool ok = true;
+
+	net_pkt_set_family(pkt, seg->family);
+	net_pkt_set_ip_hdr_len(pkt, seg->ip_hdr_len);
+
+	if (seg->family == NET_AF_INET) {
+		net_pkt_set_ipv4_opts_len(pkt, 0);
+		type = NET_IF_CHECKSUM_IPV4_TCP;
+	} else {
+		net_pkt_set_ipv6_ext_len(pkt, 0);
+		type = NET_IF_CHECKSUM_IPV6_TCP;
+	}
+
+	/* The checksum helpers expect the packet to start with the IP header */
+	net_buf_pull(pkt->buffer, sizeof(struct net_eth_hdr));
+
+	if (seg->family == NET_AF_INET &&
+	    net_if_need_calc_rx_checksum(iface, NET_IF_CHECKSUM_IPV4_HEADER) &&
+	    net_calc_chksum_ipv4(pkt) != 0U) {
+		ok = false;
+	} else if (IS_ENABLED(CONFIG_NET_TCP_CHECKSUM) &&
+		   net_if_need_calc_rx_checksum(iface, type) &&
+		   net_calc_chksum_tcp(pkt) != 0U) {
+		ok = false;
+	}
+
+	net_buf_push(pkt->buffer, sizeof(struct net_eth_hdr));
+
+	return ok;
+}
+
+static bool gro_is_local(struct gro_seg *seg)
+{
+	if (seg->family == NET_AF_INET) {
+		return net_ipv4_is_my_addr_raw(seg->ipv4->dst);
+	}
+
+	return net_ipv6_is_my_addr_raw(seg->ipv6->dst);
+}
+
+/* Move the TCP data of next to the end of pkt, and free next */
+static void gro_append(struct net_pkt *pkt, struct net_pkt *next,
+		       struct gro_seg *next_seg)
+{
+	struct net_buf *frag = next->buffer;
+
+	next->buffer = NULL;
+
+	net_buf_pull(frag, next_seg->hdr_len);
+	if (frag->len == 0U) {
+		frag = net_buf_frag_del(NULL, frag);
+	}
+
+	if (frag != NULL) {
+		net_buf_frag_add(pkt->buffer, frag);
+	}
+
+	net_pkt_unref(next);
+}
+
+static void gro_finish(struct net_pkt *pkt, struct gro_seg *seg, size_t ip_len)
+{
+	uint16_t sum;
+
+	if (seg->family == NET_AF_INET) {
+		seg->ipv4->len = net_htons(ip_len);
+		seg->ipv4->chksum = 0U;
+
+		sum = calc_chksum(0U, (uint8_t *)seg->ipv4, sizeof(struct net_ipv4_hdr));
+		sum = (sum == 0U) ? 0xffff : net_htons(sum);
+		seg->ipv4->chksum = ~sum;
+	} else {
+		seg->ipv6->len = net_htons(ip_len - sizeof(struct net_ipv6_hdr));
+	}
+
+	net_pkt_cursor_init(pkt);
+}
+
+struct net_pkt *net_gro_receive(struct net_pkt *pkt, struct k_fifo *fifo,
+				struct k_sem *fifo_slot)
+{
+	struct gro_seg seg;
+	struct gro_seg next_seg;
+	struct net_pkt *next;
+	uint32_t data_len;
+	size_t ip_len;
+	int count = 1;
+	uint8_t flags;
+
+	if (k_fifo_is_empty(fifo) || !gro_parse(pkt, &seg) ||
+	    th_flags(seg.th) != ACK || seg.data_len == 0U) {
+		return pkt;
+	}
+
+	data_len = seg.data_len;
+	ip_len = seg.hdr_len - sizeof(struct net_eth_hdr) + seg.data_len;
+
+	/* Only the packets already queued are looked at, and the merge stops
+	 * at the first one that does not fit, so the ordering is kept.
+	 */
+	while ((next = k_fifo_peek_head(fifo)) != NULL) {
+		if (!gro_parse(next, &next_seg) ||
+		    !gro_can_merge(pkt, &seg, next, &next_seg, ip_len, data_len)) {
+			break;
+		}
+
+		if (count == 1) {
+			/* Merged packets would not be forwarded properly */
+			if (!gro_is_local(&seg) || !gro_chksum_ok(pkt, &seg)) {
+				break;
+			}
+		}
+
+		/* A corrupted segment is dropped by the regular input path */
+		if (!gro_chksum_ok(next, &next_seg)) {
+			break;
+		}
+
+		(void)k_fifo_get(fifo, K_NO_WAIT);
+		if (fifo_slot != NULL) {
+			k_sem_give(fifo_slot);
+		}
+
+		flags = th_flags(next_seg.th);
+		data_len += next_seg.data_len;
+		ip_len += next_seg.data_len;
+		count++;
+
+		gro_append(pkt, next, &next_seg);
+
+		/* The merged packet ends with the pushed data, so it must be
+		 * pushed too. Segments with any other flag are never merged.
+		 */
+		if ((flags & PSH) != 0U) {
+			seg.th->th_flags |= PSH;
+			break;
+		}
+	}
+
+	if (count > 1) {
+		NET_DBG("Merged %d segments into pkt %p, len %zu", count, pkt, ip_len);
+
+		gro_finish(pkt, &seg, ip_len);
+		net_pkt_set_chksum_done(pkt, true);
+	}
+
+	return pkt;
+}
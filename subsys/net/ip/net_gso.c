@@ -0,0 +1,200 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Generic segmentation offload. A TCP super-segment built by tcp.c goes
+ * through the IP output path once, and is split here into segments of
+ * net_pkt_gso_size() bytes of data just before being given to the L2.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_if, CONFIG_NET_IF_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <string.h>
+
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+
+#include "net_private.h"
+#include "tcp_internal.h"
+
+/* Timeout for the allocation of a segment */
+#define NET_BUF_TIMEOUT K_MSEC(100)
+
+static struct net_pkt *gso_segment_alloc(struct net_pkt *pkt, size_t hdr_len,
+					 size_t offset, size_t len)
+{
+	struct net_pkt *seg;
+
+	seg = net_pkt_alloc_with_buffer(net_pkt_iface(pkt), hdr_len + len,
+					NET_AF_UNSPEC, 0, NET_BUF_TIMEOUT);
+	if (!seg) {
+		return NULL;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	/* Copy the headers, then the data of this segment */
+	if (net_pkt_copy(seg, pkt, hdr_len) ||
+	    net_pkt_skip(pkt, offset) ||
+	    net_pkt_copy(seg, pkt, len)) {
+		net_pkt_unref(seg);
+		return NULL;
+	}
+
+	net_pkt_set_family(seg, net_pkt_family(pkt));
+	net_pkt_set_context(seg, net_pkt_context(pkt));
+	net_pkt_set_ip_hdr_len(seg, net_pkt_ip_hdr_len(pkt));
+	net_pkt_set_ll_proto_type(seg, net_pkt_ll_proto_type(pkt));
+	net_pkt_set_priority(seg, net_pkt_priority(pkt));
+	net_pkt_set_vlan_tag(seg, net_pkt_vlan_tag(pkt));
+
+	memcpy(net_pkt_lladdr_src(seg), net_pkt_lladdr_src(pkt),
+	       sizeof(struct net_linkaddr));
+	memcpy(net_pkt_lladdr_dst(seg), net_pkt_lladdr_dst(pkt),
+	       sizeof(struct net_linkaddr));
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == NET_AF_INET) {
+		net_pkt_set_ipv4_opts_len(seg, net_pkt_ipv4_opts_len(pkt));
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == NET_AF_INET6) {
+		net_pkt_set_ipv6_ext_len(seg, net_pkt_ipv6_ext_len(pkt));
+	}
+
+	return seg;
+}
+
+/* Update the IP length, the TCP sequence number and flags, and the
+ * checksums of a segment.
+ */
+static int gso_segment_finalize(struct net_pkt *seg, uint32_t seq, bool last)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
+	struct net_pkt_cursor backup;
+	struct tcphdr *th;
+	uint8_t flags;
+	int ret;
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(seg) == NET_AF_INET) {
+		struct net_ipv4_hdr *ipv4_hdr = NET_IPV4_HDR(seg);
+
+		ipv4_hdr->len = net_htons(net_pkt_get_len(seg));
+		ipv4_hdr->chksum = 0U;
+
+		if (net_if_need_calc_tx_checksum(net_pkt_iface(seg),
+						 NET_IF_CHECKSUM_IPV4_HEADER)) {
+			ipv4_hdr->chksum = net_calc_chksum_ipv4(seg);
+		}
+	} else {
+		NET_IPV6_HDR(seg)->len = net_htons(net_pkt_get_len(seg) -
+						   sizeof(struct net_ipv6_hdr));
+	}
+
+	net_pkt_set_overwrite(seg, true);
+	net_pkt_cursor_init(seg);
+
+	ret = net_pkt_skip(seg, net_pkt_ip_hdr_len(seg) + net_pkt_ip_opts_len(seg));
+	if (ret < 0) {
+		return ret;
+	}
+
+	net_pkt_cursor_backup(seg, &backup);
+
+	th = (struct tcphdr *)net_pkt_get_data(seg, &tcp_access);
+	if (!th) {
+		return -ENOBUFS;
+	}
+
+	/* Only the last segment carries the PSH and FIN flags */
+	flags = th_flags(th);
+	if (!last) {
+		flags &= ~(PSH | FIN);
+	}
+
+	UNALIGNED_PUT(flags, &th->th_flags);
+	UNALIGNED_PUT(net_htonl(seq), UNALIGNED_MEMBER_ADDR(th, th_seq));
+
+	ret = net_pkt_set_data(seg, &tcp_access);
+	if (ret < 0) {
+		return ret;
+	}
+
+	net_pkt_cursor_restore(seg, &backup);
+
+	ret = net_tcp_finalize(seg, false);
+
+	net_pkt_set_overwrite(seg, false);
+	net_pkt_cursor_init(seg);
+
+	return ret;
+}
+
+int net_gso_segment(struct net_if *iface, struct net_pkt *pkt, net_gso_tx_cb_t tx)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
+	size_t ip_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+	size_t gso_size = net_pkt_gso_size(pkt);
+	size_t data_len;
+	size_t hdr_len;
+	size_t offset;
+	size_t len;
+	struct tcphdr *th;
+	struct net_pkt *seg;
+	uint32_t seq;
+	int ret = 0;
+
+	net_pkt_set_overwrite(pkt, true);
+	net_pkt_cursor_init(pkt);
+
+	if (net_pkt_skip(pkt, ip_len)) {
+		ret = -EINVAL;
+		goto out;
+	}
+
+	th = (struct tcphdr *)net_pkt_get_data(pkt, &tcp_access);
+	if (!th) {
+		ret = -ENOBUFS;
+		goto out;
+	}
+
+	hdr_len = ip_len + th_off(th) * 4U;
+	seq = th_seq(th);
+
+	if (net_pkt_get_len(pkt) < hdr_len) {
+		ret = -EINVAL;
+		goto out;
+	}
+
+	data_len = net_pkt_get_len(pkt) - hdr_len;
+
+	NET_DBG("Splitting pkt %p with %zu bytes of data into segments of %zu bytes",
+		pkt, data_len, gso_size);
+
+	for (offset = 0; offset < data_len; offset += len) {
+		len = MIN(gso_size, data_len - offset);
+
+		seg = gso_segment_alloc(pkt, hdr_len, offset, len);
+		if (!seg) {
+			NET_DBG("Cannot allocate segment of %zu bytes", hdr_len + len);
+			ret = -ENOMEM;
+			break;
+		}
+
+		ret = gso_segment_finalize(seg, seq + offset, offset + len == data_len);
+		if (ret < 0) {
+			net_pkt_unref(seg);
+			break;
+		}
+
+		(void)tx(iface, seg);
+	}
+
+out:
+	/* The data that could not be sent is retransmitted by TCP */
+	net_pkt_unref(pkt);
+
+	return ret;
+}
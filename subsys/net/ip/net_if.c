@@ -212,7 +212,7 @@ static void update_txtime_stats_detail(struct net_pkt *pkt,
 	}
 }
 
-static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
+static bool net_if_tx_pkt(struct net_if *iface, struct net_pkt *pkt)
 {
 	struct net_linkaddr ll_dst = { 0 };
 	struct net_context *context;
@@ -326,6 +326,38 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 	return true;
 }
 
+#if defined(CONFIG_NET_GSO)
+static bool net_if_tso_supported(struct net_if *iface)
+{
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET)) {
+		return (net_eth_get_hw_capabilities(iface) & ETHERNET_HW_TSO) != 0;
+	}
+#endif
+
+	ARG_UNUSED(iface);
+
+	return false;
+}
+#endif /* CONFIG_NET_GSO */
+
+static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
+{
+#if defined(CONFIG_NET_GSO)
+	/* Split a TCP super-segment unless the driver does it */
+	if (pkt != NULL && net_pkt_gso_size(pkt) > 0U && !net_if_tso_supported(iface)) {
+		if (net_gso_segment(iface, pkt, net_if_tx_pkt) < 0) {
+			NET_WARN_RATELIMIT("iface %d segmentation failure",
+					   net_if_get_by_iface(iface));
+		}
+
+		return true;
+	}
+#endif
+
+	return net_if_tx_pkt(iface, pkt);
+}
+
 void net_process_tx_packet(struct net_pkt *pkt)
 {
 	struct net_if *iface;
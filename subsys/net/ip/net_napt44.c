@@ -0,0 +1,366 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Network address and port translation of IPv4 (NAPT44). The TCP, UDP and
+ * ICMP echo packets that the hosts of the inside interfaces send through
+ * the router get the address of the outside interface and a port of their
+ * own, from which the replies are translated back. Mapping n uses port
+ * CONFIG_NET_NAPT44_PORT_BASE + n, so that a reply finds it directly. The
+ * packets are forwarded by the fast path, and ARP resolves their next hop
+ * on the egress interface: the inside host, or the gateway of the outside
+ * interface.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_fastpath, CONFIG_NET_FASTPATH_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <string.h>
+
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/icmp.h>
+#include <zephyr/net/napt.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/hash_function.h>
+
+#include "net_private.h"
+#include "ipv4.h"
+#include "icmpv4.h"
+
+BUILD_ASSERT(CONFIG_NET_NAPT44_PORT_BASE + CONFIG_NET_NAPT44_MAX_MAPPINGS <= 65536,
+	     "NAPT44 ports out of range");
+
+struct napt_key {
+	uint8_t addr[NET_IPV4_ADDR_SIZE];
+	uint16_t port;
+	uint16_t proto;
+};
+
+struct napt_entry {
+	sys_snode_t node;
+	/* Inside interface, NULL if the mapping is unused */
+	struct net_if *iface;
+	/* Inside address and port, or ICMP echo identifier */
+	struct napt_key key;
+	uint32_t last_used;
+};
+
+static struct napt_entry napt_entries[CONFIG_NET_NAPT44_MAX_MAPPINGS];
+static sys_slist_t napt_buckets[CONFIG_NET_NAPT44_MAX_MAPPINGS];
+static struct net_if *napt_outside;
+static size_t napt_next;
+static struct k_spinlock napt_lock;
+
+static sys_slist_t *napt_bucket(const struct napt_key *key)
+{
+	return &napt_buckets[sys_hash32(key, sizeof(*key)) % CONFIG_NET_NAPT44_MAX_MAPPINGS];
+}
+
+static bool napt_is_expired(struct napt_entry *entry, uint32_t now)
+{
+	return now - entry->last_used > CONFIG_NET_NAPT44_TIMEOUT * MSEC_PER_SEC;
+}
+
+static struct napt_entry *napt_lookup(struct net_if *iface, const struct napt_key *key)
+{
+	struct napt_entry *entry;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(napt_bucket(key), entry, node) {
+		if (entry->iface == iface && memcmp(&entry->key, key, sizeof(*key)) == 0) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+static struct napt_entry *napt_alloc(struct net_if *iface, const struct napt_key *key,
+				     uint32_t now)
+{
+	struct napt_entry *entry;
+
+	for (size_t i = 0; i < ARRAY_SIZE(napt_entries); i++) {
+		entry = &napt_entries[napt_next];
+		napt_next = (napt_next + 1) % ARRAY_SIZE(napt_entries);
+
+		if (entry->iface != NULL) {
+			if (!napt_is_expired(entry, now)) {
+				continue;
+			}
+
+			(void)sys_slist_find_and_remove(napt_bucket(&entry->key), &entry->node);
+		}
+
+		entry->iface = iface;
+		entry->key = *key;
+		sys_slist_prepend(napt_bucket(key), &entry->node);
+
+		return entry;
+	}
+
+	return NULL;
+}
+
+static void napt_flush(void)
+{
+	ARRAY_FOR_EACH(napt_entries, i) {
+		napt_entries[i].iface = NULL;
+		sys_slist_init(&napt_buckets[i]);
+	}
+}
+
+/* Return where the port, or the ICMP echo identifier, of the packet is */
+static uint8_t *napt_port(uint8_t proto, uint8_t *l4, bool src)
+{
+	if (proto == NET_IPPROTO_ICMP) {
+		return l4 + offsetof(struct net_icmpv4_echo_req, identifier) +
+		       sizeof(struct net_icmp_hdr);
+	}
+
+	/* The ports are at the same place in the TCP and UDP headers */
+	return src ? l4 : l4 + sizeof(uint16_t);
+}
+
+/* Replace the source or destination address and port of the packet, update
+ * the checksums and decrement the TTL.
+ */
+static void napt_rewrite(struct net_ipv4_hdr *hdr, uint8_t *l4, bool src,
+			 const uint8_t *addr, uint16_t port)
+{
+	uint8_t *old_addr = src ? hdr->src : hdr->dst;
+	uint8_t *old_port = napt_port(hdr->proto, l4, src);
+	uint16_t from, to, chksum;
+	uint32_t from32, to32;
+	uint8_t *l4_chksum;
+
+	switch (hdr->proto) {
+	case NET_IPPROTO_TCP:
+		l4_chksum = (uint8_t *)&((struct net_tcp_hdr *)l4)->chksum;
+		break;
+	case NET_IPPROTO_UDP:
+		l4_chksum = (uint8_t *)&((struct net_udp_hdr *)l4)->chksum;
+		break;
+	default:
+		l4_chksum = (uint8_t *)&((struct net_icmp_hdr *)l4)->chksum;
+		break;
+	}
+
+	memcpy(&from32, old_addr, sizeof(from32));
+	memcpy(&to32, addr, sizeof(to32));
+	memcpy(&from, old_port, sizeof(from));
+	memcpy(&chksum, l4_chksum, sizeof(chksum));
+
+	/* A UDP checksum of 0 means that the sender did not compute it */
+	if (hdr->proto != NET_IPPROTO_UDP || chksum != 0U) {
+		/* The ICMP checksum does not cover a pseudo header */
+		if (hdr->proto != NET_IPPROTO_ICMP) {
+			chksum = net_chksum_update_32(chksum, from32, to32);
+		}
+
+		chksum = net_chksum_update_16(chksum, from, port);
+
+		if (hdr->proto == NET_IPPROTO_UDP && chksum == 0U) {
+			chksum = 0xffff;
+		}
+
+		memcpy(l4_chksum, &chksum, sizeof(chksum));
+	}
+
+	memcpy(old_port, &port, sizeof(port));
+	memcpy(old_addr, addr, NET_IPV4_ADDR_SIZE);
+
+	/* The TTL shares a 16-bit word with the protocol */
+	memcpy(&from, &hdr->ttl, sizeof(from));
+	hdr->ttl--;
+	memcpy(&to, &hdr->ttl, sizeof(to));
+
+	hdr->chksum = net_chksum_update_32(hdr->chksum, from32, to32);
+	hdr->chksum = net_chksum_update_16(hdr->chksum, from, to);
+}
+
+static enum net_verdict napt_out(struct net_pkt *pkt, struct net_if *outside,
+				 struct net_ipv4_hdr *hdr, uint8_t *l4, size_t len)
+{
+	struct net_if *iface = net_pkt_iface(pkt);
+	uint32_t now = k_uptime_get_32();
+	struct napt_entry *entry;
+	struct net_in_addr *addr;
+	struct napt_key key = { 0 };
+	k_spinlock_key_t lock;
+	uint16_t port = 0U;
+
+	/* The packets sent to the router itself go to the slow path */
+	if (net_ipv4_is_my_addr_raw(hdr->dst) || net_ipv4_is_addr_mcast_raw(hdr->dst) ||
+	    net_ipv4_is_my_addr_raw(hdr->src) || !net_if_is_up(outside)) {
+		return NET_CONTINUE;
+	}
+
+	if (hdr->proto == NET_IPPROTO_ICMP && l4[0] != NET_ICMPV4_ECHO_REQUEST) {
+		return NET_CONTINUE;
+	}
+
+	addr = net_if_ipv4_get_global_addr(outside, NET_ADDR_PREFERRED);
+	if (addr == NULL) {
+		return NET_CONTINUE;
+	}
+
+	memcpy(key.addr, hdr->src, sizeof(key.addr));
+	memcpy(&key.port, napt_port(hdr->proto, l4, true), sizeof(key.port));
+	key.proto = hdr->proto;
+
+	lock = k_spin_lock(&napt_lock);
+
+	entry = napt_lookup(iface, &key);
+	if (entry == NULL) {
+		entry = napt_alloc(iface, &key, now);
+	}
+
+	if (entry != NULL) {
+		entry->last_used = now;
+		port = net_htons(CONFIG_NET_NAPT44_PORT_BASE + ARRAY_INDEX(napt_entries, entry));
+	}
+
+	k_spin_unlock(&napt_lock, lock);
+
+	if (entry == NULL) {
+		NET_DBG("No free mapping for %s", net_sprint_ipv4_addr(hdr->src));
+		return NET_CONTINUE;
+	}
+
+	napt_rewrite(hdr, l4, true, addr->s4_addr, port);
+
+	return net_fastpath_send(pkt, outside, NET_AF_INET, NET_ETH_PTYPE_IP, NULL, len);
+}
+
+static enum net_verdict napt_in(struct net_pkt *pkt, struct net_if *outside,
+				struct net_ipv4_hdr *hdr, uint8_t *l4, size_t len)
+{
+	uint32_t now = k_uptime_get_32();
+	struct napt_entry *entry;
+	struct net_in_addr *addr;
+	struct napt_key key = { 0 };
+	struct net_if *iface;
+	k_spinlock_key_t lock;
+	uint16_t port;
+
+	if (hdr->proto == NET_IPPROTO_ICMP && l4[0] != NET_ICMPV4_ECHO_REPLY) {
+		return NET_CONTINUE;
+	}
+
+	addr = net_if_ipv4_get_global_addr(outside, NET_ADDR_PREFERRED);
+	if (addr == NULL || !net_ipv4_addr_cmp_raw(hdr->dst, addr->s4_addr)) {
+		return NET_CONTINUE;
+	}
+
+	port = sys_get_be16(napt_port(hdr->proto, l4, false));
+	if (port < CONFIG_NET_NAPT44_PORT_BASE ||
+	    port - CONFIG_NET_NAPT44_PORT_BASE >= ARRAY_SIZE(napt_entries)) {
+		return NET_CONTINUE;
+	}
+
+	entry = &napt_entries[port - CONFIG_NET_NAPT44_PORT_BASE];
+
+	lock = k_spin_lock(&napt_lock);
+
+	iface = entry->iface;
+	if (iface != NULL && entry->key.proto == hdr->proto && !napt_is_expired(entry, now)) {
+		entry->last_used = now;
+		key = entry->key;
+	} else {
+		iface = NULL;
+	}
+
+	k_spin_unlock(&napt_lock, lock);
+
+	if (iface == NULL || !net_if_is_up(iface)) {
+		return NET_CONTINUE;
+	}
+
+	napt_rewrite(hdr, l4, false, key.addr, key.port);
+
+	return net_fastpath_send(pkt, iface, NET_AF_INET, NET_ETH_PTYPE_IP, NULL, len);
+}
+
+enum net_verdict net_napt44_input(struct net_pkt *pkt, size_t len)
+{
+	struct net_if *outside = napt_outside;
+	struct net_buf *buf = pkt->buffer;
+	struct net_ipv4_hdr *hdr;
+	size_t hdr_len, ip_len, l4_len;
+
+	if (outside == NULL ||
+	    buf->len < sizeof(struct net_eth_hdr) + sizeof(struct net_ipv4_hdr)) {
+		return NET_CONTINUE;
+	}
+
+	hdr = (struct net_ipv4_hdr *)(buf->data + sizeof(struct net_eth_hdr));
+	hdr_len = (hdr->vhl & NET_IPV4_IHL_MASK) * 4U;
+	ip_len = net_ntohs(hdr->len);
+
+	switch (hdr->proto) {
+	case NET_IPPROTO_TCP:
+		l4_len = offsetof(struct net_tcp_hdr, chksum) + sizeof(uint16_t);
+		break;
+	case NET_IPPROTO_UDP:
+		l4_len = sizeof(struct net_udp_hdr);
+		break;
+	case NET_IPPROTO_ICMP:
+		l4_len = sizeof(struct net_icmp_hdr) + sizeof(struct net_icmpv4_echo_req);
+		break;
+	default:
+		return NET_CONTINUE;
+	}
+
+	/* Only the first fragment holds the ports, so the fragments cannot be
+	 * translated.
+	 */
+	if ((hdr->vhl & 0xf0) != 0x40 || hdr_len < sizeof(struct net_ipv4_hdr) ||
+	    ip_len < hdr_len + l4_len || ip_len > len ||
+	    buf->len < sizeof(struct net_eth_hdr) + hdr_len + l4_len || hdr->ttl <= 1U ||
+	    (sys_get_be16(hdr->offset) &
+	     (NET_IPV4_MORE_FRAG_MASK | NET_IPV4_FRAGH_OFFSET_MASK)) != 0U) {
+		return NET_CONTINUE;
+	}
+
+	if (net_pkt_iface(pkt) == outside) {
+		return napt_in(pkt, outside, hdr, (uint8_t *)hdr + hdr_len, ip_len);
+	}
+
+	return napt_out(pkt, outside, hdr, (uint8_t *)hdr + hdr_len, ip_len);
+}
+
+int net_napt44_enable(struct net_if *iface)
+{
+	k_spinlock_key_t lock;
+
+	if (iface == NULL || net_if_l2(iface) != &NET_L2_GET_NAME(ETHERNET)) {
+		return -EINVAL;
+	}
+
+	lock = k_spin_lock(&napt_lock);
+
+	napt_flush();
+	napt_outside = iface;
+
+	k_spin_unlock(&napt_lock, lock);
+
+	NET_DBG("NAPT44 outside iface %d", net_if_get_by_iface(iface));
+
+	return 0;
+}
+
+void net_napt44_disable(void)
+{
+	k_spinlock_key_t lock = k_spin_lock(&napt_lock);
+
+	napt_outside = NULL;
+	napt_flush();
+
+	k_spin_unlock(&napt_lock, lock);
+}
@@ -1076,6 +1076,10 @@ static size_t pkt_buffer_length(struct net_pkt *pkt,
 				size_t existing)
 {
 	net_sa_family_t family = net_pkt_family(pkt);
+	/* Only TCP builds super-segments, which are split into MTU sized
+	 * segments before reaching the driver.
+	 */
+	bool gso = IS_ENABLED(CONFIG_NET_GSO) && proto == NET_IPPROTO_TCP;
 	size_t max_len;
 
 	if (net_pkt_iface(pkt)) {
@@ -1086,17 +1090,19 @@ static size_t pkt_buffer_length(struct net_pkt *pkt,
 
 	/* Family vs iface MTU */
 	if (IS_ENABLED(CONFIG_NET_IPV6) && family == NET_AF_INET6) {
-		if (IS_ENABLED(CONFIG_NET_IPV6_FRAGMENT) && (size > max_len)) {
-			/* We support larger packets if IPv6 fragmentation is
-			 * enabled.
+		if ((IS_ENABLED(CONFIG_NET_IPV6_FRAGMENT) || gso) && (size > max_len)) {
+			/* We support larger packets if IPv6 fragmentation or
+			 * TCP segmentation offload is enabled.
 			 */
 			max_len = size;
 		}
 
 		max_len = MAX(max_len, NET_IPV6_MTU);
 	} else if (IS_ENABLED(CONFIG_NET_IPV4) && family == NET_AF_INET) {
-		if (IS_ENABLED(CONFIG_NET_IPV4_FRAGMENT) && (size > max_len)) {
-			/* We support larger packets if IPv4 fragmentation is enabled */
+		if ((IS_ENABLED(CONFIG_NET_IPV4_FRAGMENT) || gso) && (size > max_len)) {
+			/* We support larger packets if IPv4 fragmentation or
+			 * TCP segmentation offload is enabled.
+			 */
 			max_len = size;
 		}
 
@@ -2091,6 +2097,7 @@ static void clone_pkt_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 	net_pkt_set_l2_bridged(clone_pkt, net_pkt_is_l2_bridged(pkt));
 	net_pkt_set_l2_processed(clone_pkt, net_pkt_is_l2_processed(pkt));
 	net_pkt_set_ll_proto_type(clone_pkt, net_pkt_ll_proto_type(pkt));
+	net_pkt_set_gso_size(clone_pkt, net_pkt_gso_size(pkt));
 
 #if defined(CONFIG_NET_OFFLOAD) || defined(CONFIG_NET_L2_IPIP)
 	net_pkt_set_remote_address(clone_pkt, net_pkt_remote_address(pkt),
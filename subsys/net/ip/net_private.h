@@ -231,6 +231,292 @@ static inline bool net_tc_rx_is_immediate(int tc, int prio)
 }
 extern enum net_verdict net_promisc_mode_input(struct net_pkt *pkt);
 
+#if defined(CONFIG_NET_GRO)
+/**
+ * @brief Merge the TCP segments following pkt in a receive queue into it.
+ *
+ * @param pkt Packet just taken from the queue.
+ * @param fifo Receive queue, from which the merged packets are taken.
+ * @param fifo_slot Semaphore counting the free slots of the queue, or NULL.
+ *
+ * @return The packet to process, which is always pkt.
+ */
+struct net_pkt *net_gro_receive(struct net_pkt *pkt, struct k_fifo *fifo,
+				struct k_sem *fifo_slot);
+#else
+static inline struct net_pkt *net_gro_receive(struct net_pkt *pkt,
+					      struct k_fifo *fifo,
+					      struct k_sem *fifo_slot)
+{
+	ARG_UNUSED(fifo);
+	ARG_UNUSED(fifo_slot);
+
+	return pkt;
+}
+#endif /* CONFIG_NET_GRO */
+
+#if defined(CONFIG_NET_TC_RX_RSS)
+/**
+ * @brief Compute the flow hash of a received frame.
+ *
+ * @param pkt Frame, with its L2 header, as given by the driver.
+ *
+ * @return Hash of the addresses, protocol and ports of the packet, or 0 if
+ *         the frame does not carry IP.
+ */
+uint32_t net_rss_hash(struct net_pkt *pkt);
+
+/**
+ * @brief Select the receive queue of a frame in its traffic class.
+ *
+ * The hash set by the driver is used if valid, else it is computed with
+ * net_rss_hash() and recorded in the packet.
+ *
+ * @param pkt Frame, with its L2 header, as given by the driver.
+ *
+ * @return Receive queue, from 0 to CONFIG_NET_TC_RX_RSS_QUEUE_COUNT - 1.
+ */
+int net_rss_queue(struct net_pkt *pkt);
+#endif /* CONFIG_NET_TC_RX_RSS */
+
+#if defined(CONFIG_NET_FASTPATH)
+struct net_eth_addr;
+
+/**
+ * @brief Forward a received frame right away if it belongs to a known flow.
+ *
+ * @param pkt Frame, with its L2 header, as given by the driver.
+ *
+ * @return NET_OK if the packet was queued to its egress interface,
+ *         NET_CONTINUE if it must go through the normal input processing.
+ */
+enum net_verdict net_fastpath_input(struct net_pkt *pkt);
+
+/**
+ * @brief Queue a packet whose IP header was rewritten to its egress interface.
+ *
+ * @param pkt Frame, with its Ethernet header, which is removed.
+ * @param iface Egress interface.
+ * @param family Address family of the packet.
+ * @param ptype Ethernet protocol type of the packet.
+ * @param lladdr Link layer address of the next hop, or NULL to resolve it
+ *        with ARP.
+ * @param len Length of the IP packet, without the padding of the frame.
+ *
+ * @return NET_OK, the packet being consumed.
+ */
+enum net_verdict net_fastpath_send(struct net_pkt *pkt, struct net_if *iface,
+				   uint8_t family, uint16_t ptype,
+				   const struct net_eth_addr *lladdr, size_t len);
+#else
+static inline enum net_verdict net_fastpath_input(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return NET_CONTINUE;
+}
+#endif /* CONFIG_NET_FASTPATH */
+
+#if defined(CONFIG_NET_FASTPATH) && defined(CONFIG_NET_ROUTING)
+/**
+ * @brief Remember the flow of an IPv6 packet being forwarded.
+ *
+ * @param pkt Packet, whose interface is the egress one.
+ * @param lladdr Link layer address of the next hop.
+ */
+void net_fastpath_learn(struct net_pkt *pkt, const struct net_linkaddr *lladdr);
+
+/**
+ * @brief Forget the flows to a prefix, after a change of its route.
+ *
+ * @param prefix Destination prefix of the route.
+ * @param prefix_len Length of the prefix, in bits.
+ */
+void net_fastpath_flush(const struct net_in6_addr *prefix, uint8_t prefix_len);
+
+/**
+ * @brief Forget the flows sent to a neighbor, whose link layer address
+ *        changes or which is removed.
+ *
+ * @param iface Interface of the neighbor.
+ * @param lladdr Link layer address the flows were sent to.
+ */
+void net_fastpath_flush_lladdr(struct net_if *iface, const struct net_linkaddr *lladdr);
+#else
+static inline void net_fastpath_learn(struct net_pkt *pkt,
+				      const struct net_linkaddr *lladdr)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(lladdr);
+}
+
+static inline void net_fastpath_flush(const struct net_in6_addr *prefix,
+				      uint8_t prefix_len)
+{
+	ARG_UNUSED(prefix);
+	ARG_UNUSED(prefix_len);
+}
+
+static inline void net_fastpath_flush_lladdr(struct net_if *iface,
+					     const struct net_linkaddr *lladdr)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(lladdr);
+}
+#endif /* CONFIG_NET_FASTPATH && CONFIG_NET_ROUTING */
+
+#if defined(CONFIG_NET_NAPT44)
+/**
+ * @brief Translate and forward a received IPv4 frame if it can be.
+ *
+ * @param pkt Frame, with its Ethernet header.
+ * @param len Length of the frame without the Ethernet header.
+ *
+ * @return NET_OK if the packet was queued to its egress interface,
+ *         NET_CONTINUE if it must go through the normal input processing.
+ */
+enum net_verdict net_napt44_input(struct net_pkt *pkt, size_t len);
+#else
+static inline enum net_verdict net_napt44_input(struct net_pkt *pkt, size_t len)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(len);
+
+	return NET_CONTINUE;
+}
+#endif /* CONFIG_NET_NAPT44 */
+
+#if defined(CONFIG_NET_GSO)
+typedef bool (*net_gso_tx_cb_t)(struct net_if *iface, struct net_pkt *pkt);
+
+/**
+ * @brief Split a TCP super-segment into segments of net_pkt_gso_size() bytes.
+ *
+ * @param iface Interface the packet is sent to.
+ * @param pkt Super-segment, which is released.
+ * @param tx Function sending each of the segments.
+ *
+ * @return 0 if all segments were handed to tx, <0 otherwise.
+ */
+int net_gso_segment(struct net_if *iface, struct net_pkt *pkt, net_gso_tx_cb_t tx);
+#endif /* CONFIG_NET_GSO */
+
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+/**
+ * @brief Start a zero-copy send.
+ *
+ * @param context Context the data is sent from.
+ *
+ * @return Buffer tracking the send, or NULL if the context has too many
+ *         sends in flight or there is no free buffer.
+ */
+struct net_buf *net_zc_tx_start(struct net_context *context);
+
+/**
+ * @brief Finish a zero-copy send started by net_zc_tx_start().
+ *
+ * The completion of a queued send is reported once the buffers referencing
+ * its data are all released.
+ *
+ * @param context Context the data is sent from.
+ * @param send Buffer tracking the send, NULL is ignored.
+ * @param queued Whether the send was queued, and is then given an id.
+ * @param copied Whether the data was copied instead.
+ */
+void net_zc_tx_finish(struct net_context *context, struct net_buf *send,
+		      bool queued, bool copied);
+
+/**
+ * @brief Get a buffer referencing data of a zero-copy send.
+ *
+ * @param send Buffer tracking the send.
+ * @param data Data, which must stay valid until the buffer is released.
+ * @param len Length of the data.
+ * @param timeout Time to wait for a free buffer.
+ *
+ * @return Buffer, or NULL if none could be allocated.
+ */
+struct net_buf *net_zc_tx_buf_get(struct net_buf *send, const void *data,
+				  size_t len, k_timeout_t timeout);
+
+/**
+ * @brief Get a buffer referencing part of the data of a zero-copy buffer.
+ *
+ * @param buf Zero-copy buffer.
+ * @param offset Offset of the data in buf.
+ * @param len Length of the data.
+ * @param timeout Time to wait for a free buffer.
+ *
+ * @return Buffer, or NULL if none could be allocated.
+ */
+struct net_buf *net_zc_tx_buf_slice(struct net_buf *buf, size_t offset,
+				    size_t len, k_timeout_t timeout);
+
+/**
+ * @brief Tell if a buffer references zero-copy data.
+ */
+bool net_zc_tx_buf_is_zc(struct net_buf *buf);
+
+/**
+ * @brief Get the range of the sends completed since the last call.
+ *
+ * @param context Context the data was sent from.
+ * @param first Id of the first completed send.
+ * @param last Id of the last completed send.
+ * @param copied Whether the data of some of the sends was copied.
+ *
+ * @return 0 if some sends completed, -EAGAIN otherwise.
+ */
+int net_zc_tx_completion_get(struct net_context *context, uint32_t *first,
+			     uint32_t *last, bool *copied);
+
+/**
+ * @brief Tell if there are completed sends not reported yet.
+ */
+bool net_zc_tx_completion_pending(struct net_context *context);
+#else
+static inline struct net_buf *net_zc_tx_buf_get(struct net_buf *send,
+						const void *data, size_t len,
+						k_timeout_t timeout)
+{
+	ARG_UNUSED(send);
+	ARG_UNUSED(data);
+	ARG_UNUSED(len);
+	ARG_UNUSED(timeout);
+
+	return NULL;
+}
+
+static inline struct net_buf *net_zc_tx_buf_slice(struct net_buf *buf,
+						  size_t offset, size_t len,
+						  k_timeout_t timeout)
+{
+	ARG_UNUSED(buf);
+	ARG_UNUSED(offset);
+	ARG_UNUSED(len);
+	ARG_UNUSED(timeout);
+
+	return NULL;
+}
+
+static inline bool net_zc_tx_buf_is_zc(struct net_buf *buf)
+{
+	ARG_UNUSED(buf);
+
+	return false;
+}
+
+static inline void net_zc_tx_finish(struct net_context *context,
+				    struct net_buf *send, bool queued,
+				    bool copied)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(send);
+	ARG_UNUSED(queued);
+	ARG_UNUSED(copied);
+}
+#endif /* CONFIG_NET_CONTEXT_ZEROCOPY */
+
 char *net_sprint_addr(net_sa_family_t af, const void *addr);
 
 #define net_sprint_ipv4_addr(_addr) net_sprint_addr(NET_AF_INET, _addr)
@@ -304,6 +590,68 @@ extern char *net_sprint_ll_addr_buf(const uint8_t *ll, uint8_t ll_len,
 extern uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len);
 extern uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto);
 
+/**
+ * @brief Update an Internet checksum after a 16-bit word it covers changed.
+ *
+ * This is the incremental update of RFC 1624. The values are taken as they
+ * are stored in the headers, in network byte order. The result may be
+ * 0x0000, which the caller must turn into 0xffff for a UDP checksum.
+ *
+ * @param chksum Checksum before the change.
+ * @param from Previous value of the word.
+ * @param to New value of the word.
+ *
+ * @return Updated checksum.
+ */
+static inline uint16_t net_chksum_update_16(uint16_t chksum, uint16_t from,
+					    uint16_t to)
+{
+	uint32_t sum = (uint32_t)(uint16_t)~chksum + (uint16_t)~from + to;
+
+	sum = (sum & 0xffff) + (sum >> 16);
+	sum = (sum & 0xffff) + (sum >> 16);
+
+	return (uint16_t)~sum;
+}
+
+/**
+ * @brief Update an Internet checksum after a 32-bit value it covers changed,
+ *        such as an IPv4 address.
+ *
+ * @param chksum Checksum before the change.
+ * @param from Previous value, as stored in the header.
+ * @param to New value, as stored in the header.
+ *
+ * @return Updated checksum.
+ */
+static inline uint16_t net_chksum_update_32(uint16_t chksum, uint32_t from,
+					    uint32_t to)
+{
+	chksum = net_chksum_update_16(chksum, (uint16_t)from, (uint16_t)to);
+
+	return net_chksum_update_16(chksum, (uint16_t)(from >> 16),
+				    (uint16_t)(to >> 16));
+}
+
+/**
+ * @brief Update an Internet checksum after some data it covers changed, such
+ *        as an IPv6 address.
+ *
+ * @param chksum Checksum before the change.
+ * @param from Previous data.
+ * @param to New data.
+ * @param len Length of the data, which must be even and start at an even
+ *        offset of the data covered by the checksum.
+ *
+ * @return Updated checksum.
+ */
+static inline uint16_t net_chksum_update(uint16_t chksum, const uint8_t *from,
+					 const uint8_t *to, size_t len)
+{
+	return net_chksum_update_16(chksum, net_htons(calc_chksum(0U, from, len)),
+				    net_htons(calc_chksum(0U, to, len)));
+}
+
 /**
  * @brief Deliver the incoming packet through the recv_cb of the net_context
  *        to the upper layers
@@ -0,0 +1,157 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Receive-side scaling. The flow hash of a received frame selects the
+ * receive queue of its traffic class, so that the packets of a flow are
+ * always processed in order by the same thread while different flows are
+ * processed in parallel on the other CPUs.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tc, CONFIG_NET_TC_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <string.h>
+
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/sys/hash_function.h>
+
+#include "net_private.h"
+#include "ipv4.h"
+
+struct rss_key {
+	uint8_t addr[2 * sizeof(struct net_in6_addr)];
+	uint16_t port[2];
+	uint8_t proto;
+};
+
+/* Return the offset of the IP header in the first buffer of the frame,
+ * and its family, or -1 if the frame does not carry IP.
+ */
+static int rss_ip_offset(struct net_pkt *pkt, uint8_t *data, size_t len,
+			 net_sa_family_t *family)
+{
+	struct net_if *iface = net_pkt_iface(pkt);
+	uint16_t type;
+	int offset;
+
+	if (IS_ENABLED(CONFIG_NET_L2_ETHERNET) &&
+	    net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET)) {
+		if (len < sizeof(struct net_eth_hdr)) {
+			return -1;
+		}
+
+		type = net_ntohs(((struct net_eth_hdr *)data)->type);
+		offset = sizeof(struct net_eth_hdr);
+
+		if (type == NET_ETH_PTYPE_VLAN) {
+			if (len < sizeof(struct net_eth_vlan_hdr)) {
+				return -1;
+			}
+
+			type = net_ntohs(((struct net_eth_vlan_hdr *)data)->type);
+			offset = sizeof(struct net_eth_vlan_hdr);
+		}
+
+		if (type == NET_ETH_PTYPE_IP) {
+			*family = NET_AF_INET;
+		} else if (type == NET_ETH_PTYPE_IPV6) {
+			*family = NET_AF_INET6;
+		} else {
+			return -1;
+		}
+
+		return offset;
+	}
+
+	/* The loopback interface carries bare IP packets */
+	if (IS_ENABLED(CONFIG_NET_L2_DUMMY) &&
+	    net_if_l2(iface) == &NET_L2_GET_NAME(DUMMY) && len > 0) {
+		if ((data[0] & 0xf0) == 0x40) {
+			*family = NET_AF_INET;
+		} else if ((data[0] & 0xf0) == 0x60) {
+			*family = NET_AF_INET6;
+		} else {
+			return -1;
+		}
+
+		return 0;
+	}
+
+	return -1;
+}
+
+uint32_t net_rss_hash(struct net_pkt *pkt)
+{
+	struct net_buf *buf = pkt->buffer;
+	struct rss_key key = { 0 };
+	net_sa_family_t family;
+	size_t hdr_len;
+	uint8_t *ip;
+	size_t len;
+	int offset;
+
+	if (buf == NULL) {
+		return 0U;
+	}
+
+	offset = rss_ip_offset(pkt, buf->data, buf->len, &family);
+	if (offset < 0) {
+		return 0U;
+	}
+
+	ip = buf->data + offset;
+	len = buf->len - offset;
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && family == NET_AF_INET &&
+	    len >= sizeof(struct net_ipv4_hdr)) {
+		struct net_ipv4_hdr *hdr = (struct net_ipv4_hdr *)ip;
+
+		memcpy(key.addr, hdr->src, 2 * NET_IPV4_ADDR_SIZE);
+		key.proto = hdr->proto;
+		hdr_len = (hdr->vhl & NET_IPV4_IHL_MASK) * 4U;
+
+		/* Only the first fragment holds the ports, so the fragments
+		 * are hashed on the addresses to stay in order.
+		 */
+		if ((sys_get_be16(hdr->offset) &
+		     (NET_IPV4_MORE_FRAG_MASK | NET_IPV4_FRAGH_OFFSET_MASK)) != 0U) {
+			goto hash;
+		}
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && family == NET_AF_INET6 &&
+		   len >= sizeof(struct net_ipv6_hdr)) {
+		struct net_ipv6_hdr *hdr = (struct net_ipv6_hdr *)ip;
+
+		memcpy(key.addr, hdr->src, 2 * NET_IPV6_ADDR_SIZE);
+		key.proto = hdr->nexthdr;
+		hdr_len = sizeof(struct net_ipv6_hdr);
+	} else {
+		return 0U;
+	}
+
+	/* The ports are at the same place in the TCP and UDP headers. A packet
+	 * with IPv6 extension headers is hashed on its addresses only.
+	 */
+	if ((key.proto == NET_IPPROTO_TCP || key.proto == NET_IPPROTO_UDP) &&
+	    len >= hdr_len + sizeof(key.port)) {
+		memcpy(key.port, ip + hdr_len, sizeof(key.port));
+	}
+
+hash:
+	return sys_hash32(&key, sizeof(key));
+}
+
+int net_rss_queue(struct net_pkt *pkt)
+{
+	if (!net_pkt_rx_hash_is_valid(pkt)) {
+		net_pkt_set_rx_hash(pkt, net_rss_hash(pkt));
+	}
+
+	return net_pkt_rx_hash(pkt) % CONFIG_NET_TC_RX_RSS_QUEUE_COUNT;
+}
@@ -18,12 +18,21 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 #include "net_stats.h"
 #include "net_tc_mapping.h"
 
+/* Number of receive queues of each Rx traffic class */
+#if defined(CONFIG_NET_TC_RX_RSS)
+#define NET_TC_RX_QUEUES CONFIG_NET_TC_RX_RSS_QUEUE_COUNT
+#else
+#define NET_TC_RX_QUEUES 1
+#endif
+
 #if NET_TC_RX_EFFECTIVE_COUNT > 1
-#define NET_TC_RX_SLOTS (CONFIG_NET_PKT_RX_COUNT / NET_TC_RX_EFFECTIVE_COUNT)
+#define NET_TC_RX_SLOTS (CONFIG_NET_PKT_RX_COUNT / \
+			 (NET_TC_RX_EFFECTIVE_COUNT * NET_TC_RX_QUEUES))
 BUILD_ASSERT(NET_TC_RX_SLOTS > 0,
 		"Misconfiguration: There are more traffic classes then packets, "
 		"either increase CONFIG_NET_PKT_RX_COUNT or decrease "
-		"CONFIG_NET_TC_RX_COUNT or disable CONFIG_NET_TC_RX_SKIP_FOR_HIGH_PRIO");
+		"CONFIG_NET_TC_RX_COUNT or disable CONFIG_NET_TC_RX_SKIP_FOR_HIGH_PRIO "
+		"or decrease CONFIG_NET_TC_RX_RSS_QUEUE_COUNT");
 #endif
 
 
@@ -41,15 +50,17 @@ BUILD_ASSERT(NET_TC_TX_SLOTS > 0,
 /* Template for thread name. The "xx" is either "TX" denoting transmit thread,
  * or "RX" denoting receive thread. The "q[y]" denotes the traffic class queue
  * where y indicates the traffic class id. The value of y can be from 0 to 7.
+ * With receive-side scaling, "q[y.zz]" denotes the receive queue zz of the
+ * traffic class y.
  */
-#define MAX_NAME_LEN sizeof("xx_q[y]")
+#define MAX_NAME_LEN sizeof("xx_q[y.zz]")
 
 /* Stacks for TX work queue */
 K_KERNEL_STACK_ARRAY_DEFINE(tx_stack, NET_TC_TX_COUNT,
 			    CONFIG_NET_TX_STACK_SIZE);
 
 /* Stacks for RX work queue */
-K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_COUNT,
+K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_COUNT * NET_TC_RX_QUEUES,
 			    CONFIG_NET_RX_STACK_SIZE);
 
 #if NET_TC_TX_COUNT > 0
@@ -57,7 +68,13 @@ static struct net_traffic_class tx_classes[NET_TC_TX_COUNT];
 #endif
 
 #if NET_TC_RX_COUNT > 0
-static struct net_traffic_class rx_classes[NET_TC_RX_COUNT];
+static struct net_traffic_class rx_classes[NET_TC_RX_COUNT * NET_TC_RX_QUEUES];
+#endif
+
+#if defined(CONFIG_NET_TC_RX_RSS)
+#define rx_rss_queue(pkt) net_rss_queue(pkt)
+#else
+#define rx_rss_queue(pkt) 0
 #endif
 
 enum net_verdict net_tc_try_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt,
@@ -84,13 +101,15 @@ enum net_verdict net_tc_try_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt,
 enum net_verdict net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt)
 {
 #if NET_TC_RX_COUNT > 0
+	struct net_traffic_class *rx_class = &rx_classes[tc * NET_TC_RX_QUEUES +
+							 rx_rss_queue(pkt)];
 #if NET_TC_RX_EFFECTIVE_COUNT > 1
 	uint8_t retry_cnt = NET_TC_RETRY_CNT;
 #endif
 	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
 
 #if NET_TC_RX_EFFECTIVE_COUNT > 1
-	while (k_sem_take(&rx_classes[tc].fifo_slot, K_NO_WAIT) != 0) {
+	while (k_sem_take(&rx_class->fifo_slot, K_NO_WAIT) != 0) {
 		if (k_is_in_isr() || retry_cnt == 0) {
 			return NET_DROP;
 		}
@@ -103,7 +122,7 @@ enum net_verdict net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt)
 	}
 #endif
 
-	k_fifo_put(&rx_classes[tc].fifo, pkt);
+	k_fifo_put(&rx_class->fifo, pkt);
 	return NET_OK;
 #else
 	ARG_UNUSED(tc);
@@ -273,6 +292,10 @@ static void tc_rx_handler(void *p1, void *p2, void *p3)
 
 #if NET_TC_RX_EFFECTIVE_COUNT > 1
 		k_sem_give(fifo_slot);
+
+		pkt = net_gro_receive(pkt, fifo, fifo_slot);
+#else
+		pkt = net_gro_receive(pkt, fifo, NULL);
 #endif
 
 		net_process_rx_packet(pkt);
@@ -382,10 +405,9 @@ void net_tc_rx_init(void)
 	net_if_foreach(net_tc_rx_stats_priority_setup, NULL);
 #endif
 
-	for (i = 0; i < NET_TC_RX_COUNT; i++) {
+	for (i = 0; i < NET_TC_RX_COUNT * NET_TC_RX_QUEUES; i++) {
 		k_tid_t tid;
-		int priority = net_tc_rx_thread_priority(i);
-
+		int priority = net_tc_rx_thread_priority(i / NET_TC_RX_QUEUES);
 
 		NET_DBG("[%d] Starting RX handler %p stack size %zd prio %d", i,
 			&rx_classes[i].handler,
@@ -414,10 +436,23 @@ void net_tc_rx_init(void)
 			continue;
 		}
 
+#if defined(CONFIG_NET_TC_RX_RSS_CPU_PIN)
+		if (k_thread_cpu_pin(tid, (i % NET_TC_RX_QUEUES) %
+				     arch_num_cpus()) < 0) {
+			NET_ERR("Cannot pin TC handler thread %d", i);
+		}
+#endif
+
 		if (IS_ENABLED(CONFIG_THREAD_NAME)) {
 			char name[MAX_NAME_LEN];
 
-			snprintk(name, sizeof(name), "rx_q[%d]", i);
+			if (IS_ENABLED(CONFIG_NET_TC_RX_RSS)) {
+				snprintk(name, sizeof(name), "rx_q[%d.%d]",
+					 i / NET_TC_RX_QUEUES, i % NET_TC_RX_QUEUES);
+			} else {
+				snprintk(name, sizeof(name), "rx_q[%d]", i);
+			}
+
 			k_thread_name_set(tid, name);
 		}
 
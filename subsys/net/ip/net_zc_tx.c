@@ -0,0 +1,203 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Zero-copy transmit. The data of a send is referenced by buffers of the
+ * pool below instead of being copied. Each of them holds a reference to a
+ * buffer without data tracking the send, whose release means that the
+ * application can reuse the data. The completion of the sends is then
+ * reported in order, as a range of send ids, through the error queue of
+ * the socket.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_ctx, CONFIG_NET_CONTEXT_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_context.h>
+#include <zephyr/net_buf.h>
+
+#include "net_private.h"
+
+/* Number of sends tracked past the oldest not completed one */
+#define ZC_TX_MAX_AHEAD 32U
+
+struct zc_tx_meta {
+	/* Buffer tracking the send, NULL for the tracking buffer itself */
+	struct net_buf *send;
+	/* Set for the tracking buffer of a queued send */
+	struct net_context *context;
+	uint32_t id;
+	bool copied;
+};
+
+static void zc_tx_destroy(struct net_buf *buf);
+
+NET_BUF_POOL_FIXED_DEFINE(zc_tx_bufs, CONFIG_NET_CONTEXT_ZEROCOPY_BUF_COUNT,
+			  0, 0, zc_tx_destroy);
+
+static struct zc_tx_meta zc_tx_meta[CONFIG_NET_CONTEXT_ZEROCOPY_BUF_COUNT];
+
+static void zc_tx_complete(struct net_context *context, uint32_t id, bool copied)
+{
+	k_spinlock_key_t key = k_spin_lock(&context->zc.lock);
+	uint32_t ahead = id - context->zc.done;
+
+	if (ahead == 0U) {
+		/* Bit n of zc.ahead stands for the send done + 1 + n */
+		context->zc.done++;
+
+		while ((context->zc.ahead & BIT(0)) != 0U) {
+			context->zc.ahead >>= 1;
+			context->zc.done++;
+		}
+
+		context->zc.ahead >>= 1;
+	} else if (ahead <= ZC_TX_MAX_AHEAD) {
+		context->zc.ahead |= BIT(ahead - 1U);
+	}
+
+	context->zc.copied |= copied;
+
+	if (context->zc.done != context->zc.reported) {
+		k_poll_signal_raise(&context->zc.signal, 0);
+	}
+
+	k_spin_unlock(&context->zc.lock, key);
+}
+
+static void zc_tx_destroy(struct net_buf *buf)
+{
+	struct zc_tx_meta *meta = &zc_tx_meta[net_buf_id(buf)];
+	struct net_buf *send = meta->send;
+	struct net_context *context = meta->context;
+
+	meta->send = NULL;
+	meta->context = NULL;
+
+	if (send != NULL) {
+		net_buf_destroy(buf);
+		net_buf_unref(send);
+		return;
+	}
+
+	if (context != NULL) {
+		zc_tx_complete(context, meta->id, meta->copied);
+	}
+
+	net_buf_destroy(buf);
+
+	if (context != NULL) {
+		net_context_unref(context);
+	}
+}
+
+struct net_buf *net_zc_tx_start(struct net_context *context)
+{
+	struct net_buf *send;
+
+	/* The completion of a send too far ahead could not be tracked */
+	if (context->zc.next - context->zc.done >= ZC_TX_MAX_AHEAD) {
+		NET_DBG("ctx %p has too many zero-copy sends in flight", context);
+		return NULL;
+	}
+
+	send = net_buf_alloc_len(&zc_tx_bufs, 0, K_NO_WAIT);
+	if (send == NULL) {
+		return NULL;
+	}
+
+	zc_tx_meta[net_buf_id(send)] = (struct zc_tx_meta){ 0 };
+
+	return send;
+}
+
+void net_zc_tx_finish(struct net_context *context, struct net_buf *send,
+		      bool queued, bool copied)
+{
+	struct zc_tx_meta *meta;
+
+	if (send == NULL) {
+		return;
+	}
+
+	meta = &zc_tx_meta[net_buf_id(send)];
+
+	if (queued) {
+		(void)net_context_ref(context);
+		meta->context = context;
+		meta->id = context->zc.next++;
+		meta->copied = copied;
+	}
+
+	/* Completes now if the data is not referenced anymore */
+	net_buf_unref(send);
+}
+
+struct net_buf *net_zc_tx_buf_get(struct net_buf *send, const void *data,
+				  size_t len, k_timeout_t timeout)
+{
+	struct net_buf *buf;
+
+	buf = net_buf_alloc_with_data(&zc_tx_bufs, (void *)data, len, timeout);
+	if (buf == NULL) {
+		return NULL;
+	}
+
+	zc_tx_meta[net_buf_id(buf)] = (struct zc_tx_meta){
+		.send = net_buf_ref(send),
+	};
+
+	return buf;
+}
+
+struct net_buf *net_zc_tx_buf_slice(struct net_buf *buf, size_t offset,
+				    size_t len, k_timeout_t timeout)
+{
+	return net_zc_tx_buf_get(zc_tx_meta[net_buf_id(buf)].send,
+				 buf->data + offset, len, timeout);
+}
+
+bool net_zc_tx_buf_is_zc(struct net_buf *buf)
+{
+	return net_buf_pool_get(buf->pool_id) == &zc_tx_bufs &&
+	       zc_tx_meta[net_buf_id(buf)].send != NULL;
+}
+
+int net_zc_tx_completion_get(struct net_context *context, uint32_t *first,
+			     uint32_t *last, bool *copied)
+{
+	k_spinlock_key_t key = k_spin_lock(&context->zc.lock);
+	int ret = 0;
+
+	if (context->zc.done == context->zc.reported) {
+		ret = -EAGAIN;
+		goto out;
+	}
+
+	*first = context->zc.reported;
+	*last = context->zc.done - 1U;
+	*copied = context->zc.copied;
+
+	context->zc.reported = context->zc.done;
+	context->zc.copied = false;
+	k_poll_signal_reset(&context->zc.signal);
+
+out:
+	k_spin_unlock(&context->zc.lock, key);
+
+	return ret;
+}
+
+bool net_zc_tx_completion_pending(struct net_context *context)
+{
+	k_spinlock_key_t key = k_spin_lock(&context->zc.lock);
+	bool pending = context->zc.done != context->zc.reported;
+
+	k_spin_unlock(&context->zc.lock, key);
+
+	return pending;
+}
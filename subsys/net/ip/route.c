@@ -32,7 +32,7 @@ LOG_MODULE_REGISTER(net_route, CONFIG_NET_ROUTE_LOG_LEVEL);
 /* We keep track of the routes in a separate list so that we can remove
  * the oldest routes (at tail) if needed.
  */
-static sys_slist_t routes;
+static sys_dlist_t routes = SYS_DLIST_STATIC_INIT(&routes);
 
 /* Track currently active route lifetime timers */
 static sys_slist_t active_route_lifetime_timers;
@@ -263,19 +263,211 @@ static int nbr_nexthop_put(struct net_nbr *nbr)
 /* Route was accessed, so place it in front of the routes list */
 static inline void update_route_access(struct net_route_entry *route)
 {
-	sys_slist_find_and_remove(&routes, &route->node);
-	sys_slist_prepend(&routes, &route->node);
+	sys_dlist_remove(&route->node);
+	sys_dlist_prepend(&routes, &route->node);
 }
 
-struct net_route_entry *net_route_lookup(struct net_if *iface,
-					 struct net_in6_addr *dst)
+#if defined(CONFIG_NET_ROUTE_LPM_TRIE)
+/* Path-compressed binary trie of the route prefixes. A node holds the
+ * routes of its prefix, and its children the longer prefixes, the bit
+ * following the node prefix selecting the child. The nodes without routes
+ * only branch, so there are less than two nodes per prefix.
+ */
+struct route_trie_node {
+	struct route_trie_node *child[2];
+	sys_slist_t routes;
+	struct net_in6_addr prefix;
+	uint8_t prefix_len;
+};
+
+K_MEM_SLAB_DEFINE_STATIC(route_trie_slab, sizeof(struct route_trie_node),
+			 2 * CONFIG_NET_MAX_ROUTES, sizeof(void *));
+
+static struct route_trie_node *route_trie;
+
+static inline uint8_t addr_bit(const struct net_in6_addr *addr, uint8_t bit)
+{
+	return (addr->s6_addr[bit / 8U] >> (7U - bit % 8U)) & 1U;
+}
+
+/* Return how many leading bits, up to max, two addresses have in common */
+static uint8_t addr_common_len(const struct net_in6_addr *a,
+			       const struct net_in6_addr *b, uint8_t max)
+{
+	uint8_t len = 0U;
+
+	for (int i = 0; i < sizeof(struct net_in6_addr) && len < max; i++) {
+		uint8_t diff = a->s6_addr[i] ^ b->s6_addr[i];
+
+		if (diff != 0U) {
+			len += __builtin_clz(diff) - 24;
+			break;
+		}
+
+		len += 8U;
+	}
+
+	return MIN(len, max);
+}
+
+static struct route_trie_node *route_trie_node_alloc(const struct net_in6_addr *prefix,
+						     uint8_t prefix_len)
+{
+	struct route_trie_node *node;
+
+	if (k_mem_slab_alloc(&route_trie_slab, (void **)&node, K_NO_WAIT) != 0) {
+		return NULL;
+	}
+
+	node->child[0] = NULL;
+	node->child[1] = NULL;
+	sys_slist_init(&node->routes);
+	net_ipaddr_copy(&node->prefix, prefix);
+	node->prefix_len = prefix_len;
+
+	return node;
+}
+
+static int route_trie_insert(struct net_route_entry *route)
+{
+	struct route_trie_node **link = &route_trie;
+	uint8_t len = route->prefix_len;
+	struct route_trie_node *node;
+	struct route_trie_node *new;
+	struct route_trie_node *branch;
+	uint8_t common = 0U;
+
+	while ((node = *link) != NULL) {
+		common = addr_common_len(&node->prefix, &route->addr,
+					 MIN(node->prefix_len, len));
+		if (common < node->prefix_len) {
+			break;
+		}
+
+		if (node->prefix_len == len) {
+			sys_slist_prepend(&node->routes, &route->trie_node);
+			return 0;
+		}
+
+		link = &node->child[addr_bit(&route->addr, node->prefix_len)];
+	}
+
+	new = route_trie_node_alloc(&route->addr, len);
+	if (new == NULL) {
+		return -ENOMEM;
+	}
+
+	sys_slist_prepend(&new->routes, &route->trie_node);
+
+	if (node == NULL) {
+		*link = new;
+		return 0;
+	}
+
+	/* The new prefix is a prefix of the node one */
+	if (common == len) {
+		new->child[addr_bit(&node->prefix, len)] = node;
+		*link = new;
+		return 0;
+	}
+
+	/* The prefixes diverge at bit common */
+	branch = route_trie_node_alloc(&route->addr, common);
+	if (branch == NULL) {
+		k_mem_slab_free(&route_trie_slab, new);
+		return -ENOMEM;
+	}
+
+	branch->child[addr_bit(&route->addr, common)] = new;
+	branch->child[addr_bit(&node->prefix, common)] = node;
+	*link = branch;
+
+	return 0;
+}
+
+/* Replace a node without routes and with at most one child by this child */
+static void route_trie_prune(struct route_trie_node **link)
+{
+	struct route_trie_node *node = *link;
+
+	if (!sys_slist_is_empty(&node->routes) ||
+	    (node->child[0] != NULL && node->child[1] != NULL)) {
+		return;
+	}
+
+	*link = (node->child[0] != NULL) ? node->child[0] : node->child[1];
+	k_mem_slab_free(&route_trie_slab, node);
+}
+
+static void route_trie_remove(struct net_route_entry *route)
+{
+	struct route_trie_node **parent_link = NULL;
+	struct route_trie_node **link = &route_trie;
+	struct route_trie_node *node;
+
+	while ((node = *link) != NULL && node->prefix_len < route->prefix_len) {
+		parent_link = link;
+		link = &node->child[addr_bit(&route->addr, node->prefix_len)];
+	}
+
+	if (node == NULL || node->prefix_len != route->prefix_len ||
+	    !sys_slist_find_and_remove(&node->routes, &route->trie_node)) {
+		return;
+	}
+
+	route_trie_prune(link);
+
+	/* A branch node is left with a single child if node was a leaf */
+	if (parent_link != NULL) {
+		route_trie_prune(parent_link);
+	}
+}
+
+static struct net_route_entry *route_find(struct net_if *iface,
+					  struct net_in6_addr *dst)
+{
+	struct route_trie_node *node = route_trie;
+	struct net_route_entry *route, *found = NULL;
+
+	while (node != NULL &&
+	       net_ipv6_is_prefix(dst->s6_addr, node->prefix.s6_addr,
+				  node->prefix_len)) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&node->routes, route, trie_node) {
+			if (iface == NULL || route->iface == iface) {
+				found = route;
+				break;
+			}
+		}
+
+		if (node->prefix_len == 128U) {
+			break;
+		}
+
+		node = node->child[addr_bit(dst, node->prefix_len)];
+	}
+
+	return found;
+}
+#else
+static inline int route_trie_insert(struct net_route_entry *route)
+{
+	ARG_UNUSED(route);
+
+	return 0;
+}
+
+static inline void route_trie_remove(struct net_route_entry *route)
+{
+	ARG_UNUSED(route);
+}
+
+static struct net_route_entry *route_find(struct net_if *iface,
+					  struct net_in6_addr *dst)
 {
 	struct net_route_entry *route, *found = NULL;
 	uint8_t longest_match = 0U;
 	int i;
 
-	net_ipv6_nbr_lock();
-
 	for (i = 0; i < CONFIG_NET_MAX_ROUTES && longest_match < 128; i++) {
 		struct net_nbr *nbr = get_nbr(i);
 
@@ -298,6 +490,84 @@ struct net_route_entry *net_route_lookup(struct net_if *iface,
 		}
 	}
 
+	return found;
+}
+#endif /* CONFIG_NET_ROUTE_LPM_TRIE */
+
+#if CONFIG_NET_ROUTE_CACHE_SIZE > 0
+/* Direct-mapped cache of the recent lookups, flushed on route changes */
+struct route_cache_entry {
+	struct net_in6_addr dst;
+	struct net_if *iface;
+	struct net_route_entry *route;
+};
+
+static struct route_cache_entry route_cache[CONFIG_NET_ROUTE_CACHE_SIZE];
+
+static struct route_cache_entry *route_cache_slot(struct net_if *iface,
+						  struct net_in6_addr *dst)
+{
+	uint32_t hash = (uint32_t)(uintptr_t)iface;
+
+	for (int i = 0; i < ARRAY_SIZE(dst->s6_addr32); i++) {
+		hash ^= UNALIGNED_GET(&dst->s6_addr32[i]);
+	}
+
+	hash ^= hash >> 16;
+	hash *= 0x45d9f3bU;
+	hash ^= hash >> 16;
+
+	return &route_cache[hash % CONFIG_NET_ROUTE_CACHE_SIZE];
+}
+
+static struct net_route_entry *route_cache_get(struct net_if *iface,
+					       struct net_in6_addr *dst)
+{
+	struct route_cache_entry *entry = route_cache_slot(iface, dst);
+
+	if (entry->route == NULL || entry->iface != iface ||
+	    !net_ipv6_addr_cmp(&entry->dst, dst)) {
+		return NULL;
+	}
+
+	return entry->route;
+}
+
+static void route_cache_put(struct net_if *iface, struct net_in6_addr *dst,
+			    struct net_route_entry *route)
+{
+	struct route_cache_entry *entry = route_cache_slot(iface, dst);
+
+	net_ipaddr_copy(&entry->dst, dst);
+	entry->iface = iface;
+	entry->route = route;
+}
+
+static void route_cache_flush(void)
+{
+	memset(route_cache, 0, sizeof(route_cache));
+}
+#else
+#define route_cache_get(iface, dst) NULL
+#define route_cache_put(iface, dst, route)
+#define route_cache_flush()
+#endif /* CONFIG_NET_ROUTE_CACHE_SIZE > 0 */
+
+struct net_route_entry *net_route_lookup(struct net_if *iface,
+					 struct net_in6_addr *dst)
+{
+	struct net_route_entry *found;
+
+	net_ipv6_nbr_lock();
+
+	found = route_cache_get(iface, dst);
+	if (found == NULL) {
+		found = route_find(iface, dst);
+		if (found != NULL) {
+			route_cache_put(iface, dst, found);
+		}
+	}
+
 	if (found) {
 		net_route_info("Found", found, dst);
 
@@ -393,9 +663,7 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	nbr = nbr_new(iface, addr, prefix_len);
 	if (!nbr) {
 		/* Remove the oldest route and try again */
-		sys_snode_t *last = sys_slist_peek_tail(&routes);
-
-		sys_slist_find_and_remove(&routes, last);
+		sys_dnode_t *last = sys_dlist_peek_tail(&routes);
 
 		route = CONTAINER_OF(last,
 				     struct net_route_entry,
@@ -442,9 +710,20 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	route->iface = iface;
 	route->preference = preference;
 
+	if (route_trie_insert(route) < 0) {
+		NET_ERR("No route trie node available!");
+		release_nexthop_route(nexthop_route);
+		nbr_free(nbr);
+		route = NULL;
+		goto exit;
+	}
+
+	route_cache_flush();
+	net_fastpath_flush(&route->addr, route->prefix_len);
+
 	net_route_update_lifetime(route, lifetime);
 
-	sys_slist_prepend(&routes, &route->node);
+	sys_dlist_prepend(&routes, &route->node);
 
 	tmp = nbr_nexthop_get(iface, nexthop);
 
@@ -586,7 +865,9 @@ int net_route_del(struct net_route_entry *route)
 		}
 	}
 
-	sys_slist_find_and_remove(&routes, &route->node);
+	if (sys_dnode_is_linked(&route->node)) {
+		sys_dlist_remove(&route->node);
+	}
 
 	nbr = net_route_get_nbr(route);
 	if (!nbr) {
@@ -594,6 +875,10 @@ int net_route_del(struct net_route_entry *route)
 		return -ENOENT;
 	}
 
+	route_trie_remove(route);
+	route_cache_flush();
+	net_fastpath_flush(&route->addr, route->prefix_len);
+
 	net_route_info("Deleted", route, &route->addr);
 
 	SYS_SLIST_FOR_EACH_CONTAINER(&route->nexthop, nexthop_route, node) {
@@ -1113,6 +1398,10 @@ int net_route_packet(struct net_pkt *pkt, struct net_in6_addr *nexthop)
 
 	net_pkt_set_iface(pkt, nbr->iface);
 
+	if (lladdr) {
+		net_fastpath_learn(pkt, lladdr);
+	}
+
 	net_ipv6_nbr_unlock();
 
 	return net_send_data(pkt);
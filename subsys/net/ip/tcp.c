@@ -59,15 +59,15 @@ static int tcp_tx_window =
 	CONFIG_NET_PKT_BUF_TX_DATA_POOL_SIZE / 3;
 #endif /* CONFIG_NET_BUF_FIXED_DATA_SIZE */
 #endif
-#ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
+#if defined(CONFIG_NET_TCP_RANDOMIZED_RTO) || defined(CONFIG_NET_TCP_TIMESTAMPS)
 #define TCP_RTO_MS (conn->rto)
 #else
 #define TCP_RTO_MS (tcp_rto)
 #endif
 
-/* Define the number of MSS sections the congestion window is initialized at */
-#define TCP_CONGESTION_INITIAL_WIN 1
-#define TCP_CONGESTION_INITIAL_SSTHRESH 3
+/* Options are padded with NOPs so that each of them is 32-bit aligned */
+#define TCP_TIMESTAMP_OPT_LEN 12
+#define TCP_SACK_OPT_LEN(_n) (4 + (_n) * NET_TCP_SACK_BLOCK_SIZE)
 
 static sys_slist_t tcp_conns = SYS_SLIST_STATIC_INIT(&tcp_conns);
 
@@ -473,26 +473,62 @@ out:
 
 static void tcp_derive_rto(struct tcp *conn)
 {
+#if defined(CONFIG_NET_TCP_RANDOMIZED_RTO) || defined(CONFIG_NET_TCP_TIMESTAMPS)
+	uint32_t rto = (uint32_t)tcp_rto;
 #ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
-	/* Compute a randomized rto 1 and 1.5 times tcp_rto */
 	uint32_t gain;
 	uint8_t gain8;
-	uint32_t rto;
+#endif
 
-	/* Getting random is computational expensive, so only use 8 bits */
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	if (conn->srtt != 0U) {
+		/* RFC 6298: RTO = SRTT + max(G, 4 * RTTVAR), with the
+		 * configured initial RTO as the lower bound.
+		 */
+		rto = MAX((conn->srtt >> 3) + MAX(1U, conn->rttvar), rto);
+	}
+#endif
+#ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
+	/* Compute a randomized rto 1 and 1.5 times the base rto.
+	 * Getting random is computational expensive, so only use 8 bits.
+	 */
 	sys_rand_get(&gain8, sizeof(uint8_t));
 
 	gain = (uint32_t)gain8;
 	gain += 1 << 9;
 
-	rto = (uint32_t)tcp_rto;
 	rto = (gain * rto) >> 9;
-	conn->rto = (uint16_t)rto;
+#endif
+	conn->rto = (uint16_t)MIN(rto, UINT16_MAX);
 #else
 	ARG_UNUSED(conn);
 #endif
 }
 
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+/* Update the RTT estimators of RFC 6298 with a new sample */
+static void tcp_rtt_sample(struct tcp *conn, uint32_t rtt)
+{
+	int32_t delta;
+
+	if (conn->srtt == 0U) {
+		conn->srtt = MAX(rtt, 1U) << 3;
+		conn->rttvar = rtt << 1;
+	} else {
+		/* SRTT += (R - SRTT) / 8, RTTVAR += (|SRTT - R| - RTTVAR) / 4 */
+		delta = (int32_t)rtt - (int32_t)(conn->srtt >> 3);
+		conn->srtt = MAX((int32_t)conn->srtt + delta, 1);
+		delta = (delta < 0) ? -delta : delta;
+		conn->rttvar += delta - (int32_t)(conn->rttvar >> 2);
+	}
+
+	NET_DBG("[%p] rtt=%u srtt=%u rttvar=%u", conn, rtt,
+		conn->srtt >> 3, conn->rttvar >> 2);
+
+	tcp_derive_rto(conn);
+}
+#endif
+
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
 
 /* Implementation according to RFC6582 */
@@ -536,7 +572,7 @@ static void tcp_new_reno_dup_ack(struct tcp *conn)
 	int32_t new_win = conn->ca.cwnd;
 
 	new_win += conn_mss(conn);
-	conn->ca.cwnd = MIN(new_win, UINT16_MAX);
+	conn->ca.cwnd = MIN(new_win, (int32_t)TCP_WIN_MAX);
 	tcp_new_reno_log(conn, "dup_ack");
 }
 
@@ -552,7 +588,7 @@ static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
 			/* Implement a div_ceil	to avoid rounding to 0 */
 			new_win += ((win_inc * win_inc) + conn->ca.cwnd - 1) / conn->ca.cwnd;
 		}
-		conn->ca.cwnd = MIN(new_win, UINT16_MAX);
+		conn->ca.cwnd = MIN(new_win, (int32_t)TCP_WIN_MAX);
 	} else {
 		/* Check if it is still in fast recovery mode */
 		if (conn->ca.pending_fast_retransmit_bytes <= acked_len) {
@@ -566,29 +602,119 @@ static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
 	tcp_new_reno_log(conn, "pkts_acked");
 }
 
+static const struct tcp_cc_ops tcp_new_reno_ops = {
+	.name = "newreno",
+	.init = tcp_new_reno_init,
+	.fast_retransmit = tcp_new_reno_fast_retransmit,
+	.timeout = tcp_new_reno_timeout,
+	.dup_ack = tcp_new_reno_dup_ack,
+	.pkts_acked = tcp_new_reno_pkts_acked,
+};
+
+static const struct tcp_cc_ops *const tcp_cc_algorithms[] = {
+	&tcp_new_reno_ops,
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC)
+	&tcp_cubic_ops,
+#endif
+};
+
+static const struct tcp_cc_ops *tcp_cc_default(void)
+{
+#if defined(CONFIG_NET_TCP_CONGESTION_DEFAULT_CUBIC)
+	return &tcp_cubic_ops;
+#else
+	return &tcp_new_reno_ops;
+#endif
+}
+
+static const struct tcp_cc_ops *tcp_cc_find(const char *name, size_t len)
+{
+	ARRAY_FOR_EACH(tcp_cc_algorithms, i) {
+		const struct tcp_cc_ops *cc = tcp_cc_algorithms[i];
+
+		if (strlen(cc->name) == len && strncmp(cc->name, name, len) == 0) {
+			return cc;
+		}
+	}
+
+	return NULL;
+}
+
 static void tcp_ca_init(struct tcp *conn)
 {
-	tcp_new_reno_init(conn);
+	conn->cc->init(conn);
 }
 
 static void tcp_ca_fast_retransmit(struct tcp *conn)
 {
-	tcp_new_reno_fast_retransmit(conn);
+	conn->cc->fast_retransmit(conn);
 }
 
 static void tcp_ca_timeout(struct tcp *conn)
 {
-	tcp_new_reno_timeout(conn);
+	conn->cc->timeout(conn);
 }
 
 static void tcp_ca_dup_ack(struct tcp *conn)
 {
-	tcp_new_reno_dup_ack(conn);
+	conn->cc->dup_ack(conn);
 }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len)
 {
-	tcp_new_reno_pkts_acked(conn, acked_len);
+	conn->cc->pkts_acked(conn, acked_len);
+}
+
+/* Accepted connections use the algorithm of the listening socket */
+static void tcp_ca_copy(struct tcp *to, struct tcp *from)
+{
+	to->cc = from->cc;
+}
+
+static int set_tcp_congestion(struct tcp *conn, const void *value, uint32_t len)
+{
+	const struct tcp_cc_ops *cc;
+
+	if (value == NULL || len == 0U) {
+		return -EINVAL;
+	}
+
+	cc = tcp_cc_find(value, strnlen(value, MIN(len, NET_TCP_CC_NAME_MAX)));
+	if (cc == NULL) {
+		return -ENOENT;
+	}
+
+	if (cc == conn->cc) {
+		return 0;
+	}
+
+	conn->cc = cc;
+
+	if (net_context_get_state(conn->context) == NET_CONTEXT_CONNECTED) {
+		struct tcp_collision_avoidance_reno ca = conn->ca;
+
+		/* Only the state private to the new algorithm is set up, the
+		 * connection goes on with its current window.
+		 */
+		tcp_ca_init(conn);
+		conn->ca = ca;
+	}
+
+	return 0;
+}
+
+static int get_tcp_congestion(struct tcp *conn, void *value, uint32_t *len)
+{
+	size_t name_len = strlen(conn->cc->name) + 1;
+
+	if (len == NULL) {
+		return -EINVAL;
+	}
+
+	*len = MIN(*len, name_len);
+	memcpy(value, conn->cc->name, *len);
+
+	return 0;
 }
 #else
 
@@ -602,6 +728,77 @@ static void tcp_ca_dup_ack(struct tcp *conn) { }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len) { }
 
+static void tcp_ca_copy(struct tcp *to, struct tcp *from) { }
+
+static int set_tcp_congestion(struct tcp *conn, const void *value, uint32_t len)
+{
+	return -ENOPROTOOPT;
+}
+
+static int get_tcp_congestion(struct tcp *conn, void *value, uint32_t *len)
+{
+	return -ENOPROTOOPT;
+}
+
+#endif
+
+#if defined(CONFIG_NET_TCP_PACING)
+/* Pacing rate in percent of the congestion window per smoothed RTT */
+#define TCP_PACING_SS_RATIO 200
+#define TCP_PACING_CA_RATIO 120
+
+static uint64_t tcp_pacing_now(void)
+{
+	return k_ticks_to_us_floor64(k_uptime_ticks());
+}
+
+/* Push the time the next segment is due by the time needed to send len
+ * bytes at the pacing rate.
+ */
+static void tcp_pacing_update(struct tcp *conn, uint32_t len)
+{
+	uint64_t interval;
+	uint32_t ratio;
+
+	/* Send at line rate until the RTT is known */
+	if (conn->srtt == 0U || conn->ca.cwnd == 0U) {
+		return;
+	}
+
+	ratio = (conn->ca.cwnd < conn->ca.ssthresh) ? TCP_PACING_SS_RATIO :
+						      TCP_PACING_CA_RATIO;
+
+	/* srtt is in ms scaled by 8, i.e. 125 us units */
+	interval = (uint64_t)len * conn->srtt * 125U * 100U /
+		   ((uint64_t)conn->ca.cwnd * ratio);
+
+	conn->pacing_next = MAX(conn->pacing_next, tcp_pacing_now()) + interval;
+}
+
+/* Return true if the queued data must wait for the pacing timer. Segments
+ * due within a tick are sent right away, as the timer cannot be any more
+ * precise.
+ */
+static bool tcp_pacing_wait(struct tcp *conn)
+{
+	uint64_t now = tcp_pacing_now();
+
+	if (conn->pacing_next <= now + k_ticks_to_us_ceil64(1)) {
+		return false;
+	}
+
+	(void)k_work_schedule_for_queue(&tcp_work_q, &conn->pacing_timer,
+					K_USEC(conn->pacing_next - now));
+
+	return true;
+}
+#else
+static void tcp_pacing_update(struct tcp *conn, uint32_t len) { }
+
+static bool tcp_pacing_wait(struct tcp *conn)
+{
+	return false;
+}
 #endif
 
 #if defined(CONFIG_NET_TCP_KEEPALIVE)
@@ -901,6 +1098,9 @@ static void tcp_conn_release(struct k_work *work)
 	(void)k_work_cancel_delayable(&conn->ack_timer);
 	(void)k_work_cancel_delayable(&conn->send_timer);
 	(void)k_work_cancel_delayable(&conn->recv_queue_timer);
+#if defined(CONFIG_NET_TCP_PACING)
+	(void)k_work_cancel_delayable(&conn->pacing_timer);
+#endif
 	keep_alive_timer_stop(conn);
 
 	k_mutex_unlock(&conn->lock);
@@ -1096,9 +1296,51 @@ static uint8_t *tcp_options_get(struct net_pkt *pkt, int tcp_options_len,
 	return buf;
 }
 
-static bool tcp_options_check(struct tcp_options *recv_options,
-			      struct net_pkt *pkt, ssize_t len)
+#if defined(CONFIG_NET_TCP_SACK)
+/* Store the SACK blocks reported by the peer, sorted by sequence number.
+ * Blocks which do not cover unacknowledged data are ignored.
+ */
+static void tcp_sack_blocks_parse(struct tcp *conn, const uint8_t *opt,
+				  uint8_t opt_len)
+{
+	struct tcp_sack_block block;
+	int i;
+
+	conn->sacked_cnt = 0U;
+
+	for (opt += 2, opt_len -= 2; opt_len >= NET_TCP_SACK_BLOCK_SIZE;
+	     opt += NET_TCP_SACK_BLOCK_SIZE, opt_len -= NET_TCP_SACK_BLOCK_SIZE) {
+		block.start = net_ntohl(UNALIGNED_GET((uint32_t *)opt));
+		block.end = net_ntohl(UNALIGNED_GET((uint32_t *)(opt + 4)));
+
+		if (!net_tcp_seq_greater(block.end, block.start) ||
+		    !net_tcp_seq_greater(block.start, conn->seq) ||
+		    net_tcp_seq_greater(block.end, conn->seq + conn->send_data_total)) {
+			continue;
+		}
+
+		if (conn->sacked_cnt == ARRAY_SIZE(conn->sacked)) {
+			break;
+		}
+
+		for (i = conn->sacked_cnt; i > 0; i--) {
+			if (!net_tcp_seq_greater(conn->sacked[i - 1].start, block.start)) {
+				break;
+			}
+
+			conn->sacked[i] = conn->sacked[i - 1];
+		}
+
+		conn->sacked[i] = block;
+		conn->sacked_cnt++;
+	}
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
+static bool tcp_options_check(struct tcp *conn, struct net_pkt *pkt,
+			      ssize_t len, bool syn)
 {
+	struct tcp_options *recv_options = &conn->recv_options;
 	uint8_t options_buf[40]; /* TCP header max options size is 40 */
 	bool result = len > 0 && ((len % 4) == 0) ? true : false;
 	uint8_t *options = tcp_options_get(pkt, len, options_buf,
@@ -1107,8 +1349,12 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 	NET_DBG("len=%zd", len);
 
-	recv_options->mss_found = false;
-	recv_options->wnd_found = false;
+	/* MSS, window scale and SACK permitted are only valid in a SYN */
+	if (syn) {
+		recv_options->mss_found = false;
+		recv_options->wnd_found = false;
+		recv_options->sack_perm_found = false;
+	}
 
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
@@ -1143,6 +1389,10 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 				goto end;
 			}
 
+			if (!syn) {
+				break;
+			}
+
 			recv_options->mss =
 				net_ntohs(UNALIGNED_GET((uint16_t *)(options + 2)));
 			recv_options->mss_found = true;
@@ -1154,8 +1404,49 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 				goto end;
 			}
 
-			recv_options->window = opt;
+			if (!syn) {
+				break;
+			}
+
+			recv_options->window = MIN(options[2], NET_TCP_WINDOW_SCALE_MAX);
 			recv_options->wnd_found = true;
+			NET_DBG("WSCALE=%hu", recv_options->window);
+			break;
+		case NET_TCP_SACK_PERM_OPT:
+			if (opt_len != NET_TCP_SACK_PERM_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			if (syn) {
+				recv_options->sack_perm_found = true;
+			}
+			break;
+		case NET_TCP_SACK_OPT:
+			if (((opt_len - 2) % NET_TCP_SACK_BLOCK_SIZE) != 0) {
+				result = false;
+				goto end;
+			}
+
+#if defined(CONFIG_NET_TCP_SACK)
+			if (conn->sack_ok && !syn) {
+				tcp_sack_blocks_parse(conn, options, opt_len);
+			}
+#endif
+			break;
+		case NET_TCP_TIMESTAMP_OPT:
+			if (opt_len != NET_TCP_TIMESTAMP_SIZE) {
+				result = false;
+				goto end;
+			}
+
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+			recv_options->tsval =
+				net_ntohl(UNALIGNED_GET((uint32_t *)(options + 2)));
+			recv_options->tsecr =
+				net_ntohl(UNALIGNED_GET((uint32_t *)(options + 6)));
+#endif
+			recv_options->ts_found = true;
 			break;
 		default:
 			continue;
@@ -1206,10 +1497,10 @@ static int tcp_update_recv_wnd(struct tcp *conn, int32_t delta)
 	bool short_win_before;
 	bool short_win_after;
 
-	new_win = conn->recv_win + delta;
+	new_win = (int32_t)conn->recv_win + delta;
 	if (new_win < 0) {
 		new_win = 0;
-	} else if (new_win > conn->recv_win_max) {
+	} else if (new_win > (int32_t)conn->recv_win_max) {
 		new_win = conn->recv_win_max;
 	}
 
@@ -1346,8 +1637,23 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 	return -EINVAL;
 }
 
+/* Return the receive window to advertise in a segment */
+static uint16_t tcp_adv_win(struct tcp *conn, uint8_t flags)
+{
+	uint32_t win = conn->recv_win;
+
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	/* The window field of a SYN segment is never scaled */
+	if (conn->wscale_ok && !(flags & SYN)) {
+		win >>= conn->recv_wscale;
+	}
+#endif
+
+	return MIN(win, UINT16_MAX);
+}
+
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
-			  uint32_t seq)
+			  uint32_t seq, size_t options_len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct tcphdr *th;
@@ -1361,14 +1667,10 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 
 	UNALIGNED_PUT(conn->src.sin.sin_port, UNALIGNED_MEMBER_ADDR(th, th_sport));
 	UNALIGNED_PUT(conn->dst.sin.sin_port, UNALIGNED_MEMBER_ADDR(th, th_dport));
-	th->th_off = 5;
-
-	if (conn->send_options.mss_found) {
-		th->th_off++;
-	}
+	th->th_off = 5 + options_len / 4;
 
 	UNALIGNED_PUT(flags, &th->th_flags);
-	UNALIGNED_PUT(net_htons(conn->recv_win), UNALIGNED_MEMBER_ADDR(th, th_win));
+	UNALIGNED_PUT(net_htons(tcp_adv_win(conn, flags)), UNALIGNED_MEMBER_ADDR(th, th_win));
 	UNALIGNED_PUT(net_htonl(seq), UNALIGNED_MEMBER_ADDR(th, th_seq));
 
 	if (ACK & flags) {
@@ -1426,23 +1728,117 @@ static int get_tcp_nodelay(struct tcp *conn, void *value, uint32_t *len)
 	return 0;
 }
 
-static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
+#if defined(CONFIG_NET_TCP_SACK)
+/* The receive queue holds a single range of out-of-order data, which is
+ * reported to the peer as a SACK block.
+ */
+static bool tcp_sack_block_get(struct tcp *conn, struct tcp_sack_block *block)
 {
-	NET_PKT_DATA_ACCESS_DEFINE(mss_opt_access, struct tcp_mss_option);
-	struct tcp_mss_option *mss;
-	uint32_t recv_mss;
+	if (!conn->sack_ok || conn->queue_recv_data == NULL) {
+		return false;
+	}
 
-	mss = net_pkt_get_data(pkt, &mss_opt_access);
-	if (!mss) {
-		return -ENOBUFS;
+	block->start = tcp_get_seq(conn->queue_recv_data);
+	block->end = block->start + net_buf_frags_len(conn->queue_recv_data);
+
+	return net_tcp_seq_greater(block->start, conn->ack);
+}
+#endif
+
+/* Length of the options carried by the data segments of an established
+ * connection, which is deducted from the MSS when sending data.
+ */
+static size_t tcp_data_options_len(struct tcp *conn)
+{
+	size_t len = 0;
+#if defined(CONFIG_NET_TCP_SACK)
+	struct tcp_sack_block block;
+#endif
+
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	if (conn->ts_ok) {
+		len += TCP_TIMESTAMP_OPT_LEN;
+	}
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	if (tcp_sack_block_get(conn, &block)) {
+		len += TCP_SACK_OPT_LEN(1);
 	}
+#endif
+	ARG_UNUSED(conn);
+
+	return len;
+}
+
+/* Write the options of a segment with the given flags into buf, which must
+ * hold the 40 bytes of the largest TCP option list. Each option is padded
+ * with NOPs to keep the options 32-bit aligned. Returns the options length.
+ */
+static size_t tcp_options_build(struct tcp *conn, uint8_t flags, uint8_t *buf)
+{
+	/* Options are offered in a SYN, and only answered in a SYN-ACK if
+	 * the peer offered them.
+	 */
+	bool offer = (flags & SYN) && !(flags & ACK);
+	uint8_t *opt = buf;
+#if defined(CONFIG_NET_TCP_SACK)
+	struct tcp_sack_block block;
+#endif
+
+	if (conn->send_options.mss_found) {
+		*opt++ = NET_TCP_MSS_OPT;
+		*opt++ = NET_TCP_MSS_SIZE;
+		UNALIGNED_PUT(net_htons(net_tcp_get_supported_mss(conn)), (uint16_t *)opt);
+		opt += sizeof(uint16_t);
+	}
+
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	if ((flags & SYN) && (offer || conn->wscale_ok)) {
+		*opt++ = NET_TCP_NOP_OPT;
+		*opt++ = NET_TCP_WINDOW_SCALE_OPT;
+		*opt++ = NET_TCP_WINDOW_SCALE_SIZE;
+		*opt++ = conn->recv_wscale;
+	}
+#endif
+
+#if defined(CONFIG_NET_TCP_SACK)
+	if ((flags & SYN) && (offer || conn->sack_ok)) {
+		*opt++ = NET_TCP_NOP_OPT;
+		*opt++ = NET_TCP_NOP_OPT;
+		*opt++ = NET_TCP_SACK_PERM_OPT;
+		*opt++ = NET_TCP_SACK_PERM_SIZE;
+	}
+#endif
 
-	recv_mss = net_tcp_get_supported_mss(conn);
-	recv_mss |= (NET_TCP_MSS_OPT << 24) | (NET_TCP_MSS_SIZE << 16);
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	if (offer || conn->ts_ok) {
+		*opt++ = NET_TCP_NOP_OPT;
+		*opt++ = NET_TCP_NOP_OPT;
+		*opt++ = NET_TCP_TIMESTAMP_OPT;
+		*opt++ = NET_TCP_TIMESTAMP_SIZE;
+		UNALIGNED_PUT(net_htonl(k_uptime_get_32()), (uint32_t *)opt);
+		opt += sizeof(uint32_t);
+		UNALIGNED_PUT(net_htonl((flags & ACK) ? conn->ts_recent : 0U),
+			      (uint32_t *)opt);
+		opt += sizeof(uint32_t);
+	}
+#endif
 
-	UNALIGNED_PUT(net_htonl(recv_mss), (uint32_t *)mss);
+#if defined(CONFIG_NET_TCP_SACK)
+	if (!(flags & SYN) && (flags & ACK) && tcp_sack_block_get(conn, &block)) {
+		*opt++ = NET_TCP_NOP_OPT;
+		*opt++ = NET_TCP_NOP_OPT;
+		*opt++ = NET_TCP_SACK_OPT;
+		*opt++ = 2 + NET_TCP_SACK_BLOCK_SIZE;
+		UNALIGNED_PUT(net_htonl(block.start), (uint32_t *)opt);
+		opt += sizeof(uint32_t);
+		UNALIGNED_PUT(net_htonl(block.end), (uint32_t *)opt);
+		opt += sizeof(uint32_t);
+	}
+#endif
+	ARG_UNUSED(offer);
 
-	return net_pkt_set_data(pkt, &mss_opt_access);
+	return opt - buf;
 }
 
 static bool is_destination_local(struct net_pkt *pkt)
@@ -1557,14 +1953,12 @@ err:
 static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		       uint32_t seq)
 {
-	size_t alloc_len = sizeof(struct tcphdr);
+	uint8_t options[40]; /* TCP header max options size is 40 */
+	size_t options_len = tcp_options_build(conn, flags, options);
+	size_t alloc_len = sizeof(struct tcphdr) + options_len;
 	struct net_pkt *pkt;
 	int ret = 0;
 
-	if (conn->send_options.mss_found) {
-		alloc_len += sizeof(uint32_t);
-	}
-
 	pkt = tcp_pkt_alloc(conn, alloc_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
@@ -1583,14 +1977,19 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		goto out;
 	}
 
-	ret = tcp_header_add(conn, pkt, flags, seq);
+	/* A super-segment looped back to a local address is received whole */
+	if (data && net_pkt_gso_size(data) > 0U && !is_destination_local(pkt)) {
+		net_pkt_set_gso_size(pkt, net_pkt_gso_size(data));
+	}
+
+	ret = tcp_header_add(conn, pkt, flags, seq, options_len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		goto out;
 	}
 
-	if (conn->send_options.mss_found) {
-		ret = net_tcp_set_mss_opt(conn, pkt);
+	if (options_len > 0) {
+		ret = net_pkt_write(pkt, options, options_len);
 		if (ret < 0) {
 			tcp_pkt_unref(pkt);
 			goto out;
@@ -1650,6 +2049,59 @@ static int tcp_pkt_pull(struct net_pkt *pkt, size_t len)
 	return ret;
 }
 
+static bool tcp_send_data_is_zc(struct tcp *conn)
+{
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+	return conn->send_data_zc;
+#else
+	ARG_UNUSED(conn);
+
+	return false;
+#endif
+}
+
+/* Remove the acknowledged data from the send queue. Zero-copy data belongs
+ * to the application and must not be moved, so the buffers are pulled
+ * instead.
+ */
+static int tcp_send_data_pull(struct tcp *conn, size_t len)
+{
+	struct net_pkt *pkt = &conn->send_data;
+	struct net_buf *buf;
+
+	if (!tcp_send_data_is_zc(conn)) {
+		return tcp_pkt_pull(pkt, len);
+	}
+
+	if (len > net_pkt_get_len(pkt)) {
+		return -EINVAL;
+	}
+
+	while (len > 0) {
+		buf = pkt->buffer;
+
+		if (buf->len > len) {
+			net_buf_pull(buf, len);
+			break;
+		}
+
+		len -= buf->len;
+		pkt->buffer = buf->frags;
+		buf->frags = NULL;
+		net_buf_unref(buf);
+	}
+
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+	if (pkt->buffer == NULL) {
+		conn->send_data_zc = false;
+	}
+#endif
+
+	net_pkt_cursor_init(pkt);
+
+	return 0;
+}
+
 static int tcp_pkt_trim_data(struct tcp *conn, struct net_pkt *pkt, size_t data_len,
 			     size_t trim_len)
 {
@@ -1761,6 +2213,72 @@ static int tcp_pkt_append(struct net_pkt *pkt, const uint8_t *data, size_t len)
 	return ret;
 }
 
+/* Queue zero-copy data, which is then referenced until it is acknowledged */
+static int tcp_send_data_append_zc(struct tcp *conn, struct net_buf *zc_send,
+				   const void *data, size_t len)
+{
+	struct net_buf *buf;
+
+	if (len == 0) {
+		return 0;
+	}
+
+	buf = net_zc_tx_buf_get(zc_send, data, len, TCP_PKT_ALLOC_TIMEOUT);
+	if (buf == NULL) {
+		return -ENOBUFS;
+	}
+
+	net_pkt_append_buffer(&conn->send_data, buf);
+
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+	conn->send_data_zc = true;
+#endif
+
+	return 0;
+}
+
+/* Same as tcp_pkt_peek(), but the zero-copy data is referenced instead of
+ * being copied.
+ */
+static int tcp_pkt_peek_zc(struct net_pkt *to, struct net_pkt *from, size_t pos,
+			   size_t len)
+{
+	struct net_buf *frag;
+	size_t frag_len;
+	int ret;
+
+	for (struct net_buf *buf = from->buffer; buf != NULL && len > 0; buf = buf->frags) {
+		if (pos >= buf->len) {
+			pos -= buf->len;
+			continue;
+		}
+
+		frag_len = MIN(buf->len - pos, len);
+
+		if (net_zc_tx_buf_is_zc(buf)) {
+			frag = net_zc_tx_buf_slice(buf, pos, frag_len,
+						   TCP_PKT_ALLOC_TIMEOUT);
+			if (frag == NULL) {
+				return -ENOBUFS;
+			}
+
+			net_pkt_append_buffer(to, frag);
+		} else {
+			ret = tcp_pkt_append(to, buf->data + pos, frag_len);
+			if (ret < 0) {
+				return ret;
+			}
+		}
+
+		pos = 0;
+		len -= frag_len;
+	}
+
+	net_pkt_cursor_init(to);
+
+	return (len > 0) ? -EINVAL : 0;
+}
+
 static bool tcp_window_full(struct tcp *conn)
 {
 	bool window_full = (conn->send_data_total >= conn->send_win);
@@ -1814,31 +2332,115 @@ static void tcp_setup_retransmission(struct tcp *conn)
 	k_work_reschedule_for_queue(&tcp_work_q, &conn->send_data_timer, K_MSEC(TCP_RTO_MS));
 }
 
+#if defined(CONFIG_NET_TCP_SACK)
+/* Move the send position past the data already held by the peer */
+static void tcp_sack_skip(struct tcp *conn)
+{
+	for (int i = 0; i < conn->sacked_cnt; i++) {
+		uint32_t pos = conn->seq + conn->unacked_len;
+
+		if (!net_tcp_seq_greater(conn->sacked[i].start, pos) &&
+		    net_tcp_seq_greater(conn->sacked[i].end, pos)) {
+			conn->unacked_len = conn->sacked[i].end - conn->seq;
+		}
+	}
+}
+
+/* Limit len to the hole before the next data held by the peer */
+static int tcp_sack_hole_len(struct tcp *conn, int len)
+{
+	uint32_t pos = conn->seq + conn->unacked_len;
+
+	for (int i = 0; i < conn->sacked_cnt; i++) {
+		if (net_tcp_seq_greater(conn->sacked[i].start, pos)) {
+			return MIN(len, (int)(conn->sacked[i].start - pos));
+		}
+	}
+
+	return len;
+}
+
+/* Tell if there is still a hole below the highest data held by the peer */
+static bool tcp_sack_hole_pending(struct tcp *conn)
+{
+	return conn->sacked_cnt > 0 &&
+	       net_tcp_seq_greater(conn->sacked[conn->sacked_cnt - 1].start,
+				   conn->seq + conn->unacked_len);
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
+#if defined(CONFIG_NET_GSO)
+/* Return how much data can be sent at once as a super-segment, which is
+ * split into segments of seg_len bytes before reaching the driver.
+ * Retransmissions are kept to a single segment.
+ */
+static int tcp_gso_max_len(struct tcp *conn, int seg_len)
+{
+	if (conn->data_mode == TCP_DATA_MODE_RESEND || seg_len <= 0) {
+		return seg_len;
+	}
+
+	return seg_len * MAX(CONFIG_NET_GSO_MAX_SIZE / seg_len, 1);
+}
+#else
+#define tcp_gso_max_len(conn, seg_len) (seg_len)
+#endif
+
 static int tcp_send_data(struct tcp *conn)
 {
 	int ret = 0;
+	int seg_len;
 	int len;
 	struct net_pkt *pkt;
 
-	len = MIN(tcp_unsent_len(conn), conn_mss(conn));
+#if defined(CONFIG_NET_TCP_SACK)
+	tcp_sack_skip(conn);
+#endif
+
+	seg_len = conn_mss(conn) - (int)tcp_data_options_len(conn);
+	len = MIN(tcp_unsent_len(conn), tcp_gso_max_len(conn, seg_len));
 	if (len < 0) {
 		ret = len;
 		goto out;
 	}
+
+#if defined(CONFIG_NET_TCP_SACK)
+	len = tcp_sack_hole_len(conn, len);
+#endif
 	if (len == 0) {
 		NET_DBG("[%p] no data to send", conn);
 		ret = -ENODATA;
 		goto out;
 	}
 
-	pkt = tcp_pkt_alloc(conn, len);
+	if (tcp_send_data_is_zc(conn)) {
+		/* The buffers are added when the data is peeked */
+		pkt = tcp_pkt_alloc(conn, 0);
+	} else {
+		pkt = tcp_pkt_alloc(conn, len);
+		if (!pkt && len > seg_len) {
+			/* Fall back to a single segment */
+			len = seg_len;
+			pkt = tcp_pkt_alloc(conn, len);
+		}
+	}
+
 	if (!pkt) {
 		NET_ERR("[%p] packet allocation failed, len=%d", conn, len);
 		ret = -ENOBUFS;
 		goto out;
 	}
 
-	ret = tcp_pkt_peek(pkt, &conn->send_data, conn->unacked_len, len);
+	if (len > seg_len) {
+		net_pkt_set_gso_size(pkt, seg_len);
+	}
+
+	if (tcp_send_data_is_zc(conn)) {
+		ret = tcp_pkt_peek_zc(pkt, &conn->send_data, conn->unacked_len, len);
+	} else {
+		ret = tcp_pkt_peek(pkt, &conn->send_data, conn->unacked_len, len);
+	}
+
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		ret = -ENOBUFS;
@@ -1848,6 +2450,7 @@ static int tcp_send_data(struct tcp *conn)
 	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
 	if (ret == 0) {
 		conn->unacked_len += len;
+		tcp_pacing_update(conn, len);
 
 		if (conn->data_mode == TCP_DATA_MODE_RESEND) {
 			net_stats_update_tcp_resent(conn->iface, len);
@@ -1870,6 +2473,43 @@ static int tcp_send_data(struct tcp *conn)
 	return ret;
 }
 
+#if defined(CONFIG_NET_TCP_SACK)
+/* Resend the holes following the one just resent during a fast
+ * retransmit, for as long as the data in flight fits in the window
+ * (RFC 6675 section 5). The data beyond the highest byte held by the
+ * peer is counted as in flight, the holes below it as lost.
+ */
+static void tcp_sack_resend_holes(struct tcp *conn, int outstanding)
+{
+	uint32_t win = conn->send_win;
+	int pipe;
+
+	if (conn->sacked_cnt == 0) {
+		return;
+	}
+
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+	win = MIN(win, conn->ca.cwnd);
+#endif
+
+	pipe = outstanding - (int)(conn->sacked[conn->sacked_cnt - 1].end - conn->seq) +
+	       conn->unacked_len;
+
+	while (tcp_sack_hole_pending(conn) && pipe < (int)win) {
+		int pos;
+
+		tcp_sack_skip(conn);
+		pos = conn->unacked_len;
+
+		if (tcp_send_data(conn) < 0) {
+			break;
+		}
+
+		pipe += conn->unacked_len - pos;
+	}
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
 /* Send all queued but unsent data from the send_data packet by packet
  * until the receiver's window is full. */
 static int tcp_send_queued_data(struct tcp *conn)
@@ -1895,6 +2535,10 @@ static int tcp_send_queued_data(struct tcp *conn)
 			}
 		}
 
+		if (tcp_pacing_wait(conn)) {
+			break;
+		}
+
 		ret = tcp_send_data(conn);
 		if (ret < 0) {
 			break;
@@ -1916,6 +2560,22 @@ static int tcp_send_queued_data(struct tcp *conn)
 	return ret;
 }
 
+#if defined(CONFIG_NET_TCP_PACING)
+static void tcp_pacing_send(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct tcp *conn = CONTAINER_OF(dwork, struct tcp, pacing_timer);
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	if (conn->state != TCP_UNUSED) {
+		(void)tcp_send_queued_data(conn);
+	}
+
+	k_mutex_unlock(&conn->lock);
+}
+#endif
+
 static void tcp_cleanup_recv_queue(struct k_work *work)
 {
 	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
@@ -1972,6 +2632,14 @@ static void tcp_resend_data(struct k_work *work)
 		conn->data_mode = TCP_DATA_MODE_RESEND;
 		conn->unacked_len = 0;
 
+#if defined(CONFIG_NET_TCP_SACK)
+		/* The peer may have discarded the data it reported, so
+		 * resend from the first unacknowledged byte (RFC 2018
+		 * section 8).
+		 */
+		conn->sacked_cnt = 0U;
+#endif
+
 		ret = tcp_send_data(conn);
 		if (ret == -ENODATA) {
 			NET_ERR("TCP exception with no data for retransmission");
@@ -2189,10 +2857,10 @@ static struct tcp *tcp_conn_alloc(void)
 
 	conn->in_connect = false;
 	conn->state = TCP_LISTEN;
-	conn->recv_win_max = tcp_rx_window;
+	conn->recv_win_max = MIN((uint32_t)tcp_rx_window, TCP_WIN_MAX);
 	conn->recv_win = conn->recv_win_max;
 	conn->recv_win_sent = conn->recv_win_max;
-	conn->send_win_max = MAX(tcp_tx_window, NET_IPV6_MTU);
+	conn->send_win_max = MIN((uint32_t)MAX(tcp_tx_window, NET_IPV6_MTU), TCP_WIN_MAX);
 	conn->send_win = conn->send_win_max;
 	conn->tcp_nodelay = false;
 	conn->addr_ref_done = false;
@@ -2203,7 +2871,8 @@ static struct tcp *tcp_conn_alloc(void)
 	/* Initially set the congestion window at its max size, since only the MSS
 	 * is available as soon as the connection is established
 	 */
-	conn->ca.cwnd = UINT16_MAX;
+	conn->ca.cwnd = TCP_WIN_MAX;
+	conn->cc = tcp_cc_default();
 #endif
 
 	/* The ISN value will be set when we get the connection attempt or
@@ -2220,6 +2889,9 @@ static struct tcp *tcp_conn_alloc(void)
 	k_work_init_delayable(&conn->recv_queue_timer, tcp_cleanup_recv_queue);
 	k_work_init_delayable(&conn->persist_timer, tcp_send_zwp);
 	k_work_init_delayable(&conn->ack_timer, tcp_send_ack);
+#if defined(CONFIG_NET_TCP_PACING)
+	k_work_init_delayable(&conn->pacing_timer, tcp_pacing_send);
+#endif
 	k_work_init(&conn->conn_release, tcp_conn_release);
 	keep_alive_timer_init(conn);
 
@@ -2876,7 +3548,10 @@ static void tcp_check_sock_options(struct tcp *conn)
 					     &rcvbuf_opt, NULL);
 	}
 
-	if (sndbuf_opt > 0 && sndbuf_opt != conn->send_win_max) {
+	sndbuf_opt = MIN(sndbuf_opt, (int)TCP_WIN_MAX);
+	rcvbuf_opt = MIN(rcvbuf_opt, (int)TCP_WIN_MAX);
+
+	if (sndbuf_opt > 0 && (uint32_t)sndbuf_opt != conn->send_win_max) {
 		k_mutex_lock(&conn->lock, K_FOREVER);
 
 		conn->send_win_max = sndbuf_opt;
@@ -2887,12 +3562,12 @@ static void tcp_check_sock_options(struct tcp *conn)
 		k_mutex_unlock(&conn->lock);
 	}
 
-	if (rcvbuf_opt > 0 && rcvbuf_opt != conn->recv_win_max) {
+	if (rcvbuf_opt > 0 && (uint32_t)rcvbuf_opt != conn->recv_win_max) {
 		int diff;
 
 		k_mutex_lock(&conn->lock, K_FOREVER);
 
-		diff = rcvbuf_opt - conn->recv_win_max;
+		diff = rcvbuf_opt - (int)conn->recv_win_max;
 		conn->recv_win_max = rcvbuf_opt;
 		tcp_update_recv_wnd(conn, diff);
 
@@ -2900,6 +3575,56 @@ static void tcp_check_sock_options(struct tcp *conn)
 	}
 }
 
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+/* Smallest shift letting the maximum receive window fit the window field */
+static uint8_t tcp_recv_wscale(struct tcp *conn)
+{
+	uint8_t shift = 0U;
+
+	while (shift < NET_TCP_WINDOW_SCALE_MAX &&
+	       (conn->recv_win_max >> shift) > UINT16_MAX) {
+		shift++;
+	}
+
+	return shift;
+}
+#endif
+
+/* Enable the options which both ends offered during the handshake */
+static void tcp_options_negotiate(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	conn->wscale_ok = conn->recv_options.wnd_found;
+	if (conn->wscale_ok) {
+		conn->send_wscale = conn->recv_options.window;
+	} else {
+		conn->send_wscale = 0U;
+		conn->recv_wscale = 0U;
+	}
+#endif
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	conn->ts_ok = conn->recv_options.ts_found;
+	if (conn->ts_ok) {
+		conn->ts_recent = conn->recv_options.tsval;
+	}
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	conn->sack_ok = conn->recv_options.sack_perm_found;
+#endif
+	ARG_UNUSED(conn);
+}
+
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+/* Measure the round-trip time from the timestamp echoed in an ACK */
+static void tcp_ts_rtt_update(struct tcp *conn)
+{
+	if (conn->ts_ok && conn->recv_options.ts_found &&
+	    conn->recv_options.tsecr != 0U) {
+		tcp_rtt_sample(conn, k_uptime_get_32() - conn->recv_options.tsecr);
+	}
+}
+#endif
+
 /* TCP state machine, everything happens here */
 static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 {
@@ -2999,8 +3724,14 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto out;
 	}
 
-	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
-						  tcp_options_len)) {
+	/* Timestamps and SACK blocks only describe the current segment */
+	conn->recv_options.ts_found = false;
+#if defined(CONFIG_NET_TCP_SACK)
+	conn->sacked_cnt = 0U;
+#endif
+
+	if (tcp_options_len && !tcp_options_check(conn, pkt, tcp_options_len,
+						  (th_flags(th) & SYN) != 0)) {
 		NET_DBG("[%p] DROP: Invalid TCP option list", conn);
 		net_tcp_reply_rst(pkt);
 		do_close = true;
@@ -3059,6 +3790,12 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 
 	/* Both the seqnum and the acknum are valid, then do processing. */
 	conn->send_win = net_ntohs(th_win(th));
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	/* The window field of a SYN segment is never scaled */
+	if (conn->wscale_ok && !(th_flags(th) & SYN)) {
+		conn->send_win <<= conn->send_wscale;
+	}
+#endif
 	if (conn->send_win > conn->send_win_max) {
 		NET_DBG("[%p] Lowering send window from %u to %u",
 			conn, conn->send_win, conn->send_win_max);
@@ -3081,6 +3818,14 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		k_sem_give(&conn->tx_sem);
 	}
 
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	/* RFC 7323: echo the timestamp of the segments which are in order */
+	if (conn->ts_ok && conn->recv_options.ts_found &&
+	    net_tcp_seq_cmp(th_seq(th), conn->ack) <= 0) {
+		conn->ts_recent = conn->recv_options.tsval;
+	}
+#endif
+
 	switch (conn->state) {
 	case TCP_LISTEN:
 		if (FL(&fl, ==, SYN)) {
@@ -3092,6 +3837,11 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 				tcp_backlog_dec(conn->accepted_conn);
 			}
 
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+			conn->recv_wscale = tcp_recv_wscale(conn);
+#endif
+			tcp_options_negotiate(conn);
+
 			/* Make sure our MSS is also sent in the ACK */
 			conn->send_options.mss_found = true;
 			conn->isn_peer = th_seq(th);
@@ -3123,6 +3873,7 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 				accept_cb = conn->accepted_conn->accept_cb;
 				context = conn->accepted_conn->context;
 				keep_alive_param_copy(conn, conn->accepted_conn);
+				tcp_ca_copy(conn, conn->accepted_conn);
 			}
 
 			k_work_cancel_delayable(&conn->establish_timer);
@@ -3207,6 +3958,10 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		 */
 		if (FL(&fl, &, SYN | ACK, th && th_ack(th) == conn->seq)) {
 			k_work_cancel_delayable(&conn->send_data_timer);
+			tcp_options_negotiate(conn);
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+			tcp_ts_rtt_update(conn);
+#endif
 			conn->isn_peer = th_seq(th);
 			conn_ack(conn, th_seq(th) + 1);
 			if (len) {
@@ -3275,14 +4030,19 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 				/* Apply a fast retransmit */
 				int temp_unacked_len = conn->unacked_len;
 
+				tcp_ca_fast_retransmit(conn);
+
 				conn->unacked_len = 0;
 
 				(void)tcp_send_data(conn);
 
+#if defined(CONFIG_NET_TCP_SACK)
+				tcp_sack_resend_holes(conn, temp_unacked_len);
+#endif
+
 				/* Restore the current transmission */
 				conn->unacked_len = temp_unacked_len;
 
-				tcp_ca_fast_retransmit(conn);
 				if (tcp_window_full(conn)) {
 					(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
 				}
@@ -3300,8 +4060,7 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 			NET_DBG("[%p] len_acked=%u", conn, len_acked);
 
 			if ((conn->send_data_total < len_acked) ||
-					(tcp_pkt_pull(&conn->send_data,
-						      len_acked) < 0)) {
+					(tcp_send_data_pull(conn, len_acked) < 0)) {
 				NET_ERR("[%p] Invalid len_acked=%u "
 					"(total=%zu)", conn, len_acked,
 					conn->send_data_total);
@@ -3315,6 +4074,9 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 			/* New segment, reset duplicate ack counter */
 			conn->dup_ack_cnt = 0;
+#endif
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+			tcp_ts_rtt_update(conn);
 #endif
 			tcp_ca_pkts_acked(conn, len_acked);
 
@@ -3804,7 +4566,7 @@ int net_tcp_update_recv_wnd(struct net_context *context, int32_t delta)
 }
 
 int net_tcp_queue(struct net_context *context, const void *data, size_t len,
-		  const struct net_msghdr *msg)
+		  const struct net_msghdr *msg, struct net_buf *zc_send)
 {
 	struct tcp *conn = context->tcp;
 	size_t queued_len = 0;
@@ -3844,9 +4606,16 @@ int net_tcp_queue(struct net_context *context, const void *data, size_t len,
 		for (int i = 0; i < msg->msg_iovlen; i++) {
 			int iovlen = MIN(msg->msg_iov[i].iov_len, len);
 
-			ret = tcp_pkt_append(&conn->send_data,
-					     msg->msg_iov[i].iov_base,
-					     iovlen);
+			if (zc_send != NULL) {
+				ret = tcp_send_data_append_zc(conn, zc_send,
+							      msg->msg_iov[i].iov_base,
+							      iovlen);
+			} else {
+				ret = tcp_pkt_append(&conn->send_data,
+						     msg->msg_iov[i].iov_base,
+						     iovlen);
+			}
+
 			if (ret < 0) {
 				if (queued_len == 0) {
 					goto out;
@@ -3863,7 +4632,12 @@ int net_tcp_queue(struct net_context *context, const void *data, size_t len,
 			}
 		}
 	} else {
-		ret = tcp_pkt_append(&conn->send_data, data, len);
+		if (zc_send != NULL) {
+			ret = tcp_send_data_append_zc(conn, zc_send, data, len);
+		} else {
+			ret = tcp_pkt_append(&conn->send_data, data, len);
+		}
+
 		if (ret < 0) {
 			goto out;
 		}
@@ -3912,6 +4686,9 @@ static int tcp_start_handshake(struct tcp *conn)
 	/* Start the connection handshake */
 	k_mutex_lock(&conn->lock, K_FOREVER);
 	tcp_check_sock_options(conn);
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	conn->recv_wscale = tcp_recv_wscale(conn);
+#endif
 	conn->send_options.mss_found = true;
 	ret = tcp_out_ext(conn, SYN, NULL /* no data */, conn->seq);
 	if (ret < 0) {
@@ -4217,6 +4994,11 @@ int net_tcp_finalize(struct net_pkt *pkt, bool force_chksum)
 
 	tcp_hdr->chksum = 0U;
 
+	/* The checksum of a super-segment is computed for each of its segments */
+	if (net_pkt_gso_size(pkt) > 0U && !force_chksum) {
+		return net_pkt_set_data(pkt, &tcp_access);
+	}
+
 	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt), type) || force_chksum) {
 		tcp_hdr->chksum = net_calc_chksum_tcp(pkt);
 		net_pkt_set_chksum_done(pkt, true);
@@ -4232,9 +5014,11 @@ struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
 	enum net_if_checksum_type type = net_pkt_family(pkt) == NET_AF_INET6 ?
 		NET_IF_CHECKSUM_IPV6_TCP : NET_IF_CHECKSUM_IPV4_TCP;
 
+	/* Segments merged by GRO had their checksum verified before */
 	if (IS_ENABLED(CONFIG_NET_TCP_CHECKSUM) &&
 	    (net_if_need_calc_rx_checksum(net_pkt_iface(pkt), type) ||
 	     net_pkt_is_ip_reassembled(pkt)) &&
+	    !(IS_ENABLED(CONFIG_NET_GRO) && net_pkt_is_chksum_done(pkt)) &&
 	    net_calc_chksum_tcp(pkt) != 0U) {
 		NET_DBG("DROP: checksum mismatch");
 		goto drop;
@@ -4683,6 +5467,9 @@ int net_tcp_set_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = set_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = set_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -4720,6 +5507,9 @@ int net_tcp_get_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = get_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = get_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
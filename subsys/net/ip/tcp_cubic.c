@@ -0,0 +1,216 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* CUBIC congestion control, according to RFC 9438 */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+
+#include "tcp_internal.h"
+
+/* Multiplicative decrease factor beta_cubic = 0.7 */
+#define CUBIC_BETA_NUM 7
+#define CUBIC_BETA_DEN 10
+
+/* alpha_cubic = 3 * (1 - beta_cubic) / (1 + beta_cubic) = 9 / 17 */
+#define CUBIC_ALPHA_NUM 9
+#define CUBIC_ALPHA_DEN 17
+
+/* Constant C = 0.4 segments per s^3, i.e. 2 / 5 / 10^9 segments per ms^3 */
+#define CUBIC_C_NUM 2
+#define CUBIC_C_DEN (5ULL * 1000ULL * 1000ULL * 1000ULL)
+
+/* Keep the cube of the time since K times the MSS from overflowing */
+#define CUBIC_MAX_T_MS 50000U
+
+static void tcp_cubic_log(struct tcp *conn, char *step)
+{
+	NET_DBG("[%p] cubic %s, cwnd=%u, ssthres=%u, fast_pend=%u, w_max=%u, k=%u",
+		conn, step, conn->ca.cwnd, conn->ca.ssthresh,
+		conn->ca.pending_fast_retransmit_bytes, conn->cubic.w_max,
+		conn->cubic.k);
+}
+
+static uint32_t cubic_root(uint64_t a)
+{
+	uint64_t y = 0U;
+	uint64_t b;
+
+	for (int s = 63; s >= 0; s -= 3) {
+		y <<= 1;
+		b = 3U * y * (y + 1U) + 1U;
+		if ((a >> s) >= b) {
+			a -= b << s;
+			y++;
+		}
+	}
+
+	return (uint32_t)y;
+}
+
+static uint32_t cubic_rtt_ms(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	return conn->srtt >> 3;
+#else
+	return 0U;
+#endif
+}
+
+static void cubic_epoch_start(struct tcp *conn)
+{
+	struct tcp_cubic *c = &conn->cubic;
+	uint32_t mss = conn_mss(conn);
+
+	c->in_epoch = true;
+	c->epoch_start = k_uptime_get_32();
+	c->w_est = conn->ca.cwnd;
+
+	if (conn->ca.cwnd < c->w_max) {
+		/* K = cubic_root((W_max - cwnd_epoch) / C) */
+		c->k = cubic_root((uint64_t)(c->w_max - conn->ca.cwnd) * CUBIC_C_DEN /
+				  ((uint64_t)mss * CUBIC_C_NUM));
+	} else {
+		c->k = 0U;
+		c->w_max = conn->ca.cwnd;
+	}
+}
+
+/* Return the window the cubic function reaches one RTT from now */
+static uint32_t cubic_target(struct tcp *conn)
+{
+	struct tcp_cubic *c = &conn->cubic;
+	uint32_t t = k_uptime_get_32() - c->epoch_start + cubic_rtt_ms(conn);
+	uint64_t d = (t > c->k) ? (t - c->k) : (c->k - t);
+	uint64_t delta;
+
+	d = MIN(d, CUBIC_MAX_T_MS);
+	delta = d * d * d * CUBIC_C_NUM * conn_mss(conn) / CUBIC_C_DEN;
+
+	if (t < c->k) {
+		return (delta < c->w_max) ? (uint32_t)(c->w_max - delta) : 0U;
+	}
+
+	return (uint32_t)MIN((uint64_t)c->w_max + delta, (uint64_t)TCP_WIN_MAX);
+}
+
+static void cubic_cong_avoid(struct tcp *conn, uint32_t acked_len)
+{
+	struct tcp_cubic *c = &conn->cubic;
+	uint32_t cwnd = conn->ca.cwnd;
+	uint32_t target;
+
+	if (!c->in_epoch) {
+		cubic_epoch_start(conn);
+	}
+
+	/* Window a Reno flow would have, to stay TCP-friendly on short RTTs */
+	c->w_est += ((uint64_t)CUBIC_ALPHA_NUM * acked_len * conn_mss(conn) +
+		     (uint64_t)CUBIC_ALPHA_DEN * cwnd - 1U) /
+		    ((uint64_t)CUBIC_ALPHA_DEN * cwnd);
+
+	target = cubic_target(conn);
+	target = CLAMP(target, cwnd, cwnd + cwnd / 2U);
+	target = MAX(target, c->w_est);
+
+	if (target > cwnd) {
+		/* Grow by (target - cwnd) / cwnd per acknowledged byte, with a
+		 * div_ceil to avoid rounding to 0
+		 */
+		cwnd += ((uint64_t)(target - cwnd) * acked_len + cwnd - 1U) / cwnd;
+	}
+
+	conn->ca.cwnd = MIN(cwnd, TCP_WIN_MAX);
+}
+
+/* Reduce the window on a congestion event, with fast convergence. w_max is
+ * the window reached at the loss event, the new threshold is based on the
+ * data in flight (RFC 9438, section 4.6).
+ */
+static void cubic_reduce(struct tcp *conn)
+{
+	struct tcp_cubic *c = &conn->cubic;
+	uint32_t cwnd = conn->ca.cwnd;
+	uint32_t flight = conn->unacked_len;
+
+	c->in_epoch = false;
+
+	if (cwnd < c->w_max) {
+		c->w_max = (uint32_t)((uint64_t)cwnd * (CUBIC_BETA_DEN + CUBIC_BETA_NUM) /
+				      (2U * CUBIC_BETA_DEN));
+	} else {
+		c->w_max = cwnd;
+	}
+
+	conn->ca.ssthresh = MAX(conn_mss(conn) * 2U,
+				(uint32_t)((uint64_t)flight * CUBIC_BETA_NUM / CUBIC_BETA_DEN));
+}
+
+static void tcp_cubic_init(struct tcp *conn)
+{
+	conn->ca.cwnd = conn_mss(conn) * TCP_CONGESTION_INITIAL_WIN;
+	conn->ca.ssthresh = conn_mss(conn) * TCP_CONGESTION_INITIAL_SSTHRESH;
+	conn->ca.pending_fast_retransmit_bytes = 0;
+	conn->cubic = (struct tcp_cubic){ 0 };
+	tcp_cubic_log(conn, "init");
+}
+
+static void tcp_cubic_fast_retransmit(struct tcp *conn)
+{
+	if (conn->ca.pending_fast_retransmit_bytes == 0) {
+		cubic_reduce(conn);
+		/* Account for the lost segments */
+		conn->ca.cwnd = conn_mss(conn) * 3 + conn->ca.ssthresh;
+		conn->ca.pending_fast_retransmit_bytes = conn->unacked_len;
+		tcp_cubic_log(conn, "fast_retransmit");
+	}
+}
+
+static void tcp_cubic_timeout(struct tcp *conn)
+{
+	cubic_reduce(conn);
+	conn->ca.cwnd = conn_mss(conn);
+	tcp_cubic_log(conn, "timeout");
+}
+
+static void tcp_cubic_dup_ack(struct tcp *conn)
+{
+	conn->ca.cwnd = MIN(conn->ca.cwnd + conn_mss(conn), TCP_WIN_MAX);
+	tcp_cubic_log(conn, "dup_ack");
+}
+
+static void tcp_cubic_pkts_acked(struct tcp *conn, uint32_t acked_len)
+{
+	if (conn->ca.pending_fast_retransmit_bytes == 0) {
+		if (conn->ca.cwnd < conn->ca.ssthresh) {
+			conn->ca.cwnd += MIN(acked_len, conn_mss(conn));
+			conn->ca.cwnd = MIN(conn->ca.cwnd, TCP_WIN_MAX);
+		} else {
+			cubic_cong_avoid(conn, acked_len);
+		}
+	} else {
+		/* Check if it is still in fast recovery mode */
+		if (conn->ca.pending_fast_retransmit_bytes <= acked_len) {
+			conn->ca.pending_fast_retransmit_bytes = 0;
+			conn->ca.cwnd = conn->ca.ssthresh;
+		} else {
+			conn->ca.pending_fast_retransmit_bytes -= acked_len;
+			conn->ca.cwnd -= acked_len;
+		}
+	}
+	tcp_cubic_log(conn, "pkts_acked");
+}
+
+const struct tcp_cc_ops tcp_cubic_ops = {
+	.name = "cubic",
+	.init = tcp_cubic_init,
+	.fast_retransmit = tcp_cubic_fast_retransmit,
+	.timeout = tcp_cubic_timeout,
+	.dup_ack = tcp_cubic_dup_ack,
+	.pkts_acked = tcp_cubic_pkts_acked,
+};
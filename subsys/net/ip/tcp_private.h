@@ -148,7 +148,7 @@
 #define conn_send_data_dump(_conn)                                             \
 	({                                                                     \
 		NET_DBG("[%p] total=%zd, unacked_len=%d, "		       \
-			"send_win=%hu, mss=%hu",                               \
+			"send_win=%u, mss=%hu",                                \
 			(_conn), net_pkt_get_len(&(_conn)->send_data),         \
 			_conn->unacked_len, _conn->send_win,                   \
 			(uint16_t)conn_mss((_conn)));                          \
@@ -194,10 +194,6 @@ enum th_flags {
 	CWR = BIT(7),
 };
 
-struct tcp_mss_option {
-	uint32_t option;
-};
-
 enum tcp_state {
 	TCP_UNUSED = 0,
 	TCP_CLOSED,
@@ -229,32 +225,101 @@ union tcp_endpoint {
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
+#define NET_TCP_TIMESTAMP_OPT    8
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+#define NET_TCP_SACK_BLOCK_SIZE   8
+#define NET_TCP_TIMESTAMP_SIZE    10
+
+/* Largest shift allowed by RFC 7323 */
+#define NET_TCP_WINDOW_SCALE_MAX  14
+
+/* Most SACK blocks fitting in the option space next to a timestamp */
+#define NET_TCP_SACK_MAX_BLOCKS   3
 
 struct tcp_options {
 	uint16_t mss;
 	uint16_t window;
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	uint32_t tsval;
+	uint32_t tsecr;
+#endif
 	bool mss_found : 1;
 	bool wnd_found : 1;
+	bool sack_perm_found : 1;
+	bool ts_found : 1;
+};
+
+struct tcp_sack_block {
+	uint32_t start;
+	uint32_t end;
 };
 
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+#define TCP_WIN_MAX ((uint32_t)UINT16_MAX << NET_TCP_WINDOW_SCALE_MAX)
+#else
+#define TCP_WIN_MAX UINT16_MAX
+#endif
+
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
 
+/* Define the number of MSS sections the congestion window is initialized at */
+#define TCP_CONGESTION_INITIAL_WIN 1
+#define TCP_CONGESTION_INITIAL_SSTHRESH 3
+
+/* Longest name of a congestion control algorithm, including the nul */
+#define NET_TCP_CC_NAME_MAX 16
+
 struct tcp_collision_avoidance_reno {
-	uint16_t cwnd;
-	uint16_t ssthresh;
-	uint16_t pending_fast_retransmit_bytes;
+	uint32_t cwnd;
+	uint32_t ssthresh;
+	uint32_t pending_fast_retransmit_bytes;
+};
+#endif
+
+#ifdef CONFIG_NET_TCP_CONGESTION_CUBIC
+struct tcp_cubic {
+	uint32_t w_max;       /* Window before the last reduction, in bytes */
+	uint32_t w_est;       /* Reno-friendly window estimate, in bytes */
+	uint32_t k;           /* Time to grow back to w_max, in ms */
+	uint32_t epoch_start; /* Start of the congestion avoidance epoch, in ms */
+	bool in_epoch : 1;
 };
 #endif
 
 struct tcp;
 typedef void (*net_tcp_closed_cb_t)(struct tcp *conn, void *user_data);
 
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+/* Congestion control algorithm. The callbacks are called with the connection
+ * locked and update conn->ca.
+ */
+struct tcp_cc_ops {
+	const char *name;
+	/* The connection is established, or switches to this algorithm */
+	void (*init)(struct tcp *conn);
+	/* Three duplicate ACKs were received */
+	void (*fast_retransmit)(struct tcp *conn);
+	/* The retransmission timer expired */
+	void (*timeout)(struct tcp *conn);
+	/* A further duplicate ACK was received */
+	void (*dup_ack)(struct tcp *conn);
+	/* New data was acknowledged */
+	void (*pkts_acked)(struct tcp *conn, uint32_t acked_len);
+};
+
+#ifdef CONFIG_NET_TCP_CONGESTION_CUBIC
+extern const struct tcp_cc_ops tcp_cubic_ops;
+#endif
+#endif
+
 struct tcp { /* TCP connection */
 	sys_snode_t next;
 	struct net_context *context;
@@ -295,6 +360,10 @@ struct tcp { /* TCP connection */
 #if defined(CONFIG_NET_TCP_KEEPALIVE)
 	struct k_work_delayable keepalive_timer;
 #endif /* CONFIG_NET_TCP_KEEPALIVE */
+#if defined(CONFIG_NET_TCP_PACING)
+	struct k_work_delayable pacing_timer;
+	uint64_t pacing_next; /* Uptime in us at which the next segment is due */
+#endif
 	struct k_work conn_release;
 
 	union {
@@ -326,16 +395,36 @@ struct tcp { /* TCP connection */
 	uint32_t keep_cnt;
 	uint32_t keep_cur;
 #endif /* CONFIG_NET_TCP_KEEPALIVE */
-	uint16_t recv_win_sent;
-	uint16_t recv_win_max;
-	uint16_t recv_win;
-	uint16_t send_win_max;
-	uint16_t send_win;
-#ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
+	uint32_t recv_win_sent;
+	uint32_t recv_win_max;
+	uint32_t recv_win;
+	uint32_t send_win_max;
+	uint32_t send_win;
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	uint32_t ts_recent; /* Peer's timestamp to echo back */
+	uint32_t srtt;      /* Smoothed RTT in ms, scaled by 8 */
+	uint32_t rttvar;    /* RTT variation in ms, scaled by 4 */
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	/* SACK blocks of the last received ACK, sorted by sequence number */
+	struct tcp_sack_block sacked[NET_TCP_SACK_MAX_BLOCKS];
+#endif
+#if defined(CONFIG_NET_TCP_RANDOMIZED_RTO) || defined(CONFIG_NET_TCP_TIMESTAMPS)
 	uint16_t rto;
 #endif
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	uint8_t send_wscale; /* Shift applied to the windows of the peer */
+	uint8_t recv_wscale; /* Shift applied to our advertised windows */
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	uint8_t sacked_cnt;
+#endif
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+	const struct tcp_cc_ops *cc;
 	struct tcp_collision_avoidance_reno ca;
+#endif
+#ifdef CONFIG_NET_TCP_CONGESTION_CUBIC
+	struct tcp_cubic cubic;
 #endif
 	uint8_t send_data_retries;
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
@@ -350,6 +439,19 @@ struct tcp { /* TCP connection */
 	bool tcp_nodelay : 1;
 	bool addr_ref_done : 1;
 	bool rst_received : 1;
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	bool wscale_ok : 1;
+#endif
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	bool ts_ok : 1;
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	bool sack_ok : 1;
+#endif
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+	/* The send queue holds zero-copy data */
+	bool send_data_zc : 1;
+#endif
 };
 
 #define _flags(_fl, _op, _mask, _cond)					\
@@ -27,6 +27,18 @@ LOG_MODULE_REGISTER(net_utils, CONFIG_NET_UTILS_LOG_LEVEL);
 #include <zephyr/net/net_core.h>
 #include <zephyr/net/socketcan.h>
 
+#if defined(CONFIG_NET_CHKSUM_SIMD)
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_FEATURE_MVE)
+#include <arm_mve.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+#endif /* CONFIG_NET_CHKSUM_SIMD */
+
 char *net_sprint_addr(net_sa_family_t af, const void *addr)
 {
 #define NBUFS 3
@@ -569,6 +581,169 @@ static uint16_t offset_based_swap8(const uint8_t *data)
 	}
 }
 
+/* Return the sum of count native endian 32-bit words. Folding it gives the
+ * same 16-bit ones' complement sum as adding the 16-bit words they hold.
+ */
+#if defined(CONFIG_NET_CHKSUM_SIMD) && defined(__AVX2__)
+static uint64_t chksum_words(const uint32_t *p, size_t count)
+{
+	__m256i acc_a = _mm256_setzero_si256();
+	__m256i acc_b = _mm256_setzero_si256();
+	uint64_t lanes[4];
+	uint64_t sum;
+
+	/* The words are widened to 64-bit lanes, which cannot overflow */
+	for (; count >= 8; count -= 8, p += 8) {
+		acc_a = _mm256_add_epi64(acc_a, _mm256_cvtepu32_epi64(
+					 _mm_loadu_si128((const __m128i *)p)));
+		acc_b = _mm256_add_epi64(acc_b, _mm256_cvtepu32_epi64(
+					 _mm_loadu_si128((const __m128i *)(p + 4))));
+	}
+
+	_mm256_storeu_si256((__m256i *)lanes, _mm256_add_epi64(acc_a, acc_b));
+	sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+
+	for (; count > 0; count--) {
+		sum += *p++;
+	}
+
+	return sum;
+}
+#elif defined(CONFIG_NET_CHKSUM_SIMD) && defined(__SSE2__)
+static uint64_t chksum_words(const uint32_t *p, size_t count)
+{
+	const __m128i zero = _mm_setzero_si128();
+	__m128i acc_lo = zero;
+	__m128i acc_hi = zero;
+	uint64_t lanes[2];
+	uint64_t sum;
+
+	/* The words are widened to 64-bit lanes, which cannot overflow */
+	for (; count >= 4; count -= 4, p += 4) {
+		__m128i v = _mm_loadu_si128((const __m128i *)p);
+
+		acc_lo = _mm_add_epi64(acc_lo, _mm_unpacklo_epi32(v, zero));
+		acc_hi = _mm_add_epi64(acc_hi, _mm_unpackhi_epi32(v, zero));
+	}
+
+	_mm_storeu_si128((__m128i *)lanes, _mm_add_epi64(acc_lo, acc_hi));
+	sum = lanes[0] + lanes[1];
+
+	for (; count > 0; count--) {
+		sum += *p++;
+	}
+
+	return sum;
+}
+#elif defined(CONFIG_NET_CHKSUM_SIMD) && defined(__ARM_FEATURE_MVE)
+static uint64_t chksum_words(const uint32_t *p, size_t count)
+{
+	uint64_t sum = 0U;
+
+	for (; count >= 4; count -= 4, p += 4) {
+		sum = vaddlvaq_u32(sum, vldrwq_u32(p));
+	}
+
+	for (; count > 0; count--) {
+		sum += *p++;
+	}
+
+	return sum;
+}
+#elif defined(CONFIG_NET_CHKSUM_SIMD) && defined(__ARM_NEON)
+static uint64_t chksum_words(const uint32_t *p, size_t count)
+{
+	uint64x2_t acc = vdupq_n_u64(0U);
+	uint64_t sum;
+
+	/* Pairs of words are added to 64-bit lanes, which cannot overflow */
+	for (; count >= 4; count -= 4, p += 4) {
+		acc = vpadalq_u32(acc, vld1q_u32(p));
+	}
+
+	sum = vgetq_lane_u64(acc, 0) + vgetq_lane_u64(acc, 1);
+
+	for (; count > 0; count--) {
+		sum += *p++;
+	}
+
+	return sum;
+}
+#elif defined(CONFIG_64BIT)
+static uint64_t chksum_words(const uint32_t *p, size_t count)
+{
+	const uint64_t *q;
+	uint64_t carry = 0U;
+	uint64_t sum = 0U;
+	uint64_t w;
+
+	if (((uintptr_t)p & 0x04) != 0 && count > 0) {
+		sum = *p++;
+		count--;
+	}
+
+	/* Add 64-bit words, counting the carries apart */
+	q = (const uint64_t *)p;
+
+	for (; count >= 8; count -= 8, q += 4) {
+		w = q[0];
+		sum += w;
+		carry += (sum < w);
+		w = q[1];
+		sum += w;
+		carry += (sum < w);
+		w = q[2];
+		sum += w;
+		carry += (sum < w);
+		w = q[3];
+		sum += w;
+		carry += (sum < w);
+	}
+
+	for (; count >= 2; count -= 2, q++) {
+		w = *q;
+		sum += w;
+		carry += (sum < w);
+	}
+
+	/* As 2^32 and 2^64 are both 1 modulo 0xffff, the halves of the sum
+	 * and the carries can simply be added.
+	 */
+	sum = (sum & 0xffffffffU) + (sum >> 32) + carry;
+
+	if (count > 0) {
+		sum += *(const uint32_t *)q;
+	}
+
+	return sum;
+}
+#else
+static uint64_t chksum_words(const uint32_t *p, size_t count)
+{
+	uint64_t sum = 0U;
+	size_t i = 0;
+
+	/* Do loop unrolling for the very large data sets */
+	while (count >= 4) {
+		uint64_t sum_a = p[i];
+		uint64_t sum_b = p[i + 1];
+
+		count -= 4;
+		sum_a += p[i + 2];
+		sum_b += p[i + 3];
+		i += 4;
+		sum += sum_a + sum_b;
+	}
+
+	while (count > 0) {
+		count--;
+		sum = sum + p[i++];
+	}
+
+	return sum;
+}
+#endif
+
 /* Word based checksum calculation based on:
  * https://blogs.igalia.com/dpino/2018/06/14/fast-checksum-computation/
  * It’s not necessary to add octets as 16-bit words. Due to the associative property of addition,
@@ -579,8 +754,7 @@ static uint16_t offset_based_swap8(const uint8_t *data)
 uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 {
 	uint64_t sum;
-	uint32_t *p;
-	size_t i = 0;
+	size_t count;
 	size_t pending = len;
 	int odd_start = ((uintptr_t)data & 0x01);
 
@@ -604,24 +778,12 @@ uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 		sum = sum + *((uint16_t *)data);
 		data += sizeof(uint16_t);
 	}
-	p = (uint32_t *)data;
 
-	/* Do loop unrolling for the very large data sets */
-	while (pending >= sizeof(uint32_t) * 4) {
-		uint64_t sum_a = p[i];
-		uint64_t sum_b = p[i + 1];
+	count = pending / sizeof(uint32_t);
+	sum += chksum_words((const uint32_t *)data, count);
+	data += count * sizeof(uint32_t);
+	pending -= count * sizeof(uint32_t);
 
-		pending -= sizeof(uint32_t) * 4;
-		sum_a += p[i + 2];
-		sum_b += p[i + 3];
-		i += 4;
-		sum += sum_a + sum_b;
-	}
-	while (pending >= sizeof(uint32_t)) {
-		pending -= sizeof(uint32_t);
-		sum = sum + p[i++];
-	}
-	data = (uint8_t *)(p + i);
 	if (pending >= 2) {
 		pending -= sizeof(uint16_t);
 		sum = sum + *((uint16_t *)data);
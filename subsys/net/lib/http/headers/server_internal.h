@@ -31,6 +31,7 @@ int handle_http1_request(struct http_client_ctx *client);
 int handle_http1_to_http2_upgrade(struct http_client_ctx *client);
 int handle_http1_to_websocket_upgrade(struct http_client_ctx *client);
 void http_server_release_client(struct http_client_ctx *client);
+void release_http2_streams(struct http_client_ctx *client);
 
 int enter_http1_request(struct http_client_ctx *client);
 int enter_http2_request(struct http_client_ctx *client);
@@ -48,6 +49,7 @@ bool compression_value_is_valid(enum http_compression compression);
 struct http_resource_detail *get_resource_detail(const struct http_service_desc *service,
 						 const char *path, int *len, bool is_ws);
 int http_server_sendall(struct http_client_ctx *client, const void *buf, size_t len);
+int http_server_sendv(struct http_client_ctx *client, struct net_iovec *iov, size_t iovcnt);
 void http_server_get_content_type_from_extension(char *url, char *content_type,
 						 size_t content_type_size);
 int http_server_find_file(char *fname, size_t fname_size, size_t *file_size,
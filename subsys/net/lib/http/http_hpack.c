@@ -10,6 +10,7 @@
 #include <zephyr/logging/log.h>
 #include <zephyr/net/http/hpack.h>
 #include <zephyr/net/net_core.h>
+#include <zephyr/sys/util.h>
 
 LOG_MODULE_DECLARE(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
 
@@ -106,7 +107,7 @@ static int http_hpack_find_index(struct http_hpack_header_buf *header,
 	     i <= HTTP_SERVER_HPACK_WWW_AUTHENTICATE; i++) {
 		entry = &http_hpack_table_static[i];
 
-		if (entry->name != NULL &&
+		if (entry->name != NULL && entry->name[0] == header->name[0] &&
 		    strlen(entry->name) == header->name_len &&
 		    memcmp(entry->name, header->name, header->name_len) == 0) {
 			if (entry->value != NULL &&
@@ -132,6 +133,169 @@ static int http_hpack_find_index(struct http_hpack_header_buf *header,
 	return -ENOENT;
 }
 
+void http_hpack_table_init(struct http_hpack_table *table, uint32_t max_size)
+{
+	memset(table, 0, sizeof(*table));
+
+	table->max_size = MIN(max_size, sizeof(table->data));
+	table->limit = sizeof(table->data);
+}
+
+static uint32_t hpack_table_index(struct http_hpack_table *table,
+				  const struct http_hpack_table_entry *entry)
+{
+	/* The newest entry comes right after the static table. */
+	return HTTP_SERVER_HPACK_WWW_AUTHENTICATE + table->count -
+	       (entry - table->entries);
+}
+
+static const struct http_hpack_table_entry *
+hpack_table_entry_get(struct http_hpack_table *table, uint32_t index)
+{
+	if (table == NULL || index <= HTTP_SERVER_HPACK_WWW_AUTHENTICATE) {
+		return NULL;
+	}
+
+	index -= HTTP_SERVER_HPACK_WWW_AUTHENTICATE;
+	if (index > table->count) {
+		return NULL;
+	}
+
+	return &table->entries[table->count - index];
+}
+
+static void hpack_table_evict(struct http_hpack_table *table, uint32_t max_size)
+{
+	struct http_hpack_table_entry *entry = table->entries;
+	uint16_t len = 0;
+	uint16_t count = 0;
+
+	while (table->size > max_size) {
+		len += entry->name_len + entry->value_len;
+		table->size -= entry->name_len + entry->value_len +
+			       HTTP_HPACK_ENTRY_OVERHEAD;
+		entry++;
+		count++;
+	}
+
+	if (count == 0) {
+		return;
+	}
+
+	table->count -= count;
+	table->datalen -= len;
+
+	memmove(table->data, table->data + len, table->datalen);
+	memmove(table->entries, entry, table->count * sizeof(*entry));
+
+	for (int i = 0; i < table->count; i++) {
+		table->entries[i].offset -= len;
+	}
+}
+
+static void hpack_table_insert(struct http_hpack_table *table,
+			       struct http_hpack_header_buf *header)
+{
+	size_t entry_size = header->name_len + header->value_len +
+			    HTTP_HPACK_ENTRY_OVERHEAD;
+	struct http_hpack_table_entry *entry;
+
+	if (entry_size > table->max_size) {
+		/* An entry larger than the table empties it, RFC7541 ch 4.4. */
+		hpack_table_evict(table, 0);
+		return;
+	}
+
+	hpack_table_evict(table, table->max_size - entry_size);
+
+	entry = &table->entries[table->count++];
+	entry->offset = table->datalen;
+	entry->name_len = header->name_len;
+	entry->value_len = header->value_len;
+
+	memcpy(table->data + table->datalen, header->name, header->name_len);
+	table->datalen += header->name_len;
+	memcpy(table->data + table->datalen, header->value, header->value_len);
+	table->datalen += header->value_len;
+
+	table->size += entry_size;
+}
+
+static int hpack_table_find_index(struct http_hpack_table *table,
+				  struct http_hpack_header_buf *header,
+				  bool *name_only)
+{
+	const struct http_hpack_table_entry *entry;
+	const uint8_t *name;
+	int candidate = -1;
+
+	if (table == NULL) {
+		return -ENOENT;
+	}
+
+	/* Look from the newest entry, which has the smallest index. */
+	for (int i = table->count - 1; i >= 0; i--) {
+		entry = &table->entries[i];
+		name = table->data + entry->offset;
+
+		if (entry->name_len != header->name_len ||
+		    memcmp(name, header->name, header->name_len) != 0) {
+			continue;
+		}
+
+		if (entry->value_len == header->value_len &&
+		    memcmp(name + entry->name_len, header->value,
+			   header->value_len) == 0) {
+			*name_only = false;
+			return hpack_table_index(table, entry);
+		}
+
+		if (candidate < 0) {
+			candidate = hpack_table_index(table, entry);
+		}
+	}
+
+	if (candidate > 0) {
+		*name_only = true;
+		return candidate;
+	}
+
+	return -ENOENT;
+}
+
+static void hpack_table_set_max_size(struct http_hpack_table *table,
+				     uint32_t max_size)
+{
+	hpack_table_evict(table, max_size);
+	table->max_size = max_size;
+}
+
+void http_hpack_table_set_limit(struct http_hpack_table *table, uint32_t limit)
+{
+	uint32_t max_size = MIN(limit, sizeof(table->data));
+
+	if (max_size == table->max_size) {
+		return;
+	}
+
+	hpack_table_set_max_size(table, max_size);
+
+	/* If the size was reduced and increased again since the last header
+	 * block, the smallest size has to be signaled first, RFC7541 ch 4.2.
+	 */
+	table->min_update = table->size_update ?
+			    MIN(table->min_update, max_size) : max_size;
+	table->size_update = true;
+}
+
+void http_hpack_table_reset(struct http_hpack_table *table)
+{
+	hpack_table_evict(table, 0);
+
+	table->min_update = 0;
+	table->size_update = true;
+}
+
 #define HPACK_INTEGER_CONTINUATION_FLAG            0x80
 #define HPACK_STRING_HUFFMAN_FLAG                  0x80
 #define HPACK_STRING_PREFIX_LEN                    7
@@ -281,10 +445,50 @@ static int hpack_string_decode(const uint8_t *buf, size_t datalen,
 	return len;
 }
 
-static int hpack_handle_indexed(const uint8_t *buf, size_t datalen,
-				struct http_hpack_header_buf *header)
+static int hpack_entry_get(struct http_hpack_table *table, uint32_t index,
+			   struct http_hpack_header_buf *header, bool with_value)
 {
+	const struct http_hpack_table_entry *dynamic;
 	const struct hpack_table_entry *entry;
+
+	entry = http_hpack_table_get(index);
+	if (entry != NULL) {
+		if (entry->name == NULL ||
+		    (with_value && entry->value == NULL)) {
+			return -EBADMSG;
+		}
+
+		header->name = entry->name;
+		header->name_len = strlen(entry->name);
+
+		if (with_value) {
+			header->value = entry->value;
+			header->value_len = strlen(entry->value);
+		}
+
+		return 0;
+	}
+
+	dynamic = hpack_table_entry_get(table, index);
+	if (dynamic == NULL) {
+		return -EBADMSG;
+	}
+
+	header->name = table->data + dynamic->offset;
+	header->name_len = dynamic->name_len;
+
+	if (with_value) {
+		header->value = header->name + dynamic->name_len;
+		header->value_len = dynamic->value_len;
+	}
+
+	return 0;
+}
+
+static int hpack_handle_indexed(struct http_hpack_table *table,
+				const uint8_t *buf, size_t datalen,
+				struct http_hpack_header_buf *header)
+{
 	uint32_t index;
 	int ret;
 
@@ -298,24 +502,15 @@ static int hpack_handle_indexed(const uint8_t *buf, size_t datalen,
 		return -EBADMSG;
 	}
 
-	entry = http_hpack_table_get(index);
-	if (entry == NULL) {
-		return -EBADMSG;
-	}
-
-	if (entry->name == NULL || entry->value == NULL) {
+	if (hpack_entry_get(table, index, header, true) < 0) {
 		return -EBADMSG;
 	}
 
-	header->name = entry->name;
-	header->name_len = strlen(entry->name);
-	header->value = entry->value;
-	header->value_len = strlen(entry->value);
-
 	return ret;
 }
 
-static int hpack_handle_literal(const uint8_t *buf, size_t datalen,
+static int hpack_handle_literal(struct http_hpack_table *table,
+				const uint8_t *buf, size_t datalen,
 				struct http_hpack_header_buf *header,
 				uint8_t prefix_len)
 {
@@ -346,19 +541,9 @@ static int hpack_handle_literal(const uint8_t *buf, size_t datalen,
 		datalen -= ret;
 	} else {
 		/* Indexed name. */
-		const struct hpack_table_entry *entry;
-
-		entry = http_hpack_table_get(index);
-		if (entry == NULL) {
-			return -EBADMSG;
-		}
-
-		if (entry->name == NULL) {
+		if (hpack_entry_get(table, index, header, false) < 0) {
 			return -EBADMSG;
 		}
-
-		header->name = entry->name;
-		header->name_len = strlen(entry->name);
 	}
 
 	ret = hpack_string_decode(buf, datalen, HPACK_HEADER_VALUE, header);
@@ -371,23 +556,48 @@ static int hpack_handle_literal(const uint8_t *buf, size_t datalen,
 	return len;
 }
 
-static int hpack_handle_literal_index(const uint8_t *buf, size_t datalen,
-			       struct http_hpack_header_buf *header)
+static int hpack_handle_literal_index(struct http_hpack_table *table,
+				      const uint8_t *buf, size_t datalen,
+				      struct http_hpack_header_buf *header)
 {
-	/* TODO Add dynamic table support, if needed. */
+	int ret;
+
+	ret = hpack_handle_literal(table, buf, datalen, header,
+				   HPACK_PREFIX_LEN_LITERAL_INDEXING);
+	if (ret < 0 || table == NULL) {
+		return ret;
+	}
 
-	return hpack_handle_literal(buf, datalen, header,
-				    HPACK_PREFIX_LEN_LITERAL_INDEXING);
+	/* A name taken from the dynamic table may be evicted while the new
+	 * entry is added, so copy it to the decoding buffer first.
+	 */
+	if ((const uint8_t *)header->name >= table->data &&
+	    (const uint8_t *)header->name < table->data + sizeof(table->data)) {
+		if (header->name_len > sizeof(header->buf) - header->datalen) {
+			return -ENOBUFS;
+		}
+
+		memcpy(header->buf + header->datalen, header->name,
+		       header->name_len);
+		header->name = header->buf + header->datalen;
+		header->datalen += header->name_len;
+	}
+
+	hpack_table_insert(table, header);
+
+	return ret;
 }
 
-static int hpack_handle_literal_no_index(const uint8_t *buf, size_t datalen,
-				  struct http_hpack_header_buf *header)
+static int hpack_handle_literal_no_index(struct http_hpack_table *table,
+					 const uint8_t *buf, size_t datalen,
+					 struct http_hpack_header_buf *header)
 {
-	return hpack_handle_literal(buf, datalen, header,
+	return hpack_handle_literal(table, buf, datalen, header,
 				    HPACK_PREFIX_LEN_LITERAL_NO_INDEXING);
 }
 
-static int hpack_handle_dynamic_size_update(const uint8_t *buf, size_t datalen)
+static int hpack_handle_dynamic_size_update(struct http_hpack_table *table,
+					    const uint8_t *buf, size_t datalen)
 {
 	uint32_t max_size;
 	int ret;
@@ -398,21 +608,47 @@ static int hpack_handle_dynamic_size_update(const uint8_t *buf, size_t datalen)
 		return ret;
 	}
 
-	/* TODO Add dynamic table support, if needed. */
+	if (table == NULL) {
+		return ret;
+	}
+
+	if (max_size > table->limit) {
+		LOG_DBG("Dynamic table size update too large (%u)", max_size);
+		return -EBADMSG;
+	}
+
+	hpack_table_set_max_size(table, max_size);
 
 	return ret;
 }
 
-int http_hpack_decode_header(const uint8_t *buf, size_t datalen,
-			     struct http_hpack_header_buf *header)
+int http_hpack_table_decode_header(struct http_hpack_table *table,
+				   const uint8_t *buf, size_t datalen,
+				   struct http_hpack_header_buf *header)
 {
 	uint8_t prefix;
-	int ret;
+	int ret, len = 0;
 
 	if (buf == NULL || header == NULL) {
 		return -EINVAL;
 	}
 
+	/* Size updates come before the first header field of a block, and
+	 * are applied again if the header field is incomplete, which leaves
+	 * the table unchanged.
+	 */
+	while (datalen > 0 && (*buf & HPACK_PREFIX_DYNAMIC_TABLE_SIZE_MASK) ==
+			      HPACK_PREFIX_DYNAMIC_TABLE_SIZE_UPDATE) {
+		ret = hpack_handle_dynamic_size_update(table, buf, datalen);
+		if (ret < 0) {
+			return ret;
+		}
+
+		len += ret;
+		buf += ret;
+		datalen -= ret;
+	}
+
 	if (datalen == 0) {
 		return -EAGAIN;
 	}
@@ -420,23 +656,30 @@ int http_hpack_decode_header(const uint8_t *buf, size_t datalen,
 	prefix = *buf;
 
 	if ((prefix & HPACK_PREFIX_INDEXED_MASK) == HPACK_PREFIX_INDEXED) {
-		ret = hpack_handle_indexed(buf, datalen, header);
+		ret = hpack_handle_indexed(table, buf, datalen, header);
 	} else if ((prefix & HPACK_PREFIX_LITERAL_INDEXING_MASK) ==
 		   HPACK_PREFIX_LITERAL_INDEXING) {
-		ret = hpack_handle_literal_index(buf, datalen, header);
+		ret = hpack_handle_literal_index(table, buf, datalen, header);
 	} else if (((prefix & HPACK_PREFIX_LITERAL_NO_INDEXING_MASK) ==
 		    HPACK_PREFIX_LITERAL_NO_INDEXING) ||
 		   ((prefix & HPACK_PREFIX_LITERAL_NEVER_INDEXED_MASK) ==
 		    HPACK_PREFIX_LITERAL_NEVER_INDEXED)) {
-		ret = hpack_handle_literal_no_index(buf, datalen, header);
-	} else if ((prefix & HPACK_PREFIX_DYNAMIC_TABLE_SIZE_MASK) ==
-		   HPACK_PREFIX_DYNAMIC_TABLE_SIZE_UPDATE) {
-		ret = hpack_handle_dynamic_size_update(buf, datalen);
+		ret = hpack_handle_literal_no_index(table, buf, datalen, header);
 	} else {
 		ret = -EINVAL;
 	}
 
-	return ret;
+	if (ret < 0) {
+		return ret;
+	}
+
+	return len + ret;
+}
+
+int http_hpack_decode_header(const uint8_t *buf, size_t datalen,
+			     struct http_hpack_header_buf *header)
+{
+	return http_hpack_table_decode_header(NULL, buf, datalen, header);
 }
 
 static int hpack_integer_encode(uint8_t *buf, size_t buflen, int value,
@@ -465,7 +708,7 @@ static int hpack_integer_encode(uint8_t *buf, size_t buflen, int value,
 			return -ENOBUFS;
 		}
 
-		*buf = (uint8_t)((value % 128) + 128);
+		*buf++ = (uint8_t)((value % 128) + 128);
 		len++;
 		value /= 128;
 	}
@@ -529,14 +772,12 @@ static int hpack_string_encode(uint8_t *buf, size_t buflen,
 	return len;
 }
 
-static int hpack_encode_literal(uint8_t *buf, size_t buflen,
-				struct http_hpack_header_buf *header)
+static int hpack_encode_literal(uint8_t *buf, size_t buflen, uint8_t prefix,
+				uint8_t n, struct http_hpack_header_buf *header)
 {
 	int ret, len = 0;
 
-	ret = hpack_integer_encode(buf, buflen, 0,
-				   HPACK_PREFIX_LITERAL_NEVER_INDEXED,
-				   HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED);
+	ret = hpack_integer_encode(buf, buflen, 0, prefix, n);
 	if (ret < 0) {
 		return ret;
 	}
@@ -565,13 +806,12 @@ static int hpack_encode_literal(uint8_t *buf, size_t buflen,
 }
 
 static int hpack_encode_literal_value(uint8_t *buf, size_t buflen, int index,
+				      uint8_t prefix, uint8_t n,
 				      struct http_hpack_header_buf *header)
 {
 	int ret, len = 0;
 
-	ret = hpack_integer_encode(buf, buflen, index,
-				   HPACK_PREFIX_LITERAL_NEVER_INDEXED,
-				   HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED);
+	ret = hpack_integer_encode(buf, buflen, index, prefix, n);
 	if (ret < 0) {
 		return ret;
 	}
@@ -596,10 +836,44 @@ static int hpack_encode_indexed(uint8_t *buf, size_t buflen, int index)
 				    HPACK_PREFIX_LEN_INDEXED);
 }
 
-int http_hpack_encode_header(uint8_t *buf, size_t buflen,
-			     struct http_hpack_header_buf *header)
+static int hpack_encode_size_update(uint8_t *buf, size_t buflen,
+				   struct http_hpack_table *table)
 {
 	int ret, len = 0;
+
+	if (table->min_update < table->max_size) {
+		ret = hpack_integer_encode(buf, buflen, table->min_update,
+					   HPACK_PREFIX_DYNAMIC_TABLE_SIZE_UPDATE,
+					   HPACK_PREFIX_LEN_DYNAMIC_TABLE_SIZE_UPDATE);
+		if (ret < 0) {
+			return ret;
+		}
+
+		buf += ret;
+		buflen -= ret;
+		len += ret;
+	}
+
+	ret = hpack_integer_encode(buf, buflen, table->max_size,
+				   HPACK_PREFIX_DYNAMIC_TABLE_SIZE_UPDATE,
+				   HPACK_PREFIX_LEN_DYNAMIC_TABLE_SIZE_UPDATE);
+	if (ret < 0) {
+		return ret;
+	}
+
+	len += ret;
+
+	return len;
+}
+
+int http_hpack_table_encode_header(struct http_hpack_table *table,
+				   uint8_t *buf, size_t buflen,
+				   struct http_hpack_header_buf *header)
+{
+	uint8_t prefix = HPACK_PREFIX_LITERAL_NEVER_INDEXED;
+	uint8_t n = HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED;
+	int ret, index, len = 0;
+	bool indexing = false;
 	bool name_only;
 
 	if (buf == NULL || header == NULL ||
@@ -612,17 +886,71 @@ int http_hpack_encode_header(uint8_t *buf, size_t buflen,
 		return -ENOBUFS;
 	}
 
-	ret = http_hpack_find_index(header, &name_only);
-	if (ret < 0) {
+	if (table != NULL && table->size_update) {
+		ret = hpack_encode_size_update(buf, buflen, table);
+		if (ret < 0) {
+			return ret;
+		}
+
+		buf += ret;
+		buflen -= ret;
+		len += ret;
+	}
+
+	index = http_hpack_find_index(header, &name_only);
+	if (index < 0 || name_only) {
+		bool dynamic_name_only;
+		int dynamic;
+
+		dynamic = hpack_table_find_index(table, header, &dynamic_name_only);
+		if (dynamic > 0 && (!dynamic_name_only || index < 0)) {
+			index = dynamic;
+			name_only = dynamic_name_only;
+		}
+	}
+
+	if (table != NULL && (index < 0 || name_only) &&
+	    header->name_len + header->value_len + HTTP_HPACK_ENTRY_OVERHEAD <=
+	    table->max_size) {
+		/* Add the header field to the table so that it can be sent
+		 * indexed in the next header blocks.
+		 */
+		prefix = HPACK_PREFIX_LITERAL_INDEXING;
+		n = HPACK_PREFIX_LEN_LITERAL_INDEXING;
+		indexing = true;
+	}
+
+	if (index < 0) {
 		/* All literal */
-		len = hpack_encode_literal(buf, buflen, header);
+		ret = hpack_encode_literal(buf, buflen, prefix, n, header);
 	} else if (name_only) {
 		/* Literal value */
-		len = hpack_encode_literal_value(buf, buflen, ret, header);
+		ret = hpack_encode_literal_value(buf, buflen, index, prefix, n,
+						 header);
 	} else {
 		/* Indexed */
-		len = hpack_encode_indexed(buf, buflen, ret);
+		ret = hpack_encode_indexed(buf, buflen, index);
+	}
+
+	if (ret < 0) {
+		return ret;
+	}
+
+	len += ret;
+
+	if (indexing) {
+		hpack_table_insert(table, header);
+	}
+
+	if (table != NULL) {
+		table->size_update = false;
 	}
 
 	return len;
 }
+
+int http_hpack_encode_header(uint8_t *buf, size_t buflen,
+			     struct http_hpack_header_buf *header)
+{
+	return http_hpack_table_encode_header(NULL, buf, buflen, header);
+}
@@ -8,408 +8,266 @@
 #include <stdint.h>
 
 #include <zephyr/logging/log.h>
-#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
 
 LOG_MODULE_DECLARE(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
 
-struct decode_elem {
+/* Huffman code of each symbol, from RFC 7541 Appendix B. */
+struct encode_elem {
+	uint32_t code;
 	uint8_t bitlen;
-	uint8_t symbol;
-	uint8_t code[4];
 };
 
-static const struct decode_elem decode_table[] = {
-	{  5,  48, { 0b00000000, 0b00000000, 0b00000000, 0b00000000 } },
-	{  5,  49, { 0b00001000, 0b00000000, 0b00000000, 0b00000000 } },
-	{  5,  50, { 0b00010000, 0b00000000, 0b00000000, 0b00000000 } },
-	{  5,  97, { 0b00011000, 0b00000000, 0b00000000, 0b00000000 } },
-	{  5,  99, { 0b00100000, 0b00000000, 0b00000000, 0b00000000 } },
-	{  5, 101, { 0b00101000, 0b00000000, 0b00000000, 0b00000000 } },
-	{  5, 105, { 0b00110000, 0b00000000, 0b00000000, 0b00000000 } },
-	{  5, 111, { 0b00111000, 0b00000000, 0b00000000, 0b00000000 } },
-	{  5, 115, { 0b01000000, 0b00000000, 0b00000000, 0b00000000 } },
-	{  5, 116, { 0b01001000, 0b00000000, 0b00000000, 0b00000000 } },
-	{  6,  32, { 0b01010000, 0b00000000, 0b00000000, 0b00000000 } },
-	{  6,  37, { 0b01010100, 0b00000000, 0b00000000, 0b00000000 } },
-	{  6,  45, { 0b01011000, 0b00000000, 0b00000000, 0b00000000 } },
-	{  6,  46, { 0b01011100, 0b00000000, 0b00000000, 0b00000000 } },
-	{  6,  47, { 0b01100000, 0b00000000, 0b00000000, 0b00000000 } },
-	{  6,  51, { 0b01100100, 0b00000000, 0b00000000, 0b00000000 } },
-	{  6,  52, { 0b01101000, 0b00000000, 0b00000000, 0b00000000 } },
-	{  6,  53, { 0b01101100, 0b00000000, 0b00000000, 0b00000000 } },
-	{  6,  54, { 0b01110000, 0b00000000, 0b00000000, 0b00000000 } },
-	{  6,  55, { 0b01110100, 0b00000000, 0b00000000, 0b00000000 } },
-	{  6,  56, { 0b01111000, 0b00000000, 0b00000000, 0b00000000 } },
-	{  6,  57, { 0b01111100, 0b00000000, 0b00000000, 0b00000000 } },
-	{  6,  61, { 0b10000000, 0b00000000, 0b00000000, 0b00000000 } },
-	{  6,  65, { 0b10000100, 0b00000000, 0b00000000, 0b00000000 } },
-	{  6,  95, { 0b10001000, 0b00000000, 0b00000000, 0b00000000 } },
-	{  6,  98, { 0b10001100, 0b00000000, 0b00000000, 0b00000000 } },
-	{  6, 100, { 0b10010000, 0b00000000, 0b00000000, 0b00000000 } },
-	{  6, 102, { 0b10010100, 0b00000000, 0b00000000, 0b00000000 } },
-	{  6, 103, { 0b10011000, 0b00000000, 0b00000000, 0b00000000 } },
-	{  6, 104, { 0b10011100, 0b00000000, 0b00000000, 0b00000000 } },
-	{  6, 108, { 0b10100000, 0b00000000, 0b00000000, 0b00000000 } },
-	{  6, 109, { 0b10100100, 0b00000000, 0b00000000, 0b00000000 } },
-	{  6, 110, { 0b10101000, 0b00000000, 0b00000000, 0b00000000 } },
-	{  6, 112, { 0b10101100, 0b00000000, 0b00000000, 0b00000000 } },
-	{  6, 114, { 0b10110000, 0b00000000, 0b00000000, 0b00000000 } },
-	{  6, 117, { 0b10110100, 0b00000000, 0b00000000, 0b00000000 } },
-	{  7,  58, { 0b10111000, 0b00000000, 0b00000000, 0b00000000 } },
-	{  7,  66, { 0b10111010, 0b00000000, 0b00000000, 0b00000000 } },
-	{  7,  67, { 0b10111100, 0b00000000, 0b00000000, 0b00000000 } },
-	{  7,  68, { 0b10111110, 0b00000000, 0b00000000, 0b00000000 } },
-	{  7,  69, { 0b11000000, 0b00000000, 0b00000000, 0b00000000 } },
-	{  7,  70, { 0b11000010, 0b00000000, 0b00000000, 0b00000000 } },
-	{  7,  71, { 0b11000100, 0b00000000, 0b00000000, 0b00000000 } },
-	{  7,  72, { 0b11000110, 0b00000000, 0b00000000, 0b00000000 } },
-	{  7,  73, { 0b11001000, 0b00000000, 0b00000000, 0b00000000 } },
-	{  7,  74, { 0b11001010, 0b00000000, 0b00000000, 0b00000000 } },
-	{  7,  75, { 0b11001100, 0b00000000, 0b00000000, 0b00000000 } },
-	{  7,  76, { 0b11001110, 0b00000000, 0b00000000, 0b00000000 } },
-	{  7,  77, { 0b11010000, 0b00000000, 0b00000000, 0b00000000 } },
-	{  7,  78, { 0b11010010, 0b00000000, 0b00000000, 0b00000000 } },
-	{  7,  79, { 0b11010100, 0b00000000, 0b00000000, 0b00000000 } },
-	{  7,  80, { 0b11010110, 0b00000000, 0b00000000, 0b00000000 } },
-	{  7,  81, { 0b11011000, 0b00000000, 0b00000000, 0b00000000 } },
-	{  7,  82, { 0b11011010, 0b00000000, 0b00000000, 0b00000000 } },
-	{  7,  83, { 0b11011100, 0b00000000, 0b00000000, 0b00000000 } },
-	{  7,  84, { 0b11011110, 0b00000000, 0b00000000, 0b00000000 } },
-	{  7,  85, { 0b11100000, 0b00000000, 0b00000000, 0b00000000 } },
-	{  7,  86, { 0b11100010, 0b00000000, 0b00000000, 0b00000000 } },
-	{  7,  87, { 0b11100100, 0b00000000, 0b00000000, 0b00000000 } },
-	{  7,  89, { 0b11100110, 0b00000000, 0b00000000, 0b00000000 } },
-	{  7, 106, { 0b11101000, 0b00000000, 0b00000000, 0b00000000 } },
-	{  7, 107, { 0b11101010, 0b00000000, 0b00000000, 0b00000000 } },
-	{  7, 113, { 0b11101100, 0b00000000, 0b00000000, 0b00000000 } },
-	{  7, 118, { 0b11101110, 0b00000000, 0b00000000, 0b00000000 } },
-	{  7, 119, { 0b11110000, 0b00000000, 0b00000000, 0b00000000 } },
-	{  7, 120, { 0b11110010, 0b00000000, 0b00000000, 0b00000000 } },
-	{  7, 121, { 0b11110100, 0b00000000, 0b00000000, 0b00000000 } },
-	{  7, 122, { 0b11110110, 0b00000000, 0b00000000, 0b00000000 } },
-	{  8,  38, { 0b11111000, 0b00000000, 0b00000000, 0b00000000 } },
-	{  8,  42, { 0b11111001, 0b00000000, 0b00000000, 0b00000000 } },
-	{  8,  44, { 0b11111010, 0b00000000, 0b00000000, 0b00000000 } },
-	{  8,  59, { 0b11111011, 0b00000000, 0b00000000, 0b00000000 } },
-	{  8,  88, { 0b11111100, 0b00000000, 0b00000000, 0b00000000 } },
-	{  8,  90, { 0b11111101, 0b00000000, 0b00000000, 0b00000000 } },
-	{ 10,  33, { 0b11111110, 0b00000000, 0b00000000, 0b00000000 } },
-	{ 10,  34, { 0b11111110, 0b01000000, 0b00000000, 0b00000000 } },
-	{ 10,  40, { 0b11111110, 0b10000000, 0b00000000, 0b00000000 } },
-	{ 10,  41, { 0b11111110, 0b11000000, 0b00000000, 0b00000000 } },
-	{ 10,  63, { 0b11111111, 0b00000000, 0b00000000, 0b00000000 } },
-	{ 11,  39, { 0b11111111, 0b01000000, 0b00000000, 0b00000000 } },
-	{ 11,  43, { 0b11111111, 0b01100000, 0b00000000, 0b00000000 } },
-	{ 11, 124, { 0b11111111, 0b10000000, 0b00000000, 0b00000000 } },
-	{ 12,  35, { 0b11111111, 0b10100000, 0b00000000, 0b00000000 } },
-	{ 12,  62, { 0b11111111, 0b10110000, 0b00000000, 0b00000000 } },
-	{ 13,   0, { 0b11111111, 0b11000000, 0b00000000, 0b00000000 } },
-	{ 13,  36, { 0b11111111, 0b11001000, 0b00000000, 0b00000000 } },
-	{ 13,  64, { 0b11111111, 0b11010000, 0b00000000, 0b00000000 } },
-	{ 13,  91, { 0b11111111, 0b11011000, 0b00000000, 0b00000000 } },
-	{ 13,  93, { 0b11111111, 0b11100000, 0b00000000, 0b00000000 } },
-	{ 13, 126, { 0b11111111, 0b11101000, 0b00000000, 0b00000000 } },
-	{ 14,  94, { 0b11111111, 0b11110000, 0b00000000, 0b00000000 } },
-	{ 14, 125, { 0b11111111, 0b11110100, 0b00000000, 0b00000000 } },
-	{ 15,  60, { 0b11111111, 0b11111000, 0b00000000, 0b00000000 } },
-	{ 15,  96, { 0b11111111, 0b11111010, 0b00000000, 0b00000000 } },
-	{ 15, 123, { 0b11111111, 0b11111100, 0b00000000, 0b00000000 } },
-	{ 19,  92, { 0b11111111, 0b11111110, 0b00000000, 0b00000000 } },
-	{ 19, 195, { 0b11111111, 0b11111110, 0b00100000, 0b00000000 } },
-	{ 19, 208, { 0b11111111, 0b11111110, 0b01000000, 0b00000000 } },
-	{ 20, 128, { 0b11111111, 0b11111110, 0b01100000, 0b00000000 } },
-	{ 20, 130, { 0b11111111, 0b11111110, 0b01110000, 0b00000000 } },
-	{ 20, 131, { 0b11111111, 0b11111110, 0b10000000, 0b00000000 } },
-	{ 20, 162, { 0b11111111, 0b11111110, 0b10010000, 0b00000000 } },
-	{ 20, 184, { 0b11111111, 0b11111110, 0b10100000, 0b00000000 } },
-	{ 20, 194, { 0b11111111, 0b11111110, 0b10110000, 0b00000000 } },
-	{ 20, 224, { 0b11111111, 0b11111110, 0b11000000, 0b00000000 } },
-	{ 20, 226, { 0b11111111, 0b11111110, 0b11010000, 0b00000000 } },
-	{ 21, 153, { 0b11111111, 0b11111110, 0b11100000, 0b00000000 } },
-	{ 21, 161, { 0b11111111, 0b11111110, 0b11101000, 0b00000000 } },
-	{ 21, 167, { 0b11111111, 0b11111110, 0b11110000, 0b00000000 } },
-	{ 21, 172, { 0b11111111, 0b11111110, 0b11111000, 0b00000000 } },
-	{ 21, 176, { 0b11111111, 0b11111111, 0b00000000, 0b00000000 } },
-	{ 21, 177, { 0b11111111, 0b11111111, 0b00001000, 0b00000000 } },
-	{ 21, 179, { 0b11111111, 0b11111111, 0b00010000, 0b00000000 } },
-	{ 21, 209, { 0b11111111, 0b11111111, 0b00011000, 0b00000000 } },
-	{ 21, 216, { 0b11111111, 0b11111111, 0b00100000, 0b00000000 } },
-	{ 21, 217, { 0b11111111, 0b11111111, 0b00101000, 0b00000000 } },
-	{ 21, 227, { 0b11111111, 0b11111111, 0b00110000, 0b00000000 } },
-	{ 21, 229, { 0b11111111, 0b11111111, 0b00111000, 0b00000000 } },
-	{ 21, 230, { 0b11111111, 0b11111111, 0b01000000, 0b00000000 } },
-	{ 22, 129, { 0b11111111, 0b11111111, 0b01001000, 0b00000000 } },
-	{ 22, 132, { 0b11111111, 0b11111111, 0b01001100, 0b00000000 } },
-	{ 22, 133, { 0b11111111, 0b11111111, 0b01010000, 0b00000000 } },
-	{ 22, 134, { 0b11111111, 0b11111111, 0b01010100, 0b00000000 } },
-	{ 22, 136, { 0b11111111, 0b11111111, 0b01011000, 0b00000000 } },
-	{ 22, 146, { 0b11111111, 0b11111111, 0b01011100, 0b00000000 } },
-	{ 22, 154, { 0b11111111, 0b11111111, 0b01100000, 0b00000000 } },
-	{ 22, 156, { 0b11111111, 0b11111111, 0b01100100, 0b00000000 } },
-	{ 22, 160, { 0b11111111, 0b11111111, 0b01101000, 0b00000000 } },
-	{ 22, 163, { 0b11111111, 0b11111111, 0b01101100, 0b00000000 } },
-	{ 22, 164, { 0b11111111, 0b11111111, 0b01110000, 0b00000000 } },
-	{ 22, 169, { 0b11111111, 0b11111111, 0b01110100, 0b00000000 } },
-	{ 22, 170, { 0b11111111, 0b11111111, 0b01111000, 0b00000000 } },
-	{ 22, 173, { 0b11111111, 0b11111111, 0b01111100, 0b00000000 } },
-	{ 22, 178, { 0b11111111, 0b11111111, 0b10000000, 0b00000000 } },
-	{ 22, 181, { 0b11111111, 0b11111111, 0b10000100, 0b00000000 } },
-	{ 22, 185, { 0b11111111, 0b11111111, 0b10001000, 0b00000000 } },
-	{ 22, 186, { 0b11111111, 0b11111111, 0b10001100, 0b00000000 } },
-	{ 22, 187, { 0b11111111, 0b11111111, 0b10010000, 0b00000000 } },
-	{ 22, 189, { 0b11111111, 0b11111111, 0b10010100, 0b00000000 } },
-	{ 22, 190, { 0b11111111, 0b11111111, 0b10011000, 0b00000000 } },
-	{ 22, 196, { 0b11111111, 0b11111111, 0b10011100, 0b00000000 } },
-	{ 22, 198, { 0b11111111, 0b11111111, 0b10100000, 0b00000000 } },
-	{ 22, 228, { 0b11111111, 0b11111111, 0b10100100, 0b00000000 } },
-	{ 22, 232, { 0b11111111, 0b11111111, 0b10101000, 0b00000000 } },
-	{ 22, 233, { 0b11111111, 0b11111111, 0b10101100, 0b00000000 } },
-	{ 23,   1, { 0b11111111, 0b11111111, 0b10110000, 0b00000000 } },
-	{ 23, 135, { 0b11111111, 0b11111111, 0b10110010, 0b00000000 } },
-	{ 23, 137, { 0b11111111, 0b11111111, 0b10110100, 0b00000000 } },
-	{ 23, 138, { 0b11111111, 0b11111111, 0b10110110, 0b00000000 } },
-	{ 23, 139, { 0b11111111, 0b11111111, 0b10111000, 0b00000000 } },
-	{ 23, 140, { 0b11111111, 0b11111111, 0b10111010, 0b00000000 } },
-	{ 23, 141, { 0b11111111, 0b11111111, 0b10111100, 0b00000000 } },
-	{ 23, 143, { 0b11111111, 0b11111111, 0b10111110, 0b00000000 } },
-	{ 23, 147, { 0b11111111, 0b11111111, 0b11000000, 0b00000000 } },
-	{ 23, 149, { 0b11111111, 0b11111111, 0b11000010, 0b00000000 } },
-	{ 23, 150, { 0b11111111, 0b11111111, 0b11000100, 0b00000000 } },
-	{ 23, 151, { 0b11111111, 0b11111111, 0b11000110, 0b00000000 } },
-	{ 23, 152, { 0b11111111, 0b11111111, 0b11001000, 0b00000000 } },
-	{ 23, 155, { 0b11111111, 0b11111111, 0b11001010, 0b00000000 } },
-	{ 23, 157, { 0b11111111, 0b11111111, 0b11001100, 0b00000000 } },
-	{ 23, 158, { 0b11111111, 0b11111111, 0b11001110, 0b00000000 } },
-	{ 23, 165, { 0b11111111, 0b11111111, 0b11010000, 0b00000000 } },
-	{ 23, 166, { 0b11111111, 0b11111111, 0b11010010, 0b00000000 } },
-	{ 23, 168, { 0b11111111, 0b11111111, 0b11010100, 0b00000000 } },
-	{ 23, 174, { 0b11111111, 0b11111111, 0b11010110, 0b00000000 } },
-	{ 23, 175, { 0b11111111, 0b11111111, 0b11011000, 0b00000000 } },
-	{ 23, 180, { 0b11111111, 0b11111111, 0b11011010, 0b00000000 } },
-	{ 23, 182, { 0b11111111, 0b11111111, 0b11011100, 0b00000000 } },
-	{ 23, 183, { 0b11111111, 0b11111111, 0b11011110, 0b00000000 } },
-	{ 23, 188, { 0b11111111, 0b11111111, 0b11100000, 0b00000000 } },
-	{ 23, 191, { 0b11111111, 0b11111111, 0b11100010, 0b00000000 } },
-	{ 23, 197, { 0b11111111, 0b11111111, 0b11100100, 0b00000000 } },
-	{ 23, 231, { 0b11111111, 0b11111111, 0b11100110, 0b00000000 } },
-	{ 23, 239, { 0b11111111, 0b11111111, 0b11101000, 0b00000000 } },
-	{ 24,   9, { 0b11111111, 0b11111111, 0b11101010, 0b00000000 } },
-	{ 24, 142, { 0b11111111, 0b11111111, 0b11101011, 0b00000000 } },
-	{ 24, 144, { 0b11111111, 0b11111111, 0b11101100, 0b00000000 } },
-	{ 24, 145, { 0b11111111, 0b11111111, 0b11101101, 0b00000000 } },
-	{ 24, 148, { 0b11111111, 0b11111111, 0b11101110, 0b00000000 } },
-	{ 24, 159, { 0b11111111, 0b11111111, 0b11101111, 0b00000000 } },
-	{ 24, 171, { 0b11111111, 0b11111111, 0b11110000, 0b00000000 } },
-	{ 24, 206, { 0b11111111, 0b11111111, 0b11110001, 0b00000000 } },
-	{ 24, 215, { 0b11111111, 0b11111111, 0b11110010, 0b00000000 } },
-	{ 24, 225, { 0b11111111, 0b11111111, 0b11110011, 0b00000000 } },
-	{ 24, 236, { 0b11111111, 0b11111111, 0b11110100, 0b00000000 } },
-	{ 24, 237, { 0b11111111, 0b11111111, 0b11110101, 0b00000000 } },
-	{ 25, 199, { 0b11111111, 0b11111111, 0b11110110, 0b00000000 } },
-	{ 25, 207, { 0b11111111, 0b11111111, 0b11110110, 0b10000000 } },
-	{ 25, 234, { 0b11111111, 0b11111111, 0b11110111, 0b00000000 } },
-	{ 25, 235, { 0b11111111, 0b11111111, 0b11110111, 0b10000000 } },
-	{ 26, 192, { 0b11111111, 0b11111111, 0b11111000, 0b00000000 } },
-	{ 26, 193, { 0b11111111, 0b11111111, 0b11111000, 0b01000000 } },
-	{ 26, 200, { 0b11111111, 0b11111111, 0b11111000, 0b10000000 } },
-	{ 26, 201, { 0b11111111, 0b11111111, 0b11111000, 0b11000000 } },
-	{ 26, 202, { 0b11111111, 0b11111111, 0b11111001, 0b00000000 } },
-	{ 26, 205, { 0b11111111, 0b11111111, 0b11111001, 0b01000000 } },
-	{ 26, 210, { 0b11111111, 0b11111111, 0b11111001, 0b10000000 } },
-	{ 26, 213, { 0b11111111, 0b11111111, 0b11111001, 0b11000000 } },
-	{ 26, 218, { 0b11111111, 0b11111111, 0b11111010, 0b00000000 } },
-	{ 26, 219, { 0b11111111, 0b11111111, 0b11111010, 0b01000000 } },
-	{ 26, 238, { 0b11111111, 0b11111111, 0b11111010, 0b10000000 } },
-	{ 26, 240, { 0b11111111, 0b11111111, 0b11111010, 0b11000000 } },
-	{ 26, 242, { 0b11111111, 0b11111111, 0b11111011, 0b00000000 } },
-	{ 26, 243, { 0b11111111, 0b11111111, 0b11111011, 0b01000000 } },
-	{ 26, 255, { 0b11111111, 0b11111111, 0b11111011, 0b10000000 } },
-	{ 27, 203, { 0b11111111, 0b11111111, 0b11111011, 0b11000000 } },
-	{ 27, 204, { 0b11111111, 0b11111111, 0b11111011, 0b11100000 } },
-	{ 27, 211, { 0b11111111, 0b11111111, 0b11111100, 0b00000000 } },
-	{ 27, 212, { 0b11111111, 0b11111111, 0b11111100, 0b00100000 } },
-	{ 27, 214, { 0b11111111, 0b11111111, 0b11111100, 0b01000000 } },
-	{ 27, 221, { 0b11111111, 0b11111111, 0b11111100, 0b01100000 } },
-	{ 27, 222, { 0b11111111, 0b11111111, 0b11111100, 0b10000000 } },
-	{ 27, 223, { 0b11111111, 0b11111111, 0b11111100, 0b10100000 } },
-	{ 27, 241, { 0b11111111, 0b11111111, 0b11111100, 0b11000000 } },
-	{ 27, 244, { 0b11111111, 0b11111111, 0b11111100, 0b11100000 } },
-	{ 27, 245, { 0b11111111, 0b11111111, 0b11111101, 0b00000000 } },
-	{ 27, 246, { 0b11111111, 0b11111111, 0b11111101, 0b00100000 } },
-	{ 27, 247, { 0b11111111, 0b11111111, 0b11111101, 0b01000000 } },
-	{ 27, 248, { 0b11111111, 0b11111111, 0b11111101, 0b01100000 } },
-	{ 27, 250, { 0b11111111, 0b11111111, 0b11111101, 0b10000000 } },
-	{ 27, 251, { 0b11111111, 0b11111111, 0b11111101, 0b10100000 } },
-	{ 27, 252, { 0b11111111, 0b11111111, 0b11111101, 0b11000000 } },
-	{ 27, 253, { 0b11111111, 0b11111111, 0b11111101, 0b11100000 } },
-	{ 27, 254, { 0b11111111, 0b11111111, 0b11111110, 0b00000000 } },
-	{ 28,   2, { 0b11111111, 0b11111111, 0b11111110, 0b00100000 } },
-	{ 28,   3, { 0b11111111, 0b11111111, 0b11111110, 0b00110000 } },
-	{ 28,   4, { 0b11111111, 0b11111111, 0b11111110, 0b01000000 } },
-	{ 28,   5, { 0b11111111, 0b11111111, 0b11111110, 0b01010000 } },
-	{ 28,   6, { 0b11111111, 0b11111111, 0b11111110, 0b01100000 } },
-	{ 28,   7, { 0b11111111, 0b11111111, 0b11111110, 0b01110000 } },
-	{ 28,   8, { 0b11111111, 0b11111111, 0b11111110, 0b10000000 } },
-	{ 28,  11, { 0b11111111, 0b11111111, 0b11111110, 0b10010000 } },
-	{ 28,  12, { 0b11111111, 0b11111111, 0b11111110, 0b10100000 } },
-	{ 28,  14, { 0b11111111, 0b11111111, 0b11111110, 0b10110000 } },
-	{ 28,  15, { 0b11111111, 0b11111111, 0b11111110, 0b11000000 } },
-	{ 28,  16, { 0b11111111, 0b11111111, 0b11111110, 0b11010000 } },
-	{ 28,  17, { 0b11111111, 0b11111111, 0b11111110, 0b11100000 } },
-	{ 28,  18, { 0b11111111, 0b11111111, 0b11111110, 0b11110000 } },
-	{ 28,  19, { 0b11111111, 0b11111111, 0b11111111, 0b00000000 } },
-	{ 28,  20, { 0b11111111, 0b11111111, 0b11111111, 0b00010000 } },
-	{ 28,  21, { 0b11111111, 0b11111111, 0b11111111, 0b00100000 } },
-	{ 28,  23, { 0b11111111, 0b11111111, 0b11111111, 0b00110000 } },
-	{ 28,  24, { 0b11111111, 0b11111111, 0b11111111, 0b01000000 } },
-	{ 28,  25, { 0b11111111, 0b11111111, 0b11111111, 0b01010000 } },
-	{ 28,  26, { 0b11111111, 0b11111111, 0b11111111, 0b01100000 } },
-	{ 28,  27, { 0b11111111, 0b11111111, 0b11111111, 0b01110000 } },
-	{ 28,  28, { 0b11111111, 0b11111111, 0b11111111, 0b10000000 } },
-	{ 28,  29, { 0b11111111, 0b11111111, 0b11111111, 0b10010000 } },
-	{ 28,  30, { 0b11111111, 0b11111111, 0b11111111, 0b10100000 } },
-	{ 28,  31, { 0b11111111, 0b11111111, 0b11111111, 0b10110000 } },
-	{ 28, 127, { 0b11111111, 0b11111111, 0b11111111, 0b11000000 } },
-	{ 28, 220, { 0b11111111, 0b11111111, 0b11111111, 0b11010000 } },
-	{ 28, 249, { 0b11111111, 0b11111111, 0b11111111, 0b11100000 } },
-	{ 30,  10, { 0b11111111, 0b11111111, 0b11111111, 0b11110000 } },
-	{ 30,  13, { 0b11111111, 0b11111111, 0b11111111, 0b11110100 } },
-	{ 30,  22, { 0b11111111, 0b11111111, 0b11111111, 0b11111000 } },
+static const struct encode_elem encode_table[] = {
+	{     0x1ff8, 13 }, {   0x7fffd8, 23 }, {  0xfffffe2, 28 }, {  0xfffffe3, 28 },
+	{  0xfffffe4, 28 }, {  0xfffffe5, 28 }, {  0xfffffe6, 28 }, {  0xfffffe7, 28 },
+	{  0xfffffe8, 28 }, {   0xffffea, 24 }, { 0x3ffffffc, 30 }, {  0xfffffe9, 28 },
+	{  0xfffffea, 28 }, { 0x3ffffffd, 30 }, {  0xfffffeb, 28 }, {  0xfffffec, 28 },
+	{  0xfffffed, 28 }, {  0xfffffee, 28 }, {  0xfffffef, 28 }, {  0xffffff0, 28 },
+	{  0xffffff1, 28 }, {  0xffffff2, 28 }, { 0x3ffffffe, 30 }, {  0xffffff3, 28 },
+	{  0xffffff4, 28 }, {  0xffffff5, 28 }, {  0xffffff6, 28 }, {  0xffffff7, 28 },
+	{  0xffffff8, 28 }, {  0xffffff9, 28 }, {  0xffffffa, 28 }, {  0xffffffb, 28 },
+	{       0x14,  6 }, {      0x3f8, 10 }, {      0x3f9, 10 }, {      0xffa, 12 },
+	{     0x1ff9, 13 }, {       0x15,  6 }, {       0xf8,  8 }, {      0x7fa, 11 },
+	{      0x3fa, 10 }, {      0x3fb, 10 }, {       0xf9,  8 }, {      0x7fb, 11 },
+	{       0xfa,  8 }, {       0x16,  6 }, {       0x17,  6 }, {       0x18,  6 },
+	{        0x0,  5 }, {        0x1,  5 }, {        0x2,  5 }, {       0x19,  6 },
+	{       0x1a,  6 }, {       0x1b,  6 }, {       0x1c,  6 }, {       0x1d,  6 },
+	{       0x1e,  6 }, {       0x1f,  6 }, {       0x5c,  7 }, {       0xfb,  8 },
+	{     0x7ffc, 15 }, {       0x20,  6 }, {      0xffb, 12 }, {      0x3fc, 10 },
+	{     0x1ffa, 13 }, {       0x21,  6 }, {       0x5d,  7 }, {       0x5e,  7 },
+	{       0x5f,  7 }, {       0x60,  7 }, {       0x61,  7 }, {       0x62,  7 },
+	{       0x63,  7 }, {       0x64,  7 }, {       0x65,  7 }, {       0x66,  7 },
+	{       0x67,  7 }, {       0x68,  7 }, {       0x69,  7 }, {       0x6a,  7 },
+	{       0x6b,  7 }, {       0x6c,  7 }, {       0x6d,  7 }, {       0x6e,  7 },
+	{       0x6f,  7 }, {       0x70,  7 }, {       0x71,  7 }, {       0x72,  7 },
+	{       0xfc,  8 }, {       0x73,  7 }, {       0xfd,  8 }, {     0x1ffb, 13 },
+	{    0x7fff0, 19 }, {     0x1ffc, 13 }, {     0x3ffc, 14 }, {       0x22,  6 },
+	{     0x7ffd, 15 }, {        0x3,  5 }, {       0x23,  6 }, {        0x4,  5 },
+	{       0x24,  6 }, {        0x5,  5 }, {       0x25,  6 }, {       0x26,  6 },
+	{       0x27,  6 }, {        0x6,  5 }, {       0x74,  7 }, {       0x75,  7 },
+	{       0x28,  6 }, {       0x29,  6 }, {       0x2a,  6 }, {        0x7,  5 },
+	{       0x2b,  6 }, {       0x76,  7 }, {       0x2c,  6 }, {        0x8,  5 },
+	{        0x9,  5 }, {       0x2d,  6 }, {       0x77,  7 }, {       0x78,  7 },
+	{       0x79,  7 }, {       0x7a,  7 }, {       0x7b,  7 }, {     0x7ffe, 15 },
+	{      0x7fc, 11 }, {     0x3ffd, 14 }, {     0x1ffd, 13 }, {  0xffffffc, 28 },
+	{    0xfffe6, 20 }, {   0x3fffd2, 22 }, {    0xfffe7, 20 }, {    0xfffe8, 20 },
+	{   0x3fffd3, 22 }, {   0x3fffd4, 22 }, {   0x3fffd5, 22 }, {   0x7fffd9, 23 },
+	{   0x3fffd6, 22 }, {   0x7fffda, 23 }, {   0x7fffdb, 23 }, {   0x7fffdc, 23 },
+	{   0x7fffdd, 23 }, {   0x7fffde, 23 }, {   0xffffeb, 24 }, {   0x7fffdf, 23 },
+	{   0xffffec, 24 }, {   0xffffed, 24 }, {   0x3fffd7, 22 }, {   0x7fffe0, 23 },
+	{   0xffffee, 24 }, {   0x7fffe1, 23 }, {   0x7fffe2, 23 }, {   0x7fffe3, 23 },
+	{   0x7fffe4, 23 }, {   0x1fffdc, 21 }, {   0x3fffd8, 22 }, {   0x7fffe5, 23 },
+	{   0x3fffd9, 22 }, {   0x7fffe6, 23 }, {   0x7fffe7, 23 }, {   0xffffef, 24 },
+	{   0x3fffda, 22 }, {   0x1fffdd, 21 }, {    0xfffe9, 20 }, {   0x3fffdb, 22 },
+	{   0x3fffdc, 22 }, {   0x7fffe8, 23 }, {   0x7fffe9, 23 }, {   0x1fffde, 21 },
+	{   0x7fffea, 23 }, {   0x3fffdd, 22 }, {   0x3fffde, 22 }, {   0xfffff0, 24 },
+	{   0x1fffdf, 21 }, {   0x3fffdf, 22 }, {   0x7fffeb, 23 }, {   0x7fffec, 23 },
+	{   0x1fffe0, 21 }, {   0x1fffe1, 21 }, {   0x3fffe0, 22 }, {   0x1fffe2, 21 },
+	{   0x7fffed, 23 }, {   0x3fffe1, 22 }, {   0x7fffee, 23 }, {   0x7fffef, 23 },
+	{    0xfffea, 20 }, {   0x3fffe2, 22 }, {   0x3fffe3, 22 }, {   0x3fffe4, 22 },
+	{   0x7ffff0, 23 }, {   0x3fffe5, 22 }, {   0x3fffe6, 22 }, {   0x7ffff1, 23 },
+	{  0x3ffffe0, 26 }, {  0x3ffffe1, 26 }, {    0xfffeb, 20 }, {    0x7fff1, 19 },
+	{   0x3fffe7, 22 }, {   0x7ffff2, 23 }, {   0x3fffe8, 22 }, {  0x1ffffec, 25 },
+	{  0x3ffffe2, 26 }, {  0x3ffffe3, 26 }, {  0x3ffffe4, 26 }, {  0x7ffffde, 27 },
+	{  0x7ffffdf, 27 }, {  0x3ffffe5, 26 }, {   0xfffff1, 24 }, {  0x1ffffed, 25 },
+	{    0x7fff2, 19 }, {   0x1fffe3, 21 }, {  0x3ffffe6, 26 }, {  0x7ffffe0, 27 },
+	{  0x7ffffe1, 27 }, {  0x3ffffe7, 26 }, {  0x7ffffe2, 27 }, {   0xfffff2, 24 },
+	{   0x1fffe4, 21 }, {   0x1fffe5, 21 }, {  0x3ffffe8, 26 }, {  0x3ffffe9, 26 },
+	{  0xffffffd, 28 }, {  0x7ffffe3, 27 }, {  0x7ffffe4, 27 }, {  0x7ffffe5, 27 },
+	{    0xfffec, 20 }, {   0xfffff3, 24 }, {    0xfffed, 20 }, {   0x1fffe6, 21 },
+	{   0x3fffe9, 22 }, {   0x1fffe7, 21 }, {   0x1fffe8, 21 }, {   0x7ffff3, 23 },
+	{   0x3fffea, 22 }, {   0x3fffeb, 22 }, {  0x1ffffee, 25 }, {  0x1ffffef, 25 },
+	{   0xfffff4, 24 }, {   0xfffff5, 24 }, {  0x3ffffea, 26 }, {   0x7ffff4, 23 },
+	{  0x3ffffeb, 26 }, {  0x7ffffe6, 27 }, {  0x3ffffec, 26 }, {  0x3ffffed, 26 },
+	{  0x7ffffe7, 27 }, {  0x7ffffe8, 27 }, {  0x7ffffe9, 27 }, {  0x7ffffea, 27 },
+	{  0x7ffffeb, 27 }, {  0xffffffe, 28 }, {  0x7ffffec, 27 }, {  0x7ffffed, 27 },
+	{  0x7ffffee, 27 }, {  0x7ffffef, 27 }, {  0x7fffff0, 27 }, {  0x3ffffee, 26 },
 };
 
-static const struct decode_elem eos = {
-	30,   0, { 0b11111111, 0b11111111, 0b11111111, 0b11111100 }
+/* The Huffman code is canonical: the codes of a given length are
+ * consecutive and follow the codes of the shorter lengths. The codes of up
+ * to 8 bits, which encode the most common characters, are decoded with a
+ * single lookup of the next 8 bits of input. The longer codes are decoded
+ * by comparing the next 32 bits of input with the last code of each length.
+ */
+#define FAST_LOOKUP_BITS 8
+
+/* Symbol and code length for each 8 bit input, 0 if the code is longer. */
+static const uint8_t fast_symbols[BIT(FAST_LOOKUP_BITS)] = {
+	 48,  48,  48,  48,  48,  48,  48,  48,  49,  49,  49,  49,  49,  49,  49,  49,
+	 50,  50,  50,  50,  50,  50,  50,  50,  97,  97,  97,  97,  97,  97,  97,  97,
+	 99,  99,  99,  99,  99,  99,  99,  99, 101, 101, 101, 101, 101, 101, 101, 101,
+	105, 105, 105, 105, 105, 105, 105, 105, 111, 111, 111, 111, 111, 111, 111, 111,
+	115, 115, 115, 115, 115, 115, 115, 115, 116, 116, 116, 116, 116, 116, 116, 116,
+	 32,  32,  32,  32,  37,  37,  37,  37,  45,  45,  45,  45,  46,  46,  46,  46,
+	 47,  47,  47,  47,  51,  51,  51,  51,  52,  52,  52,  52,  53,  53,  53,  53,
+	 54,  54,  54,  54,  55,  55,  55,  55,  56,  56,  56,  56,  57,  57,  57,  57,
+	 61,  61,  61,  61,  65,  65,  65,  65,  95,  95,  95,  95,  98,  98,  98,  98,
+	100, 100, 100, 100, 102, 102, 102, 102, 103, 103, 103, 103, 104, 104, 104, 104,
+	108, 108, 108, 108, 109, 109, 109, 109, 110, 110, 110, 110, 112, 112, 112, 112,
+	114, 114, 114, 114, 117, 117, 117, 117,  58,  58,  66,  66,  67,  67,  68,  68,
+	 69,  69,  70,  70,  71,  71,  72,  72,  73,  73,  74,  74,  75,  75,  76,  76,
+	 77,  77,  78,  78,  79,  79,  80,  80,  81,  81,  82,  82,  83,  83,  84,  84,
+	 85,  85,  86,  86,  87,  87,  89,  89, 106, 106, 107, 107, 113, 113, 118, 118,
+	119, 119, 120, 120, 121, 121, 122, 122,  38,  42,  44,  59,  88,  90,   0,   0,
 };
 
-#define UINT32_BITLEN 32
-
-#define MSB_MASK(len) (UINT32_MAX << (UINT32_BITLEN - len))
-#define LSB_MASK(len) ((1UL << len) - 1UL)
-
-static bool huffman_bits_compare(uint32_t bits, const struct decode_elem *entry)
-{
-	uint32_t mask = MSB_MASK(entry->bitlen);
-	uint32_t code = sys_get_be32(entry->code);
-
-	if (code == (bits & mask)) {
-		return true;
-	}
-
-	return false;
-}
-
-static const struct decode_elem *huffman_decode_bits(uint32_t bits)
-{
-	for (int i = 0; i < ARRAY_SIZE(decode_table); i++) {
-		if (huffman_bits_compare(bits, &decode_table[i])) {
-			return &decode_table[i];
-		}
-	}
+static const uint8_t fast_bitlens[BIT(FAST_LOOKUP_BITS)] = {
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+	6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+	6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+	6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+	6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+	6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+	6, 6, 6, 6, 6, 6, 6, 6, 7, 7, 7, 7, 7, 7, 7, 7,
+	7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+	7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+	7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+	7, 7, 7, 7, 7, 7, 7, 7, 8, 8, 8, 8, 8, 8, 0, 0,
+};
 
-	if (huffman_bits_compare(bits, &eos)) {
-		return &eos;
-	}
+/* Symbols in code order, EOS (256) being the last one. */
+static const uint8_t symbols[] = {
+	 48,  49,  50,  97,  99, 101, 105, 111, 115, 116,  32,  37,  45,  46,  47,  51,
+	 52,  53,  54,  55,  56,  57,  61,  65,  95,  98, 100, 102, 103, 104, 108, 109,
+	110, 112, 114, 117,  58,  66,  67,  68,  69,  70,  71,  72,  73,  74,  75,  76,
+	 77,  78,  79,  80,  81,  82,  83,  84,  85,  86,  87,  89, 106, 107, 113, 118,
+	119, 120, 121, 122,  38,  42,  44,  59,  88,  90,  33,  34,  40,  41,  63,  39,
+	 43, 124,  35,  62,   0,  36,  64,  91,  93, 126,  94, 125,  60,  96, 123,  92,
+	195, 208, 128, 130, 131, 162, 184, 194, 224, 226, 153, 161, 167, 172, 176, 177,
+	179, 209, 216, 217, 227, 229, 230, 129, 132, 133, 134, 136, 146, 154, 156, 160,
+	163, 164, 169, 170, 173, 178, 181, 185, 186, 187, 189, 190, 196, 198, 228, 232,
+	233,   1, 135, 137, 138, 139, 140, 141, 143, 147, 149, 150, 151, 152, 155, 157,
+	158, 165, 166, 168, 174, 175, 180, 182, 183, 188, 191, 197, 231, 239,   9, 142,
+	144, 145, 148, 159, 171, 206, 215, 225, 236, 237, 199, 207, 234, 235, 192, 193,
+	200, 201, 202, 205, 210, 213, 218, 219, 238, 240, 242, 243, 255, 203, 204, 211,
+	212, 214, 221, 222, 223, 241, 244, 245, 246, 247, 248, 250, 251, 252, 253, 254,
+	  2,   3,   4,   5,   6,   7,   8,  11,  12,  14,  15,  16,  17,  18,  19,  20,
+	 21,  23,  24,  25,  26,  27,  28,  29,  30,  31, 127, 220, 249,  10,  13,  22,
+};
 
-	return NULL;
-}
+#define EOS_INDEX  ARRAY_SIZE(symbols)
+#define EOS_SYMBOL 256
 
-static const struct decode_elem *huffman_find_entry(uint8_t symbol)
-{
-	for (int i = 0; i < ARRAY_SIZE(decode_table); i++) {
-		if (decode_table[i].symbol == symbol) {
-			return &decode_table[i];
-		}
-	}
+struct length_elem {
+	/* Last code of this length, MSB aligned and padded with ones. */
+	uint32_t last;
+	/* First code of this length. */
+	uint32_t first_code;
+	/* Index of the first code of this length in symbols. */
+	uint16_t first_index;
+	uint8_t bitlen;
+};
 
-	return NULL;
-}
+/* Lengths of the codes longer than FAST_LOOKUP_BITS. */
+static const struct length_elem length_table[] = {
+	{ 0xff3fffff, 0x000003f8,  74, 10 },
+	{ 0xff9fffff, 0x000007fa,  79, 11 },
+	{ 0xffbfffff, 0x00000ffa,  82, 12 },
+	{ 0xffefffff, 0x00001ff8,  84, 13 },
+	{ 0xfff7ffff, 0x00003ffc,  90, 14 },
+	{ 0xfffdffff, 0x00007ffc,  92, 15 },
+	{ 0xfffe5fff, 0x0007fff0,  95, 19 },
+	{ 0xfffedfff, 0x000fffe6,  98, 20 },
+	{ 0xffff47ff, 0x001fffdc, 106, 21 },
+	{ 0xffffafff, 0x003fffd2, 119, 22 },
+	{ 0xffffe9ff, 0x007fffd8, 145, 23 },
+	{ 0xfffff5ff, 0x00ffffea, 174, 24 },
+	{ 0xfffff7ff, 0x01ffffec, 186, 25 },
+	{ 0xfffffbbf, 0x03ffffe0, 190, 26 },
+	{ 0xfffffe1f, 0x07ffffde, 205, 27 },
+	{ 0xffffffef, 0x0fffffe2, 224, 28 },
+	{ 0xffffffff, 0x3ffffffc, 253, 30 },
+};
 
 #define MAX_PADDING_LEN 7
 
 int http_hpack_huffman_decode(const uint8_t *encoded_buf, size_t encoded_len,
 			      uint8_t *buf, size_t buflen)
 {
-	size_t encoded_bits_len = encoded_len * 8;
-	uint8_t bits_needed = UINT32_BITLEN;
-	const struct decode_elem *decoded;
-	uint8_t bits_in_byte_left = 8;
+	const struct length_elem *length = NULL;
 	size_t decoded_len = 0;
-	uint32_t bits = 0;
+	uint64_t bits = 0;
+	uint8_t bits_len = 0;
+	uint16_t symbol;
+	uint8_t bitlen;
+	uint32_t index;
+	uint32_t code;
+	uint8_t top;
 
 	if (encoded_buf == NULL || buf == NULL || encoded_len == 0) {
 		return -EINVAL;
 	}
 
-	while (encoded_bits_len > 0) {
-		/* Refill the bits variable */
-		while (bits_needed > 0) {
-			if (encoded_len > 0) {
-				if (bits_in_byte_left <= bits_needed) {
-					/* Consume rest of the byte */
-					bits <<= bits_in_byte_left;
-					bits |= *encoded_buf &
-						    LSB_MASK(bits_in_byte_left);
-					bits_needed -= bits_in_byte_left;
-					bits_in_byte_left = 0;
-				} else {
-					/* Consume part of the byte */
-					bits <<= bits_needed;
-					bits |= (*encoded_buf >>
-						 (bits_in_byte_left - bits_needed)) &
-						LSB_MASK(bits_needed);
-					bits_in_byte_left -= bits_needed;
-					bits_needed = 0;
-				}
-			} else {
-				/* Pad with ones */
-				bits <<= bits_needed;
-				bits |= LSB_MASK(bits_needed);
-				bits_needed = 0;
-			}
+	while (true) {
+		/* Refill the bits variable, MSB aligned */
+		while (bits_len <= 56 && encoded_len > 0) {
+			bits |= (uint64_t)*encoded_buf << (56 - bits_len);
+			bits_len += 8;
+			encoded_buf++;
+			encoded_len--;
+		}
 
-			/* Move to next encoded byte */
-			if (bits_in_byte_left == 0) {
-				encoded_buf++;
-				encoded_len--;
-				bits_in_byte_left = 8;
-			}
+		if (bits_len == 0) {
+			break;
 		}
 
-		/* Pass to decoder */
-		decoded = huffman_decode_bits(bits);
-		if (decoded == NULL) {
-			LOG_ERR("No symbol found");
-			return -EBADMSG;
+		top = bits >> (64 - FAST_LOOKUP_BITS);
+		symbol = fast_symbols[top];
+		bitlen = fast_bitlens[top];
+
+		if (bitlen == 0) {
+			code = bits >> 32;
+
+			ARRAY_FOR_EACH_PTR(length_table, elem) {
+				if (code <= elem->last) {
+					length = elem;
+					break;
+				}
+			}
+
+			bitlen = length->bitlen;
+			index = length->first_index + (code >> (32 - bitlen)) -
+				length->first_code;
+			symbol = (index < EOS_INDEX) ? symbols[index] : EOS_SYMBOL;
 		}
 
-		if (decoded == &eos) {
-			if (encoded_bits_len > MAX_PADDING_LEN) {
-				LOG_ERR("eos reached prematurely");
+		if (bitlen > bits_len) {
+			/* Only a part of the EOS code can be used for padding */
+			if (bits_len > MAX_PADDING_LEN ||
+			    (bits >> (64 - bits_len)) != BIT_MASK(bits_len)) {
+				LOG_ERR("Invalid padding");
 				return -EBADMSG;
 			}
 
 			break;
 		}
 
-		if (encoded_bits_len < decoded->bitlen) {
-			LOG_ERR("Invalid symbol used for padding");
+		if (symbol == EOS_SYMBOL) {
+			LOG_ERR("eos reached prematurely");
 			return -EBADMSG;
 		}
 
-		/* Remove consumed bits from bits variable. */
-		bits_needed += decoded->bitlen;
-		encoded_bits_len -= decoded->bitlen;
-
 		/* Store decoded symbol */
 		if (buflen == 0) {
 			LOG_ERR("Not enough buffer to decode string");
 			return -ENOBUFS;
 		}
 
-		*buf = decoded->symbol;
+		*buf = symbol;
 		buf++;
 		buflen--;
 		decoded_len++;
+
+		/* Remove consumed bits from bits variable. */
+		bits <<= bitlen;
+		bits_len -= bitlen;
 	}
 
 	return decoded_len;
@@ -418,9 +276,9 @@ int http_hpack_huffman_decode(const uint8_t *encoded_buf, size_t encoded_len,
 int http_hpack_huffman_encode(const uint8_t *str, size_t str_len,
 			      uint8_t *buf, size_t buflen)
 {
-	const struct decode_elem *entry;
-	size_t buflen_bits = buflen * 8;
-	uint8_t bit_offset = 0;
+	const struct encode_elem *entry;
+	uint64_t bits = 0;
+	uint8_t bits_len = 0;
 	int len = 0;
 
 	if (str == NULL || buf == NULL || str_len == 0) {
@@ -428,52 +286,32 @@ int http_hpack_huffman_encode(const uint8_t *str, size_t str_len,
 	}
 
 	while (str_len > 0) {
-		uint32_t code;
-		uint8_t bitlen;
-
-		entry = huffman_find_entry(*str);
-		if (entry == NULL) {
-			return -EINVAL;
-		}
-
-		if (entry->bitlen > buflen_bits) {
-			return -ENOBUFS;
-		}
+		entry = &encode_table[*str];
 
-		bitlen = entry->bitlen;
-		code = sys_get_be32(entry->code);
+		/* The bits not written out yet are the LSBs of bits */
+		bits = (bits << entry->bitlen) | entry->code;
+		bits_len += entry->bitlen;
 
-		while (bitlen > 0) {
-			uint8_t to_copy = MIN(8 - bit_offset, bitlen);
-			uint8_t byte = (uint8_t)((code & MSB_MASK(to_copy)) >>
-						 (24 + bit_offset));
-
-			/* This is way suboptimal */
-			if (bit_offset == 0) {
-				*buf = byte;
-			} else {
-				*buf |= byte;
+		while (bits_len >= 8) {
+			if (len >= buflen) {
+				return -ENOBUFS;
 			}
 
-			code <<= to_copy;
-			bitlen -= to_copy;
-			bit_offset  = (bit_offset + to_copy) % 8;
-
-			if (bit_offset == 0) {
-				buf++;
-				len++;
-			}
+			bits_len -= 8;
+			buf[len++] = (uint8_t)(bits >> bits_len);
 		}
 
-		buflen_bits -= entry->bitlen;
 		str_len--;
 		str++;
 	}
 
 	/* Pad with ones. */
-	if (bit_offset > 0) {
-		*buf |= LSB_MASK((8 - bit_offset));
-		len++;
+	if (bits_len > 0) {
+		if (len >= buflen) {
+			return -ENOBUFS;
+		}
+
+		buf[len++] = (uint8_t)((bits << (8 - bits_len)) | BIT_MASK(8 - bits_len));
 	}
 
 	return len;
@@ -43,6 +43,10 @@ LOG_MODULE_REGISTER(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
 #define HTTP_SERVER_MAX_CLIENTS  CONFIG_HTTP_SERVER_MAX_CLIENTS
 #define HTTP_SERVER_SOCK_COUNT (1 + HTTP_SERVER_MAX_SERVICES + HTTP_SERVER_MAX_CLIENTS)
 
+BUILD_ASSERT(HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE == 0 ||
+	     HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE >= HTTP_HPACK_DEFAULT_TABLE_SIZE,
+	     "The HPACK dynamic table must hold the default table of the clients");
+
 struct http_server_ctx {
 	int listen_fds; /* max value of 1 + MAX_SERVICES */
 
@@ -359,6 +363,7 @@ void http_server_release_client(struct http_client_ctx *client)
 
 	k_work_cancel_delayable_sync(&client->inactivity_timer, &sync);
 	client_release_resources(client);
+	release_http2_streams(client);
 
 	client->service->data->num_clients--;
 
@@ -432,6 +437,15 @@ static void init_client_ctx(struct http_client_ctx *client, const struct http_se
 	client->has_upgrade_header = false;
 	client->preface_sent = false;
 	client->window_size = HTTP_SERVER_INITIAL_WINDOW_SIZE;
+	client->send_window_size = HTTP2_DEFAULT_WINDOW_SIZE;
+	client->peer_initial_window_size = HTTP2_DEFAULT_WINDOW_SIZE;
+	client->peer_max_frame_size = HTTP2_DEFAULT_MAX_FRAME_SIZE;
+
+	/* The client encodes with the default table size until it signals
+	 * another one, which it may do before it gets our settings.
+	 */
+	http_hpack_table_init(&client->decoder_table, HTTP_HPACK_DEFAULT_TABLE_SIZE);
+	http_hpack_table_init(&client->encoder_table, HTTP_HPACK_DEFAULT_TABLE_SIZE);
 
 	memset(client->buffer, 0, sizeof(client->buffer));
 	memset(client->url_buffer, 0, sizeof(client->url_buffer));
@@ -915,6 +929,24 @@ int http_server_sendall(struct http_client_ctx *client, const void *buf, size_t
 	return 0;
 }
 
+int http_server_sendv(struct http_client_ctx *client, struct net_iovec *iov, size_t iovcnt)
+{
+	struct net_msghdr msg = {
+		.msg_iov = iov,
+		.msg_iovlen = iovcnt,
+	};
+	int ret;
+
+	ret = zsock_sendmsg_all(client->fd, &msg, 0, K_FOREVER, NULL);
+	if (ret < 0) {
+		return ret;
+	}
+
+	http_client_timer_restart(client);
+
+	return 0;
+}
+
 bool http_response_is_final(struct http_response_ctx *rsp, enum http_transaction_status status)
 {
 	if (status != HTTP_SERVER_REQUEST_DATA_FINAL) {
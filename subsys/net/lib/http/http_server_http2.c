@@ -18,6 +18,7 @@
 #include <zephyr/logging/log.h>
 #include <zephyr/net/http/service.h>
 #include <zephyr/net/http/server.h>
+#include <zephyr/net/socket.h>
 
 LOG_MODULE_DECLARE(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
 
@@ -85,6 +86,8 @@ static struct http2_stream_ctx *allocate_http_stream_context(
 			client->streams[i].stream_state = HTTP2_STREAM_OPEN;
 			client->streams[i].window_size =
 				HTTP_SERVER_INITIAL_WINDOW_SIZE;
+			client->streams[i].send_window_size =
+				client->peer_initial_window_size;
 			client->streams[i].headers_sent = false;
 			client->streams[i].end_stream_sent = false;
 			return &client->streams[i];
@@ -94,11 +97,35 @@ static struct http2_stream_ctx *allocate_http_stream_context(
 	return NULL;
 }
 
+static void cancel_pending_data(struct http2_stream_ctx *stream)
+{
+#if defined(CONFIG_FILE_SYSTEM)
+	if (stream->send_pending && stream->send_from_file) {
+		(void)fs_close(&stream->file);
+	}
+#endif
+
+	stream->send_pending = false;
+	stream->send_from_file = false;
+	stream->send_data = NULL;
+	stream->send_len = 0;
+}
+
 static void release_http_stream_context(struct http_client_ctx *client,
 					uint32_t stream_id)
 {
 	ARRAY_FOR_EACH(client->streams, i) {
 		if (client->streams[i].stream_id == stream_id) {
+			if (client->streams[i].send_pending) {
+				/* The request is complete, keep the stream
+				 * until the whole reply is sent.
+				 */
+				client->streams[i].stream_state =
+					HTTP2_STREAM_HALF_CLOSED_REMOTE;
+				client->streams[i].current_detail = NULL;
+				break;
+			}
+
 			client->streams[i].stream_id = 0;
 			client->streams[i].stream_state = HTTP2_STREAM_IDLE;
 			client->streams[i].current_detail = NULL;
@@ -117,7 +144,8 @@ static int add_header_field(struct http_client_ctx *client, uint8_t **buf,
 	client->header_field.value = value;
 	client->header_field.value_len = strlen(value);
 
-	ret = http_hpack_encode_header(*buf, *buflen, &client->header_field);
+	ret = http_hpack_table_encode_header(&client->encoder_table, *buf, *buflen,
+					     &client->header_field);
 	if (ret < 0) {
 		LOG_DBG("Failed to encode header, err %d", ret);
 		return ret;
@@ -160,7 +188,7 @@ static int send_headers_frame(struct http_client_ctx *client, enum http_status s
 
 	ret = add_header_field(client, &buf, &buflen, ":status", status_str);
 	if (ret < 0) {
-		return ret;
+		goto error;
 	}
 
 	for (size_t i = 0; i < extra_headers_count; i++) {
@@ -176,7 +204,7 @@ static int send_headers_frame(struct http_client_ctx *client, enum http_status s
 
 		ret = add_header_field(client, &buf, &buflen, hdr->name, hdr->value);
 		if (ret < 0) {
-			return ret;
+			goto error;
 		}
 	}
 
@@ -184,7 +212,7 @@ static int send_headers_frame(struct http_client_ctx *client, enum http_status s
 		ret = add_header_field(client, &buf, &buflen, "content-encoding",
 				       detail_common->content_encoding);
 		if (ret < 0) {
-			return ret;
+			goto error;
 		}
 	}
 
@@ -192,7 +220,7 @@ static int send_headers_frame(struct http_client_ctx *client, enum http_status s
 		ret = add_header_field(client, &buf, &buflen, "content-type",
 				       detail_common->content_type);
 		if (ret < 0) {
-			return ret;
+			goto error;
 		}
 	}
 
@@ -206,38 +234,337 @@ static int send_headers_frame(struct http_client_ctx *client, enum http_status s
 				  payload_len + HTTP2_FRAME_HEADER_SIZE);
 	if (ret < 0) {
 		LOG_DBG("Cannot write to socket (%d)", ret);
-		return ret;
+		goto error;
 	}
 
 	client->current_stream->headers_sent = true;
 
 	return 0;
+
+error:
+	/* The peer did not get the header fields added to the dynamic table,
+	 * so empty it on both sides.
+	 */
+	http_hpack_table_reset(&client->encoder_table);
+
+	return ret;
 }
 
 static int send_data_frame(struct http_client_ctx *client, const char *payload,
 			   size_t length, uint32_t stream_id, uint8_t flags)
 {
+	struct http2_stream_ctx *stream = find_http_stream_context(client, stream_id);
 	uint8_t frame_header[HTTP2_FRAME_HEADER_SIZE];
+	struct net_iovec iov[2];
+	size_t frame_len;
+	int ret;
+
+	/* The payload is sent from where it is, split in frames the peer
+	 * accepts.
+	 */
+	do {
+		frame_len = MIN(length, client->peer_max_frame_size);
+
+		encode_frame_header(frame_header, frame_len, HTTP2_DATA_FRAME,
+				    (is_header_flag_set(flags, HTTP2_FLAG_END_STREAM) &&
+				     frame_len == length) ? HTTP2_FLAG_END_STREAM : 0,
+				    stream_id);
+
+		iov[0].iov_base = frame_header;
+		iov[0].iov_len = sizeof(frame_header);
+		iov[1].iov_base = (void *)payload;
+		iov[1].iov_len = (payload != NULL) ? frame_len : 0;
+
+		ret = http_server_sendv(client, iov, ARRAY_SIZE(iov));
+		if (ret < 0) {
+			LOG_DBG("Cannot write to socket (%d)", ret);
+			return ret;
+		}
+
+		/* The short error replies are not held back by the
+		 * windows, but they still consume them.
+		 */
+		client->send_window_size -= frame_len;
+		if (stream != NULL) {
+			stream->send_window_size -= frame_len;
+		}
+
+		if (payload != NULL) {
+			payload += frame_len;
+		}
+
+		length -= frame_len;
+	} while (length > 0);
+
+	return 0;
+}
+
+static int send_pending_frame(struct http_client_ctx *client,
+			      struct http2_stream_ctx *stream)
+{
+	const char *data = (const char *)stream->send_data;
+	size_t len;
 	int ret;
+#if defined(CONFIG_FILE_SYSTEM)
+	char chunk[MAX(CONFIG_HTTP_SERVER_STATIC_FS_RESPONSE_SIZE, 64)];
+#endif
 
-	encode_frame_header(frame_header, length, HTTP2_DATA_FRAME,
-			    is_header_flag_set(flags, HTTP2_FLAG_END_STREAM) ?
-			    HTTP2_FLAG_END_STREAM : 0,
-			    stream_id);
+	len = MIN(stream->send_len, client->peer_max_frame_size);
+	if (len > 0) {
+		/* Both windows are open, see send_pending_data() */
+		len = MIN(len, (size_t)MIN(stream->send_window_size,
+					   client->send_window_size));
+	}
+
+#if defined(CONFIG_FILE_SYSTEM)
+	if (stream->send_from_file) {
+		len = MIN(len, sizeof(chunk));
+
+		ret = fs_read(&stream->file, chunk, len);
+		if (ret < 0) {
+			LOG_ERR("Filesystem read error (%d)", ret);
+			return ret;
+		}
+
+		if (ret == 0 && len > 0) {
+			LOG_ERR("File shorter than expected");
+			return -EIO;
+		}
+
+		len = ret;
+		data = chunk;
+	}
+#endif
 
-	ret = http_server_sendall(client, frame_header, sizeof(frame_header));
+	stream->send_len -= len;
+	if (stream->send_data != NULL) {
+		stream->send_data += len;
+	}
+
+	ret = send_data_frame(client, data, len, stream->stream_id,
+			      (stream->send_len == 0) ? HTTP2_FLAG_END_STREAM : 0);
 	if (ret < 0) {
-		LOG_DBG("Cannot write to socket (%d)", ret);
-	} else {
-		if (payload != NULL && length > 0) {
-			ret = http_server_sendall(client, payload, length);
+		return ret;
+	}
+
+	if (stream->send_len == 0) {
+		cancel_pending_data(stream);
+
+		if (stream->stream_state == HTTP2_STREAM_HALF_CLOSED_REMOTE) {
+			release_http_stream_context(client, stream->stream_id);
+		}
+	}
+
+	return 0;
+}
+
+/* Send the pending reply bodies as far as the peer windows allow. The
+ * streams take turns, one DATA frame at a time, so that a large reply
+ * does not hold back the others.
+ */
+static int send_pending_data(struct http_client_ctx *client)
+{
+	bool sent;
+	int ret;
+
+	do {
+		sent = false;
+
+		ARRAY_FOR_EACH_PTR(client->streams, stream) {
+			if (!stream->send_pending) {
+				continue;
+			}
+
+			if (stream->send_len > 0 &&
+			    (stream->send_window_size <= 0 || client->send_window_size <= 0)) {
+				continue;
+			}
+
+			ret = send_pending_frame(client, stream);
 			if (ret < 0) {
-				LOG_DBG("Cannot write to socket (%d)", ret);
+				return ret;
+			}
+
+			sent = true;
+		}
+	} while (sent);
+
+	return 0;
+}
+
+/* Apply the WINDOW_UPDATE frames received after the frame being processed
+ * and drop them from the client buffer, the other frames are left in place to
+ * be processed afterwards.
+ */
+static int apply_window_updates(struct http_client_ctx *client, uint32_t stream_id)
+{
+	struct http2_frame *frame = &client->current_frame;
+	size_t offset = frame->length + frame->padding_len;
+	struct http2_stream_ctx *stream;
+	uint32_t increment;
+	uint32_t frame_id;
+	size_t frame_len;
+	uint8_t *hdr;
+	int *window;
+
+	while (offset + HTTP2_FRAME_HEADER_SIZE <= client->data_len) {
+		hdr = client->cursor + offset;
+		frame_len = sys_get_be24(&hdr[HTTP2_FRAME_LENGTH_OFFSET]);
+		frame_id = sys_get_be32(&hdr[HTTP2_FRAME_STREAM_ID_OFFSET]) &
+			   HTTP2_FRAME_STREAM_ID_MASK;
+
+		if (hdr[HTTP2_FRAME_TYPE_OFFSET] == HTTP2_RST_STREAM_FRAME &&
+		    frame_id == stream_id) {
+			LOG_DBG("Stream %u reset while waiting for the window", stream_id);
+			return -ECONNRESET;
+		}
+
+		if (hdr[HTTP2_FRAME_TYPE_OFFSET] != HTTP2_WINDOW_UPDATE_FRAME) {
+			offset += HTTP2_FRAME_HEADER_SIZE + frame_len;
+			continue;
+		}
+
+		if (frame_len != HTTP2_WINDOW_UPDATE_FRAME_LEN) {
+			return -EBADMSG;
+		}
+
+		if (offset + HTTP2_FRAME_HEADER_SIZE + frame_len > client->data_len) {
+			break;
+		}
+
+		increment = sys_get_be32(hdr + HTTP2_FRAME_HEADER_SIZE) &
+			    HTTP2_WINDOW_SIZE_INCREMENT_MASK;
+
+		window = NULL;
+		if (frame_id == 0) {
+			window = &client->send_window_size;
+		} else {
+			stream = find_http_stream_context(client, frame_id);
+			if (stream != NULL) {
+				window = &stream->send_window_size;
+			}
+		}
+
+		if (window != NULL) {
+			if (increment == 0 ||
+			    (int64_t)*window + increment > HTTP2_MAX_WINDOW_SIZE) {
+				return -EBADMSG;
 			}
+
+			*window += increment;
 		}
+
+		client->data_len -= HTTP2_FRAME_HEADER_SIZE + frame_len;
+		memmove(hdr, hdr + HTTP2_FRAME_HEADER_SIZE + frame_len,
+			client->data_len - offset);
 	}
 
-	return ret;
+	return 0;
+}
+
+/* Wait until the peer opens both flow control windows of the stream. The
+ * body of a dynamic reply lives in an application buffer which is only valid
+ * during the callback, so the reply cannot be deferred like static content.
+ */
+static int wait_send_window(struct http_client_ctx *client,
+			    struct http2_stream_ctx *stream)
+{
+	struct zsock_pollfd fds = {
+		.fd = client->fd,
+		.events = ZSOCK_POLLIN,
+	};
+	size_t space;
+	int ret;
+
+	while (true) {
+		ret = apply_window_updates(client, stream->stream_id);
+		if (ret < 0) {
+			return ret;
+		}
+
+		if (stream->send_window_size > 0 && client->send_window_size > 0) {
+			return 0;
+		}
+
+		/* The peer cannot be heard before it sent the connection
+		 * preface, after an HTTP/1.1 upgrade.
+		 */
+		space = sizeof(client->buffer) - (client->cursor - client->buffer) -
+			client->data_len;
+		if (client->server_state == HTTP_SERVER_REQUEST_STATE || space == 0) {
+			LOG_DBG("Cannot receive a window update for stream %d",
+				stream->stream_id);
+			return -ENOBUFS;
+		}
+
+		ret = zsock_poll(&fds, 1,
+				 CONFIG_HTTP_SERVER_CLIENT_INACTIVITY_TIMEOUT * MSEC_PER_SEC);
+		if (ret == 0) {
+			return -ETIMEDOUT;
+		} else if (ret < 0) {
+			return -errno;
+		}
+
+		ret = zsock_recv(client->fd, client->cursor + client->data_len, space,
+				 ZSOCK_MSG_DONTWAIT);
+		if (ret == 0) {
+			return -ENOTCONN;
+		} else if (ret < 0) {
+			if (errno == EAGAIN) {
+				continue;
+			}
+
+			return -errno;
+		}
+
+		client->data_len += ret;
+	}
+}
+
+/* Send the body of a dynamic reply within the peer flow control windows,
+ * waiting for them to open when exhausted.
+ */
+static int send_dynamic_data(struct http_client_ctx *client, const uint8_t *body,
+			     size_t length, uint32_t stream_id, uint8_t flags)
+{
+	struct http2_stream_ctx *stream = client->current_stream;
+	bool waited = false;
+	size_t len;
+	int ret;
+
+	do {
+		if (length > 0 &&
+		    (stream->send_window_size <= 0 || client->send_window_size <= 0)) {
+			ret = wait_send_window(client, stream);
+			if (ret < 0) {
+				return ret;
+			}
+
+			waited = true;
+		}
+
+		len = MIN(length, (size_t)MIN(stream->send_window_size,
+					      client->send_window_size));
+
+		ret = send_data_frame(client, (const char *)body, len, stream_id,
+				      (len == length) ? flags : 0);
+		if (ret < 0) {
+			return ret;
+		}
+
+		body += len;
+		length -= len;
+	} while (length > 0);
+
+	/* The window updates may also let deferred replies go on */
+	return waited ? send_pending_data(client) : 0;
+}
+
+void release_http2_streams(struct http_client_ctx *client)
+{
+	ARRAY_FOR_EACH_PTR(client->streams, stream) {
+		cancel_pending_data(stream);
+	}
 }
 
 int send_settings_frame(struct http_client_ctx *client, bool ack)
@@ -262,7 +589,8 @@ int send_settings_frame(struct http_client_ctx *client, bool ack)
 			(settings_frame + HTTP2_FRAME_HEADER_SIZE);
 		UNALIGNED_PUT(net_htons(HTTP2_SETTINGS_HEADER_TABLE_SIZE),
 			      UNALIGNED_MEMBER_ADDR(setting, id));
-		UNALIGNED_PUT(0, UNALIGNED_MEMBER_ADDR(setting, value));
+		UNALIGNED_PUT(net_htonl(client->decoder_table.limit),
+			      UNALIGNED_MEMBER_ADDR(setting, value));
 
 		setting++;
 		UNALIGNED_PUT(net_htons(HTTP2_SETTINGS_MAX_CONCURRENT_STREAMS),
@@ -414,8 +742,7 @@ static int handle_http2_static_resource(
 	struct http_resource_detail_static *static_detail,
 	struct http2_frame *frame, struct http_client_ctx *client)
 {
-	const char *content_200;
-	size_t content_len;
+	struct http2_stream_ctx *stream;
 	int ret;
 
 	if (client->method != HTTP_GET) {
@@ -426,28 +753,24 @@ static int handle_http2_static_resource(
 		return -ENOENT;
 	}
 
-	content_200 = static_detail->static_data;
-	content_len = static_detail->static_data_len;
+	stream = client->current_stream;
 
 	ret = send_headers_frame(client, HTTP_200_OK, frame->stream_identifier,
 				 &static_detail->common, 0, NULL, 0);
 	if (ret < 0) {
 		LOG_DBG("Cannot write to socket (%d)", ret);
-		goto out;
-	}
-
-	ret = send_data_frame(client, content_200, content_len,
-			      frame->stream_identifier,
-			      HTTP2_FLAG_END_STREAM);
-	if (ret < 0) {
-		LOG_DBG("Cannot write to socket (%d)", ret);
-		goto out;
+		return ret;
 	}
 
-	client->current_stream->end_stream_sent = true;
+	/* The data, possibly precompressed, is sent straight from the
+	 * resource, END_STREAM being set on its last DATA frame.
+	 */
+	stream->send_data = static_detail->static_data;
+	stream->send_len = static_detail->static_data_len;
+	stream->send_pending = true;
+	stream->end_stream_sent = true;
 
-out:
-	return ret;
+	return send_pending_data(client);
 }
 
 #if defined(CONFIG_FILE_SYSTEM)
@@ -456,7 +779,6 @@ static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs
 					   struct http_client_ctx *client)
 {
 	int ret;
-	struct fs_file_t file;
 	char fname[HTTP_SERVER_MAX_URL_LENGTH];
 	char content_type[HTTP_SERVER_MAX_CONTENT_TYPE_LEN] = "text/html";
 	struct http_resource_detail res_detail = {
@@ -467,15 +789,15 @@ static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs
 		.type = static_fs_detail->common.type,
 	};
 	enum http_compression chosen_compression = 0;
+	struct http2_stream_ctx *stream = client->current_stream;
+	size_t file_size;
 	int len;
-	int remaining;
-	char tmp[64];
 
 	if (client->method != HTTP_GET) {
 		return send_http2_405(client, frame);
 	}
 
-	if (client->current_stream == NULL) {
+	if (stream == NULL) {
 		return -ENOENT;
 	}
 
@@ -493,10 +815,10 @@ static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs
 
 	/* open file, if it exists */
 #ifdef CONFIG_HTTP_SERVER_COMPRESSION
-	ret = http_server_find_file(fname, sizeof(fname), &client->data_len,
+	ret = http_server_find_file(fname, sizeof(fname), &file_size,
 					client->supported_compression, &chosen_compression);
 #else
-	ret = http_server_find_file(fname, sizeof(fname), &client->data_len, 0, NULL);
+	ret = http_server_find_file(fname, sizeof(fname), &file_size, 0, NULL);
 #endif /* CONFIG_HTTP_SERVER_COMPRESSION */
 	if (ret < 0) {
 		LOG_ERR("fs_stat %s: %d", fname, ret);
@@ -508,13 +830,11 @@ static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs
 		}
 		return ret;
 	}
-	fs_file_t_init(&file);
-	ret = fs_open(&file, fname, FS_O_READ);
+	fs_file_t_init(&stream->file);
+	ret = fs_open(&stream->file, fname, FS_O_READ);
 	if (ret < 0) {
 		LOG_ERR("fs_open %s: %d", fname, ret);
-		if (ret < 0) {
-			return ret;
-		}
+		return ret;
 	}
 
 	/* send headers */
@@ -525,34 +845,17 @@ static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs
 				 NULL, 0);
 	if (ret < 0) {
 		LOG_DBG("Cannot write to socket (%d)", ret);
-		goto out;
-	}
-
-	/* read and send file */
-	remaining = client->data_len;
-	while (remaining > 0) {
-		len = fs_read(&file, tmp, sizeof(tmp));
-		if (len < 0) {
-			LOG_ERR("Filesystem read error (%d)", len);
-			goto out;
-		}
-
-		remaining -= len;
-		ret = send_data_frame(client, tmp, len, frame->stream_identifier,
-				      (remaining > 0) ? 0 : HTTP2_FLAG_END_STREAM);
-		if (ret < 0) {
-			LOG_DBG("Cannot write to socket (%d)", ret);
-			goto out;
-		}
+		fs_close(&stream->file);
+		return ret;
 	}
 
-	client->current_stream->end_stream_sent = true;
+	/* The file is read as the peer windows allow, it is closed once sent */
+	stream->send_len = file_size;
+	stream->send_from_file = true;
+	stream->send_pending = true;
+	stream->end_stream_sent = true;
 
-out:
-	/* close file */
-	fs_close(&file);
-
-	return ret;
+	return send_pending_data(client);
 }
 #endif /* CONFIG_FILE_SYSTEM */
 
@@ -607,8 +910,8 @@ static int http2_dynamic_response(struct http_client_ctx *client, struct http2_f
 			client->current_stream->end_stream_sent = true;
 		}
 
-		ret = send_data_frame(client, rsp->body, rsp->body_len, frame->stream_identifier,
-				      flags);
+		ret = send_dynamic_data(client, rsp->body, rsp->body_len,
+					frame->stream_identifier, flags);
 		if (ret < 0) {
 			return ret;
 		}
@@ -1593,7 +1896,8 @@ int handle_http_frame_headers(struct http_client_ctx *client)
 		struct http_hpack_header_buf *header = &client->header_field;
 		size_t datalen = MIN(client->data_len, frame->length);
 
-		ret = http_hpack_decode_header(client->cursor, datalen, header);
+		ret = http_hpack_table_decode_header(&client->decoder_table,
+						     client->cursor, datalen, header);
 		if (ret <= 0) {
 			if (ret == -EAGAIN) {
 				ret = handle_incomplete_http_header(client);
@@ -1747,6 +2051,7 @@ int handle_http_frame_rst_stream(struct http_client_ctx *client)
 	LOG_DBG("Stream %u reset with error code %u", stream_ctx->stream_id,
 		error_code);
 
+	cancel_pending_data(stream_ctx);
 	release_http_stream_context(client, stream_ctx->stream_id);
 
 	client->data_len -= HTTP2_RST_STREAM_FRAME_LEN;
@@ -1757,10 +2062,74 @@ int handle_http_frame_rst_stream(struct http_client_ctx *client)
 	return 0;
 }
 
+static int apply_http2_settings(struct http_client_ctx *client)
+{
+	struct http2_frame *frame = &client->current_frame;
+	const uint8_t *field = client->cursor;
+	const uint8_t *end = client->cursor + frame->length;
+	uint32_t value;
+	uint16_t id;
+	int delta;
+
+	if (frame->length % sizeof(struct http2_settings_field) != 0) {
+		return -EBADMSG;
+	}
+
+	for (; field < end; field += sizeof(struct http2_settings_field)) {
+		id = sys_get_be16(field);
+		value = sys_get_be32(field + sizeof(uint16_t));
+
+		switch (id) {
+		case HTTP2_SETTINGS_HEADER_TABLE_SIZE:
+			http_hpack_table_set_limit(&client->encoder_table, value);
+			break;
+
+		case HTTP2_SETTINGS_INITIAL_WINDOW_SIZE:
+			if (value > HTTP2_MAX_WINDOW_SIZE) {
+				return -EBADMSG;
+			}
+
+			/* The change applies to the streams already open */
+			delta = (int)value - client->peer_initial_window_size;
+
+			ARRAY_FOR_EACH_PTR(client->streams, stream) {
+				if (stream->stream_state == HTTP2_STREAM_IDLE) {
+					continue;
+				}
+
+				if ((int64_t)stream->send_window_size + delta >
+				    HTTP2_MAX_WINDOW_SIZE) {
+					return -EBADMSG;
+				}
+
+				stream->send_window_size += delta;
+			}
+
+			client->peer_initial_window_size = value;
+			break;
+
+		case HTTP2_SETTINGS_MAX_FRAME_SIZE:
+			if (value < HTTP2_DEFAULT_MAX_FRAME_SIZE ||
+			    value > HTTP2_MAX_FRAME_SIZE) {
+				return -EBADMSG;
+			}
+
+			client->peer_max_frame_size = value;
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	return 0;
+}
+
 int handle_http_frame_settings(struct http_client_ctx *client)
 {
 	struct http2_frame *frame = &client->current_frame;
 	int bytes_consumed;
+	int ret;
 
 	LOG_DBG("HTTP_SERVER_FRAME_SETTINGS");
 
@@ -1768,13 +2137,22 @@ int handle_http_frame_settings(struct http_client_ctx *client)
 		return -EAGAIN;
 	}
 
+	if (is_header_flag_set(frame->flags, HTTP2_FLAG_SETTINGS_ACK)) {
+		if (frame->length != 0) {
+			return -EBADMSG;
+		}
+	} else {
+		ret = apply_http2_settings(client);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
 	bytes_consumed = client->current_frame.length;
 	client->data_len -= bytes_consumed;
 	client->cursor += bytes_consumed;
 
 	if (!is_header_flag_set(frame->flags, HTTP2_FLAG_SETTINGS_ACK)) {
-		int ret;
-
 		ret = send_settings_frame(client, true);
 		if (ret < 0) {
 			LOG_DBG("Cannot write to socket (%d)", ret);
@@ -1784,7 +2162,8 @@ int handle_http_frame_settings(struct http_client_ctx *client)
 
 	client->server_state = HTTP_SERVER_FRAME_HEADER_STATE;
 
-	return 0;
+	/* A larger initial window may let pending replies go on */
+	return send_pending_data(client);
 }
 
 int handle_http_frame_goaway(struct http_client_ctx *client)
@@ -1810,23 +2189,46 @@ int handle_http_frame_goaway(struct http_client_ctx *client)
 int handle_http_frame_window_update(struct http_client_ctx *client)
 {
 	struct http2_frame *frame = &client->current_frame;
-	int bytes_consumed;
+	struct http2_stream_ctx *stream;
+	uint32_t increment;
+	int *window;
 
 	LOG_DBG("HTTP_SERVER_FRAME_WINDOW_UPDATE");
 
-	/* TODO Implement flow control, for now just ignore. */
+	if (frame->length != HTTP2_WINDOW_UPDATE_FRAME_LEN) {
+		return -EBADMSG;
+	}
 
 	if (client->data_len < frame->length) {
 		return -EAGAIN;
 	}
 
-	bytes_consumed = client->current_frame.length;
-	client->data_len -= bytes_consumed;
-	client->cursor += bytes_consumed;
+	increment = sys_get_be32(client->cursor) & HTTP2_WINDOW_SIZE_INCREMENT_MASK;
+
+	client->data_len -= HTTP2_WINDOW_UPDATE_FRAME_LEN;
+	client->cursor += HTTP2_WINDOW_UPDATE_FRAME_LEN;
 
 	client->server_state = HTTP_SERVER_FRAME_HEADER_STATE;
 
-	return 0;
+	if (frame->stream_identifier == 0) {
+		window = &client->send_window_size;
+	} else {
+		stream = find_http_stream_context(client, frame->stream_identifier);
+		if (stream == NULL) {
+			/* The stream may have just been closed, nothing to do */
+			return 0;
+		}
+
+		window = &stream->send_window_size;
+	}
+
+	if (increment == 0 || (int64_t)*window + increment > HTTP2_MAX_WINDOW_SIZE) {
+		return -EBADMSG;
+	}
+
+	*window += increment;
+
+	return send_pending_data(client);
 }
 
 int handle_http_frame_continuation(struct http_client_ctx *client)
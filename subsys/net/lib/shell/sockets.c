@@ -123,10 +123,31 @@ static void walk_socket_services(const struct net_socket_service_desc *svc,
 	snprintk(owner, sizeof(owner), "<unknown>");
 #endif
 
-	PR("%32s  %-5d %s\n", owner, svc->pev_len, pev_output);
+	PR("%32s  %-6d %-5d %s\n", owner, net_socket_service_get_worker(svc), svc->pev_len,
+	   pev_output);
 
 	(*count)++;
 }
+
+#if defined(CONFIG_NET_SOCKETS_SERVICE_STATS)
+static void print_socket_service_stats(const struct shell *sh)
+{
+	struct net_socket_service_stats stats;
+
+	PR("\nService threads (times in microseconds):\n");
+	PR("%-6s %-10s %-10s %-6s %-6s %-12s %-12s %-12s %-12s\n", "Worker", "Events",
+	   "Batches", "Queue", "Max", "Latency avg", "Latency max", "Run avg", "Run max");
+
+	for (int worker = 0; net_socket_service_stats_get(worker, &stats) == 0; worker++) {
+		uint32_t events = MAX(stats.events, 1U);
+
+		PR("%-6d %-10u %-10u %-6u %-6u %-12u %-12u %-12u %-12u\n", worker,
+		   stats.events, stats.batches, stats.queue_depth, stats.max_queue_depth,
+		   (uint32_t)(stats.latency_sum_us / events), stats.latency_max_us,
+		   (uint32_t)(stats.run_sum_us / events), stats.run_max_us);
+	}
+}
+#endif /* CONFIG_NET_SOCKETS_SERVICE_STATS */
 #endif /* CONFIG_NET_SOCKETS_SERVICE */
 
 static int cmd_net_sockets(const struct shell *sh, size_t argc, char *argv[])
@@ -180,7 +201,7 @@ static int cmd_net_sockets(const struct shell *sh, size_t argc, char *argv[])
 	svc_user_data.user_data = &svc_count;
 
 	PR("Services:\n");
-	PR("%32s  %-5s %s\n", "Owner", "Count", "FDs");
+	PR("%32s  %-6s %-5s %s\n", "Owner", "Worker", "Count", "FDs");
 	PR("\n");
 
 	net_socket_service_foreach(walk_socket_services, (void *)&svc_user_data);
@@ -192,6 +213,10 @@ static int cmd_net_sockets(const struct shell *sh, size_t argc, char *argv[])
 		   svc_count == 1 ? "" : "s");
 	}
 
+#if defined(CONFIG_NET_SOCKETS_SERVICE_STATS)
+	print_socket_service_stats(sh);
+#endif
+
 #if !defined(CONFIG_NET_SOCKETS_OBJ_CORE)
 	PR("\n");
 #endif
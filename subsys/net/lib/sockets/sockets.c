@@ -13,6 +13,7 @@ LOG_MODULE_REGISTER(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/kernel.h>
 #include <zephyr/tracing/tracing.h>
 #include <zephyr/net/socket.h>
+#include <zephyr/net/net_pkt.h>
 #include <zephyr/internal/syscall_handler.h>
 
 #include "sockets_internal.h"
@@ -711,6 +712,161 @@ fail:
 #include <zephyr/syscalls/zsock_recvmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+int z_impl_zsock_sendmmsg(int sock, struct net_mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	unsigned int count;
+	ssize_t ret = 0;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->sendmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (count = 0U; count < vlen; count++) {
+		ret = vtable->sendmsg(obj, &msgvec[count].msg_hdr, flags);
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[count].msg_len = ret;
+		sock_obj_core_update_send_stats(sock, ret);
+	}
+
+	k_mutex_unlock(lock);
+
+	/* The error is only reported if nothing was sent */
+	return (count > 0U || ret >= 0) ? (int)count : -1;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_sendmmsg(int sock, struct net_mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	unsigned int count;
+	ssize_t ret = 0;
+
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen, sizeof(struct net_mmsghdr)));
+
+	/* Each message needs its own copy, so they are sent one by one */
+	for (count = 0U; count < vlen; count++) {
+		ret = z_vrfy_zsock_sendmsg(sock, &msgvec[count].msg_hdr, flags);
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[count].msg_len = ret;
+	}
+
+	return (count > 0U || ret >= 0) ? (int)count : -1;
+}
+#include <zephyr/syscalls/zsock_sendmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+/* Return the flags used to receive the next message in zsock_recvmmsg() */
+static int recvmmsg_flags(int flags, unsigned int count)
+{
+	if (count > 0U && (flags & ZSOCK_MSG_WAITFORONE)) {
+		flags |= ZSOCK_MSG_DONTWAIT;
+	}
+
+	return flags & ~ZSOCK_MSG_WAITFORONE;
+}
+
+static bool recvmmsg_expired(int timeout, int64_t end)
+{
+	return timeout != SYS_FOREVER_MS && k_uptime_get() >= end;
+}
+
+int z_impl_zsock_recvmmsg(int sock, struct net_mmsghdr *msgvec,
+			  unsigned int vlen, int flags, int timeout)
+{
+	const struct socket_op_vtable *vtable;
+	int64_t end = k_uptime_get() + MAX(timeout, 0);
+	struct k_mutex *lock;
+	unsigned int count;
+	ssize_t ret = 0;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->recvmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (count = 0U; count < vlen; count++) {
+		ret = vtable->recvmsg(obj, &msgvec[count].msg_hdr,
+				      recvmmsg_flags(flags, count));
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[count].msg_len = ret;
+		sock_obj_core_update_recv_stats(sock, ret);
+
+		if (recvmmsg_expired(timeout, end)) {
+			count++;
+			break;
+		}
+	}
+
+	k_mutex_unlock(lock);
+
+	/* An error after the first message, typically EAGAIN once the queue
+	 * is drained, is not reported.
+	 */
+	return (count > 0U || ret >= 0) ? (int)count : -1;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_recvmmsg(int sock, struct net_mmsghdr *msgvec,
+					unsigned int vlen, int flags, int timeout)
+{
+	int64_t end = k_uptime_get() + MAX(timeout, 0);
+	unsigned int count;
+	ssize_t ret = 0;
+
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen, sizeof(struct net_mmsghdr)));
+
+	/* Each message needs its own copy, so they are received one by one */
+	for (count = 0U; count < vlen; count++) {
+		ret = z_vrfy_zsock_recvmsg(sock, &msgvec[count].msg_hdr,
+					   recvmmsg_flags(flags, count));
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[count].msg_len = ret;
+
+		if (recvmmsg_expired(timeout, end)) {
+			count++;
+			break;
+		}
+	}
+
+	return (count > 0U || ret >= 0) ? (int)count : -1;
+}
+#include <zephyr/syscalls/zsock_recvmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
@@ -1152,3 +1308,58 @@ int zsock_sendmsg_all(int sock, const struct net_msghdr *message, int flags,
 
 	return 0;
 }
+
+ssize_t zsock_recv_zc(int sock, struct net_iovec *iov, size_t *iovcnt, int flags,
+		      struct net_sockaddr *src_addr, net_socklen_t *addrlen,
+		      struct zsock_zc_loan *loan)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	ssize_t ret;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->recv_zc == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	ret = vtable->recv_zc(obj, iov, iovcnt, flags, src_addr, addrlen, loan);
+	if (ret > 0) {
+		sock_obj_core_update_recv_stats(sock, ret);
+	}
+
+	k_mutex_unlock(lock);
+
+	return ret;
+}
+
+void zsock_recv_zc_release(int sock, struct zsock_zc_loan *loan)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	void *obj;
+
+	if (loan == NULL || loan->pkt == NULL) {
+		return;
+	}
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL || vtable->recv_zc_release == NULL) {
+		/* The socket is gone, only the buffers are left to free */
+		net_pkt_unref(loan->pkt);
+		loan->pkt = NULL;
+		return;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+	vtable->recv_zc_release(obj, loan);
+	k_mutex_unlock(lock);
+}
@@ -668,6 +668,9 @@ out:
 	return -1;
 }
 
+ssize_t zsock_sendmsg_ctx(struct net_context *ctx, const struct net_msghdr *msg,
+			  int flags);
+
 ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
 			 int flags,
 			 const struct net_sockaddr *dest_addr, net_socklen_t addrlen)
@@ -698,6 +701,22 @@ ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
 		}
 	}
 
+	if (IS_ENABLED(CONFIG_NET_CONTEXT_ZEROCOPY) && (flags & ZSOCK_MSG_ZEROCOPY)) {
+		/* Only the message based send hands the flags to net_context */
+		struct net_iovec iov = {
+			.iov_base = (void *)buf,
+			.iov_len = len,
+		};
+		struct net_msghdr msg = {
+			.msg_name = (void *)dest_addr,
+			.msg_namelen = addrlen,
+			.msg_iov = &iov,
+			.msg_iovlen = 1,
+		};
+
+		return zsock_sendmsg_ctx(ctx, &msg, flags);
+	}
+
 	while (1) {
 		if (dest_addr) {
 			status = net_context_sendto(ctx, buf, len, dest_addr,
@@ -1599,6 +1618,45 @@ ssize_t zsock_recvfrom_ctx(struct net_context *ctx, void *buf, size_t max_len,
 	return -1;
 }
 
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+/* Report the zero-copy sends completed since the last call, as a single
+ * extended error in the control data.
+ */
+static ssize_t zsock_recv_errqueue(struct net_context *ctx, struct net_msghdr *msg)
+{
+	struct zsock_extended_err err = {
+		.ee_origin = ZSOCK_SO_EE_ORIGIN_ZEROCOPY,
+	};
+	bool copied;
+
+	if (msg->msg_control == NULL ||
+	    msg->msg_controllen < NET_CMSG_SPACE(sizeof(err))) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (net_zc_tx_completion_get(ctx, &err.ee_info, &err.ee_data,
+				     &copied) < 0) {
+		errno = EAGAIN;
+		return -1;
+	}
+
+	if (copied) {
+		err.ee_code = ZSOCK_SO_EE_CODE_ZEROCOPY_COPIED;
+	}
+
+	if (insert_pktinfo(msg, ZSOCK_SOL_SOCKET, ZSOCK_SCM_ZEROCOPY,
+			   &err, sizeof(err)) < 0) {
+		msg->msg_flags |= ZSOCK_MSG_CTRUNC;
+	}
+
+	update_msg_controllen(msg);
+	msg->msg_flags |= ZSOCK_MSG_ERRQUEUE;
+
+	return 0;
+}
+#endif /* CONFIG_NET_CONTEXT_ZEROCOPY */
+
 ssize_t zsock_recvmsg_ctx(struct net_context *ctx, struct net_msghdr *msg,
 			  int flags)
 {
@@ -1615,6 +1673,12 @@ ssize_t zsock_recvmsg_ctx(struct net_context *ctx, struct net_msghdr *msg,
 		return -1;
 	}
 
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+	if (flags & ZSOCK_MSG_ERRQUEUE) {
+		return zsock_recv_errqueue(ctx, msg);
+	}
+#endif
+
 	for (i = 0; i < msg->msg_iovlen; i++) {
 		max_len += msg->msg_iov[i].iov_len;
 	}
@@ -1634,6 +1698,197 @@ ssize_t zsock_recvmsg_ctx(struct net_context *ctx, struct net_msghdr *msg,
 	return -1;
 }
 
+/* Return the packet at the head of the receive queue, dropping the empty
+ * packets that only mark the end of a stream.
+ */
+static struct net_pkt *zsock_recv_zc_head(struct net_context *ctx, bool stream)
+{
+	struct net_pkt *pkt;
+
+	while ((pkt = k_fifo_peek_head(&ctx->recv_q)) != NULL) {
+		if (!stream || net_pkt_remaining_data(pkt) > 0) {
+			break;
+		}
+
+		pkt = k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+		if (net_pkt_eof(pkt)) {
+			sock_set_eof(ctx);
+		}
+
+		net_pkt_unref(pkt);
+	}
+
+	return pkt;
+}
+
+/* Point the iovecs to the data following the cursor, and move the cursor
+ * past the data they cover.
+ */
+static size_t zsock_recv_zc_fill(struct net_pkt *pkt, struct net_iovec *iov,
+				 size_t *iovcnt)
+{
+	size_t remaining = net_pkt_remaining_data(pkt);
+	struct net_buf *frag = pkt->cursor.buf;
+	uint8_t *pos = pkt->cursor.pos;
+	bool overwrite;
+	size_t count = 0;
+	size_t len = 0;
+
+	while (frag != NULL && remaining > 0 && count < *iovcnt) {
+		size_t frag_len = MIN(frag->len - (size_t)(pos - frag->data), remaining);
+
+		if (frag_len > 0) {
+			iov[count].iov_base = pos;
+			iov[count].iov_len = frag_len;
+			count++;
+			len += frag_len;
+			remaining -= frag_len;
+		}
+
+		frag = frag->frags;
+		if (frag != NULL) {
+			pos = frag->data;
+		}
+	}
+
+	overwrite = net_pkt_is_being_overwritten(pkt);
+	net_pkt_set_overwrite(pkt, true);
+	(void)net_pkt_skip(pkt, len);
+	net_pkt_set_overwrite(pkt, overwrite);
+
+	*iovcnt = count;
+
+	return len;
+}
+
+static ssize_t zsock_recv_zc_ctx(struct net_context *ctx, struct net_iovec *iov,
+				 size_t *iovcnt, int flags,
+				 struct net_sockaddr *src_addr, net_socklen_t *addrlen,
+				 struct zsock_zc_loan *loan)
+{
+	bool stream = net_context_get_type(ctx) == NET_SOCK_STREAM;
+	k_timeout_t timeout = K_FOREVER;
+	struct net_pkt *pkt;
+	size_t len;
+	int ret;
+
+	if (iov == NULL || iovcnt == NULL || *iovcnt == 0U || loan == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if ((flags & ~ZSOCK_MSG_DONTWAIT) != 0 ||
+	    (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
+	     net_if_is_ip_offloaded(net_context_get_iface(ctx)))) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if (stream && net_context_get_state(ctx) != NET_CONTEXT_CONNECTED) {
+		errno = ENOTCONN;
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else {
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+	}
+
+	pkt = zsock_recv_zc_head(ctx, stream);
+	if (pkt == NULL && !K_TIMEOUT_EQ(timeout, K_NO_WAIT) &&
+	    !(stream && (sock_is_eof(ctx) || sock_is_error(ctx)))) {
+		ret = zsock_wait_data(ctx, &timeout);
+		if (ret < 0) {
+			errno = -ret;
+			return -1;
+		}
+
+		pkt = zsock_recv_zc_head(ctx, stream);
+	}
+
+	if (pkt == NULL) {
+		if (stream && sock_is_error(ctx)) {
+			errno = POINTER_TO_INT(ctx->user_data);
+			return -1;
+		}
+
+		if (stream && sock_is_eof(ctx)) {
+			*iovcnt = 0;
+			loan->len = 0;
+			loan->pkt = NULL;
+			return 0;
+		}
+
+		errno = EAGAIN;
+		return -1;
+	}
+
+	if (stream) {
+		ret = sock_get_stream_src_addr(ctx, src_addr, addrlen);
+	} else if (src_addr != NULL && addrlen != NULL) {
+		ret = sock_get_pkt_src_addr(ctx, pkt, src_addr, *addrlen);
+		if (ret == 0) {
+			*addrlen = (src_addr->sa_family == NET_AF_INET) ?
+				   sizeof(struct net_sockaddr_in) :
+				   sizeof(struct net_sockaddr_in6);
+		}
+	} else {
+		ret = 0;
+	}
+
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	len = zsock_recv_zc_fill(pkt, iov, iovcnt);
+
+	/* The loan holds its own reference, the one of the queue is dropped
+	 * once the packet is consumed. The rest of a stream packet not covered
+	 * by the iovecs is left for the next call.
+	 */
+	net_pkt_ref(pkt);
+
+	if (!stream || net_pkt_remaining_data(pkt) == 0) {
+		(void)k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+
+		if (stream && net_pkt_eof(pkt)) {
+			sock_set_eof(ctx);
+		}
+
+		if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS) ||
+		    IS_ENABLED(CONFIG_TRACING_NET_CORE)) {
+			net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+		}
+
+		net_pkt_unref(pkt);
+	}
+
+	loan->len = len;
+	loan->pkt = pkt;
+	loan->ctx = ctx;
+	loan->generation = ctx->generation;
+
+	return len;
+}
+
+static void zsock_recv_zc_release_ctx(struct net_context *ctx,
+				      struct zsock_zc_loan *loan)
+{
+	/* The window is not updated if the socket was closed meanwhile, even
+	 * if its descriptor and its context were then reused.
+	 */
+	if (loan->ctx == ctx && loan->generation == ctx->generation &&
+	    net_context_is_used(ctx) && loan->len > 0 &&
+	    net_context_get_type(ctx) == NET_SOCK_STREAM) {
+		net_context_update_recv_wnd(ctx, loan->len);
+	}
+
+	net_pkt_unref(loan->pkt);
+	loan->pkt = NULL;
+}
+
 static int zsock_poll_prepare_ctx(struct net_context *ctx,
 				  struct zsock_pollfd *pfd,
 				  struct k_poll_event **pev,
@@ -1651,6 +1906,23 @@ static int zsock_poll_prepare_ctx(struct net_context *ctx,
 		(*pev)++;
 	}
 
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+	/* Completed zero-copy sends are reported with POLLERR, which is
+	 * always polled for.
+	 */
+	if (ctx->options.zerocopy) {
+		if (*pev == pev_end) {
+			return -ENOMEM;
+		}
+
+		(*pev)->obj = &ctx->zc.signal;
+		(*pev)->type = K_POLL_TYPE_SIGNAL;
+		(*pev)->mode = K_POLL_MODE_NOTIFY_ONLY;
+		(*pev)->state = K_POLL_STATE_NOT_READY;
+		(*pev)++;
+	}
+#endif
+
 	if (pfd->events & ZSOCK_POLLOUT) {
 		if (IS_ENABLED(CONFIG_NET_NATIVE_TCP) &&
 		    net_context_get_type(ctx) == NET_SOCK_STREAM &&
@@ -1699,6 +1971,16 @@ static int zsock_poll_update_ctx(struct net_context *ctx,
 		}
 		(*pev)++;
 	}
+
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+	if (ctx->options.zerocopy) {
+		if (net_zc_tx_completion_pending(ctx)) {
+			pfd->revents |= ZSOCK_POLLERR;
+		}
+		(*pev)++;
+	}
+#endif
+
 	if (pfd->events & ZSOCK_POLLOUT) {
 		if (IS_ENABLED(CONFIG_NET_NATIVE_TCP) &&
 		    net_context_get_type(ctx) == NET_SOCK_STREAM &&
@@ -1990,6 +2272,20 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 				return 0;
 			}
 
+			break;
+
+		case ZSOCK_SO_ZEROCOPY:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_ZEROCOPY)) {
+				ret = net_context_get_option(ctx, NET_OPT_ZEROCOPY,
+							     optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
 			break;
 		}
 
@@ -2018,6 +2314,20 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 				return 0;
 			}
 
+			break;
+
+		case ZSOCK_TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+				ret = net_tcp_get_option(ctx, TCP_OPT_CONGESTION,
+							 optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
 			break;
 		}
 
@@ -2620,6 +2930,20 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 				return 0;
 			}
 
+			break;
+
+		case ZSOCK_SO_ZEROCOPY:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_ZEROCOPY)) {
+				ret = net_context_set_option(ctx, NET_OPT_ZEROCOPY,
+							     optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
 			break;
 		}
 
@@ -2649,6 +2973,20 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 				return 0;
 			}
 
+			break;
+
+		case ZSOCK_TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+				ret = net_tcp_set_option(ctx, TCP_OPT_CONGESTION,
+							 optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
 			break;
 		}
 		break;
@@ -3197,6 +3535,21 @@ static ssize_t sock_recvfrom_vmeth(void *obj, void *buf, size_t max_len,
 				  src_addr, addrlen);
 }
 
+static ssize_t sock_recv_zc_vmeth(void *obj, struct net_iovec *iov,
+				  size_t *iovcnt, int flags,
+				  struct net_sockaddr *src_addr,
+				  net_socklen_t *addrlen,
+				  struct zsock_zc_loan *loan)
+{
+	return zsock_recv_zc_ctx(obj, iov, iovcnt, flags, src_addr, addrlen,
+				 loan);
+}
+
+static void sock_recv_zc_release_vmeth(void *obj, struct zsock_zc_loan *loan)
+{
+	zsock_recv_zc_release_ctx(obj, loan);
+}
+
 static int sock_getsockopt_vmeth(void *obj, int level, int optname,
 				 void *optval, net_socklen_t *optlen)
 {
@@ -3245,6 +3598,8 @@ const struct socket_op_vtable sock_fd_op_vtable = {
 	.setsockopt = sock_setsockopt_vmeth,
 	.getpeername = sock_getpeername_vmeth,
 	.getsockname = sock_getsockname_vmeth,
+	.recv_zc = sock_recv_zc_vmeth,
+	.recv_zc_release = sock_recv_zc_release_vmeth,
 };
 
 static bool inet_is_supported(int family, int type, int proto)
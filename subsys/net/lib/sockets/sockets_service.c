@@ -10,6 +10,7 @@ LOG_MODULE_REGISTER(net_sock_svc, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/kernel.h>
 #include <zephyr/init.h>
 #include <zephyr/net/socket_service.h>
+#include <zephyr/sys/atomic.h>
 #include <zephyr/zvfs/eventfd.h>
 
 static int init_socket_service(void);
@@ -35,6 +36,107 @@ static struct service {
 
 #define get_idx(svc) (*(svc->idx))
 
+/* Number of threads calling the callbacks, the service thread itself if
+ * there are no workers.
+ */
+#define RUNNERS MAX(CONFIG_NET_SOCKETS_SERVICE_WORKERS, 1)
+
+#if defined(CONFIG_NET_SOCKETS_SERVICE_STATS)
+static struct runner_stats {
+	struct net_socket_service_stats stats;
+	atomic_t queue_depth;
+} runner_stats[RUNNERS];
+
+static void stats_queued(int runner, int count)
+{
+	struct runner_stats *rs = &runner_stats[runner];
+	atomic_val_t depth = atomic_add(&rs->queue_depth, count) + count;
+
+	rs->stats.batches++;
+	rs->stats.max_queue_depth = MAX(rs->stats.max_queue_depth, (uint32_t)depth);
+}
+
+static void stats_handled(int runner, uint32_t queued, uint32_t start)
+{
+	struct runner_stats *rs = &runner_stats[runner];
+	uint32_t latency = k_cyc_to_us_floor32(start - queued);
+	uint32_t run = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+
+	atomic_dec(&rs->queue_depth);
+
+	rs->stats.events++;
+	rs->stats.latency_sum_us += latency;
+	rs->stats.latency_max_us = MAX(rs->stats.latency_max_us, latency);
+	rs->stats.run_sum_us += run;
+	rs->stats.run_max_us = MAX(rs->stats.run_max_us, run);
+}
+
+int net_socket_service_stats_get(int worker, struct net_socket_service_stats *stats)
+{
+	if (worker < 0 || worker >= RUNNERS) {
+		return -EINVAL;
+	}
+
+	*stats = runner_stats[worker].stats;
+	stats->queue_depth = atomic_get(&runner_stats[worker].queue_depth);
+
+	return 0;
+}
+
+static inline uint32_t stats_timestamp(void)
+{
+	return k_cycle_get_32();
+}
+#else
+static inline void stats_queued(int runner, int count)
+{
+	ARG_UNUSED(runner);
+	ARG_UNUSED(count);
+}
+
+static inline void stats_handled(int runner, uint32_t queued, uint32_t start)
+{
+	ARG_UNUSED(runner);
+	ARG_UNUSED(queued);
+	ARG_UNUSED(start);
+}
+
+static inline uint32_t stats_timestamp(void)
+{
+	return 0;
+}
+#endif /* CONFIG_NET_SOCKETS_SERVICE_STATS */
+
+int net_socket_service_get_worker(const struct net_socket_service_desc *svc)
+{
+	int affinity = *svc->worker;
+
+	if (affinity > 0) {
+		return affinity - 1;
+	}
+
+	/* Services without affinity are spread over the workers */
+	return (svc - STRUCT_SECTION_START(net_socket_service_desc)) % RUNNERS;
+}
+
+int net_socket_service_set_worker(const struct net_socket_service_desc *svc, int worker)
+{
+	if (CONFIG_NET_SOCKETS_SERVICE_WORKERS == 0) {
+		return -ENOTSUP;
+	}
+
+	if (worker >= RUNNERS ||
+	    STRUCT_SECTION_START(net_socket_service_desc) > svc ||
+	    STRUCT_SECTION_END(net_socket_service_desc) <= svc) {
+		return -EINVAL;
+	}
+
+	/* Takes effect for the next ready events of the service */
+	*svc->worker = worker < 0 ? 0 : worker + 1;
+
+	return 0;
+}
+
 void net_socket_service_foreach(net_socket_service_cb_t cb, void *user_data)
 {
 	STRUCT_SECTION_FOREACH(net_socket_service_desc, svc) {
@@ -126,8 +228,10 @@ void net_socket_service_callback(struct net_socket_service_event *pev)
 	ev.callback(&ev);
 }
 
-static int call_work(struct zsock_pollfd *pev, struct net_socket_service_event *event)
+static int call_work(struct zsock_pollfd *pev, struct net_socket_service_event *event,
+		     uint32_t ready_time)
 {
+	uint32_t start = stats_timestamp();
 	int ret = 0;
 	int fd = pev->fd;
 
@@ -139,13 +243,15 @@ static int call_work(struct zsock_pollfd *pev, struct net_socket_service_event *
 	/* Synchronous call */
 	net_socket_service_callback(event);
 
+	stats_handled(0, ready_time, start);
+
 	/* Restore the fd so that new data can be re-triggered */
 	pev->fd = fd;
 
 	return ret;
 }
 
-static int trigger_work(struct zsock_pollfd *pev)
+static int trigger_work(struct zsock_pollfd *pev, uint32_t ready_time)
 {
 	struct net_socket_service_event *event;
 	struct net_socket_service_desc *svc;
@@ -162,17 +268,158 @@ static int trigger_work(struct zsock_pollfd *pev)
 	 */
 	event->event = *pev;
 
-	return call_work(pev, event);
+	return call_work(pev, event, ready_time);
+}
+
+#if CONFIG_NET_SOCKETS_SERVICE_WORKERS > 0
+/* A ready event handed to a worker. The socket is not polled until the
+ * callback returns, so there is at most one job per poll entry.
+ */
+struct service_job {
+	sys_snode_t node;
+	const struct net_socket_service_desc *svc;
+	struct net_socket_service_event *event;
+	struct zsock_pollfd pfd;
+	uint32_t ready_time;
+	int slot;
+};
+
+static struct service_job jobs[CONFIG_ZVFS_POLL_MAX];
+static ATOMIC_DEFINE(busy_slots, CONFIG_ZVFS_POLL_MAX);
+static struct k_fifo worker_fifos[CONFIG_NET_SOCKETS_SERVICE_WORKERS];
+
+static void socket_service_worker(void *p1, void *p2, void *p3)
+{
+	struct k_fifo *fifo = &worker_fifos[POINTER_TO_INT(p1)];
+	struct net_socket_service_event ev;
+	struct service_job *job;
+	uint32_t start;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		job = k_fifo_get(fifo, K_FOREVER);
+
+		/* Handle the whole batch, then let the service thread poll
+		 * its sockets again at once.
+		 */
+		do {
+			start = stats_timestamp();
+
+			ev = *job->event;
+			ev.svc = (struct net_socket_service_desc *)job->svc;
+			ev.event = job->pfd;
+			ev.callback(&ev);
+
+			stats_handled(POINTER_TO_INT(p1), job->ready_time, start);
+
+			atomic_clear_bit(busy_slots, job->slot);
+
+			job = k_fifo_get(fifo, K_NO_WAIT);
+		} while (job != NULL);
+
+		zvfs_eventfd_write(ctx.events[0].fd, 1);
+	}
+}
+
+/* Hand the ready events to the workers of their services, one batch per
+ * worker, and stop polling their sockets until they are handled.
+ */
+static void dispatch_work(uint32_t ready_time)
+{
+	sys_slist_t batches[CONFIG_NET_SOCKETS_SERVICE_WORKERS];
+	int counts[CONFIG_NET_SOCKETS_SERVICE_WORKERS] = { 0 };
+	struct service_job *job;
+	int worker;
+	int slot;
+
+	ARRAY_FOR_EACH(batches, i) {
+		sys_slist_init(&batches[i]);
+	}
+
+	STRUCT_SECTION_FOREACH(net_socket_service_desc, svc) {
+		worker = net_socket_service_get_worker(svc);
+
+		for (int j = 0; j < svc->pev_len; j++) {
+			slot = get_idx(svc) + j;
+
+			if (ctx.events[slot].fd < 0 || ctx.events[slot].revents == 0) {
+				continue;
+			}
+
+			job = &jobs[slot];
+			job->svc = svc;
+			job->event = &svc->pev[j];
+			job->pfd = ctx.events[slot];
+			job->ready_time = ready_time;
+			job->slot = slot;
+
+			atomic_set_bit(busy_slots, slot);
+			ctx.events[slot].fd = -1;
+
+			sys_slist_append(&batches[worker], &job->node);
+			counts[worker]++;
+		}
+	}
+
+	ARRAY_FOR_EACH(batches, i) {
+		if (counts[i] > 0) {
+			stats_queued(i, counts[i]);
+			k_fifo_put_slist(&worker_fifos[i], &batches[i]);
+		}
+	}
 }
 
+static bool is_busy(int slot)
+{
+	return atomic_test_bit(busy_slots, slot);
+}
+
+static void init_workers(void)
+{
+	static struct k_thread worker_threads[CONFIG_NET_SOCKETS_SERVICE_WORKERS];
+	static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, CONFIG_NET_SOCKETS_SERVICE_WORKERS,
+					   CONFIG_NET_SOCKETS_SERVICE_WORKER_STACK_SIZE);
+	char name[sizeof("net_socket_service_wXX")];
+	k_tid_t tid;
+
+	ARRAY_FOR_EACH(worker_threads, i) {
+		k_fifo_init(&worker_fifos[i]);
+
+		tid = k_thread_create(&worker_threads[i], worker_stacks[i],
+				      K_THREAD_STACK_SIZEOF(worker_stacks[i]),
+				      socket_service_worker, INT_TO_POINTER(i), NULL, NULL,
+				      CLAMP(CONFIG_NET_SOCKETS_SERVICE_THREAD_PRIO,
+					    K_HIGHEST_APPLICATION_THREAD_PRIO,
+					    K_LOWEST_APPLICATION_THREAD_PRIO), 0, K_NO_WAIT);
+
+		snprintk(name, sizeof(name), "net_socket_service_w%d", (int)i);
+		k_thread_name_set(tid, name);
+	}
+}
+#else
+static inline bool is_busy(int slot)
+{
+	ARG_UNUSED(slot);
+
+	return false;
+}
+
+static inline void init_workers(void)
+{
+}
+#endif /* CONFIG_NET_SOCKETS_SERVICE_WORKERS > 0 */
+
 static void socket_service_thread(void *p1, void *p2, void *p3)
 {
 	ARG_UNUSED(p1);
 	ARG_UNUSED(p2);
 	ARG_UNUSED(p3);
 
-	int ret, i, fd, count = 0;
+	int ret, fd, count = 0;
 	zvfs_eventfd_t value;
+	uint32_t ready_time;
 
 	STRUCT_SECTION_COUNT(net_socket_service_desc, &ret);
 	if (ret == 0) {
@@ -218,14 +465,18 @@ static void socket_service_thread(void *p1, void *p2, void *p3)
 	ctx.events[0].events = ZSOCK_POLLIN;
 
 restart:
-	i = 1;
-
 	k_mutex_lock(&lock, K_FOREVER);
 
-	/* Copy individual events to the big array */
+	/* Copy individual events to the big array, the sockets whose events
+	 * are being handled by a worker are polled once they are done.
+	 */
 	STRUCT_SECTION_FOREACH(net_socket_service_desc, svc) {
 		for (int j = 0; j < svc->pev_len; j++) {
 			ctx.events[get_idx(svc) + j] = svc->pev[j].event;
+
+			if (is_busy(get_idx(svc) + j)) {
+				ctx.events[get_idx(svc) + j].fd = -1;
+			}
 		}
 	}
 
@@ -244,20 +495,28 @@ restart:
 			break;
 		}
 
+		ready_time = stats_timestamp();
+
+#if CONFIG_NET_SOCKETS_SERVICE_WORKERS > 0
+		dispatch_work(ready_time);
+#else
+		stats_queued(0, ret - (ctx.events[0].revents ? 1 : 0));
+
 		/* Process work here */
-		for (i = 1; i < (count + 1); i++) {
+		for (int i = 1; i < (count + 1); i++) {
 			if (ctx.events[i].fd < 0) {
 				continue;
 			}
 
 			if (ctx.events[i].revents > 0) {
-				ret = trigger_work(&ctx.events[i]);
+				ret = trigger_work(&ctx.events[i], ready_time);
 				if (ret < 0) {
 					NET_DBG("Triggering work failed (%d)", ret);
 					goto restart;
 				}
 			}
 		}
+#endif
 
 		/* Relocate after trigger work so the work gets done before restarting */
 		if (ctx.events[0].revents) {
@@ -287,6 +546,9 @@ static int init_socket_service(void)
 	static K_THREAD_STACK_DEFINE(service_thread_stack,
 				     CONFIG_NET_SOCKETS_SERVICE_STACK_SIZE);
 
+	/* The workers must be ready before the first events are dispatched */
+	init_workers();
+
 	ssm = k_thread_create(&service_thread,
 			      service_thread_stack,
 			      K_THREAD_STACK_SIZEOF(service_thread_stack),
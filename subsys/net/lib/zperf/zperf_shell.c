@@ -318,6 +318,16 @@ static int cmd_setip(const struct shell *sh, size_t argc, char *argv[])
 	return 0;
 }
 
+/* Return the number of packets per second */
+static uint32_t packet_rate(uint32_t nb_packets, uint64_t time_in_us)
+{
+	if (time_in_us == 0U) {
+		return 0U;
+	}
+
+	return (uint32_t)(((uint64_t)nb_packets * USEC_PER_SEC) / time_in_us);
+}
+
 #ifdef CONFIG_NET_ZPERF_SERVER
 
 static void udp_session_cb(enum zperf_status status,
@@ -364,6 +374,9 @@ static void udp_session_cb(enum zperf_status status,
 		print_number(sh, rate_in_kbps, KBPS, KBPS_UNIT);
 		shell_fprintf(sh, SHELL_NORMAL, "\n");
 
+		shell_fprintf(sh, SHELL_NORMAL, " packet rate:\t\t%u pps\n",
+			      packet_rate(result->nb_packets_rcvd, result->time_in_us));
+
 		break;
 	}
 
@@ -536,6 +549,9 @@ static void shell_udp_upload_print_stats(const struct shell *sh,
 			shell_fprintf(sh, SHELL_NORMAL, "Rate:\t\t\t");
 			print_number(sh, client_rate_in_kbps, KBPS, KBPS_UNIT);
 			shell_fprintf(sh, SHELL_NORMAL, "\n");
+			shell_fprintf(sh, SHELL_NORMAL, "Packet rate:\t\t%u pps\n",
+				      packet_rate(results->nb_packets_sent,
+						  results->client_time_in_us));
 		} else {
 			shell_fprintf(sh, SHELL_NORMAL,
 					"Statistics:\t\tserver\t(client)\n");
@@ -567,6 +583,12 @@ static void shell_udp_upload_print_stats(const struct shell *sh,
 			shell_fprintf(sh, SHELL_NORMAL, "\t(");
 			print_number(sh, client_rate_in_kbps, KBPS, KBPS_UNIT);
 			shell_fprintf(sh, SHELL_NORMAL, ")\n");
+
+			shell_fprintf(sh, SHELL_NORMAL, "Packet rate:\t\t%u pps\t(%u pps)\n",
+				      packet_rate(results->nb_packets_rcvd,
+						  results->time_in_us),
+				      packet_rate(results->nb_packets_sent,
+						  results->client_time_in_us));
 		}
 
 #ifdef CONFIG_ZPERF_SESSION_PER_THREAD
@@ -1064,6 +1086,28 @@ static int shell_cmd_upload(const struct shell *sh, size_t argc,
 			opt_cnt += 2;
 			break;
 
+#if defined(CONFIG_NET_UDP)
+		case 'b': {
+			int batch = parse_arg(&i, argc, argv);
+
+			if (!is_udp) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "TCP does not support -b option\n");
+				return -ENOEXEC;
+			}
+
+			if (batch < 1 || batch > CONFIG_NET_ZPERF_UDP_BATCH_MAX) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "Parse error: %s\n", argv[i]);
+				return -ENOEXEC;
+			}
+
+			param.options.udp_batch = batch;
+			opt_cnt += 2;
+			break;
+		}
+#endif /* CONFIG_NET_UDP */
+
 		case 'i':
 			seconds = parse_arg(&i, argc, argv);
 
@@ -1317,6 +1361,28 @@ static int shell_cmd_upload2(const struct shell *sh, size_t argc,
 			opt_cnt += 2;
 			break;
 
+#if defined(CONFIG_NET_UDP)
+		case 'b': {
+			int batch = parse_arg(&i, argc, argv);
+
+			if (!is_udp) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "TCP does not support -b option\n");
+				return -ENOEXEC;
+			}
+
+			if (batch < 1 || batch > CONFIG_NET_ZPERF_UDP_BATCH_MAX) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "Parse error: %s\n", argv[i]);
+				return -ENOEXEC;
+			}
+
+			param.options.udp_batch = batch;
+			opt_cnt += 2;
+			break;
+		}
+#endif /* CONFIG_NET_UDP */
+
 		case 'i':
 			seconds = parse_arg(&i, argc, argv);
 
@@ -2009,6 +2075,7 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_udp,
 		  "-p: Specify custom packet priority\n"
 #endif /* CONFIG_NET_CONTEXT_PRIORITY */
 		  "-I: Specify host interface name\n"
+		  "-b count: Send count datagrams per zsock_sendmmsg() call\n"
 		  "Example: udp upload 192.0.2.2 1111 1 1K 1M\n"
 		  "Example: udp upload 2001:db8::2\n",
 		  cmd_udp_upload),
@@ -2034,6 +2101,7 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_udp,
 		  "-p: Specify custom packet priority\n"
 #endif /* CONFIG_NET_CONTEXT_PRIORITY */
 		  "-I: Specify host interface name\n"
+		  "-b count: Send count datagrams per zsock_sendmmsg() call\n"
 		  "Example: udp upload2 v4 1 1K 1M\n"
 		  "Example: udp upload2 v6\n"
 #if defined(CONFIG_NET_IPV6) && defined(MY_IP6ADDR_SET)
@@ -36,6 +36,7 @@ static struct net_sockaddr_in *in4_addr_my;
 #define SOCK_ID_MAX 2
 
 #define UDP_RECEIVER_BUF_SIZE 1500
+#define UDP_RECEIVER_BATCH CONFIG_NET_ZPERF_UDP_RX_BATCH
 #define POLL_TIMEOUT_MS 100
 
 static zperf_callback udp_session_cb;
@@ -312,14 +313,34 @@ static void udp_receiver_cleanup(void)
 	zperf_session_reset(SESSION_UDP);
 }
 
+static uint8_t udp_rx_bufs[UDP_RECEIVER_BATCH][UDP_RECEIVER_BUF_SIZE];
+static struct net_sockaddr udp_rx_addrs[UDP_RECEIVER_BATCH];
+static struct net_iovec udp_rx_iov[UDP_RECEIVER_BATCH];
+static struct net_mmsghdr udp_rx_msgs[UDP_RECEIVER_BATCH];
+
+/* Read the datagrams already queued on the socket, up to a batch of them */
+static int udp_recv_batch(int sock)
+{
+	for (int i = 0; i < UDP_RECEIVER_BATCH; i++) {
+		udp_rx_iov[i].iov_base = udp_rx_bufs[i];
+		udp_rx_iov[i].iov_len = sizeof(udp_rx_bufs[i]);
+
+		(void)memset(&udp_rx_msgs[i], 0, sizeof(udp_rx_msgs[i]));
+		udp_rx_msgs[i].msg_hdr.msg_name = &udp_rx_addrs[i];
+		udp_rx_msgs[i].msg_hdr.msg_namelen = sizeof(udp_rx_addrs[i]);
+		udp_rx_msgs[i].msg_hdr.msg_iov = &udp_rx_iov[i];
+		udp_rx_msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	return zsock_recvmmsg(sock, udp_rx_msgs, UDP_RECEIVER_BATCH,
+			      ZSOCK_MSG_DONTWAIT, SYS_FOREVER_MS);
+}
+
 static int udp_recv_data(struct net_socket_service_event *pev)
 {
-	static uint8_t buf[UDP_RECEIVER_BUF_SIZE];
 	int ret = 1;
 	int family, sock_error;
-	struct net_sockaddr addr;
 	net_socklen_t optlen = sizeof(int);
-	net_socklen_t addrlen = sizeof(addr);
 
 	if (!udp_server_running) {
 		return -ENOENT;
@@ -342,8 +363,7 @@ static int udp_recv_data(struct net_socket_service_event *pev)
 	}
 
 	while (ret > 0) {
-		ret = zsock_recvfrom(pev->event.fd, buf, sizeof(buf), ZSOCK_MSG_DONTWAIT,
-				     &addr, &addrlen);
+		ret = udp_recv_batch(pev->event.fd);
 		if ((ret < 0) && (errno == EAGAIN)) {
 			ret = 0;
 			break;
@@ -358,7 +378,10 @@ static int udp_recv_data(struct net_socket_service_event *pev)
 			goto error;
 		}
 
-		udp_received(pev->event.fd, &addr, buf, ret);
+		for (int i = 0; i < ret; i++) {
+			udp_received(pev->event.fd, &udp_rx_addrs[i], udp_rx_bufs[i],
+				     udp_rx_msgs[i].msg_len);
+		}
 	}
 	return ret;
 
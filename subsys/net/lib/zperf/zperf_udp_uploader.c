@@ -19,6 +19,16 @@ static uint8_t sample_packet[sizeof(struct zperf_udp_datagram) +
 			     sizeof(struct zperf_client_hdr_v1) +
 			     PACKET_SIZE_MAX];
 
+#define UDP_HDR_SIZE (sizeof(struct zperf_udp_datagram) + \
+		      sizeof(struct zperf_client_hdr_v1))
+
+/* With batching, each datagram has its own header but they all share the
+ * payload of sample_packet.
+ */
+static uint8_t batch_hdrs[CONFIG_NET_ZPERF_UDP_BATCH_MAX][UDP_HDR_SIZE];
+static struct net_iovec batch_iov[CONFIG_NET_ZPERF_UDP_BATCH_MAX][2];
+static struct net_mmsghdr batch_msgs[CONFIG_NET_ZPERF_UDP_BATCH_MAX];
+
 #if !defined(CONFIG_ZPERF_SESSION_PER_THREAD)
 static struct zperf_async_upload_context udp_async_upload_ctx;
 #endif /* CONFIG_ZPERF_SESSION_PER_THREAD */
@@ -155,6 +165,99 @@ static inline int zperf_upload_fin(int sock,
 	return 0;
 }
 
+static void udp_fill_header(uint8_t *buf, uint32_t id, uint64_t usecs64,
+			    int port, uint32_t rate_in_kbps,
+			    uint32_t packet_size)
+{
+	struct zperf_udp_datagram *datagram;
+	struct zperf_client_hdr_v1 *hdr;
+
+	datagram = (struct zperf_udp_datagram *)buf;
+
+	datagram->id = net_htonl(id);
+	datagram->tv_sec = net_htonl(usecs64 / USEC_PER_SEC);
+	datagram->tv_usec = net_htonl(usecs64 % USEC_PER_SEC);
+
+	hdr = (struct zperf_client_hdr_v1 *)(buf + sizeof(*datagram));
+	hdr->flags = 0;
+	hdr->num_of_threads = net_htonl(1);
+	hdr->port = net_htonl(port);
+	hdr->buffer_len = sizeof(sample_packet) -
+		sizeof(*datagram) - sizeof(*hdr);
+	hdr->bandwidth = net_htonl(rate_in_kbps);
+	hdr->num_of_bytes = net_htonl(packet_size);
+}
+
+static int udp_send_one(int sock, const struct zperf_upload_params *param,
+			uint32_t id, uint64_t usecs64, int port,
+			uint32_t packet_size, uint64_t *data_offset)
+{
+	int ret;
+
+	/* Fill the packet header */
+	udp_fill_header(sample_packet, id, usecs64, port, param->rate_kbps,
+			packet_size);
+
+	/* Load custom data payload if requested */
+	if (param->data_loader != NULL) {
+		ret = param->data_loader(param->data_loader_ctx, *data_offset,
+					 sample_packet + UDP_HDR_SIZE,
+					 packet_size - UDP_HDR_SIZE);
+		if (ret < 0) {
+			NET_ERR("Failed to load data for offset %llu", *data_offset);
+			return ret;
+		}
+	}
+	*data_offset += packet_size - UDP_HDR_SIZE;
+
+	/* Send the packet */
+	ret = zsock_send(sock, sample_packet, packet_size, 0);
+	if (ret < 0) {
+		NET_ERR("Failed to send the packet (%d)", errno);
+		return -errno;
+	}
+
+	return 1;
+}
+
+/* Send count datagrams, starting with the given id, using as few
+ * zsock_sendmmsg() calls as possible.
+ */
+static int udp_send_batch(int sock, int count, uint32_t id, uint64_t usecs64,
+			  int port, uint32_t rate_in_kbps,
+			  uint32_t packet_size)
+{
+	size_t hdr_len = MIN(packet_size, UDP_HDR_SIZE);
+	int sent = 0;
+	int ret;
+
+	for (int i = 0; i < count; i++) {
+		udp_fill_header(batch_hdrs[i], id + i, usecs64, port,
+				rate_in_kbps, packet_size);
+
+		batch_iov[i][0].iov_base = batch_hdrs[i];
+		batch_iov[i][0].iov_len = hdr_len;
+		batch_iov[i][1].iov_base = sample_packet + UDP_HDR_SIZE;
+		batch_iov[i][1].iov_len = packet_size - hdr_len;
+
+		(void)memset(&batch_msgs[i], 0, sizeof(batch_msgs[i]));
+		batch_msgs[i].msg_hdr.msg_iov = batch_iov[i];
+		batch_msgs[i].msg_hdr.msg_iovlen = ARRAY_SIZE(batch_iov[i]);
+	}
+
+	while (sent < count) {
+		ret = zsock_sendmmsg(sock, &batch_msgs[sent], count - sent, 0);
+		if (ret < 0) {
+			NET_ERR("Failed to send the packets (%d)", errno);
+			return -errno;
+		}
+
+		sent += ret;
+	}
+
+	return sent;
+}
+
 #define USECS_PER_TICK (Z_HZ_us / Z_HZ_ticks)
 #if (USECS_PER_TICK >= 1000)
 #define ZPERF_UDP_UPLOAD_CLOCK_COMPENSATE
@@ -230,14 +333,14 @@ static int udp_upload(int sock, int port,
 		      const struct zperf_upload_params *param,
 		      struct zperf_results *results)
 {
-	size_t header_size =
-		sizeof(struct zperf_udp_datagram) + sizeof(struct zperf_client_hdr_v1);
+	size_t header_size = UDP_HDR_SIZE;
 	uint32_t duration_in_ms = param->duration_ms;
 	uint32_t packet_size = param->packet_size;
 	uint32_t rate_in_kbps = param->rate_kbps;
-	uint32_t packet_duration_us = zperf_packet_duration(packet_size, rate_in_kbps);
-	uint32_t packet_duration = k_us_to_ticks_ceil32(packet_duration_us);
-	uint32_t delay = packet_duration;
+	int batch = CLAMP(param->options.udp_batch, 1, CONFIG_NET_ZPERF_UDP_BATCH_MAX);
+	uint32_t packet_duration_us;
+	uint32_t packet_duration;
+	uint32_t delay;
 	uint64_t data_offset = 0U;
 	uint32_t nb_packets = 0U;
 	uint64_t usecs64;
@@ -259,6 +362,16 @@ static int udp_upload(int sock, int port,
 		packet_size = header_size;
 	}
 
+	/* Custom data is loaded in sample_packet for each datagram */
+	if (param->data_loader != NULL) {
+		batch = 1;
+	}
+
+	/* Each iteration of the loop sends a whole batch */
+	packet_duration_us = zperf_packet_duration(packet_size * batch, rate_in_kbps);
+	packet_duration = k_us_to_ticks_ceil32(packet_duration_us);
+	delay = packet_duration;
+
 	/* Start the loop */
 	start_time = k_uptime_ticks();
 	last_loop_time = start_time;
@@ -279,9 +392,6 @@ static int udp_upload(int sock, int port,
 #endif
 
 	do {
-		struct zperf_udp_datagram *datagram;
-		struct zperf_client_hdr_v1 *hdr;
-		uint32_t secs, usecs;
 		int64_t loop_time;
 		int32_t adjust;
 
@@ -314,46 +424,21 @@ static int udp_upload(int sock, int port,
 		last_loop_time = loop_time;
 
 		usecs64 = param->unix_offset_us + k_ticks_to_us_floor64(loop_time - start_time);
-		secs = usecs64 / USEC_PER_SEC;
-		usecs = usecs64 % USEC_PER_SEC;
-
-		/* Fill the packet header */
-		datagram = (struct zperf_udp_datagram *)sample_packet;
 
-		datagram->id = net_htonl(nb_packets);
-		datagram->tv_sec = net_htonl(secs);
-		datagram->tv_usec = net_htonl(usecs);
-
-		hdr = (struct zperf_client_hdr_v1 *)(sample_packet +
-						     sizeof(*datagram));
-		hdr->flags = 0;
-		hdr->num_of_threads = net_htonl(1);
-		hdr->port = net_htonl(port);
-		hdr->buffer_len = sizeof(sample_packet) -
-			sizeof(*datagram) - sizeof(*hdr);
-		hdr->bandwidth = net_htonl(rate_in_kbps);
-		hdr->num_of_bytes = net_htonl(packet_size);
-
-		/* Load custom data payload if requested */
-		if (param->data_loader != NULL) {
-			ret = param->data_loader(param->data_loader_ctx, data_offset,
-				sample_packet + header_size, packet_size - header_size);
-			if (ret < 0) {
-				NET_ERR("Failed to load data for offset %llu", data_offset);
-				return ret;
-			}
+		if (batch > 1) {
+			ret = udp_send_batch(sock, batch, nb_packets, usecs64, port,
+					     rate_in_kbps, packet_size);
+		} else {
+			ret = udp_send_one(sock, param, nb_packets, usecs64, port,
+					   packet_size, &data_offset);
 		}
-		data_offset += packet_size - header_size;
 
-		/* Send the packet */
-		ret = zsock_send(sock, sample_packet, packet_size, 0);
 		if (ret < 0) {
-			NET_ERR("Failed to send the packet (%d)", errno);
-			return -errno;
-		} else {
-			nb_packets++;
+			return ret;
 		}
 
+		nb_packets += ret;
+
 		if (IS_ENABLED(CONFIG_NET_ZPERF_LOG_LEVEL_DBG)) {
 			if (print_time >= loop_time) {
 				NET_DBG("nb_packets=%u\tdelay=%u\tadjust=%d",
@@ -0,0 +1,261 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a benchmark of the HPACK header compression of the HTTP
+ * server. The same request and response header blocks are encoded and decoded
+ * repeatedly, without dynamic table and with one, and the size of the blocks
+ * and the time taken to encode or decode them are measured.
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/net/http/hpack.h>
+
+#define BLOCK_MAX_LEN 512
+
+struct header_field {
+	const char *name;
+	const char *value;
+};
+
+static const struct header_field request_fields[] = {
+	{ ":method", "GET" },
+	{ ":scheme", "https" },
+	{ ":path", "/api/v1/sensors/temperature" },
+	{ ":authority", "device.local:8443" },
+	{ "user-agent", "Mozilla/5.0 (X11; Linux x86_64; rv:128.0) Gecko/20100101 Firefox/128.0" },
+	{ "accept", "application/json, text/plain, */*" },
+	{ "accept-language", "en-US,en;q=0.5" },
+	{ "accept-encoding", "gzip, deflate, br" },
+	{ "cookie", "session=3f2a9c1e7b5d4a6f8e0c2b1d9a7f5e3c" },
+};
+
+static const struct header_field response_fields[] = {
+	{ ":status", "200" },
+	{ "content-type", "application/json" },
+	{ "content-encoding", "gzip" },
+	{ "cache-control", "no-cache" },
+	{ "access-control-allow-origin", "*" },
+	{ "server", "Zephyr" },
+};
+
+static struct http_hpack_table encoder_table;
+static struct http_hpack_table decoder_table;
+static struct http_hpack_header_buf header;
+static uint8_t first_block[BLOCK_MAX_LEN];
+static uint8_t next_block[BLOCK_MAX_LEN];
+static uint8_t huffman_buf[BLOCK_MAX_LEN];
+static unsigned int errors;
+
+static void report(const char *name, const char *table, uint64_t ns)
+{
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: hpack.%s.%s - %s %s : %llu ns :\n", name, table, name, table, ns);
+#else
+	printk("%-24s %-10s : %6llu ns\n", name, table, ns);
+#endif
+}
+
+static size_t encode_block(struct http_hpack_table *table, const struct header_field *fields,
+			   size_t num_fields, uint8_t *buf)
+{
+	size_t len = 0;
+	int ret;
+
+	for (size_t i = 0; i < num_fields; i++) {
+		header.name = fields[i].name;
+		header.name_len = strlen(fields[i].name);
+		header.value = fields[i].value;
+		header.value_len = strlen(fields[i].value);
+
+		ret = http_hpack_table_encode_header(table, buf + len, BLOCK_MAX_LEN - len,
+						     &header);
+		if (ret < 0) {
+			errors++;
+			return len;
+		}
+
+		len += ret;
+	}
+
+	return len;
+}
+
+static void decode_block(struct http_hpack_table *table, const uint8_t *buf, size_t len,
+			 size_t num_fields)
+{
+	size_t decoded = 0;
+	int ret;
+
+	while (len > 0) {
+		ret = http_hpack_table_decode_header(table, buf, len, &header);
+		if (ret <= 0) {
+			errors++;
+			return;
+		}
+
+		buf += ret;
+		len -= ret;
+		decoded++;
+	}
+
+	if (decoded != num_fields) {
+		errors++;
+	}
+}
+
+/* The first block fills the table, the next ones are the same as the second. */
+static void prepare_blocks(struct http_hpack_table *table, const struct header_field *fields,
+			   size_t num_fields, size_t *first_len, size_t *next_len)
+{
+	if (table != NULL) {
+		http_hpack_table_init(table, HTTP_HPACK_DEFAULT_TABLE_SIZE);
+	}
+
+	*first_len = encode_block(table, fields, num_fields, first_block);
+	*next_len = encode_block(table, fields, num_fields, next_block);
+}
+
+static uint64_t measure_encode(struct http_hpack_table *table, const struct header_field *fields,
+			       size_t num_fields)
+{
+	size_t first_len, next_len;
+	uint32_t start;
+	uint32_t cycles;
+
+	prepare_blocks(table, fields, num_fields, &first_len, &next_len);
+
+	start = k_cycle_get_32();
+
+	for (int r = 0; r < CONFIG_BENCHMARK_ROUNDS; r++) {
+		if (encode_block(table, fields, num_fields, next_block) != next_len) {
+			errors++;
+		}
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	return k_cyc_to_ns_floor64(cycles) / CONFIG_BENCHMARK_ROUNDS;
+}
+
+static uint64_t measure_decode(struct http_hpack_table *table, const struct header_field *fields,
+			       size_t num_fields)
+{
+	size_t first_len, next_len;
+	uint32_t start;
+	uint32_t cycles;
+
+	prepare_blocks(table == NULL ? NULL : &encoder_table, fields, num_fields, &first_len,
+		       &next_len);
+
+	if (table != NULL) {
+		http_hpack_table_init(table, HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE);
+		decode_block(table, first_block, first_len, num_fields);
+	}
+
+	start = k_cycle_get_32();
+
+	for (int r = 0; r < CONFIG_BENCHMARK_ROUNDS; r++) {
+		decode_block(table, next_block, next_len, num_fields);
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	return k_cyc_to_ns_floor64(cycles) / CONFIG_BENCHMARK_ROUNDS;
+}
+
+static void print_sizes(const char *name, const struct header_field *fields, size_t num_fields)
+{
+	size_t first_len, next_len;
+	size_t raw_len = 0;
+
+	for (size_t i = 0; i < num_fields; i++) {
+		raw_len += strlen(fields[i].name) + strlen(fields[i].value);
+	}
+
+	prepare_blocks(NULL, fields, num_fields, &first_len, &next_len);
+	printk("%s: %zu bytes of header fields, %zu bytes per block without table", name,
+	       raw_len, next_len);
+
+	prepare_blocks(&encoder_table, fields, num_fields, &first_len, &next_len);
+	printk(", %zu bytes for the first block and %zu for the next ones with table\n",
+	       first_len, next_len);
+}
+
+static void measure_huffman(void)
+{
+	const char *str = request_fields[4].value;
+	size_t str_len = strlen(str);
+	uint32_t start;
+	uint32_t cycles;
+	int len;
+
+	len = http_hpack_huffman_encode(str, str_len, huffman_buf, sizeof(huffman_buf));
+	if (len <= 0) {
+		errors++;
+		return;
+	}
+
+	start = k_cycle_get_32();
+
+	for (int r = 0; r < CONFIG_BENCHMARK_ROUNDS; r++) {
+		if (http_hpack_huffman_encode(str, str_len, huffman_buf,
+					      sizeof(huffman_buf)) != len) {
+			errors++;
+		}
+	}
+
+	cycles = k_cycle_get_32() - start;
+	report("huffman_encode", "user_agent",
+	       k_cyc_to_ns_floor64(cycles) / CONFIG_BENCHMARK_ROUNDS);
+
+	start = k_cycle_get_32();
+
+	for (int r = 0; r < CONFIG_BENCHMARK_ROUNDS; r++) {
+		if (http_hpack_huffman_decode(huffman_buf, len, header.buf,
+					      sizeof(header.buf)) != str_len) {
+			errors++;
+		}
+	}
+
+	cycles = k_cycle_get_32() - start;
+	report("huffman_decode", "user_agent",
+	       k_cyc_to_ns_floor64(cycles) / CONFIG_BENCHMARK_ROUNDS);
+}
+
+int main(void)
+{
+	int ret = 0;
+
+	printk("HPACK coding of repeated header blocks, %d rounds\n", CONFIG_BENCHMARK_ROUNDS);
+
+	print_sizes("request", request_fields, ARRAY_SIZE(request_fields));
+	print_sizes("response", response_fields, ARRAY_SIZE(response_fields));
+
+	report("request_decode", "no_table",
+	       measure_decode(NULL, request_fields, ARRAY_SIZE(request_fields)));
+	report("request_decode", "table",
+	       measure_decode(&decoder_table, request_fields, ARRAY_SIZE(request_fields)));
+	report("response_encode", "no_table",
+	       measure_encode(NULL, response_fields, ARRAY_SIZE(response_fields)));
+	report("response_encode", "table",
+	       measure_encode(&encoder_table, response_fields, ARRAY_SIZE(response_fields)));
+
+	measure_huffman();
+
+	if (errors != 0U) {
+		printk("%u header blocks were not coded correctly\n", errors);
+		ret = -EINVAL;
+	}
+
+	TC_END_REPORT((ret != 0) ? TC_FAIL : TC_PASS);
+
+	return 0;
+}
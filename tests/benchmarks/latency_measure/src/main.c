@@ -67,6 +67,9 @@ extern int stack_ops(uint32_t num_iterations, uint32_t options);
 extern int stack_blocking_ops(uint32_t num_iterations, uint32_t start_options,
 			       uint32_t alt_options);
 extern void heap_malloc_free(void);
+#if (CONFIG_MP_MAX_NUM_CPUS > 1)
+extern int mutex_contention(uint32_t num_iterations);
+#endif
 
 #if (CONFIG_MP_MAX_NUM_CPUS > 1)
 static void busy_thread_entry(void *arg1, void *arg2, void *arg3)
@@ -201,6 +204,10 @@ static void test_thread(void *arg1, void *arg2, void *arg3)
 	mutex_lock_unlock(CONFIG_BENCHMARK_NUM_ITERATIONS, K_USER);
 #endif
 
+#if (CONFIG_MP_MAX_NUM_CPUS > 1)
+	mutex_contention(CONFIG_BENCHMARK_NUM_ITERATIONS);
+#endif
+
 	heap_malloc_free();
 
 	TC_END_REPORT(error_count);
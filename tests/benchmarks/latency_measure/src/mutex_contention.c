@@ -0,0 +1,135 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file measure mutex handoff latency under contention
+ *
+ * This file contains the test that measures the time it takes a thread
+ * waiting for a mutex to get it once its owner, running on another CPU,
+ * unlocks it.  The owner only holds the mutex for a few microseconds, which
+ * is the case CONFIG_MUTEX_ADAPTIVE_SPIN is meant for.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include "utils.h"
+#include "timing_sc.h"
+
+#if (CONFIG_MP_MAX_NUM_CPUS > 1)
+
+/* Time the owner holds the mutex while the waiter contends for it */
+#define HOLD_TIME_US 5
+
+extern struct k_thread busy_thread[];
+
+static K_MUTEX_DEFINE(contended_mutex);
+
+static atomic_t held;
+static atomic_t handed_over;
+static timing_t release_stamp;
+
+static void owner_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t num_iterations = (uint32_t)(uintptr_t)p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint32_t i = 0; i < num_iterations; i++) {
+		k_mutex_lock(&contended_mutex, K_FOREVER);
+		atomic_set(&held, 1);
+
+		k_busy_wait(HOLD_TIME_US);
+
+		release_stamp = timing_timestamp_get();
+		k_mutex_unlock(&contended_mutex);
+
+		/* Wait for the waiter to get the mutex before taking it again */
+		while (!atomic_cas(&handed_over, 1, 0)) {
+		}
+	}
+}
+
+static void waiter_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t num_iterations = (uint32_t)(uintptr_t)p1;
+	timing_t acquired;
+	uint64_t cycles = 0;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint32_t i = 0; i < num_iterations; i++) {
+		/* Wait for the owner to hold the mutex */
+		while (!atomic_cas(&held, 1, 0)) {
+		}
+
+		k_mutex_lock(&contended_mutex, K_FOREVER);
+		acquired = timing_timestamp_get();
+
+		cycles += timing_cycles_get(&release_stamp, &acquired);
+
+		k_mutex_unlock(&contended_mutex);
+		atomic_set(&handed_over, 1);
+	}
+
+	timestamp.cycles = cycles;
+}
+
+/**
+ *
+ * @brief Test for the mutex handoff time between CPUs
+ *
+ * The routine runs two threads on two CPUs. One repeatedly holds a mutex
+ * for a short time while the other one waits to lock it, and measures the
+ * time from the unlock to the lock by the waiter.
+ *
+ * @return 0 on success
+ */
+int mutex_contention(uint32_t num_iterations)
+{
+	char description[120];
+	int  priority;
+
+	timing_start();
+
+	priority = k_thread_priority_get(k_current_get());
+
+	/* Free a second CPU from its busy thread */
+	k_thread_suspend(&busy_thread[0]);
+
+	atomic_clear(&held);
+	atomic_clear(&handed_over);
+
+	k_thread_create(&start_thread, start_stack,
+			K_THREAD_STACK_SIZEOF(start_stack),
+			waiter_entry,
+			(void *)(uintptr_t)num_iterations, NULL, NULL,
+			priority - 1, 0, K_NO_WAIT);
+
+	k_thread_create(&alt_thread, alt_stack,
+			K_THREAD_STACK_SIZEOF(alt_stack),
+			owner_entry,
+			(void *)(uintptr_t)num_iterations, NULL, NULL,
+			priority - 1, 0, K_NO_WAIT);
+
+	k_thread_join(&alt_thread, K_FOREVER);
+	k_thread_join(&start_thread, K_FOREVER);
+
+	k_thread_resume(&busy_thread[0]);
+
+	snprintf(description, sizeof(description),
+		 "%-40s - Lock a mutex unlocked on another CPU",
+		 "mutex.lock.contended.handoff.kernel");
+	PRINT_STATS_AVG(description, (uint32_t)timestamp.cycles, num_iterations,
+			false,
+			IS_ENABLED(CONFIG_MUTEX_ADAPTIVE_SPIN) ? "adaptive spin" : "");
+
+	timing_stop();
+	return 0;
+}
+
+#endif /* CONFIG_MP_MAX_NUM_CPUS > 1 */
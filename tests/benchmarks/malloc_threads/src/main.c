@@ -0,0 +1,154 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a benchmark of malloc() and free() done concurrently
+ * by several threads. Each thread keeps a small working set of blocks,
+ * freeing one of them and allocating a replacement of a pseudo-random size
+ * on every iteration.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <stdlib.h>
+
+#define STACK_SIZE  (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define WORKING_SET 16
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, CONFIG_BENCHMARK_NUM_THREADS, STACK_SIZE);
+static struct k_thread threads[CONFIG_BENCHMARK_NUM_THREADS];
+
+static K_SEM_DEFINE(start_sem, 0, CONFIG_BENCHMARK_NUM_THREADS);
+static K_SEM_DEFINE(done_sem, 0, CONFIG_BENCHMARK_NUM_THREADS);
+
+static uint64_t thread_cycles[CONFIG_BENCHMARK_NUM_THREADS];
+static unsigned int thread_failures[CONFIG_BENCHMARK_NUM_THREADS];
+
+static uint32_t next_random(uint32_t *state)
+{
+	*state ^= *state << 13;
+	*state ^= *state >> 17;
+	*state ^= *state << 5;
+
+	return *state;
+}
+
+static size_t random_size(uint32_t *state)
+{
+	return 1 + (next_random(state) % CONFIG_BENCHMARK_MAX_SIZE);
+}
+
+static void alloc_thread(void *p1, void *p2, void *p3)
+{
+	unsigned int id = POINTER_TO_UINT(p1);
+	uint32_t state = 0x2545f491 + id;
+	void *blocks[WORKING_SET];
+	timing_t start;
+	timing_t finish;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (unsigned int i = 0; i < WORKING_SET; i++) {
+		blocks[i] = malloc(random_size(&state));
+	}
+
+	k_sem_take(&start_sem, K_FOREVER);
+
+	start = timing_counter_get();
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		unsigned int slot = next_random(&state) % WORKING_SET;
+
+		free(blocks[slot]);
+		blocks[slot] = malloc(random_size(&state));
+		if (blocks[slot] == NULL) {
+			thread_failures[id]++;
+		}
+	}
+	finish = timing_counter_get();
+
+	thread_cycles[id] = timing_cycles_get(&start, &finish);
+
+	for (unsigned int i = 0; i < WORKING_SET; i++) {
+		free(blocks[i]);
+	}
+
+	k_sem_give(&done_sem);
+}
+
+static void report(const char *metric, const char *description, uint64_t cycles)
+{
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s - %s : %7llu cycles , %7u ns :\n", metric, description,
+	       cycles, (uint32_t)timing_cycles_to_ns(cycles));
+#else
+	printk("%-60s : %7llu cycles (%7u nsec)\n", description,
+	       cycles, (uint32_t)timing_cycles_to_ns(cycles));
+#endif
+}
+
+int main(void)
+{
+	uint64_t total = 0;
+	uint64_t longest = 0;
+	unsigned int failures = 0;
+	timing_t start;
+	timing_t finish;
+
+	timing_init();
+
+	printk("Time Measurements for malloc with %u threads on %u CPUs%s\n",
+	       CONFIG_BENCHMARK_NUM_THREADS, arch_num_cpus(),
+	       IS_ENABLED(CONFIG_COMMON_LIBC_MALLOC_CACHE) ? " (cached)" : "");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_THREADS; i++) {
+		k_thread_create(&threads[i], stacks[i], K_THREAD_STACK_SIZEOF(stacks[i]),
+				alloc_thread, UINT_TO_POINTER(i), NULL, NULL,
+				K_PRIO_PREEMPT(10), 0, K_NO_WAIT);
+	}
+
+	/* Let all threads allocate their working set and wait */
+	k_sleep(K_MSEC(10));
+
+	start = timing_counter_get();
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_THREADS; i++) {
+		k_sem_give(&start_sem);
+	}
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_THREADS; i++) {
+		k_sem_take(&done_sem, K_FOREVER);
+	}
+	finish = timing_counter_get();
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_THREADS; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+		total += thread_cycles[i];
+		longest = MAX(longest, thread_cycles[i]);
+		failures += thread_failures[i];
+	}
+
+	timing_stop();
+
+	report("malloc_threads.free_malloc.avg", "Average free() and malloc() pair",
+	       total / ((uint64_t)CONFIG_BENCHMARK_NUM_THREADS *
+			CONFIG_BENCHMARK_NUM_ITERATIONS));
+	report("malloc_threads.thread.max", "Longest thread run",
+	       longest);
+	report("malloc_threads.total", "All threads run",
+	       timing_cycles_get(&start, &finish));
+
+	if (failures != 0) {
+		printk("%u allocations failed\n", failures);
+	}
+
+	TC_END_REPORT(failures == 0 ? TC_PASS : TC_FAIL);
+
+	return 0;
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a benchmark of the memory slab alloc and free
+ * operations done concurrently by one thread per CPU on a shared slab.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define BLOCK_SIZE 64
+#define HELD_BLOCKS 4
+
+BUILD_ASSERT(CONFIG_BENCHMARK_NUM_BLOCKS >= HELD_BLOCKS * CONFIG_MP_MAX_NUM_CPUS);
+
+K_MEM_SLAB_DEFINE_STATIC(slab, BLOCK_SIZE, CONFIG_BENCHMARK_NUM_BLOCKS, 8);
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, CONFIG_MP_MAX_NUM_CPUS, STACK_SIZE);
+static struct k_thread threads[CONFIG_MP_MAX_NUM_CPUS];
+
+static K_SEM_DEFINE(start_sem, 0, CONFIG_MP_MAX_NUM_CPUS);
+
+static uint64_t thread_cycles[CONFIG_MP_MAX_NUM_CPUS];
+static unsigned int thread_failures[CONFIG_MP_MAX_NUM_CPUS];
+
+static void slab_thread(void *p1, void *p2, void *p3)
+{
+	unsigned int id = POINTER_TO_UINT(p1);
+	void *blocks[HELD_BLOCKS];
+	timing_t start;
+	timing_t finish;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_sem_take(&start_sem, K_FOREVER);
+
+	start = timing_counter_get();
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i += HELD_BLOCKS) {
+		for (unsigned int j = 0; j < HELD_BLOCKS; j++) {
+			if (k_mem_slab_alloc(&slab, &blocks[j], K_NO_WAIT) != 0) {
+				thread_failures[id]++;
+				blocks[j] = NULL;
+			}
+		}
+		for (unsigned int j = 0; j < HELD_BLOCKS; j++) {
+			if (blocks[j] != NULL) {
+				k_mem_slab_free(&slab, blocks[j]);
+			}
+		}
+	}
+	finish = timing_counter_get();
+
+	thread_cycles[id] = timing_cycles_get(&start, &finish);
+}
+
+static void report(const char *metric, const char *description, uint64_t cycles)
+{
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s - %s : %7llu cycles , %7u ns :\n", metric, description,
+	       cycles, (uint32_t)timing_cycles_to_ns(cycles));
+#else
+	printk("%-40s : %7llu cycles (%7u nsec)\n", description,
+	       cycles, (uint32_t)timing_cycles_to_ns(cycles));
+#endif
+}
+
+int main(void)
+{
+	unsigned int num_cpus = arch_num_cpus();
+	uint64_t total = 0;
+	uint64_t elapsed;
+	uint64_t ns;
+	unsigned int failures = 0;
+	timing_t start;
+	timing_t finish;
+
+	timing_init();
+
+	printk("Time Measurements for memory slab on %u CPUs%s\n", num_cpus,
+	       IS_ENABLED(CONFIG_MEM_SLAB_PER_CPU_CACHE) ? " (per-CPU caches)" : "");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		k_thread_create(&threads[i], stacks[i], K_THREAD_STACK_SIZEOF(stacks[i]),
+				slab_thread, UINT_TO_POINTER(i), NULL, NULL,
+				K_PRIO_PREEMPT(10), 0, K_NO_WAIT);
+	}
+
+	start = timing_counter_get();
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		k_sem_give(&start_sem);
+	}
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+		total += thread_cycles[i];
+		failures += thread_failures[i];
+	}
+	finish = timing_counter_get();
+
+	timing_stop();
+
+	elapsed = timing_cycles_get(&start, &finish);
+	ns = timing_cycles_to_ns(elapsed);
+
+	report("mem_slab.alloc_free.avg", "Average alloc/free pair",
+	       total / ((uint64_t)num_cpus * CONFIG_BENCHMARK_NUM_ITERATIONS));
+	report("mem_slab.total", "All threads run", elapsed);
+
+	printk("%u CPUs: %llu alloc/free pairs per second\n", num_cpus,
+	       (ns != 0) ? ((uint64_t)num_cpus * CONFIG_BENCHMARK_NUM_ITERATIONS *
+			    NSEC_PER_SEC) / ns : 0);
+
+	if (failures != 0) {
+		printk("%u allocations failed\n", failures);
+	}
+
+	TC_END_REPORT(failures == 0 ? TC_PASS : TC_FAIL);
+
+	return 0;
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a benchmark of calc_chksum(), which sums the data
+ * covered by the Internet checksum, against a plain loop adding the data
+ * 16 bits at a time.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/net/net_ip.h>
+
+#include "net_private.h"
+
+#define MAX_LEN 9000
+
+static const size_t lengths[] = { 20, 64, 576, 1500, MAX_LEN };
+
+/* One more byte to sum the data at an odd address */
+static uint8_t data[MAX_LEN + 1] __aligned(8);
+
+static uint16_t calc_chksum_ref(uint16_t sum, const uint8_t *buf, size_t len)
+{
+	const uint8_t *end = buf + len - 1;
+	uint16_t tmp;
+
+	while (buf < end) {
+		tmp = (buf[0] << 8) + buf[1];
+		sum += tmp;
+		if (sum < tmp) {
+			sum++;
+		}
+
+		buf += 2;
+	}
+
+	if (buf == end) {
+		tmp = buf[0] << 8;
+		sum += tmp;
+		if (sum < tmp) {
+			sum++;
+		}
+	}
+
+	return sum;
+}
+
+/* Return the average time in nanoseconds of a checksum, and the checksum */
+static uint64_t run(bool ref, const uint8_t *buf, size_t len, uint16_t *sum)
+{
+	uint32_t start, cycles;
+
+	start = k_cycle_get_32();
+
+	for (unsigned int r = 0; r < CONFIG_BENCHMARK_ROUNDS; r++) {
+		if (ref) {
+			*sum = calc_chksum_ref(0U, buf, len);
+		} else {
+			*sum = calc_chksum(0U, buf, len);
+		}
+
+		/* Keep the compiler from hoisting the call out of the loop */
+		compiler_barrier();
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	return k_cyc_to_ns_floor64(cycles) / CONFIG_BENCHMARK_ROUNDS;
+}
+
+static void report(const char *mode, size_t len, bool odd, uint64_t ns)
+{
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: net.chksum.%s.%zu%s - Sum of %zu bytes%s : %llu ns :\n",
+	       mode, len, odd ? ".odd" : "", len, odd ? " at an odd address" : "", ns);
+#else
+	printk("%-6s %5zu bytes%s : %8llu ns\n", mode, len, odd ? " (odd)" : "      ", ns);
+#endif
+}
+
+int main(void)
+{
+	unsigned int mismatches = 0U;
+	uint16_t sum_ref;
+	uint16_t sum;
+
+	for (size_t i = 0; i < sizeof(data); i++) {
+		data[i] = (uint8_t)(i * 7 + 3);
+	}
+
+	printk("calc_chksum() with %d rounds\n", CONFIG_BENCHMARK_ROUNDS);
+
+	for (size_t i = 0; i < ARRAY_SIZE(lengths); i++) {
+		for (int odd = 0; odd <= 1; odd++) {
+			const uint8_t *buf = data + odd;
+
+			report("ref", lengths[i], odd, run(true, buf, lengths[i], &sum_ref));
+			report("chksum", lengths[i], odd, run(false, buf, lengths[i], &sum));
+
+			if (sum != sum_ref) {
+				printk("Checksum mismatch for %zu bytes: 0x%04x != 0x%04x\n",
+				       lengths[i], sum, sum_ref);
+				mismatches++;
+			}
+		}
+	}
+
+	TC_END_REPORT((mismatches != 0U) ? TC_FAIL : TC_PASS);
+
+	return 0;
+}
@@ -0,0 +1,197 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a benchmark of the demultiplexing of received UDP
+ * packets by net_conn_input(). A growing number of connected UDP handlers
+ * sharing a local port is registered, next to one handler listening on that
+ * port, and packets from each of the connected peers in turn are looked up.
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/dummy.h>
+
+#include "connection.h"
+
+#define LOCAL_PORT 5683
+#define REMOTE_PORT_BASE 10000
+#define MIN_CONNS 8
+
+BUILD_ASSERT(CONFIG_NET_MAX_CONN > CONFIG_BENCHMARK_MAX_CONNS,
+	     "CONFIG_NET_MAX_CONN must leave room for the listener");
+
+static struct net_conn_handle *handles[CONFIG_BENCHMARK_MAX_CONNS];
+static struct net_conn_handle *listener;
+static uintptr_t expected;
+static unsigned int mismatches;
+
+static void dummy_iface_init(struct net_if *iface)
+{
+	ARG_UNUSED(iface);
+}
+
+static int dummy_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static struct dummy_api dummy_if_api = {
+	.iface_api.init = dummy_iface_init,
+	.send = dummy_send,
+};
+
+NET_DEVICE_INIT(net_conn_lookup, "net_conn_lookup", NULL, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &dummy_if_api,
+		DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), NET_IPV4_MTU);
+
+static enum net_verdict conn_cb(struct net_conn *conn, struct net_pkt *pkt,
+				union net_ip_header *ip_hdr,
+				union net_proto_header *proto_hdr,
+				void *user_data)
+{
+	if ((uintptr_t)user_data != expected) {
+		mismatches++;
+	}
+
+	/* The packet is reused for the next lookup */
+	return NET_OK;
+}
+
+/* Remote peers are spread over 192.0.2.0/24 and distinct ports */
+static void peer_addr(unsigned int i, struct net_sockaddr_in *addr)
+{
+	addr->sin_family = NET_AF_INET;
+	addr->sin_port = net_htons(REMOTE_PORT_BASE + i);
+	addr->sin_addr.s4_addr[0] = 192;
+	addr->sin_addr.s4_addr[1] = 0;
+	addr->sin_addr.s4_addr[2] = 2;
+	addr->sin_addr.s4_addr[3] = 1 + (i % 254);
+}
+
+static int register_conns(unsigned int count)
+{
+	struct net_sockaddr_in remote;
+	int ret;
+
+	for (unsigned int i = 0; i < count; i++) {
+		peer_addr(i, &remote);
+
+		ret = net_conn_register(NET_IPPROTO_UDP, NET_SOCK_DGRAM, NET_AF_INET,
+					(struct net_sockaddr *)&remote, NULL,
+					REMOTE_PORT_BASE + i, LOCAL_PORT, NULL,
+					conn_cb, (void *)(uintptr_t)i, &handles[i]);
+		if (ret < 0) {
+			printk("Cannot register connection %u (%d)\n", i, ret);
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+static void unregister_conns(unsigned int count)
+{
+	for (unsigned int i = 0; i < count; i++) {
+		(void)net_conn_unregister(handles[i]);
+	}
+}
+
+/* Return the average time in nanoseconds of a net_conn_input() call */
+static uint64_t run(struct net_pkt *pkt, unsigned int count)
+{
+	struct net_ipv4_hdr ipv4 = { 0 };
+	struct net_udp_hdr udp = { 0 };
+	union net_ip_header ip_hdr = { .ipv4 = &ipv4 };
+	union net_proto_header proto_hdr = { .udp = &udp };
+	struct net_sockaddr_in remote;
+	uint32_t start, cycles = 0U;
+
+	/* 198.51.100.1 */
+	ipv4.dst[0] = 198;
+	ipv4.dst[1] = 51;
+	ipv4.dst[2] = 100;
+	ipv4.dst[3] = 1;
+	udp.dst_port = net_htons(LOCAL_PORT);
+
+	for (unsigned int r = 0; r < CONFIG_BENCHMARK_ROUNDS; r++) {
+		unsigned int i = r % count;
+
+		peer_addr(i, &remote);
+		memcpy(ipv4.src, &remote.sin_addr, sizeof(ipv4.src));
+		udp.src_port = remote.sin_port;
+		expected = i;
+
+		start = k_cycle_get_32();
+		(void)net_conn_input(pkt, &ip_hdr, NET_IPPROTO_UDP, &proto_hdr);
+		cycles += k_cycle_get_32() - start;
+	}
+
+	return k_cyc_to_ns_floor64(cycles) / CONFIG_BENCHMARK_ROUNDS;
+}
+
+static void report(unsigned int count, uint64_t ns)
+{
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: net.conn.input.%u - Lookup among %u connections : %llu ns :\n",
+	       count, count, ns);
+#else
+	printk("Lookup among %4u connections : %6llu ns\n", count, ns);
+#endif
+}
+
+int main(void)
+{
+	struct net_if *iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	struct net_pkt *pkt;
+	int ret = 0;
+
+	pkt = net_pkt_alloc_on_iface(iface, K_FOREVER);
+	net_pkt_set_family(pkt, NET_AF_INET);
+
+	printk("net_conn_input() with %d rounds, connection hash %s\n",
+	       CONFIG_BENCHMARK_ROUNDS,
+	       IS_ENABLED(CONFIG_NET_CONN_HASH) ? "enabled" : "disabled");
+
+	/* Never matched as long as the connected handlers are there */
+	ret = net_conn_register(NET_IPPROTO_UDP, NET_SOCK_DGRAM, NET_AF_INET,
+				NULL, NULL, 0, LOCAL_PORT, NULL, conn_cb,
+				(void *)UINTPTR_MAX, &listener);
+	if (ret < 0) {
+		goto out;
+	}
+
+	for (unsigned int count = MIN_CONNS; count <= CONFIG_BENCHMARK_MAX_CONNS;
+	     count *= 2) {
+		ret = register_conns(count);
+		if (ret < 0) {
+			goto out;
+		}
+
+		report(count, run(pkt, count));
+		unregister_conns(count);
+	}
+
+	if (mismatches != 0U) {
+		printk("%u packets delivered to the wrong connection\n", mismatches);
+		ret = -EINVAL;
+	}
+
+out:
+	net_pkt_unref(pkt);
+	TC_END_REPORT((ret != 0) ? TC_FAIL : TC_PASS);
+
+	return 0;
+}
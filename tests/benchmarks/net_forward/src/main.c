@@ -0,0 +1,439 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a benchmark of packet forwarding between two Ethernet
+ * interfaces. UDP packets of a few flows are given in turn to the inside
+ * interface as a driver would, and the time taken until the outside
+ * interface sends them is measured. With CONFIG_NET_NAPT44, IPv4 packets are
+ * translated to the outside interface address, and their replies back.
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/napt.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "net_private.h"
+#include "ipv6.h"
+#include "route.h"
+#include "arp.h"
+
+#define PAYLOAD_LEN 64
+#define FRAME_LEN (sizeof(struct net_eth_hdr) + sizeof(struct net_ipv6_hdr) + \
+		   sizeof(struct net_udp_hdr) + PAYLOAD_LEN)
+
+struct eth_context {
+	struct net_eth_addr mac;
+	unsigned int sent;
+};
+
+static struct eth_context lan_ctx = {
+	.mac = { { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 } },
+};
+
+static struct eth_context wan_ctx = {
+	.mac = { { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x02 } },
+};
+
+/* Host of the inside network, and next hop of the outside one */
+static struct net_eth_addr host_mac = { { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x10 } };
+static struct net_eth_addr nexthop_mac = { { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x20 } };
+
+static struct net_in6_addr host6 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0x01, 0, 0,
+					 0, 0, 0, 0, 0, 0, 0, 0x10 } } };
+static struct net_in6_addr nexthop6 = { { { 0xfe, 0x80, 0, 0, 0, 0, 0, 0,
+					    0, 0, 0, 0, 0, 0, 0, 0x20 } } };
+static struct net_in6_addr remote6 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0x02, 0, 0,
+					   0, 0, 0, 0, 0, 0, 0, 0 } } };
+
+static uint8_t frames[CONFIG_BENCHMARK_FLOWS][FRAME_LEN];
+static size_t frame_len;
+
+/* Last frame sent by an interface, and whether the frames sent were valid */
+static uint8_t sent_frame[FRAME_LEN];
+static const struct net_eth_addr *expected_dst;
+static unsigned int errors;
+
+static void eth_iface_init(struct net_if *iface)
+{
+	struct eth_context *ctx = net_if_get_device(iface)->data;
+
+	net_if_set_link_addr(iface, ctx->mac.addr, sizeof(ctx->mac), NET_LINK_ETHERNET);
+
+	ethernet_init(iface);
+}
+
+static int eth_send(const struct device *dev, struct net_pkt *pkt)
+{
+	struct eth_context *ctx = dev->data;
+	struct net_eth_hdr *hdr = NET_ETH_HDR(pkt);
+	size_t len = net_pkt_get_len(pkt);
+
+	/* Only the unicast frames are forwarded packets */
+	if (expected_dst == NULL || net_eth_is_addr_multicast(&hdr->dst) ||
+	    net_eth_is_addr_broadcast(&hdr->dst)) {
+		return 0;
+	}
+
+	ctx->sent++;
+
+	if (len > sizeof(sent_frame) || net_pkt_read(pkt, sent_frame, len) < 0 ||
+	    memcmp(&hdr->dst, expected_dst, sizeof(*expected_dst)) != 0) {
+		errors++;
+	}
+
+	return 0;
+}
+
+static const struct ethernet_api eth_api = {
+	.iface_api.init = eth_iface_init,
+	.send = eth_send,
+};
+
+ETH_NET_DEVICE_INIT(eth_lan, "eth_lan", NULL, NULL, &lan_ctx, NULL,
+		    CONFIG_ETH_INIT_PRIORITY, &eth_api, NET_ETH_MTU);
+
+ETH_NET_DEVICE_INIT(eth_wan, "eth_wan", NULL, NULL, &wan_ctx, NULL,
+		    CONFIG_ETH_INIT_PRIORITY, &eth_api, NET_ETH_MTU);
+
+static struct net_if *iface_of(struct eth_context *ctx)
+{
+	STRUCT_SECTION_FOREACH(net_if, iface) {
+		if (net_if_get_device(iface)->data == ctx) {
+			return iface;
+		}
+	}
+
+	return NULL;
+}
+
+static size_t eth_frame(uint8_t *frame, const struct net_eth_addr *dst,
+			const struct net_eth_addr *src, uint16_t type)
+{
+	struct net_eth_hdr *hdr = (struct net_eth_hdr *)frame;
+
+	hdr->dst = *dst;
+	hdr->src = *src;
+	hdr->type = net_htons(type);
+
+	return sizeof(*hdr);
+}
+
+static void udp_frame(uint8_t *udp, uint16_t src_port, uint16_t dst_port)
+{
+	struct net_udp_hdr *hdr = (struct net_udp_hdr *)udp;
+
+	hdr->src_port = net_htons(src_port);
+	hdr->dst_port = net_htons(dst_port);
+	hdr->len = net_htons(sizeof(*hdr) + PAYLOAD_LEN);
+	hdr->chksum = 0U;
+
+	for (size_t i = 0; i < PAYLOAD_LEN; i++) {
+		udp[sizeof(*hdr) + i] = (uint8_t)i;
+	}
+}
+
+/* Fill the checksum of a UDP packet, whose addresses are given */
+static void udp_chksum(uint8_t *udp, const uint8_t *addr, size_t addr_len)
+{
+	struct net_udp_hdr *hdr = (struct net_udp_hdr *)udp;
+	size_t len = sizeof(*hdr) + PAYLOAD_LEN;
+	uint16_t sum;
+
+	sum = calc_chksum(len + NET_IPPROTO_UDP, addr, addr_len);
+	sum = calc_chksum(sum, udp, len);
+	hdr->chksum = ~((sum == 0U) ? 0xffff : net_htons(sum));
+}
+
+static size_t ipv6_frame(uint8_t *frame, const struct net_eth_addr *dst_mac,
+			 const struct net_in6_addr *src, const struct net_in6_addr *dst)
+{
+	size_t len = eth_frame(frame, dst_mac, &host_mac, NET_ETH_PTYPE_IPV6);
+	struct net_ipv6_hdr *hdr = (struct net_ipv6_hdr *)(frame + len);
+	uint8_t *udp = frame + len + sizeof(*hdr);
+
+	memset(hdr, 0, sizeof(*hdr));
+	hdr->vtc = 0x60;
+	hdr->len = net_htons(sizeof(struct net_udp_hdr) + PAYLOAD_LEN);
+	hdr->nexthdr = NET_IPPROTO_UDP;
+	hdr->hop_limit = 64U;
+	net_ipv6_addr_copy_raw(hdr->src, src->s6_addr);
+	net_ipv6_addr_copy_raw(hdr->dst, dst->s6_addr);
+
+	udp_frame(udp, 1000U, 7U);
+	udp_chksum(udp, hdr->src, 2 * NET_IPV6_ADDR_SIZE);
+
+	return len + sizeof(*hdr) + sizeof(struct net_udp_hdr) + PAYLOAD_LEN;
+}
+
+static int inject(struct net_if *iface, const uint8_t *frame, size_t len)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_rx_alloc_with_buffer(iface, len, NET_AF_UNSPEC, 0, K_FOREVER);
+	if (pkt == NULL) {
+		return -ENOMEM;
+	}
+
+	if (net_pkt_write(pkt, frame, len) < 0 || net_recv_data(iface, pkt) < 0) {
+		net_pkt_unref(pkt);
+		return -EIO;
+	}
+
+	return 0;
+}
+
+/* Send one packet of each flow, so that the flows are known */
+static int warm_up(struct net_if *iface)
+{
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_FLOWS; i++) {
+		if (inject(iface, frames[i], frame_len) < 0) {
+			return -EIO;
+		}
+	}
+
+	return 0;
+}
+
+/* Return the average time in nanoseconds taken to forward a packet */
+static uint64_t run(struct net_if *in, struct eth_context *out)
+{
+	uint32_t start, cycles;
+
+	out->sent = 0U;
+
+	start = k_cycle_get_32();
+
+	for (unsigned int r = 0; r < CONFIG_BENCHMARK_PACKETS; r++) {
+		if (inject(in, frames[r % CONFIG_BENCHMARK_FLOWS], frame_len) < 0) {
+			errors++;
+		}
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	if (out->sent != CONFIG_BENCHMARK_PACKETS) {
+		printk("%u packets forwarded out of %u\n", out->sent, CONFIG_BENCHMARK_PACKETS);
+		errors++;
+	}
+
+	return k_cyc_to_ns_floor64(cycles) / CONFIG_BENCHMARK_PACKETS;
+}
+
+static void report(const char *name, const char *desc, uint64_t ns)
+{
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: net.forward.%s - %s : %llu ns :\n", name, desc, ns);
+#else
+	printk("%-40s : %6llu ns, %8llu packets/s\n", desc, ns,
+	       (ns > 0U) ? NSEC_PER_SEC / ns : 0U);
+#endif
+}
+
+static int forward_ipv6(struct net_if *lan, struct net_if *wan)
+{
+	struct net_linkaddr lladdr;
+	struct net_in6_addr dst;
+
+	(void)net_linkaddr_create(&lladdr, nexthop_mac.addr, sizeof(nexthop_mac),
+				  NET_LINK_ETHERNET);
+
+	if (net_ipv6_nbr_add(wan, &nexthop6, &lladdr, true, NET_IPV6_NBR_STATE_STATIC) == NULL) {
+		printk("Cannot add next hop neighbor\n");
+		return -ENOMEM;
+	}
+
+	/* The route back to the host is added by the first packet forwarded */
+	(void)net_linkaddr_create(&lladdr, host_mac.addr, sizeof(host_mac),
+				  NET_LINK_ETHERNET);
+
+	if (net_ipv6_nbr_add(lan, &host6, &lladdr, false, NET_IPV6_NBR_STATE_STATIC) == NULL) {
+		printk("Cannot add host neighbor\n");
+		return -ENOMEM;
+	}
+
+	if (net_route_add(wan, &remote6, 64, &nexthop6, NET_IPV6_ND_INFINITE_LIFETIME,
+			  NET_ROUTE_PREFERENCE_MEDIUM) == NULL) {
+		printk("Cannot add route\n");
+		return -ENOMEM;
+	}
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_FLOWS; i++) {
+		dst = remote6;
+		dst.s6_addr[15] = 1U + i;
+		frame_len = ipv6_frame(frames[i], &lan_ctx.mac, &host6, &dst);
+	}
+
+	expected_dst = &nexthop_mac;
+
+	if (warm_up(lan) < 0) {
+		return -EIO;
+	}
+
+	report("ipv6", "IPv6 forwarding", run(lan, &wan_ctx));
+
+	return 0;
+}
+
+#if defined(CONFIG_NET_NAPT44)
+static struct net_in_addr host4 = { { { 192, 0, 2, 10 } } };
+static struct net_in_addr lan4 = { { { 192, 0, 2, 1 } } };
+static struct net_in_addr wan4 = { { { 198, 51, 100, 1 } } };
+static struct net_in_addr gw4 = { { { 198, 51, 100, 254 } } };
+static struct net_in_addr remote4 = { { { 203, 0, 113, 1 } } };
+static struct net_in_addr netmask4 = { { { 255, 255, 255, 0 } } };
+
+static size_t ipv4_frame(uint8_t *frame, const struct net_eth_addr *dst_mac,
+			 const struct net_eth_addr *src_mac,
+			 const struct net_in_addr *src, const struct net_in_addr *dst,
+			 uint16_t src_port, uint16_t dst_port)
+{
+	size_t len = eth_frame(frame, dst_mac, src_mac, NET_ETH_PTYPE_IP);
+	struct net_ipv4_hdr *hdr = (struct net_ipv4_hdr *)(frame + len);
+	uint8_t *udp = frame + len + sizeof(*hdr);
+
+	memset(hdr, 0, sizeof(*hdr));
+	hdr->vhl = 0x45;
+	hdr->len = net_htons(sizeof(*hdr) + sizeof(struct net_udp_hdr) + PAYLOAD_LEN);
+	hdr->ttl = 64U;
+	hdr->proto = NET_IPPROTO_UDP;
+	net_ipv4_addr_copy_raw(hdr->src, src->s4_addr);
+	net_ipv4_addr_copy_raw(hdr->dst, dst->s4_addr);
+	hdr->chksum = ~net_htons(calc_chksum(0U, (uint8_t *)hdr, sizeof(*hdr)));
+
+	udp_frame(udp, src_port, dst_port);
+	udp_chksum(udp, hdr->src, 2 * NET_IPV4_ADDR_SIZE);
+
+	return len + sizeof(*hdr) + sizeof(struct net_udp_hdr) + PAYLOAD_LEN;
+}
+
+/* Check the checksums of the last IPv4 frame sent */
+static bool ipv4_frame_is_valid(void)
+{
+	struct net_ipv4_hdr *hdr = (struct net_ipv4_hdr *)(sent_frame + sizeof(struct net_eth_hdr));
+	size_t len = sizeof(struct net_udp_hdr) + PAYLOAD_LEN;
+	uint16_t sum;
+
+	if (calc_chksum(0U, (uint8_t *)hdr, sizeof(*hdr)) != 0xffff) {
+		return false;
+	}
+
+	sum = calc_chksum(len + NET_IPPROTO_UDP, hdr->src, 2 * NET_IPV4_ADDR_SIZE);
+
+	return calc_chksum(sum, (uint8_t *)(hdr + 1), len) == 0xffff;
+}
+
+static int forward_napt44(struct net_if *lan, struct net_if *wan)
+{
+	const size_t port_offset = sizeof(struct net_eth_hdr) + sizeof(struct net_ipv4_hdr);
+	uint16_t ports[CONFIG_BENCHMARK_FLOWS];
+
+	if (net_if_ipv4_addr_add(lan, &lan4, NET_ADDR_MANUAL, 0) == NULL ||
+	    net_if_ipv4_addr_add(wan, &wan4, NET_ADDR_MANUAL, 0) == NULL) {
+		printk("Cannot add IPv4 addresses\n");
+		return -ENOMEM;
+	}
+
+	net_if_ipv4_set_netmask_by_addr(lan, &lan4, &netmask4);
+	net_if_ipv4_set_netmask_by_addr(wan, &wan4, &netmask4);
+	net_if_ipv4_set_gw(wan, &gw4);
+
+	net_arp_update(lan, &host4, &host_mac, false, true);
+	net_arp_update(wan, &gw4, &nexthop_mac, false, true);
+
+	if (net_napt44_enable(wan) < 0) {
+		printk("Cannot enable NAPT44\n");
+		return -EINVAL;
+	}
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_FLOWS; i++) {
+		frame_len = ipv4_frame(frames[i], &lan_ctx.mac, &host_mac, &host4, &remote4,
+				       1000U + i, 7U);
+	}
+
+	expected_dst = &nexthop_mac;
+
+	/* Remember the port each flow is translated to */
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_FLOWS; i++) {
+		if (inject(lan, frames[i], frame_len) < 0 || !ipv4_frame_is_valid()) {
+			return -EIO;
+		}
+
+		ports[i] = sys_get_be16(sent_frame + port_offset);
+	}
+
+	report("napt44.out", "NAPT44 forwarding to the outside", run(lan, &wan_ctx));
+
+	if (!ipv4_frame_is_valid()) {
+		errors++;
+	}
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_FLOWS; i++) {
+		frame_len = ipv4_frame(frames[i], &wan_ctx.mac, &nexthop_mac, &remote4, &wan4,
+				       7U, ports[i]);
+	}
+
+	expected_dst = &host_mac;
+
+	report("napt44.in", "NAPT44 forwarding to the inside", run(wan, &lan_ctx));
+
+	if (!ipv4_frame_is_valid() ||
+	    sys_get_be16(sent_frame + port_offset + sizeof(uint16_t)) !=
+	    1000U + (CONFIG_BENCHMARK_PACKETS - 1) % CONFIG_BENCHMARK_FLOWS) {
+		errors++;
+	}
+
+	return 0;
+}
+#else
+static inline int forward_napt44(struct net_if *lan, struct net_if *wan)
+{
+	ARG_UNUSED(lan);
+	ARG_UNUSED(wan);
+
+	return 0;
+}
+#endif /* CONFIG_NET_NAPT44 */
+
+int main(void)
+{
+	struct net_if *lan = iface_of(&lan_ctx);
+	struct net_if *wan = iface_of(&wan_ctx);
+	int ret;
+
+	printk("Forwarding of %d packets of %d flows, fast path %s, NAPT44 %s\n",
+	       CONFIG_BENCHMARK_PACKETS, CONFIG_BENCHMARK_FLOWS,
+	       IS_ENABLED(CONFIG_NET_FASTPATH) ? "enabled" : "disabled",
+	       IS_ENABLED(CONFIG_NET_NAPT44) ? "enabled" : "disabled");
+
+	ret = forward_ipv6(lan, wan);
+	if (ret < 0) {
+		goto out;
+	}
+
+	ret = forward_napt44(lan, wan);
+	if (ret < 0) {
+		goto out;
+	}
+
+	if (errors != 0U) {
+		printk("%u packets were not forwarded correctly\n", errors);
+		ret = -EINVAL;
+	}
+
+out:
+	TC_END_REPORT((ret != 0) ? TC_FAIL : TC_PASS);
+
+	return 0;
+}
@@ -0,0 +1,188 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a benchmark of net_route_lookup(). A growing number of
+ * IPv6 /64 routes through a single next hop is added, and the route of a
+ * destination in each of them in turn is looked up.
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "ipv6.h"
+#include "route.h"
+
+#define MIN_ROUTES 16
+#define WORKING_SET 16
+
+BUILD_ASSERT(CONFIG_NET_MAX_ROUTES >= CONFIG_BENCHMARK_MAX_ROUTES &&
+	     CONFIG_NET_MAX_NEXTHOPS >= CONFIG_BENCHMARK_MAX_ROUTES,
+	     "Not enough routes or next hops");
+
+static struct net_route_entry *routes[CONFIG_BENCHMARK_MAX_ROUTES];
+static unsigned int mismatches;
+
+/* fe80::1 */
+static struct net_in6_addr nexthop = { { { 0xfe, 0x80, 0, 0, 0, 0, 0, 0,
+					   0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+
+static const struct net_linkaddr nexthop_lladdr = {
+	.addr = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 },
+	.len = 6,
+	.type = NET_LINK_DUMMY,
+};
+
+static void dummy_iface_init(struct net_if *iface)
+{
+	ARG_UNUSED(iface);
+}
+
+static int dummy_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static struct dummy_api dummy_if_api = {
+	.iface_api.init = dummy_iface_init,
+	.send = dummy_send,
+};
+
+NET_DEVICE_INIT(net_route_lookup, "net_route_lookup", NULL, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &dummy_if_api,
+		DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), NET_IPV6_MTU);
+
+/* The /64 prefixes are spread over 2001:db8::/32, the multiplier being odd
+ * so that they are all distinct.
+ */
+static void route_addr(unsigned int i, uint16_t host, struct net_in6_addr *addr)
+{
+	uint32_t bits = i * 2654435761U;
+
+	memset(addr, 0, sizeof(*addr));
+
+	addr->s6_addr[0] = 0x20;
+	addr->s6_addr[1] = 0x01;
+	addr->s6_addr[2] = 0x0d;
+	addr->s6_addr[3] = 0xb8;
+	sys_put_be32(bits, &addr->s6_addr[4]);
+	sys_put_be16(host, &addr->s6_addr[14]);
+}
+
+static int add_routes(struct net_if *iface, unsigned int count)
+{
+	struct net_in6_addr addr;
+
+	for (unsigned int i = 0; i < count; i++) {
+		route_addr(i, 0U, &addr);
+
+		routes[i] = net_route_add(iface, &addr, 64,
+					  &nexthop,
+					  NET_IPV6_ND_INFINITE_LIFETIME,
+					  NET_ROUTE_PREFERENCE_MEDIUM);
+		if (routes[i] == NULL) {
+			printk("Cannot add route %u\n", i);
+			return -ENOMEM;
+		}
+	}
+
+	return 0;
+}
+
+static void del_routes(unsigned int count)
+{
+	for (unsigned int i = 0; i < count; i++) {
+		(void)net_route_del(routes[i]);
+	}
+}
+
+/* Return the average time in nanoseconds of a net_route_lookup() call */
+static uint64_t run(struct net_if *iface, unsigned int count)
+{
+	struct net_route_entry *route;
+	struct net_in6_addr dst;
+	uint32_t start, cycles = 0U;
+
+	for (unsigned int r = 0; r < CONFIG_BENCHMARK_ROUNDS; r++) {
+		unsigned int i = r % count;
+
+		route_addr(i, 1U + i, &dst);
+
+		start = k_cycle_get_32();
+		route = net_route_lookup(iface, &dst);
+		cycles += k_cycle_get_32() - start;
+
+		if (route != routes[i]) {
+			mismatches++;
+		}
+	}
+
+	return k_cyc_to_ns_floor64(cycles) / CONFIG_BENCHMARK_ROUNDS;
+}
+
+static void report(unsigned int count, unsigned int set, uint64_t ns)
+{
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: net.route.lookup.%u.%u - Lookup of %u destinations among %u routes"
+	       " : %llu ns :\n", count, set, set, count, ns);
+#else
+	printk("Lookup of %4u destinations among %4u routes : %6llu ns\n", set, count, ns);
+#endif
+}
+
+int main(void)
+{
+	struct net_if *iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	int ret = 0;
+
+	printk("net_route_lookup() with %d rounds, trie %s, cache size %d\n",
+	       CONFIG_BENCHMARK_ROUNDS,
+	       IS_ENABLED(CONFIG_NET_ROUTE_LPM_TRIE) ? "enabled" : "disabled",
+	       CONFIG_NET_ROUTE_CACHE_SIZE);
+
+	if (net_ipv6_nbr_add(iface, &nexthop, &nexthop_lladdr, true,
+			     NET_IPV6_NBR_STATE_STATIC) == NULL) {
+		printk("Cannot add next hop neighbor\n");
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	for (unsigned int count = MIN_ROUTES; count <= CONFIG_BENCHMARK_MAX_ROUTES;
+	     count *= 16) {
+		ret = add_routes(iface, count);
+		if (ret < 0) {
+			goto out;
+		}
+
+		report(count, count, run(iface, count));
+
+		if (count > WORKING_SET) {
+			report(count, WORKING_SET, run(iface, WORKING_SET));
+		}
+
+		del_routes(count);
+	}
+
+	if (mismatches != 0U) {
+		printk("%u lookups returned the wrong route\n", mismatches);
+		ret = -EINVAL;
+	}
+
+out:
+	TC_END_REPORT((ret != 0) ? TC_FAIL : TC_PASS);
+
+	return 0;
+}
@@ -0,0 +1,207 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a benchmark of the reception of UDP datagrams with
+ * zsock_recv(), which copies them to a user buffer, and with
+ * zsock_recv_zc(), which loans the network buffers holding them. Batches of
+ * datagrams are queued on a socket over the loopback interface, then
+ * received with non-blocking calls which alone are timed.
+ */
+
+#include <errno.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/net/socket.h>
+
+#define PORT 4242
+#define MAX_IOV 32
+#define QUEUE_TIMEOUT_MS 1000
+
+enum recv_mode {
+	RECV_COPY,
+	RECV_ZEROCOPY,
+};
+
+static const char *const mode_names[] = {
+	[RECV_COPY] = "copy",
+	[RECV_ZEROCOPY] = "zerocopy",
+};
+
+static uint8_t tx_buf[CONFIG_BENCHMARK_PAYLOAD_SIZE];
+static uint8_t rx_buf[CONFIG_BENCHMARK_PAYLOAD_SIZE];
+static struct net_iovec iov[MAX_IOV];
+
+/* The first byte of each datagram holds its sequence number */
+static int send_batch(int sock, uint8_t seq)
+{
+	for (int i = 0; i < CONFIG_BENCHMARK_BATCH; i++) {
+		tx_buf[0] = seq + i;
+
+		if (zsock_send(sock, tx_buf, sizeof(tx_buf), 0) != sizeof(tx_buf)) {
+			return -errno;
+		}
+	}
+
+	return 0;
+}
+
+/* Wait until the whole batch is queued on the receiving socket */
+static int wait_batch(int sock)
+{
+	int avail;
+
+	for (int i = 0; i < QUEUE_TIMEOUT_MS; i++) {
+		if (zsock_ioctl(sock, ZFD_IOCTL_FIONREAD, &avail) < 0) {
+			return -errno;
+		}
+
+		if (avail >= CONFIG_BENCHMARK_BATCH * CONFIG_BENCHMARK_PAYLOAD_SIZE) {
+			return 0;
+		}
+
+		k_msleep(1);
+	}
+
+	return -ETIMEDOUT;
+}
+
+static ssize_t recv_one(int sock, enum recv_mode mode, uint8_t *seq,
+			uint64_t *cycles)
+{
+	struct zsock_zc_loan loan;
+	size_t iovcnt = ARRAY_SIZE(iov);
+	uint32_t start;
+	ssize_t len;
+
+	start = k_cycle_get_32();
+
+	if (mode == RECV_COPY) {
+		len = zsock_recv(sock, rx_buf, sizeof(rx_buf), ZSOCK_MSG_DONTWAIT);
+		*seq = rx_buf[0];
+	} else {
+		len = zsock_recv_zc(sock, iov, &iovcnt, ZSOCK_MSG_DONTWAIT,
+				    NULL, NULL, &loan);
+		if (len > 0) {
+			*seq = *(uint8_t *)iov[0].iov_base;
+			zsock_recv_zc_release(sock, &loan);
+		}
+	}
+
+	*cycles += k_cycle_get_32() - start;
+
+	return len;
+}
+
+/* Return the average time in nanoseconds to receive a datagram */
+static int run(int rx, int tx, enum recv_mode mode, uint64_t *ns)
+{
+	uint64_t cycles = 0U;
+	uint8_t seq = 0U;
+	uint8_t got;
+	ssize_t len;
+	int ret;
+
+	for (int r = 0; r < CONFIG_BENCHMARK_ROUNDS; r++) {
+		ret = send_batch(tx, seq);
+		if (ret == 0) {
+			ret = wait_batch(rx);
+		}
+
+		if (ret < 0) {
+			printk("Cannot queue batch %d (%d)\n", r, ret);
+			return ret;
+		}
+
+		for (int i = 0; i < CONFIG_BENCHMARK_BATCH; i++, seq++) {
+			len = recv_one(rx, mode, &got, &cycles);
+			if (len != CONFIG_BENCHMARK_PAYLOAD_SIZE || got != seq) {
+				printk("Datagram %u: received %zd bytes, sequence %u\n",
+				       seq, len, got);
+				return -EINVAL;
+			}
+		}
+	}
+
+	*ns = k_cyc_to_ns_floor64(cycles) /
+	      (CONFIG_BENCHMARK_ROUNDS * CONFIG_BENCHMARK_BATCH);
+
+	return 0;
+}
+
+static void report(enum recv_mode mode, uint64_t ns)
+{
+	/* Bytes per nanosecond, in kB/s */
+	uint64_t kbps = (ns > 0U) ? CONFIG_BENCHMARK_PAYLOAD_SIZE * 1000000ULL / ns : 0U;
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: net.socket.recv.%s.%u - Receive %u bytes with %s, %llu kB/s : %llu ns :\n",
+	       mode_names[mode], CONFIG_BENCHMARK_PAYLOAD_SIZE,
+	       CONFIG_BENCHMARK_PAYLOAD_SIZE, mode_names[mode], kbps, ns);
+#else
+	printk("Receive %u bytes with %-8s : %6llu ns, %8llu kB/s\n",
+	       CONFIG_BENCHMARK_PAYLOAD_SIZE, mode_names[mode], ns, kbps);
+#endif
+}
+
+int main(void)
+{
+	struct net_sockaddr_in addr = {
+		.sin_family = NET_AF_INET,
+		.sin_port = net_htons(PORT),
+	};
+	int rx = -1;
+	int tx = -1;
+	uint64_t ns;
+	int ret;
+
+	printk("Receiving %d batches of %d datagrams of %d bytes\n",
+	       CONFIG_BENCHMARK_ROUNDS, CONFIG_BENCHMARK_BATCH,
+	       CONFIG_BENCHMARK_PAYLOAD_SIZE);
+
+	(void)zsock_inet_pton(NET_AF_INET, "127.0.0.1", &addr.sin_addr);
+
+	rx = zsock_socket(NET_AF_INET, NET_SOCK_DGRAM, NET_IPPROTO_UDP);
+	tx = zsock_socket(NET_AF_INET, NET_SOCK_DGRAM, NET_IPPROTO_UDP);
+	if (rx < 0 || tx < 0) {
+		ret = -errno;
+		goto out;
+	}
+
+	ret = zsock_bind(rx, (struct net_sockaddr *)&addr, sizeof(addr));
+	if (ret == 0) {
+		ret = zsock_connect(tx, (struct net_sockaddr *)&addr, sizeof(addr));
+	}
+
+	if (ret < 0) {
+		ret = -errno;
+		goto out;
+	}
+
+	for (int mode = RECV_COPY; mode <= RECV_ZEROCOPY; mode++) {
+		ret = run(rx, tx, mode, &ns);
+		if (ret < 0) {
+			goto out;
+		}
+
+		report(mode, ns);
+	}
+
+out:
+	if (rx >= 0) {
+		(void)zsock_close(rx);
+	}
+
+	if (tx >= 0) {
+		(void)zsock_close(tx);
+	}
+
+	TC_END_REPORT((ret != 0) ? TC_FAIL : TC_PASS);
+
+	return 0;
+}
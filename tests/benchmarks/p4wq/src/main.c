@@ -0,0 +1,130 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a benchmark of P4WQ: the latency from submission of
+ * an item to the entry to its handler, and the throughput of a queue fanning
+ * out many short items to its workers.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/p4wq.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+#define MAIN_PRIO     K_PRIO_PREEMPT(5)
+#define LATENCY_PRIO  K_PRIO_PREEMPT(1)
+#define FAN_OUT_PRIO  K_PRIO_PREEMPT(8)
+
+#ifdef CONFIG_P4WQ_WORK_STEALING
+K_P4WQ_DEFINE_WITH_FLAGS(wq, CONFIG_BENCHMARK_NUM_WORKERS, STACK_SIZE, K_P4WQ_WORK_STEALING);
+#else
+K_P4WQ_DEFINE(wq, CONFIG_BENCHMARK_NUM_WORKERS, STACK_SIZE);
+#endif
+
+struct bench_item {
+	struct k_p4wq_work work;
+	timing_t submitted;
+	timing_t ran;
+};
+
+static struct bench_item items[CONFIG_BENCHMARK_NUM_ITEMS];
+
+static void job_handler(struct k_p4wq_work *work)
+{
+	struct bench_item *item = CONTAINER_OF(work, struct bench_item, work);
+
+	item->ran = timing_counter_get();
+
+	for (volatile unsigned int i = 0; i < CONFIG_BENCHMARK_WORK_LOOPS; i++) {
+	}
+}
+
+static void submit(struct bench_item *item, int prio)
+{
+	/* The queue turns the deadline into an absolute time on every
+	 * submission, so all fields are set again.
+	 */
+	item->work.priority = prio;
+	item->work.deadline = 0;
+	item->work.handler = job_handler;
+	item->work.sync = true;
+
+	item->submitted = timing_counter_get();
+	k_p4wq_submit(&wq, &item->work);
+}
+
+static void report(const char *metric, const char *description, uint64_t cycles)
+{
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s - %s : %7llu cycles , %7u ns :\n", metric, description,
+	       cycles, (uint32_t)timing_cycles_to_ns(cycles));
+#else
+	printk("%-60s : %7llu cycles (%7u nsec)\n", description,
+	       cycles, (uint32_t)timing_cycles_to_ns(cycles));
+#endif
+}
+
+int main(void)
+{
+	const uint64_t total_items = (uint64_t)CONFIG_BENCHMARK_NUM_ROUNDS *
+				     CONFIG_BENCHMARK_NUM_ITEMS;
+	uint64_t latency = 0;
+	uint64_t fan_out = 0;
+	timing_t start;
+	timing_t finish;
+
+	k_thread_priority_set(k_current_get(), MAIN_PRIO);
+
+	timing_init();
+
+	printk("Time Measurements for P4WQ with %u worker(s) on %u CPUs%s\n",
+	       CONFIG_BENCHMARK_NUM_WORKERS, arch_num_cpus(),
+	       IS_ENABLED(CONFIG_P4WQ_WORK_STEALING) ? " (work stealing)" : "");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	for (unsigned int round = 0; round < CONFIG_BENCHMARK_NUM_ROUNDS; round++) {
+		submit(&items[0], LATENCY_PRIO);
+		(void)k_p4wq_wait(&items[0].work, K_FOREVER);
+		latency += timing_cycles_get(&items[0].submitted, &items[0].ran);
+	}
+
+	for (unsigned int round = 0; round < CONFIG_BENCHMARK_NUM_ROUNDS; round++) {
+		start = timing_counter_get();
+		for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITEMS; i++) {
+			submit(&items[i], FAN_OUT_PRIO);
+		}
+		for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITEMS; i++) {
+			(void)k_p4wq_wait(&items[i].work, K_FOREVER);
+		}
+		finish = timing_counter_get();
+
+		fan_out += timing_cycles_get(&start, &finish);
+	}
+
+	timing_stop();
+
+	report("p4wq.latency.avg", "Average submit to handler latency",
+	       latency / CONFIG_BENCHMARK_NUM_ROUNDS);
+	report("p4wq.fan_out.avg", "Average time per fanned out item",
+	       fan_out / total_items);
+
+	uint64_t fan_out_ns = timing_cycles_to_ns(fan_out);
+
+	if (fan_out_ns != 0) {
+		printk("Items per second: %llu\n",
+		       total_items * NSEC_PER_SEC / fan_out_ns);
+	}
+
+	TC_END_REPORT(TC_PASS);
+
+	return 0;
+}
@@ -6,6 +6,7 @@
 
 #include <zephyr/kernel.h>
 #include <zephyr/sys/printk.h>
+#include <zephyr/sys/mutex.h>
 
 /* private kernel APIs */
 #include <wait_q.h>
@@ -69,6 +70,59 @@ void yielder_entry(void *_thread, void *_tid, void *_nb_threads)
 
 static k_tid_t threads[MAX_NB_THREADS];
 
+K_APP_DMEM(app_1_partition) SYS_MUTEX_DEFINE(bench_mutex);
+
+void locker_entry(void *_thread, void *p2, void *p3)
+{
+	struct k_app_thread *thread = (struct k_app_thread *) _thread;
+	int ret;
+
+	struct k_mem_partition *parts[] = {
+		thread->partition,
+	};
+
+	ret = k_mem_domain_init(&thread->domain, ARRAY_SIZE(parts), parts);
+	if (ret != 0) {
+		printk("k_mem_domain_init failed %d\n", ret);
+		yielder_status = 1;
+		return;
+	}
+
+	k_mem_domain_add_thread(&thread->domain, k_current_get());
+
+	k_thread_user_mode_enter(mutex_lock_unlock, &bench_mutex, NULL, NULL);
+}
+
+static int exec_mutex_test(void)
+{
+	yielder_status = 0;
+
+	app_threads[0].partition = app_partitions[0];
+	app_threads[0].stack = &app_thread_stacks[0];
+
+	threads[0] = k_thread_create(&app_threads[0].thread,
+				     app_thread_stacks[0],
+				     APP_STACKSIZE, locker_entry,
+				     &app_threads[0], NULL, NULL,
+				     THREADS_PRIO, 0, K_FOREVER);
+
+	k_thread_priority_set(k_current_get(), MAIN_PRIO);
+
+	stamp(MEAS_START);
+	k_thread_start(threads[0]);
+	k_thread_join(threads[0], K_FOREVER);
+	stamp(MEAS_END);
+
+	uint32_t full_time = stamps[MEAS_END] - stamps[MEAS_START];
+	uint64_t time_ns = k_cyc_to_ns_near64(full_time) / NB_LOCKS;
+
+	printk("Uncontended sys_mutex: %8" PRIu32 " cyc & %6" PRIu32 " rounds -> %6"
+				PRIu64 " ns per lock/unlock\n", full_time,
+				NB_LOCKS, time_ns);
+
+	return yielder_status;
+}
+
 static int exec_test(uint8_t nb_threads)
 {
 	if (nb_threads > MAX_NB_THREADS) {
@@ -136,6 +190,16 @@ int main(void)
 		}
 	}
 
+	printk("============================\n");
+	printk("user sys_mutex lock/unlock (%s)\n",
+	       IS_ENABLED(CONFIG_SYS_MUTEX_FUTEX) ? "futex" : "syscall");
+
+	ret = exec_mutex_test();
+	if (ret != 0) {
+		printk("FAIL\n");
+		return 0;
+	}
+
 	printk("SUCCESS\n");
 	return 0;
 }
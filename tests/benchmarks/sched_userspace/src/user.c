@@ -7,6 +7,7 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <zephyr/kernel.h>
+#include <zephyr/sys/mutex.h>
 
 #include "user.h"
 
@@ -19,3 +20,14 @@ void context_switch_yield(void *p1, void *p2, void *p3)
 		k_yield();
 	}
 }
+
+void mutex_lock_unlock(void *p1, void *p2, void *p3)
+{
+	struct sys_mutex *mutex = p1;
+	uint32_t rounds = NB_LOCKS;
+
+	while (rounds--) {
+		sys_mutex_lock(mutex, K_FOREVER);
+		sys_mutex_unlock(mutex);
+	}
+}
@@ -5,5 +5,7 @@
  */
 
 #define NB_YIELDS UINT32_C(1000000)
+#define NB_LOCKS UINT32_C(1000000)
 
 void context_switch_yield(void *p1, void *p2, void *p3);
+void mutex_lock_unlock(void *p1, void *p2, void *p3);
@@ -0,0 +1,175 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the length of time required to add,
+ * abort and expire kernel timeouts while the timeout queue holds a varying
+ * number of outstanding timeouts. The timeouts are bare struct _timeout
+ * objects, so neither threads nor timers are involved in the measurements.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/drivers/timer/system_timer.h>
+#include <timeout_q.h>
+#include <stdio.h>
+
+/* Outstanding timeouts expire at least this many ticks in the future, so
+ * that none of them is processed by the announcements done while measuring.
+ */
+#define MIN_DELAY (CONFIG_BENCHMARK_NUM_ITERATIONS + 16)
+
+static const unsigned int num_timeouts[] = { 10, 100, 1000, 10000 };
+
+static struct _timeout outstanding[CONFIG_BENCHMARK_MAX_TIMEOUTS];
+static struct _timeout measured[CONFIG_BENCHMARK_NUM_ITERATIONS];
+
+static uint64_t add_cycles[CONFIG_BENCHMARK_NUM_ITERATIONS];
+static uint64_t abort_cycles[CONFIG_BENCHMARK_NUM_ITERATIONS];
+static uint64_t announce_cycles[CONFIG_BENCHMARK_NUM_ITERATIONS];
+
+static unsigned int expired;
+static uint32_t rand_state = 0x2545f491;
+
+static void timeout_handler(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+
+	expired++;
+}
+
+/* Deterministic pseudo-random delays, so that runs of the different
+ * timeout queue implementations see the same sequence.
+ */
+static k_timeout_t random_delay(void)
+{
+	rand_state ^= rand_state << 13;
+	rand_state ^= rand_state >> 17;
+	rand_state ^= rand_state << 5;
+
+	return K_TICKS(MIN_DELAY + (rand_state & 0xfffff));
+}
+
+static void report(const char *tag, const char *str, unsigned int num, uint64_t *cycles)
+{
+	uint64_t minimum = cycles[0];
+	uint64_t maximum = cycles[0];
+	uint64_t total = 0;
+	uint64_t average;
+	char metric[64];
+	char description[96];
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		minimum = MIN(minimum, cycles[i]);
+		maximum = MAX(maximum, cycles[i]);
+		total += cycles[i];
+	}
+	average = total / CONFIG_BENCHMARK_NUM_ITERATIONS;
+
+	snprintf(metric, sizeof(metric), "timeout.%s.%05u.outstanding", tag, num);
+	snprintf(description, sizeof(description), "%s with %u outstanding timeouts",
+		 str, num);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s.min - %s, min. : %7llu cycles , %7u ns :\n", metric, description,
+	       minimum, (uint32_t)timing_cycles_to_ns(minimum));
+	printk("REC: %s.max - %s, max. : %7llu cycles , %7u ns :\n", metric, description,
+	       maximum, (uint32_t)timing_cycles_to_ns(maximum));
+	printk("REC: %s.avg - %s, avg. : %7llu cycles , %7u ns :\n", metric, description,
+	       average, (uint32_t)timing_cycles_to_ns(average));
+#else
+	printk("------------------------------------\n");
+	printk("%s\n", description);
+
+	printk("    Minimum : %7llu cycles (%7u nsec)\n", minimum,
+	       (uint32_t)timing_cycles_to_ns(minimum));
+	printk("    Maximum : %7llu cycles (%7u nsec)\n", maximum,
+	       (uint32_t)timing_cycles_to_ns(maximum));
+	printk("    Average : %7llu cycles (%7u nsec)\n", average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#endif
+}
+
+static void run(unsigned int num)
+{
+	timing_t start;
+	timing_t finish;
+	unsigned int i;
+
+	for (i = 0; i < num; i++) {
+		z_init_timeout(&outstanding[i]);
+		z_add_timeout(&outstanding[i], timeout_handler, random_delay());
+	}
+
+	/* Add and abort a timeout at a random position of the queue */
+
+	for (i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		k_timeout_t delay = random_delay();
+
+		z_init_timeout(&measured[i]);
+
+		start = timing_counter_get();
+		z_add_timeout(&measured[i], timeout_handler, delay);
+		finish = timing_counter_get();
+		add_cycles[i] = timing_cycles_get(&start, &finish);
+
+		start = timing_counter_get();
+		z_abort_timeout(&measured[i]);
+		finish = timing_counter_get();
+		abort_cycles[i] = timing_cycles_get(&start, &finish);
+	}
+
+	/* Announce a tick on which exactly one timeout expires */
+
+	expired = 0;
+	for (i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		z_init_timeout(&measured[i]);
+		z_add_timeout(&measured[i], timeout_handler, K_TICKS(0));
+
+		start = timing_counter_get();
+		sys_clock_announce(1);
+		finish = timing_counter_get();
+		announce_cycles[i] = timing_cycles_get(&start, &finish);
+	}
+
+	if (expired != CONFIG_BENCHMARK_NUM_ITERATIONS) {
+		printk("Expected %u expired timeouts, got %u\n",
+		       CONFIG_BENCHMARK_NUM_ITERATIONS, expired);
+	}
+
+	for (i = 0; i < num; i++) {
+		z_abort_timeout(&outstanding[i]);
+	}
+
+	report("add", "Add a timeout", num, add_cycles);
+	report("abort", "Abort a timeout", num, abort_cycles);
+	report("announce", "Announce tick expiring one timeout", num, announce_cycles);
+}
+
+int main(void)
+{
+	timing_init();
+
+	printk("Time Measurements for %s timeout queue\n",
+	       IS_ENABLED(CONFIG_TIMEOUT_QUEUE_WHEEL) ? "timing wheel" : "simple");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(num_timeouts); i++) {
+		if (num_timeouts[i] <= CONFIG_BENCHMARK_MAX_TIMEOUTS) {
+			run(num_timeouts[i]);
+		}
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a benchmark of timer slack. A set of periodic timers
+ * with the same period and evenly spread phases is run with and without
+ * slack, and the number of ticks on which timers expired is compared.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/tc_util.h>
+
+struct bench_timer {
+	struct k_timer timer;
+	k_ticks_t nominal;
+};
+
+static struct bench_timer timers[CONFIG_BENCHMARK_NUM_TIMERS];
+static k_ticks_t period;
+static k_ticks_t slack;
+static unsigned int late_expiries;
+
+static void expiry_fn(struct k_timer *timer)
+{
+	struct bench_timer *bt = CONTAINER_OF(timer, struct bench_timer, timer);
+	k_ticks_t late = k_uptime_ticks() - bt->nominal;
+
+	/* Allow one tick for the start of the timer straddling a tick */
+	if ((late < 0) || (late > slack + 1)) {
+		late_expiries++;
+	}
+
+	bt->nominal += period;
+}
+
+/* Run all timers for the configured duration, and return the slack
+ * statistics accumulated during the run.
+ */
+static void run(k_ticks_t timer_slack, struct k_timer_slack_stats *stats)
+{
+	struct k_timer_slack_stats before;
+	k_ticks_t phase;
+	k_ticks_t now;
+
+	slack = timer_slack;
+
+	k_timer_slack_stats_get(&before);
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_TIMERS; i++) {
+		phase = period + (period * i) / CONFIG_BENCHMARK_NUM_TIMERS;
+		now = k_uptime_ticks();
+		timers[i].nominal = now + phase;
+
+		if (timer_slack > 0) {
+			k_timer_start_slack(&timers[i].timer, K_TICKS(phase), K_TICKS(period),
+					    K_TICKS(timer_slack));
+		} else {
+			k_timer_start(&timers[i].timer, K_TICKS(phase), K_TICKS(period));
+		}
+	}
+
+	k_msleep(CONFIG_BENCHMARK_DURATION_MS);
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_TIMERS; i++) {
+		k_timer_stop(&timers[i].timer);
+	}
+
+	k_timer_slack_stats_get(stats);
+	stats->expired -= before.expired;
+	stats->expiry_ticks -= before.expiry_ticks;
+	stats->deferred -= before.deferred;
+}
+
+static void report(const char *metric, const char *description, uint64_t count)
+{
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s - %s : %7llu :\n", metric, description, count);
+#else
+	printk("%-60s : %7llu\n", description, count);
+#endif
+}
+
+int main(void)
+{
+	struct k_timer_slack_stats stats;
+
+	period = k_ms_to_ticks_ceil32(CONFIG_BENCHMARK_PERIOD_MS);
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_TIMERS; i++) {
+		k_timer_init(&timers[i].timer, expiry_fn, NULL);
+	}
+
+	printk("Timer slack with %u timers of period %u ms during %u ms\n",
+	       CONFIG_BENCHMARK_NUM_TIMERS, CONFIG_BENCHMARK_PERIOD_MS,
+	       CONFIG_BENCHMARK_DURATION_MS);
+
+	run(0, &stats);
+	report("timer.no_slack.expired", "Timer expiries without slack", stats.expired);
+	report("timer.no_slack.ticks", "Ticks with expiries without slack", stats.expiry_ticks);
+
+	run(MAX(1, period * CONFIG_BENCHMARK_SLACK_PERCENT / 100), &stats);
+	report("timer.slack.expired", "Timer expiries with slack", stats.expired);
+	report("timer.slack.ticks", "Ticks with expiries with slack", stats.expiry_ticks);
+	report("timer.slack.deferred", "Expiries deferred by slack", stats.deferred);
+
+	if (late_expiries != 0U) {
+		printk("%u expiries came later than their slack allows\n", late_expiries);
+	}
+
+	TC_END_REPORT((late_expiries != 0U) ? TC_FAIL : TC_PASS);
+
+	return 0;
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a throughput benchmark of work queues. Rounds of short
+ * work items are submitted, either one at a time or as a batch, to a queue
+ * served by one or more threads, and the queue is drained after each round.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+BUILD_ASSERT((CONFIG_BENCHMARK_NUM_WORKERS == 1) || IS_ENABLED(CONFIG_WORKQUEUE_WORKERS),
+	     "Several workers require CONFIG_WORKQUEUE_WORKERS");
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, CONFIG_BENCHMARK_NUM_WORKERS, STACK_SIZE);
+#if CONFIG_BENCHMARK_NUM_WORKERS > 1
+static struct k_thread workers[CONFIG_BENCHMARK_NUM_WORKERS];
+#endif
+
+static struct k_work_q queue;
+static struct k_work items[CONFIG_BENCHMARK_NUM_ITEMS];
+static struct k_work *batch[CONFIG_BENCHMARK_NUM_ITEMS];
+
+static atomic_t completed;
+
+static void work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	for (volatile unsigned int i = 0; i < CONFIG_BENCHMARK_WORK_LOOPS; i++) {
+	}
+
+	atomic_inc(&completed);
+}
+
+static void start_queue(void)
+{
+	struct k_work_queue_config cfg = {
+		.name = "bench_workq",
+		.no_yield = true,
+#if CONFIG_BENCHMARK_NUM_WORKERS > 1
+		.pin_workers = true,
+#endif
+	};
+
+	k_work_queue_init(&queue);
+
+#if CONFIG_BENCHMARK_NUM_WORKERS > 1
+	k_work_queue_start_workers(&queue, workers, stacks[0], STACK_SIZE,
+				   CONFIG_BENCHMARK_NUM_WORKERS, K_PRIO_PREEMPT(10), &cfg);
+#else
+	k_work_queue_start(&queue, stacks[0], K_THREAD_STACK_SIZEOF(stacks[0]),
+			   K_PRIO_PREEMPT(10), &cfg);
+#endif
+}
+
+/* Run all rounds, returning the total time spent submitting items and
+ * the total time taken by the rounds.
+ */
+static void run_rounds(bool use_batch, uint64_t *submit_cycles, uint64_t *round_cycles)
+{
+	timing_t start;
+	timing_t submitted;
+	timing_t finish;
+
+	*submit_cycles = 0;
+	*round_cycles = 0;
+
+	for (unsigned int round = 0; round < CONFIG_BENCHMARK_NUM_ROUNDS; round++) {
+		start = timing_counter_get();
+		if (use_batch) {
+			(void)k_work_submit_batch(&queue, batch, CONFIG_BENCHMARK_NUM_ITEMS);
+		} else {
+			for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITEMS; i++) {
+				(void)k_work_submit_to_queue(&queue, &items[i]);
+			}
+		}
+		submitted = timing_counter_get();
+		(void)k_work_queue_drain(&queue, false);
+		finish = timing_counter_get();
+
+		*submit_cycles += timing_cycles_get(&start, &submitted);
+		*round_cycles += timing_cycles_get(&start, &finish);
+	}
+}
+
+static void report(const char *metric, const char *description, uint64_t cycles)
+{
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s - %s : %7llu cycles , %7u ns :\n", metric, description,
+	       cycles, (uint32_t)timing_cycles_to_ns(cycles));
+#else
+	printk("%-60s : %7llu cycles (%7u nsec)\n", description,
+	       cycles, (uint32_t)timing_cycles_to_ns(cycles));
+#endif
+}
+
+int main(void)
+{
+	const uint64_t total_items = (uint64_t)CONFIG_BENCHMARK_NUM_ROUNDS *
+				     CONFIG_BENCHMARK_NUM_ITEMS;
+	uint64_t submit_cycles;
+	uint64_t round_cycles;
+	bool failed = false;
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITEMS; i++) {
+		k_work_init(&items[i], work_handler);
+		batch[i] = &items[i];
+	}
+
+	timing_init();
+
+	printk("Time Measurements for work queue with %u worker(s) on %u CPUs\n",
+	       CONFIG_BENCHMARK_NUM_WORKERS, arch_num_cpus());
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	start_queue();
+
+	timing_start();
+
+	run_rounds(false, &submit_cycles, &round_cycles);
+	failed |= (atomic_get(&completed) != total_items);
+	report("workq.submit.avg", "Average k_work_submit_to_queue() per item",
+	       submit_cycles / total_items);
+	report("workq.submit.round", "Average round with single submissions",
+	       round_cycles / CONFIG_BENCHMARK_NUM_ROUNDS);
+
+	atomic_clear(&completed);
+
+	run_rounds(true, &submit_cycles, &round_cycles);
+	failed |= (atomic_get(&completed) != total_items);
+	report("workq.submit_batch.avg", "Average k_work_submit_batch() per item",
+	       submit_cycles / total_items);
+	report("workq.submit_batch.round", "Average round with batch submissions",
+	       round_cycles / CONFIG_BENCHMARK_NUM_ROUNDS);
+
+	timing_stop();
+
+	if (failed) {
+		printk("Work items were lost\n");
+	}
+
+	TC_END_REPORT(failed ? TC_FAIL : TC_PASS);
+
+	return 0;
+}
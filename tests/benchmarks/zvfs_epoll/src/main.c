@@ -0,0 +1,178 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a benchmark of the readiness wait APIs. One end of a
+ * socket pair is made readable, waited for among idle UDP sockets with
+ * zvfs_poll() or with zvfs_epoll_wait(), and read, and the time taken by a
+ * round is measured for an increasing number of idle sockets.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/zvfs/epoll.h>
+
+#define MAX_FDS (CONFIG_BENCHMARK_IDLE_SOCKETS + 1)
+
+static int idle_socks[CONFIG_BENCHMARK_IDLE_SOCKETS];
+static struct zsock_pollfd pfds[MAX_FDS];
+static int sv[2];
+static unsigned int errors;
+
+static void report(const char *name, int idle, uint64_t ns)
+{
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: zvfs.%s.%d - %s with %d idle sockets : %llu ns :\n", name, idle, name, idle,
+	       ns);
+#else
+	printk("%-12s %4d idle sockets : %6llu ns\n", name, idle, ns);
+#endif
+}
+
+static void wake(void)
+{
+	char c = 0;
+
+	if (zsock_send(sv[0], &c, sizeof(c), 0) != sizeof(c)) {
+		errors++;
+	}
+}
+
+static void consume(void)
+{
+	char c;
+
+	if (zsock_recv(sv[1], &c, sizeof(c), 0) != sizeof(c)) {
+		errors++;
+	}
+}
+
+static uint64_t measure_poll(int idle)
+{
+	uint32_t start;
+	uint32_t cycles;
+	int nfds = idle + 1;
+
+	pfds[0].fd = sv[1];
+
+	for (int i = 0; i < idle; i++) {
+		pfds[i + 1].fd = idle_socks[i];
+	}
+
+	for (int i = 0; i < nfds; i++) {
+		pfds[i].events = ZSOCK_POLLIN;
+	}
+
+	start = k_cycle_get_32();
+
+	for (int r = 0; r < CONFIG_BENCHMARK_ROUNDS; r++) {
+		wake();
+
+		if (zsock_poll(pfds, nfds, 1000) != 1 || pfds[0].revents != ZSOCK_POLLIN) {
+			errors++;
+		}
+
+		consume();
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	return k_cyc_to_ns_floor64(cycles) / CONFIG_BENCHMARK_ROUNDS;
+}
+
+static int epoll_add(int epfd, int fd)
+{
+	struct zvfs_epoll_event event = {
+		.events = ZVFS_EPOLLIN,
+		.data.fd = fd,
+	};
+
+	return zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_ADD, fd, &event);
+}
+
+static uint64_t measure_epoll(int idle)
+{
+	struct zvfs_epoll_event events[4];
+	uint32_t start;
+	uint32_t cycles;
+	int epfd;
+
+	epfd = zvfs_epoll_create(0);
+	if (epfd < 0) {
+		printk("Cannot create epoll instance (%d)\n", errno);
+		errors++;
+		return 0;
+	}
+
+	if (epoll_add(epfd, sv[1]) < 0) {
+		errors++;
+	}
+
+	for (int i = 0; i < idle; i++) {
+		if (epoll_add(epfd, idle_socks[i]) < 0) {
+			printk("Cannot add socket %d (%d)\n", idle_socks[i], errno);
+			errors++;
+		}
+	}
+
+	start = k_cycle_get_32();
+
+	for (int r = 0; r < CONFIG_BENCHMARK_ROUNDS; r++) {
+		wake();
+
+		if (zvfs_epoll_wait(epfd, events, ARRAY_SIZE(events), 1000) != 1 ||
+		    events[0].data.fd != sv[1] || events[0].events != ZVFS_EPOLLIN) {
+			errors++;
+		}
+
+		consume();
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	(void)zsock_close(epfd);
+
+	return k_cyc_to_ns_floor64(cycles) / CONFIG_BENCHMARK_ROUNDS;
+}
+
+int main(void)
+{
+	int ret = 0;
+
+	printk("Wake ups of one socket among idle ones, %d rounds\n", CONFIG_BENCHMARK_ROUNDS);
+
+	if (zsock_socketpair(NET_AF_UNIX, NET_SOCK_STREAM, 0, sv) < 0) {
+		printk("Cannot create socket pair (%d)\n", errno);
+		ret = -errno;
+		goto out;
+	}
+
+	for (int i = 0; i < CONFIG_BENCHMARK_IDLE_SOCKETS; i++) {
+		idle_socks[i] = zsock_socket(NET_AF_INET, NET_SOCK_DGRAM, NET_IPPROTO_UDP);
+		if (idle_socks[i] < 0) {
+			printk("Cannot create socket %d (%d)\n", i, errno);
+			ret = -errno;
+			goto out;
+		}
+	}
+
+	for (int idle = 4; idle <= CONFIG_BENCHMARK_IDLE_SOCKETS; idle *= 2) {
+		report("poll", idle, measure_poll(idle));
+		report("epoll", idle, measure_epoll(idle));
+	}
+
+	if (errors != 0U) {
+		printk("%u wake ups were not reported correctly\n", errors);
+		ret = -EINVAL;
+	}
+
+out:
+	TC_END_REPORT((ret != 0) ? TC_FAIL : TC_PASS);
+
+	return 0;
+}
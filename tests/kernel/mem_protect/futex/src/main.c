@@ -36,6 +36,7 @@ K_THREAD_STACK_ARRAY_DEFINE(multiple_wake_stack,
 ZTEST_BMEM int woken;
 ZTEST_BMEM int timeout;
 ZTEST_BMEM int index[TOTAL_THREADS_WAITING];
+ZTEST_BMEM atomic_t requeue_woken;
 ZTEST_BMEM struct k_futex simple_futex;
 ZTEST_BMEM struct k_futex multiple_futex[TOTAL_THREADS_WAITING];
 struct k_futex no_access_futex;
@@ -160,6 +161,17 @@ static void futex_multiple_wait_wake_task(void *p1, void *p2, void *p3)
 	atomic_sub(&(multiple_futex[idx].val), 1);
 }
 
+static void futex_requeue_wait_task(void *p1, void *p2, void *p3)
+{
+	int32_t ret_value;
+
+	ret_value = k_futex_wait(&multiple_futex[0], 0, K_FOREVER);
+	zassert_true(ret_value == 0,
+	     "k_futex_wait failed when it shouldn't have");
+
+	atomic_inc(&requeue_woken);
+}
+
 /**
  * @ingroup kernel_futex_tests
  * @{
@@ -420,6 +432,54 @@ ZTEST(futex, test_multiple_futex_wait_wake)
 	}
 }
 
+/**
+ * @brief Test k_futex_requeue() wakes one waiter and moves the rest
+ */
+ZTEST(futex, test_futex_requeue)
+{
+	int ret;
+
+	atomic_clear(&requeue_woken);
+	atomic_clear(&multiple_futex[0].val);
+	atomic_clear(&multiple_futex[1].val);
+
+	for (int i = 0; i < TOTAL_THREADS_WAITING; i++) {
+		k_thread_create(&multiple_tid[i], multiple_stack[i],
+				STACK_SIZE, futex_requeue_wait_task,
+				NULL, NULL, NULL, PRIO_WAIT,
+				K_USER | K_INHERIT_PERMS, K_NO_WAIT);
+	}
+
+	/* giving time for the other threads to execute */
+	k_yield();
+
+	ret = k_futex_requeue(&multiple_futex[0], 1, &multiple_futex[1]);
+	zassert_equal(ret, -EAGAIN, "requeued when values did not match");
+
+	ret = k_futex_requeue(&multiple_futex[0], 0, &multiple_futex[1]);
+	zassert_equal(ret, TOTAL_THREADS_WAITING,
+		      "requeue didn't account for every waiter");
+
+	k_yield();
+	zassert_equal(atomic_get(&requeue_woken), 1,
+		      "requeue should wake exactly one waiter");
+
+	/* The remaining waiters now sleep on the target futex */
+	ret = k_futex_wake(&multiple_futex[0], true);
+	zassert_equal(ret, 0, "waiters left behind on the source futex");
+	ret = k_futex_wake(&multiple_futex[1], true);
+	zassert_equal(ret, TOTAL_THREADS_WAITING - 1,
+		      "requeued waiters not found on the target futex");
+
+	k_yield();
+	zassert_equal(atomic_get(&requeue_woken), TOTAL_THREADS_WAITING,
+		      "requeued waiters were not woken");
+
+	for (int i = 0; i < TOTAL_THREADS_WAITING; i++) {
+		k_thread_abort(&multiple_tid[i]);
+	}
+}
+
 ZTEST_USER(futex, test_user_futex_bad)
 {
 	int ret;
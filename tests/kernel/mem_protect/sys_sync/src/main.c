@@ -0,0 +1,304 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/mutex.h>
+#include <zephyr/sys/condvar.h>
+#include <zephyr/sys/rwlock.h>
+#include <zephyr/sys/once.h>
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define TOTAL_THREADS (3)
+#define SHORT_TIMEOUT K_MSEC(50)
+#define SETTLE_TIME K_MSEC(20)
+
+ZTEST_BMEM SYS_MUTEX_DEFINE(mutex);
+ZTEST_BMEM SYS_CONDVAR_DEFINE(condvar);
+ZTEST_BMEM SYS_RWLOCK_DEFINE(rwlock);
+ZTEST_BMEM SYS_ONCE_DEFINE(once);
+
+ZTEST_BMEM int ready;
+ZTEST_BMEM atomic_t done;
+ZTEST_BMEM atomic_t once_runs;
+
+K_THREAD_STACK_ARRAY_DEFINE(stacks, TOTAL_THREADS, STACK_SIZE);
+struct k_thread threads[TOTAL_THREADS];
+
+#ifdef CONFIG_USERSPACE
+#define THREAD_FLAGS (K_USER | K_INHERIT_PERMS)
+#else
+#define THREAD_FLAGS 0
+#endif
+
+static void spawn(int i, k_thread_entry_t entry)
+{
+	k_thread_create(&threads[i], stacks[i], STACK_SIZE,
+			entry, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(0), THREAD_FLAGS, K_NO_WAIT);
+}
+
+static void join_all(int count)
+{
+	for (int i = 0; i < count; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+}
+
+static void reset(void)
+{
+	sys_mutex_init(&mutex);
+	sys_condvar_init(&condvar);
+	sys_rwlock_init(&rwlock);
+	ready = 0;
+	atomic_clear(&done);
+	atomic_clear(&once_runs);
+}
+
+/******************************************************************************/
+/* sys_mutex */
+
+/**
+ * @brief Test recursive locking and unlocking of a sys_mutex
+ */
+ZTEST_USER(sys_sync, test_mutex_recursive)
+{
+	reset();
+
+	zassert_ok(sys_mutex_lock(&mutex, K_NO_WAIT));
+	zassert_ok(sys_mutex_lock(&mutex, K_NO_WAIT));
+	zassert_ok(sys_mutex_unlock(&mutex));
+	zassert_ok(sys_mutex_unlock(&mutex));
+	zassert_equal(sys_mutex_unlock(&mutex), -EINVAL,
+		      "unlocking an unlocked mutex should fail");
+}
+
+static void mutex_not_owner_helper(void *p1, void *p2, void *p3)
+{
+	zassert_equal(sys_mutex_unlock(&mutex), -EPERM);
+	zassert_equal(sys_mutex_lock(&mutex, K_NO_WAIT), -EBUSY);
+	zassert_equal(sys_mutex_lock(&mutex, SHORT_TIMEOUT), -EAGAIN);
+	atomic_inc(&done);
+}
+
+/**
+ * @brief Test that a sys_mutex held by another thread cannot be taken
+ */
+ZTEST_USER(sys_sync, test_mutex_not_owner)
+{
+	reset();
+
+	zassert_ok(sys_mutex_lock(&mutex, K_NO_WAIT));
+	spawn(0, mutex_not_owner_helper);
+	join_all(1);
+	zassert_ok(sys_mutex_unlock(&mutex));
+	zassert_equal(atomic_get(&done), 1);
+}
+
+static void mutex_contended_helper(void *p1, void *p2, void *p3)
+{
+	zassert_ok(sys_mutex_lock(&mutex, K_FOREVER));
+	atomic_inc(&done);
+	zassert_ok(sys_mutex_unlock(&mutex));
+}
+
+/**
+ * @brief Test that waiters on a contended sys_mutex are all woken
+ */
+ZTEST_USER(sys_sync, test_mutex_contended)
+{
+	reset();
+
+	zassert_ok(sys_mutex_lock(&mutex, K_FOREVER));
+	for (int i = 0; i < TOTAL_THREADS; i++) {
+		spawn(i, mutex_contended_helper);
+	}
+
+	/* Let the helpers block on the mutex */
+	k_sleep(SETTLE_TIME);
+	zassert_equal(atomic_get(&done), 0, "helper got a held mutex");
+
+	zassert_ok(sys_mutex_unlock(&mutex));
+	join_all(TOTAL_THREADS);
+	zassert_equal(atomic_get(&done), TOTAL_THREADS);
+}
+
+/******************************************************************************/
+/* sys_condvar */
+
+static void condvar_wait_helper(void *p1, void *p2, void *p3)
+{
+	zassert_ok(sys_mutex_lock(&mutex, K_FOREVER));
+	while (ready == 0) {
+		zassert_ok(sys_condvar_wait(&condvar, &mutex, K_FOREVER));
+	}
+	atomic_inc(&done);
+	zassert_ok(sys_mutex_unlock(&mutex));
+}
+
+/**
+ * @brief Test that sys_condvar_signal() wakes a waiter
+ */
+ZTEST_USER(sys_sync, test_condvar_signal)
+{
+	reset();
+
+	spawn(0, condvar_wait_helper);
+	k_sleep(SETTLE_TIME);
+	zassert_equal(atomic_get(&done), 0);
+
+	zassert_ok(sys_mutex_lock(&mutex, K_FOREVER));
+	ready = 1;
+	zassert_ok(sys_condvar_signal(&condvar));
+	zassert_ok(sys_mutex_unlock(&mutex));
+
+	join_all(1);
+	zassert_equal(atomic_get(&done), 1);
+}
+
+/**
+ * @brief Test that sys_condvar_broadcast() wakes every waiter
+ */
+ZTEST_USER(sys_sync, test_condvar_broadcast)
+{
+	reset();
+
+	for (int i = 0; i < TOTAL_THREADS; i++) {
+		spawn(i, condvar_wait_helper);
+	}
+	k_sleep(SETTLE_TIME);
+	zassert_equal(atomic_get(&done), 0);
+
+	zassert_ok(sys_mutex_lock(&mutex, K_FOREVER));
+	ready = 1;
+	zassert_ok(sys_condvar_broadcast(&condvar));
+	zassert_ok(sys_mutex_unlock(&mutex));
+
+	join_all(TOTAL_THREADS);
+	zassert_equal(atomic_get(&done), TOTAL_THREADS);
+}
+
+/**
+ * @brief Test that sys_condvar_wait() times out and reacquires the mutex
+ */
+ZTEST_USER(sys_sync, test_condvar_timeout)
+{
+	reset();
+
+	zassert_ok(sys_mutex_lock(&mutex, K_FOREVER));
+	zassert_equal(sys_condvar_wait(&condvar, &mutex, SHORT_TIMEOUT),
+		      -EAGAIN);
+	/* The mutex is held again after the wait returns */
+	zassert_ok(sys_mutex_unlock(&mutex));
+	zassert_equal(sys_mutex_unlock(&mutex), -EINVAL);
+}
+
+/******************************************************************************/
+/* sys_rwlock */
+
+static void rwlock_not_owner_helper(void *p1, void *p2, void *p3)
+{
+	zassert_equal(sys_rwlock_unlock(&rwlock), -EPERM);
+	atomic_inc(&done);
+}
+
+/**
+ * @brief Test sys_rwlock reader sharing and writer exclusion
+ */
+ZTEST_USER(sys_sync, test_rwlock_basic)
+{
+	reset();
+
+	zassert_ok(sys_rwlock_rdlock(&rwlock, K_NO_WAIT));
+	zassert_ok(sys_rwlock_rdlock(&rwlock, K_NO_WAIT));
+	zassert_equal(sys_rwlock_wrlock(&rwlock, K_NO_WAIT), -EBUSY);
+	zassert_equal(sys_rwlock_wrlock(&rwlock, SHORT_TIMEOUT), -EAGAIN);
+	zassert_ok(sys_rwlock_unlock(&rwlock));
+	zassert_ok(sys_rwlock_unlock(&rwlock));
+
+	zassert_ok(sys_rwlock_wrlock(&rwlock, K_NO_WAIT));
+	zassert_equal(sys_rwlock_rdlock(&rwlock, K_NO_WAIT), -EBUSY);
+	zassert_equal(sys_rwlock_wrlock(&rwlock, K_NO_WAIT), -EBUSY);
+
+	spawn(0, rwlock_not_owner_helper);
+	join_all(1);
+	zassert_equal(atomic_get(&done), 1);
+
+	zassert_ok(sys_rwlock_unlock(&rwlock));
+	zassert_equal(sys_rwlock_unlock(&rwlock), -EINVAL);
+}
+
+static void rwlock_writer_helper(void *p1, void *p2, void *p3)
+{
+	zassert_ok(sys_rwlock_wrlock(&rwlock, K_FOREVER));
+	atomic_inc(&done);
+	zassert_ok(sys_rwlock_unlock(&rwlock));
+}
+
+/**
+ * @brief Test that a blocked writer runs once the last reader leaves
+ */
+ZTEST_USER(sys_sync, test_rwlock_writer_waits)
+{
+	reset();
+
+	zassert_ok(sys_rwlock_rdlock(&rwlock, K_FOREVER));
+	spawn(0, rwlock_writer_helper);
+	k_sleep(SETTLE_TIME);
+	zassert_equal(atomic_get(&done), 0, "writer got a read-held lock");
+
+	zassert_ok(sys_rwlock_unlock(&rwlock));
+	join_all(1);
+	zassert_equal(atomic_get(&done), 1);
+}
+
+/******************************************************************************/
+/* sys_once */
+
+static void once_init(void)
+{
+	atomic_inc(&once_runs);
+	/* Give the other callers a chance to race us */
+	k_sleep(SETTLE_TIME);
+}
+
+static void once_helper(void *p1, void *p2, void *p3)
+{
+	zassert_ok(sys_once(&once, once_init));
+	zassert_equal(atomic_get(&once_runs), 1,
+		      "sys_once returned before the init function finished");
+	atomic_inc(&done);
+}
+
+/**
+ * @brief Test that sys_once() runs its function exactly once
+ */
+ZTEST_USER(sys_sync, test_once)
+{
+	reset();
+
+	for (int i = 0; i < TOTAL_THREADS; i++) {
+		spawn(i, once_helper);
+	}
+	join_all(TOTAL_THREADS);
+	zassert_equal(atomic_get(&done), TOTAL_THREADS);
+
+	zassert_ok(sys_once(&once, once_init));
+	zassert_equal(atomic_get(&once_runs), 1);
+}
+
+void *sys_sync_setup(void)
+{
+#ifdef CONFIG_USERSPACE
+	for (int i = 0; i < TOTAL_THREADS; i++) {
+		k_thread_access_grant(k_current_get(),
+				      &threads[i], &stacks[i]);
+	}
+#endif
+
+	return NULL;
+}
+
+ZTEST_SUITE(sys_sync, NULL, sys_sync_setup, NULL, NULL, NULL);
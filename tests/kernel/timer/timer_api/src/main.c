@@ -925,6 +925,167 @@ ZTEST_USER(timer_api, test_sleep_abs)
 
 }
 
+#ifdef CONFIG_TIMER_SLACK
+static struct k_timer slack_timer;
+
+/**
+ * @brief Test timer expiry with slack
+ *
+ * Starts a periodic timer with k_timer_start_slack() and checks that
+ * each expiry happens no earlier than its nominal tick and no later
+ * than the slack allows, and that deferrals do not accumulate over
+ * periods. Also checks that the expiries show up in the statistics
+ * returned by k_timer_slack_stats_get().
+ *
+ * @ingroup kernel_timer_tests
+ *
+ * @see k_timer_start_slack(), k_timer_slack_stats_get()
+ */
+ZTEST(timer_api, test_timer_slack)
+{
+	k_ticks_t period = k_ms_to_ticks_ceil32(PERIOD);
+	k_ticks_t slack = period / 2;
+	struct k_timer_slack_stats before, after;
+	k_ticks_t start, now, nominal;
+
+	tick_sync();
+	k_timer_slack_stats_get(&before);
+
+	start = k_uptime_ticks();
+	k_timer_start_slack(&slack_timer, K_TICKS(period), K_TICKS(period),
+			    K_TICKS(slack));
+
+	for (int i = 1; i <= EXPIRE_TIMES; i++) {
+		zassert_equal(k_timer_status_sync(&slack_timer), 1);
+		now = k_uptime_ticks();
+		nominal = start + i * period;
+
+		/** TESTPOINT: expiry within [nominal, nominal + slack] */
+		zassert_true(now >= nominal && now <= nominal + slack + 1,
+			     "expiry %d at %lld, expected within [%lld, %lld]",
+			     i, now, nominal, nominal + slack + 1);
+	}
+
+	k_timer_stop(&slack_timer);
+	k_timer_slack_stats_get(&after);
+
+	/** TESTPOINT: expiries accounted in the statistics */
+	zassert_true(after.expired - before.expired >= EXPIRE_TIMES);
+}
+
+/**
+ * @brief Test periodic timer with slack and an absolute start
+ *
+ * Starts a periodic timer with slack at an absolute tick and checks
+ * that it keeps a regular stride over many periods, expiring exactly
+ * once per period.
+ *
+ * @ingroup kernel_timer_tests
+ *
+ * @see k_timer_start_slack()
+ */
+ZTEST(timer_api, test_timer_slack_periodic_abs)
+{
+	k_ticks_t period = k_ms_to_ticks_ceil32(PERIOD);
+	k_ticks_t slack = period / 2;
+	k_ticks_t start, now, nominal;
+
+	tick_sync();
+
+	start = k_uptime_ticks();
+	k_timer_start_slack(&slack_timer, K_TIMEOUT_ABS_TICKS(start + period),
+			    K_TICKS(period), K_TICKS(slack));
+
+	for (int i = 1; i <= 2 * EXPIRE_TIMES; i++) {
+		/** TESTPOINT: a single expiry per period */
+		zassert_equal(k_timer_status_sync(&slack_timer), 1,
+			      "more than one expiry in period %d", i);
+		now = k_uptime_ticks();
+		nominal = start + i * period;
+
+		/** TESTPOINT: expiry within [nominal, nominal + slack] */
+		zassert_true(now >= nominal && now <= nominal + slack + 1,
+			     "expiry %d at %lld, expected within [%lld, %lld]",
+			     i, now, nominal, nominal + slack + 1);
+	}
+
+	k_timer_stop(&slack_timer);
+}
+
+static struct k_timer slack_timers[2];
+static k_ticks_t slack_expiry[2];
+
+static void slack_expire(struct k_timer *timer)
+{
+	/* While timeouts are announced, the uptime is their expiry tick */
+	slack_expiry[timer - slack_timers] = k_uptime_ticks();
+}
+
+/**
+ * @brief Test timers with overlapping slack windows expiring together
+ *
+ * Starts two timers with absolute expiries whose slack windows,
+ * [base + 1, base + 9] and [base + 5, base + 12] for a base aligned on 64
+ * ticks, share base + 8 as their most aligned tick. Checks that both are
+ * deferred to that tick, and that the statistics count exactly these two
+ * deferrals and at least one saved wakeup.
+ *
+ * @ingroup kernel_timer_tests
+ *
+ * @see k_timer_start_slack(), k_timer_slack_stats_get()
+ */
+ZTEST(timer_api, test_timer_slack_coalesce)
+{
+	static const struct {
+		k_ticks_t offset;
+		k_ticks_t slack;
+	} windows[] = {
+		{ 1, 8 },
+		{ 5, 7 },
+	};
+	struct k_timer_slack_stats before, after;
+	k_ticks_t base;
+
+	tick_sync();
+
+	/* Far enough for both timers to be started before the window */
+	base = ROUND_UP(k_uptime_ticks() + k_ms_to_ticks_ceil64(100), 64);
+
+	k_timer_slack_stats_get(&before);
+
+	for (int i = 0; i < ARRAY_SIZE(slack_timers); i++) {
+		slack_expiry[i] = 0;
+		k_timer_start_slack(&slack_timers[i],
+				    K_TIMEOUT_ABS_TICKS(base + windows[i].offset),
+				    K_NO_WAIT, K_TICKS(windows[i].slack));
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(slack_timers); i++) {
+		zassert_equal(k_timer_status_sync(&slack_timers[i]), 1);
+	}
+
+	k_timer_slack_stats_get(&after);
+
+	for (int i = 0; i < ARRAY_SIZE(slack_timers); i++) {
+		k_ticks_t start = base + windows[i].offset;
+
+		/** TESTPOINT: expiry within the slack window, on the shared tick */
+		zassert_true(slack_expiry[i] >= start &&
+			     slack_expiry[i] <= start + windows[i].slack,
+			     "expiry %d at %lld, expected within [%lld, %lld]", i,
+			     slack_expiry[i], start, start + windows[i].slack);
+		zassert_equal(slack_expiry[i], base + 8, "expiry %d at %lld, expected %lld",
+			      i, slack_expiry[i], base + 8);
+	}
+
+	/** TESTPOINT: both expiries deferred, and expiring together */
+	zassert_equal(after.deferred - before.deferred, ARRAY_SIZE(slack_timers));
+	zassert_true((after.expired - after.expiry_ticks) -
+		     (before.expired - before.expiry_ticks) >= 1,
+		     "expiries on the same tick not coalesced");
+}
+#endif /* CONFIG_TIMER_SLACK */
+
 static void timer_init(struct k_timer *timer, k_timer_expiry_t expiry_fn,
 		       k_timer_stop_t stop_fn)
 {
@@ -946,6 +1107,11 @@ void *setup_timer_api(void)
 	timer_init(&status_anytime_timer, NULL, NULL);
 	timer_init(&status_sync_timer, duration_expire, duration_stop);
 	timer_init(&remain_timer, duration_expire, duration_stop);
+#ifdef CONFIG_TIMER_SLACK
+	timer_init(&slack_timer, NULL, NULL);
+	timer_init(&slack_timers[0], slack_expire, NULL);
+	timer_init(&slack_timers[1], slack_expire, NULL);
+#endif
 
 	if (IS_ENABLED(CONFIG_MULTITHREADING)) {
 		k_thread_access_grant(k_current_get(), &ktimer, &timer0, &timer1,
@@ -1457,6 +1457,106 @@ ZTEST(work_1cpu, test_1cpu_system_reschedule)
 		     "long %u > %u\n", elapsed_ms, max_ms);
 }
 
+/* Check that a batch is queued in order and reports items already queued. */
+ZTEST(work_1cpu, test_1cpu_submit_batch)
+{
+	struct k_work *works[] = { &common_work, &common_work1 };
+	int rc;
+
+	/* Reset state and use non-blocking handler */
+	reset_counters();
+	k_work_init(&common_work, counter_handler);
+	k_work_init(&common_work1, counter_handler);
+
+	/* Items that never ran have no queue to fall back on */
+	rc = k_work_submit_batch(NULL, works, ARRAY_SIZE(works));
+	zassert_equal(rc, -EINVAL);
+
+	rc = k_work_submit_batch(&preempt_queue, works, ARRAY_SIZE(works));
+	zassert_equal(rc, 2);
+	zassert_equal(k_work_busy_get(&common_work), K_WORK_QUEUED);
+	zassert_equal(k_work_busy_get(&common_work1), K_WORK_QUEUED);
+
+	/* Nothing new to queue */
+	rc = k_work_submit_batch(&preempt_queue, works, ARRAY_SIZE(works));
+	zassert_equal(rc, 0);
+
+	zassert_true(k_work_flush(&common_work1, &work_sync));
+	zassert_equal(preempt_counter(), 2);
+	zassert_equal(k_work_busy_get(&common_work), 0);
+	rc = k_sem_take(&sync_sem, K_NO_WAIT);
+	zassert_equal(rc, 0);
+}
+
+#ifdef CONFIG_WORKQUEUE_WORKERS
+static K_THREAD_STACK_ARRAY_DEFINE(workers_stacks, 2, STACK_SIZE);
+static struct k_thread workers_threads[2];
+static struct k_work_q workers_queue;
+
+/* Check that the workers of a queue run distinct items concurrently, but
+ * never run the same item twice at once.
+ */
+ZTEST(work_1cpu, test_1cpu_workers)
+{
+	struct k_work_queue_config cfg = {
+		.name = "wq.workers",
+	};
+	int rc;
+
+	k_work_queue_init(&workers_queue);
+	k_work_queue_start_workers(&workers_queue, workers_threads, workers_stacks[0],
+				   STACK_SIZE, ARRAY_SIZE(workers_threads),
+				   PREEMPT_PRIORITY, &cfg);
+	zassert_equal(workers_queue.flags, K_WORK_QUEUE_STARTED);
+
+	/* Reset state and use the blocking handler */
+	reset_counters();
+	k_work_init(&common_work, rel_handler);
+	k_work_init(&common_work1, rel_handler);
+
+	rc = k_work_submit_to_queue(&workers_queue, &common_work);
+	zassert_equal(rc, 1);
+	rc = k_work_submit_to_queue(&workers_queue, &common_work1);
+	zassert_equal(rc, 1);
+
+	/* Let both workers pick an item and block in it. */
+	k_sleep(K_TICKS(1));
+	zassert_equal(k_work_busy_get(&common_work), K_WORK_RUNNING);
+	zassert_equal(k_work_busy_get(&common_work1), K_WORK_RUNNING);
+
+	/* Resubmission of a running item is held back. */
+	rc = k_work_submit_to_queue(&workers_queue, &common_work);
+	zassert_equal(rc, 2);
+	zassert_equal(k_work_busy_get(&common_work), K_WORK_RUNNING | K_WORK_QUEUED);
+
+	/* The first release completes the first instance of common_work,
+	 * which is then started again by the same worker.
+	 */
+	handler_release();
+	k_sleep(K_TICKS(1));
+	zassert_equal(k_work_busy_get(&common_work), K_WORK_RUNNING);
+	zassert_equal(k_work_busy_get(&common_work1), K_WORK_RUNNING);
+
+	handler_release();
+	k_sleep(K_TICKS(1));
+	zassert_equal(k_work_busy_get(&common_work1), 0);
+
+	/* Flushing waits for the running instance only. */
+	async_release();
+	zassert_true(k_work_flush(&common_work, &work_sync));
+	zassert_equal(k_work_busy_get(&common_work), 0);
+	rc = k_sem_take(&sync_sem, K_NO_WAIT);
+	zassert_equal(rc, 0);
+
+	/* All workers exit when the queue is stopped. */
+	rc = k_work_queue_drain(&workers_queue, true);
+	zassert_true(rc >= 0);
+	rc = k_work_queue_stop(&workers_queue, K_FOREVER);
+	zassert_equal(rc, 0);
+	zassert_equal(workers_queue.flags, 0);
+}
+#endif /* CONFIG_WORKQUEUE_WORKERS */
+
 ZTEST(work, test_nop)
 {
 	ztest_test_skip();
@@ -0,0 +1,142 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/sys/heap_listener.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <stdlib.h>
+
+static size_t alloc_bytes;
+static size_t free_bytes;
+static unsigned int alloc_count;
+static unsigned int free_count;
+
+static void on_heap_alloc(uintptr_t heap_id, void *mem, size_t bytes)
+{
+	ARG_UNUSED(heap_id);
+	ARG_UNUSED(mem);
+
+	alloc_bytes += bytes;
+	alloc_count++;
+}
+
+static void on_heap_free(uintptr_t heap_id, void *mem, size_t bytes)
+{
+	ARG_UNUSED(heap_id);
+	ARG_UNUSED(mem);
+
+	free_bytes += bytes;
+	free_count++;
+}
+
+static HEAP_LISTENER_ALLOC_DEFINE(alloc_listener, HEAP_ID_LIBC, on_heap_alloc);
+static HEAP_LISTENER_FREE_DEFINE(free_listener, HEAP_ID_LIBC, on_heap_free);
+
+/* Sizes below, at and above the largest cached size, when caching is on */
+static const size_t sizes[] = { 1, 16, 24, 100, 256, 257, 300, 511, 1024 };
+
+static void *blocks[2 * ARRAY_SIZE(sizes) + 1];
+
+static void check_balanced(unsigned int expected_count)
+{
+	zassert_equal(alloc_count, expected_count, "%u allocations reported, expected %u",
+		      alloc_count, expected_count);
+	zassert_equal(free_count, expected_count, "%u frees reported, expected %u",
+		      free_count, expected_count);
+	zassert_equal(alloc_bytes, free_bytes, "%zu bytes allocated but %zu freed",
+		      alloc_bytes, free_bytes);
+}
+
+/**
+ * @brief Test that heap listeners see balanced allocations and frees
+ *
+ * Allocates blocks of sizes served and not served by the per-CPU caches,
+ * through malloc(), calloc() and aligned_alloc(), frees them in another
+ * order, and checks that as many bytes are reported freed as allocated.
+ */
+ZTEST(libc_heap_listener, test_alloc_free_balanced)
+{
+	unsigned int total = 0;
+
+	/* The second round is served from blocks cached in the first one */
+	for (int round = 0; round < 2; round++) {
+		int n = 0;
+
+		ARRAY_FOR_EACH(sizes, i) {
+			blocks[n++] = malloc(sizes[i]);
+			blocks[n++] = calloc(1, sizes[i]);
+		}
+		blocks[n++] = aligned_alloc(64, 32);
+
+		/* Free every other block from the last one, then the others */
+		for (int i = n - 1; i >= 0; i -= 2) {
+			zassert_not_null(blocks[i]);
+			free(blocks[i]);
+			blocks[i] = NULL;
+		}
+		for (int i = 0; i < n; i++) {
+			free(blocks[i]);
+			blocks[i] = NULL;
+		}
+
+		total += n;
+		check_balanced(total);
+	}
+}
+
+/**
+ * @brief Test that heap listeners see balanced reallocations
+ *
+ * Grows a block from a cached size to an uncached one and back, and
+ * frees it, checking that each realloc() is reported as the free of the
+ * old block and the allocation of the new one.
+ */
+ZTEST(libc_heap_listener, test_realloc_balanced)
+{
+	void *ptr = malloc(16);
+	unsigned int count = 1;
+
+	zassert_not_null(ptr);
+
+	ARRAY_FOR_EACH(sizes, i) {
+		ptr = realloc(ptr, sizes[i]);
+		zassert_not_null(ptr);
+		count++;
+	}
+	ptr = realloc(ptr, 8);
+	zassert_not_null(ptr);
+	count++;
+
+	zassert_equal(alloc_count - free_count, 1, "blocks outstanding not reported");
+
+	free(ptr);
+
+	check_balanced(count);
+}
+
+static void before(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	alloc_bytes = 0;
+	free_bytes = 0;
+	alloc_count = 0;
+	free_count = 0;
+
+	heap_listener_register(&alloc_listener);
+	heap_listener_register(&free_listener);
+}
+
+static void after(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	heap_listener_unregister(&alloc_listener);
+	heap_listener_unregister(&free_listener);
+}
+
+ZTEST_SUITE(libc_heap_listener, NULL, NULL, before, after, NULL);
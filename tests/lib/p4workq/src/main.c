@@ -13,7 +13,11 @@
 #define MAX_ITEMS (MAX_NUM_THREADS * 8)
 #define MAX_EVENTS 1024
 
+#ifdef CONFIG_P4WQ_WORK_STEALING
+K_P4WQ_DEFINE_WITH_FLAGS(wq, MAX_NUM_THREADS, 2048, K_P4WQ_WORK_STEALING);
+#else
 K_P4WQ_DEFINE(wq, MAX_NUM_THREADS, 2048);
+#endif
 
 static struct k_p4wq_work simple_item;
 static volatile int has_run;
@@ -126,9 +130,17 @@ static int active_count(void)
 	int count = 0;
 	sys_dnode_t *dummy;
 
+#ifdef CONFIG_P4WQ_WORK_STEALING
+	for (int i = 0; i < ARRAY_SIZE(wq.shards); i++) {
+		SYS_DLIST_FOR_EACH_NODE(&wq.shards[i].waitq.waitq, dummy) {
+			count++;
+		}
+	}
+#else
 	SYS_DLIST_FOR_EACH_NODE(&wq.waitq.waitq, dummy) {
 		count++;
 	}
+#endif
 
 	count = MAX_NUM_THREADS - count;
 	return count;
@@ -0,0 +1,478 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/types.h>
+#include <string.h>
+#include <zephyr/random/random.h>
+#include <zephyr/sys/byteorder.h>
+
+#include <zephyr/ztest.h>
+
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_pkt.h>
+
+#include "net_private.h"
+#include "tcp_internal.h"
+
+#define MY_PORT   4242
+#define PEER_PORT 4343
+#define PEER_ACK  0x10000
+#define PEER_WIN  8192
+#define SEG_LEN   200
+#define MSS       536
+
+#define IP_HDR_LEN  sizeof(struct net_ipv4_hdr)
+/* Every TCP segment carries a padded timestamp option */
+#define TCP_HDR_LEN (sizeof(struct tcphdr) + 12)
+#define HDR_LEN     (sizeof(struct net_eth_hdr) + IP_HDR_LEN + TCP_HDR_LEN)
+
+static struct net_in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct net_in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+static const uint8_t peer_mac[] = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x02 };
+
+static struct net_if *test_iface;
+static uint8_t test_data[2000];
+static uint8_t frame[HDR_LEN + sizeof(test_data)];
+
+static K_FIFO_DEFINE(rx_fifo);
+
+struct eth_context {
+	uint8_t mac_addr[6];
+};
+
+static struct eth_context eth_context;
+
+static void eth_iface_init(struct net_if *iface)
+{
+	const struct device *dev = net_if_get_device(iface);
+	struct eth_context *context = dev->data;
+
+	net_if_set_link_addr(iface, context->mac_addr, sizeof(context->mac_addr),
+			     NET_LINK_ETHERNET);
+
+	ethernet_init(iface);
+}
+
+static int eth_tx(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+/* No checksum offload, so that GRO verifies them and GSO computes them */
+static enum ethernet_hw_caps eth_get_capabilities(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return 0;
+}
+
+static struct ethernet_api api_funcs = {
+	.iface_api.init = eth_iface_init,
+	.get_capabilities = eth_get_capabilities,
+	.send = eth_tx,
+};
+
+static int eth_init(const struct device *dev)
+{
+	struct eth_context *context = dev->data;
+
+	/* 00-00-5E-00-53-xx Documentation RFC 7042 */
+	context->mac_addr[0] = 0x00;
+	context->mac_addr[1] = 0x00;
+	context->mac_addr[2] = 0x5E;
+	context->mac_addr[3] = 0x00;
+	context->mac_addr[4] = 0x53;
+	context->mac_addr[5] = 0x01;
+
+	return 0;
+}
+
+ETH_NET_DEVICE_INIT(eth_test, "eth_test", eth_init, NULL, &eth_context, NULL,
+		    CONFIG_ETH_INIT_PRIORITY, &api_funcs, NET_ETH_MTU);
+
+/* One's complement sum of data, folded to 16 bits */
+static uint16_t test_sum(uint32_t sum, const uint8_t *data, size_t len)
+{
+	for (size_t i = 0; i + 1 < len; i += 2) {
+		sum += sys_get_be16(&data[i]);
+	}
+
+	if ((len & 1U) != 0U) {
+		sum += data[len - 1] << 8;
+	}
+
+	while ((sum >> 16) != 0U) {
+		sum = (sum & 0xffff) + (sum >> 16);
+	}
+
+	return sum;
+}
+
+static uint16_t test_tcp_sum(const struct net_ipv4_hdr *ip, const uint8_t *tcp, size_t len)
+{
+	uint8_t pseudo[12];
+
+	memcpy(&pseudo[0], ip->src, NET_IPV4_ADDR_SIZE);
+	memcpy(&pseudo[4], ip->dst, NET_IPV4_ADDR_SIZE);
+	pseudo[8] = 0U;
+	pseudo[9] = NET_IPPROTO_TCP;
+	sys_put_be16(len, &pseudo[10]);
+
+	return test_sum(test_sum(0U, pseudo, sizeof(pseudo)), tcp, len);
+}
+
+struct test_seg {
+	uint32_t seq;
+	uint8_t flags;
+	uint32_t tsval;
+	size_t len;
+	bool bad_chksum;
+};
+
+/* Build an IPv4/TCP segment from the peer carrying test_data from offset,
+ * in frame, starting with the Ethernet header if eth is set.
+ */
+static size_t build_segment(const struct test_seg *s, size_t offset, bool eth,
+			    const struct net_in_addr *src, const struct net_in_addr *dst,
+			    size_t tcp_hdr_len)
+{
+	uint8_t *p = frame;
+	struct net_ipv4_hdr *ip;
+	struct tcphdr *th;
+	uint8_t *opt;
+	uint16_t sum;
+
+	if (eth) {
+		struct net_eth_hdr *eth_hdr = (struct net_eth_hdr *)p;
+
+		memcpy(eth_hdr->dst.addr, net_if_get_link_addr(test_iface)->addr,
+		       sizeof(eth_hdr->dst.addr));
+		memcpy(eth_hdr->src.addr, peer_mac, sizeof(eth_hdr->src.addr));
+		eth_hdr->type = net_htons(NET_ETH_PTYPE_IP);
+		p += sizeof(struct net_eth_hdr);
+	}
+
+	ip = (struct net_ipv4_hdr *)p;
+	memset(ip, 0, IP_HDR_LEN);
+	ip->vhl = 0x45;
+	ip->len = net_htons(IP_HDR_LEN + tcp_hdr_len + s->len);
+	ip->id[1] = (uint8_t)s->seq;
+	ip->offset[0] = 0x40; /* Don't fragment */
+	ip->ttl = 64U;
+	ip->proto = NET_IPPROTO_TCP;
+	net_ipv4_addr_copy_raw(ip->src, src->s4_addr);
+	net_ipv4_addr_copy_raw(ip->dst, dst->s4_addr);
+	ip->chksum = net_htons(~test_sum(0U, (uint8_t *)ip, IP_HDR_LEN));
+
+	th = (struct tcphdr *)(p + IP_HDR_LEN);
+	memset(th, 0, tcp_hdr_len);
+	th->th_sport = net_htons(eth ? PEER_PORT : MY_PORT);
+	th->th_dport = net_htons(eth ? MY_PORT : PEER_PORT);
+	th->th_seq = net_htonl(s->seq);
+	th->th_ack = net_htonl(PEER_ACK);
+	th->th_off = tcp_hdr_len / 4U;
+	th->th_flags = s->flags;
+	th->th_win = net_htons(PEER_WIN);
+
+	if (tcp_hdr_len > sizeof(struct tcphdr)) {
+		opt = (uint8_t *)(th + 1);
+		opt[0] = NET_TCP_NOP_OPT;
+		opt[1] = NET_TCP_NOP_OPT;
+		opt[2] = NET_TCP_TIMESTAMP_OPT;
+		opt[3] = NET_TCP_TIMESTAMP_SIZE;
+		sys_put_be32(s->tsval, &opt[4]);
+		sys_put_be32(1U, &opt[8]);
+	}
+
+	memcpy((uint8_t *)th + tcp_hdr_len, &test_data[offset], s->len);
+
+	sum = ~test_tcp_sum(ip, (uint8_t *)th, tcp_hdr_len + s->len);
+	if (s->bad_chksum) {
+		sum++;
+	}
+	th->th_sum = net_htons(sum);
+
+	return (uint8_t *)th + tcp_hdr_len + s->len - frame;
+}
+
+static struct net_pkt *rx_segment(const struct test_seg *s)
+{
+	size_t len = build_segment(s, s->seq, true, &peer_addr, &my_addr, TCP_HDR_LEN);
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_rx_alloc_with_buffer(test_iface, len, NET_AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate packet");
+	zassert_ok(net_pkt_write(pkt, frame, len));
+	net_pkt_cursor_init(pkt);
+
+	return pkt;
+}
+
+/* Queue the segments following the first one, and run GRO on the first */
+static struct net_pkt *gro_run(const struct test_seg *segs, size_t count)
+{
+	struct net_pkt *pkt = rx_segment(&segs[0]);
+
+	for (size_t i = 1; i < count; i++) {
+		k_fifo_put(&rx_fifo, rx_segment(&segs[i]));
+	}
+
+	zassert_equal(net_gro_receive(pkt, &rx_fifo, NULL), pkt, "Another packet returned");
+
+	return pkt;
+}
+
+/* Check that pkt holds the unmodified segment s */
+static void check_segment(struct net_pkt *pkt, const struct test_seg *s)
+{
+	size_t len = net_pkt_get_len(pkt);
+	struct net_ipv4_hdr *ip;
+	struct tcphdr *th;
+
+	zassert_equal(len, HDR_LEN + s->len, "Segment %u has length %zu", s->seq, len);
+
+	net_pkt_cursor_init(pkt);
+	zassert_ok(net_pkt_read(pkt, frame, len));
+	net_pkt_cursor_init(pkt);
+
+	ip = (struct net_ipv4_hdr *)(frame + sizeof(struct net_eth_hdr));
+	th = (struct tcphdr *)(ip + 1);
+
+	zassert_equal(net_ntohs(ip->len), IP_HDR_LEN + TCP_HDR_LEN + s->len);
+	zassert_equal(th_seq(th), s->seq);
+	zassert_equal(th_flags(th), s->flags);
+	zassert_false(net_pkt_is_chksum_done(pkt), "Unmerged segment marked as verified");
+}
+
+/**
+ * @brief Test merging of back-to-back segments
+ *
+ * Queues in-order segments of a connection, the last of them with PSH,
+ * and checks that they are merged into the first one, with its sequence
+ * number, the total length, a valid IPv4 header checksum and the PSH
+ * flag, and that a segment following the pushed one is left queued.
+ */
+ZTEST(net_gro, test_gro_merge)
+{
+	const struct test_seg segs[] = {
+		{ .seq = 0, .flags = ACK, .tsval = 7, .len = SEG_LEN },
+		{ .seq = SEG_LEN, .flags = ACK, .tsval = 7, .len = SEG_LEN },
+		{ .seq = 2 * SEG_LEN, .flags = ACK, .tsval = 7, .len = SEG_LEN },
+		{ .seq = 3 * SEG_LEN, .flags = ACK | PSH, .tsval = 7, .len = SEG_LEN / 2 },
+		{ .seq = 3 * SEG_LEN + SEG_LEN / 2, .flags = ACK, .tsval = 7, .len = SEG_LEN },
+	};
+	size_t data_len = 3 * SEG_LEN + SEG_LEN / 2;
+	struct net_pkt *pkt = gro_run(segs, ARRAY_SIZE(segs));
+	struct net_ipv4_hdr *ip;
+	struct tcphdr *th;
+	struct net_pkt *next;
+
+	zassert_equal(net_pkt_get_len(pkt), HDR_LEN + data_len,
+		      "Merged length %zu, expected %zu", net_pkt_get_len(pkt),
+		      HDR_LEN + data_len);
+	zassert_true(net_pkt_is_chksum_done(pkt), "Merged packet not marked as verified");
+
+	zassert_ok(net_pkt_read(pkt, frame, net_pkt_get_len(pkt)));
+	net_pkt_cursor_init(pkt);
+
+	ip = (struct net_ipv4_hdr *)(frame + sizeof(struct net_eth_hdr));
+	th = (struct tcphdr *)(ip + 1);
+
+	/** TESTPOINT: headers of the merged packet */
+	zassert_equal(net_ntohs(ip->len), IP_HDR_LEN + TCP_HDR_LEN + data_len);
+	zassert_equal(test_sum(0U, (uint8_t *)ip, IP_HDR_LEN), 0xffff,
+		      "Invalid IPv4 header checksum");
+	zassert_equal(th_seq(th), 0U);
+	zassert_equal(th_flags(th), ACK | PSH, "Flags 0x%02x", th_flags(th));
+
+	/** TESTPOINT: data of all merged segments, in order */
+	zassert_mem_equal(frame + HDR_LEN, test_data, data_len);
+
+	/** TESTPOINT: the segment after the pushed one stays queued */
+	next = k_fifo_get(&rx_fifo, K_NO_WAIT);
+	zassert_not_null(next, "Segment following PSH merged");
+	check_segment(next, &segs[4]);
+	zassert_true(k_fifo_is_empty(&rx_fifo));
+
+	net_pkt_unref(next);
+	net_pkt_unref(pkt);
+}
+
+/* Run GRO on a segment followed by one that must not be merged into it */
+static void gro_no_merge(const struct test_seg *second)
+{
+	const struct test_seg first = {
+		.seq = 0, .flags = ACK, .tsval = 7, .len = SEG_LEN,
+	};
+	const struct test_seg segs[] = { first, *second };
+	struct net_pkt *pkt = gro_run(segs, ARRAY_SIZE(segs));
+	struct net_pkt *next;
+
+	check_segment(pkt, &first);
+
+	next = k_fifo_get(&rx_fifo, K_NO_WAIT);
+	zassert_not_null(next, "Segment merged");
+	check_segment(next, second);
+	zassert_true(k_fifo_is_empty(&rx_fifo));
+
+	net_pkt_unref(next);
+	net_pkt_unref(pkt);
+}
+
+ZTEST(net_gro, test_gro_out_of_order)
+{
+	/* A gap, and a retransmission of the held data */
+	gro_no_merge(&(struct test_seg){ .seq = 2 * SEG_LEN, .flags = ACK, .tsval = 7,
+					 .len = SEG_LEN });
+	gro_no_merge(&(struct test_seg){ .seq = 0, .flags = ACK, .tsval = 7,
+					 .len = SEG_LEN });
+}
+
+ZTEST(net_gro, test_gro_flags)
+{
+	gro_no_merge(&(struct test_seg){ .seq = SEG_LEN, .flags = ACK | FIN, .tsval = 7,
+					 .len = SEG_LEN });
+	gro_no_merge(&(struct test_seg){ .seq = SEG_LEN, .flags = ACK | URG, .tsval = 7,
+					 .len = SEG_LEN });
+	gro_no_merge(&(struct test_seg){ .seq = SEG_LEN, .flags = ACK | RST, .tsval = 7,
+					 .len = SEG_LEN });
+}
+
+ZTEST(net_gro, test_gro_options_mismatch)
+{
+	gro_no_merge(&(struct test_seg){ .seq = SEG_LEN, .flags = ACK, .tsval = 8,
+					 .len = SEG_LEN });
+}
+
+ZTEST(net_gro, test_gro_bad_chksum)
+{
+	gro_no_merge(&(struct test_seg){ .seq = SEG_LEN, .flags = ACK, .tsval = 7,
+					 .len = SEG_LEN, .bad_chksum = true });
+}
+
+static struct net_pkt *gso_segs[8];
+static int gso_seg_count;
+
+static bool gso_tx(struct net_if *iface, struct net_pkt *pkt)
+{
+	zassert_equal(iface, test_iface);
+	zassert_true(gso_seg_count < ARRAY_SIZE(gso_segs), "Too many segments");
+
+	gso_segs[gso_seg_count++] = pkt;
+
+	return true;
+}
+
+/**
+ * @brief Test splitting of a super-segment larger than the MTU
+ *
+ * Splits a TCP super-segment carrying more data than fits in the MTU,
+ * with PSH set, and checks that the segments carry MSS bytes of data in
+ * order, with their sequence number, IPv4 length, valid IPv4 and TCP
+ * checksums, and PSH only on the last one.
+ */
+ZTEST(net_gso, test_gso_segment)
+{
+	const struct test_seg super = {
+		.seq = 1000, .flags = ACK | PSH, .len = sizeof(test_data),
+	};
+	size_t tcp_hdr_len = sizeof(struct tcphdr);
+	size_t len = build_segment(&super, 0, false, &my_addr, &peer_addr, tcp_hdr_len);
+	size_t offset = 0;
+	struct net_pkt *pkt;
+
+	zassert_true(len > NET_ETH_MTU);
+
+	pkt = net_pkt_alloc_with_buffer(test_iface, len, NET_AF_INET, NET_IPPROTO_TCP,
+					K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate packet");
+	zassert_ok(net_pkt_write(pkt, frame, len));
+	net_pkt_set_ip_hdr_len(pkt, IP_HDR_LEN);
+	net_pkt_set_ipv4_opts_len(pkt, 0);
+	net_pkt_set_gso_size(pkt, MSS);
+
+	gso_seg_count = 0;
+	zassert_ok(net_gso_segment(test_iface, pkt, gso_tx));
+	zassert_equal(gso_seg_count, DIV_ROUND_UP(sizeof(test_data), MSS),
+		      "%d segments", gso_seg_count);
+
+	for (int i = 0; i < gso_seg_count; i++) {
+		struct net_pkt *seg = gso_segs[i];
+		size_t data_len = MIN(MSS, sizeof(test_data) - offset);
+		size_t seg_len = net_pkt_get_len(seg);
+		struct net_ipv4_hdr *ip = (struct net_ipv4_hdr *)frame;
+		struct tcphdr *th = (struct tcphdr *)(ip + 1);
+		bool last = (i == gso_seg_count - 1);
+
+		zassert_equal(seg_len, IP_HDR_LEN + tcp_hdr_len + data_len,
+			      "Segment %d has length %zu", i, seg_len);
+
+		net_pkt_cursor_init(seg);
+		zassert_ok(net_pkt_read(seg, frame, seg_len));
+
+		/** TESTPOINT: headers of each segment */
+		zassert_equal(net_ntohs(ip->len), seg_len);
+		zassert_equal(test_sum(0U, (uint8_t *)ip, IP_HDR_LEN), 0xffff,
+			      "Invalid IPv4 header checksum in segment %d", i);
+		zassert_equal(test_tcp_sum(ip, (uint8_t *)th, tcp_hdr_len + data_len), 0xffff,
+			      "Invalid TCP checksum in segment %d", i);
+		zassert_equal(th_seq(th), super.seq + offset);
+		zassert_equal(th_flags(th), last ? (ACK | PSH) : ACK,
+			      "Flags 0x%02x in segment %d", th_flags(th), i);
+
+		/** TESTPOINT: data of each segment */
+		zassert_mem_equal(frame + IP_HDR_LEN + tcp_hdr_len, &test_data[offset],
+				  data_len);
+
+		offset += data_len;
+		net_pkt_unref(seg);
+	}
+
+	zassert_equal(offset, sizeof(test_data));
+}
+
+static void *setup(void)
+{
+	struct net_if_addr *ifaddr;
+
+	if (test_iface != NULL) {
+		return NULL;
+	}
+
+	test_iface = net_if_get_first_by_type(&NET_L2_GET_NAME(ETHERNET));
+	zassert_not_null(test_iface, "No Ethernet interface");
+
+	ifaddr = net_if_ipv4_addr_add(test_iface, &my_addr, NET_ADDR_MANUAL, 0);
+	zassert_not_null(ifaddr, "Cannot add IPv4 address");
+
+	for (size_t i = 0; i < sizeof(test_data); i++) {
+		test_data[i] = sys_rand8_get();
+	}
+
+	return NULL;
+}
+
+static void after(void *arg)
+{
+	struct net_pkt *pkt;
+
+	ARG_UNUSED(arg);
+
+	while ((pkt = k_fifo_get(&rx_fifo, K_NO_WAIT)) != NULL) {
+		net_pkt_unref(pkt);
+	}
+}
+
+ZTEST_SUITE(net_gro, NULL, setup, NULL, after, NULL);
+ZTEST_SUITE(net_gso, NULL, setup, NULL, NULL, NULL);
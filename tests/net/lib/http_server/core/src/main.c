@@ -64,6 +64,9 @@ BUILD_ASSERT(sizeof(long_payload) - 1 > CONFIG_HTTP_SERVER_CLIENT_BUFFER_SIZE,
 	0x00, 0x03, 0x00, 0x00, 0x00, 0x64, 0x00, 0x04, 0x00, 0x00, 0xff, 0xff
 #define TEST_HTTP2_SETTINGS_ACK \
 	0x00, 0x00, 0x00, 0x04, 0x01, 0x00, 0x00, 0x00, 0x00
+#define TEST_HTTP2_SETTINGS_WINDOW_SIZE_4 \
+	0x00, 0x00, 0x06, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, \
+	0x00, 0x04, 0x00, 0x00, 0x00, 0x04
 #define TEST_HTTP2_GOAWAY \
 	0x00, 0x00, 0x08, 0x07, 0x00, 0x00, 0x00, 0x00, \
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
@@ -202,6 +205,9 @@ BUILD_ASSERT(sizeof(long_payload) - 1 > CONFIG_HTTP_SERVER_CLIENT_BUFFER_SIZE,
 #define TEST_HTTP2_RST_STREAM_STREAM_1 \
 	0x00, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x00, TEST_STREAM_ID_1, \
 	0xaa, 0xaa, 0xaa, 0xaa
+#define TEST_HTTP2_WINDOW_UPDATE_STREAM_1 \
+	0x00, 0x00, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00, TEST_STREAM_ID_1, \
+	0x00, 0x00, 0x00, 0x20
 #define TEST_HTTP2_HEADERS_PUT_DYNAMIC_STREAM_1 \
 	0x00, 0x00, 0x34, 0x01, 0x04, 0x00, 0x00, 0x00, TEST_STREAM_ID_1, \
 	0x42, 0x03, 0x50, 0x55, 0x54, 0x86, 0x41, 0x87, 0x0b, 0xe2, 0x5c, 0x0b, \
@@ -796,6 +802,48 @@ ZTEST(server_function_tests, test_http2_static_get)
 				HTTP2_FLAG_END_STREAM);
 }
 
+ZTEST(server_function_tests, test_http2_static_get_flow_control)
+{
+	static const uint8_t request_get_static_small_window[] = {
+		TEST_HTTP2_MAGIC,
+		TEST_HTTP2_SETTINGS_WINDOW_SIZE_4,
+		TEST_HTTP2_SETTINGS_ACK,
+		TEST_HTTP2_HEADERS_GET_ROOT_STREAM_1,
+		TEST_HTTP2_HEADERS_GET_INDEX_STREAM_2,
+	};
+	static const uint8_t request_window_update[] = {
+		TEST_HTTP2_WINDOW_UPDATE_STREAM_1,
+		TEST_HTTP2_GOAWAY,
+	};
+	size_t offset = 0;
+	int ret;
+
+	ret = zsock_send(client_fd, request_get_static_small_window,
+			 sizeof(request_get_static_small_window), 0);
+	zassert_not_equal(ret, -1, "send() failed (%d)", errno);
+
+	memset(buf, 0, sizeof(buf));
+
+	/* Only the first 4 bytes fit in the stream window, the other stream
+	 * is served in the meantime.
+	 */
+	expect_http2_settings_frame(&offset, false);
+	expect_http2_settings_frame(&offset, true);
+	expect_http2_headers_frame(&offset, TEST_STREAM_ID_1, HTTP2_FLAG_END_HEADERS, NULL, 0);
+	expect_http2_data_frame(&offset, TEST_STREAM_ID_1, TEST_STATIC_PAYLOAD, 4, 0);
+	expect_http2_headers_frame(&offset, TEST_STREAM_ID_2, HTTP2_FLAG_END_HEADERS, NULL, 0);
+	expect_http2_data_frame(&offset, TEST_STREAM_ID_2, NULL, 0,
+				HTTP2_FLAG_END_STREAM);
+
+	ret = zsock_send(client_fd, request_window_update,
+			 sizeof(request_window_update), 0);
+	zassert_not_equal(ret, -1, "send() failed (%d)", errno);
+
+	expect_http2_data_frame(&offset, TEST_STREAM_ID_1, TEST_STATIC_PAYLOAD + 4,
+				strlen(TEST_STATIC_PAYLOAD) - 4,
+				HTTP2_FLAG_END_STREAM);
+}
+
 ZTEST(server_function_tests, test_http1_static_upgrade_get)
 {
 	static const char http1_request[] =
@@ -1017,6 +1065,49 @@ ZTEST(server_function_tests, test_http2_dynamic_get)
 						sizeof(request_get_dynamic));
 }
 
+ZTEST(server_function_tests, test_http2_dynamic_get_flow_control)
+{
+	static const uint8_t request_get_dynamic_small_window[] = {
+		TEST_HTTP2_MAGIC,
+		TEST_HTTP2_SETTINGS_WINDOW_SIZE_4,
+		TEST_HTTP2_SETTINGS_ACK,
+		TEST_HTTP2_HEADERS_GET_DYNAMIC_STREAM_1,
+	};
+	static const uint8_t request_window_update[] = {
+		TEST_HTTP2_WINDOW_UPDATE_STREAM_1,
+		TEST_HTTP2_GOAWAY,
+	};
+	size_t offset = 0;
+	int ret;
+
+	dynamic_payload_len = strlen(TEST_DYNAMIC_GET_PAYLOAD);
+	memcpy(dynamic_payload, TEST_DYNAMIC_GET_PAYLOAD, dynamic_payload_len);
+
+	ret = zsock_send(client_fd, request_get_dynamic_small_window,
+			 sizeof(request_get_dynamic_small_window), 0);
+	zassert_not_equal(ret, -1, "send() failed (%d)", errno);
+
+	memset(buf, 0, sizeof(buf));
+
+	/* Only the first 4 bytes fit in the stream window, the server waits
+	 * for the window update to send the rest.
+	 */
+	expect_http2_settings_frame(&offset, false);
+	expect_http2_settings_frame(&offset, true);
+	expect_http2_headers_frame(&offset, TEST_STREAM_ID_1, HTTP2_FLAG_END_HEADERS, NULL, 0);
+	expect_http2_data_frame(&offset, TEST_STREAM_ID_1, TEST_DYNAMIC_GET_PAYLOAD, 4, 0);
+	zassert_false(dynamic_complete, "Transaction completed before the reply was sent");
+
+	ret = zsock_send(client_fd, request_window_update,
+			 sizeof(request_window_update), 0);
+	zassert_not_equal(ret, -1, "send() failed (%d)", errno);
+
+	expect_http2_data_frame(&offset, TEST_STREAM_ID_1, TEST_DYNAMIC_GET_PAYLOAD + 4,
+				strlen(TEST_DYNAMIC_GET_PAYLOAD) - 4,
+				HTTP2_FLAG_END_STREAM);
+	zassert_true(dynamic_complete, "Callback not called with transaction complete status");
+}
+
 ZTEST(server_function_tests, test_http1_dynamic_upgrade_get)
 {
 	static const char http1_request[] =
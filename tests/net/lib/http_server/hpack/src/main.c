@@ -494,4 +494,230 @@ ZTEST(http2_hpack, test_http2_hpack_literal_not_indexed_decode)
 				 ARRAY_SIZE(test_enc_literal_not_indexed_headers));
 }
 
+struct example_header_block {
+	struct {
+		const char *name;
+		const char *value;
+	} fields[6];
+	size_t num_fields;
+	uint8_t encoded[100];
+	size_t encoded_len;
+	uint32_t table_size;
+};
+
+/* Request examples from RFC7541 ch C.3, decoded with the same table. */
+static const struct example_header_block test_dynamic_requests[] = {
+	{ {
+		  { ":method", "GET" },
+		  { ":scheme", "http" },
+		  { ":path", "/" },
+		  { ":authority", "www.example.com" },
+	  },
+	  4,
+	  { 0x82, 0x86, 0x84, 0x41, 0x0f, 0x77, 0x77, 0x77,
+	    0x2e, 0x65, 0x78, 0x61, 0x6d, 0x70, 0x6c, 0x65,
+	    0x2e, 0x63, 0x6f, 0x6d },
+	  20,
+	  57 },
+	{ {
+		  { ":method", "GET" },
+		  { ":scheme", "http" },
+		  { ":path", "/" },
+		  { ":authority", "www.example.com" },
+		  { "cache-control", "no-cache" },
+	  },
+	  5,
+	  { 0x82, 0x86, 0x84, 0xbe, 0x58, 0x08, 0x6e, 0x6f,
+	    0x2d, 0x63, 0x61, 0x63, 0x68, 0x65 },
+	  14,
+	  110 },
+	{ {
+		  { ":method", "GET" },
+		  { ":scheme", "https" },
+		  { ":path", "/index.html" },
+		  { ":authority", "www.example.com" },
+		  { "custom-key", "custom-value" },
+	  },
+	  5,
+	  { 0x82, 0x87, 0x85, 0xbf, 0x40, 0x0a, 0x63, 0x75,
+	    0x73, 0x74, 0x6f, 0x6d, 0x2d, 0x6b, 0x65, 0x79,
+	    0x0c, 0x63, 0x75, 0x73, 0x74, 0x6f, 0x6d, 0x2d,
+	    0x76, 0x61, 0x6c, 0x75, 0x65 },
+	  29,
+	  164 },
+};
+
+/* Response examples from RFC7541 ch C.5, with a 256 bytes table. */
+static const struct example_header_block test_dynamic_responses[] = {
+	{ {
+		  { ":status", "302" },
+		  { "cache-control", "private" },
+		  { "date", "Mon, 21 Oct 2013 20:13:21 GMT" },
+		  { "location", "https://www.example.com" },
+	  },
+	  4,
+	  { 0x48, 0x03, 0x33, 0x30, 0x32, 0x58, 0x07, 0x70,
+	    0x72, 0x69, 0x76, 0x61, 0x74, 0x65, 0x61, 0x1d,
+	    0x4d, 0x6f, 0x6e, 0x2c, 0x20, 0x32, 0x31, 0x20,
+	    0x4f, 0x63, 0x74, 0x20, 0x32, 0x30, 0x31, 0x33,
+	    0x20, 0x32, 0x30, 0x3a, 0x31, 0x33, 0x3a, 0x32,
+	    0x31, 0x20, 0x47, 0x4d, 0x54, 0x6e, 0x17, 0x68,
+	    0x74, 0x74, 0x70, 0x73, 0x3a, 0x2f, 0x2f, 0x77,
+	    0x77, 0x77, 0x2e, 0x65, 0x78, 0x61, 0x6d, 0x70,
+	    0x6c, 0x65, 0x2e, 0x63, 0x6f, 0x6d },
+	  70,
+	  222 },
+	{ {
+		  { ":status", "307" },
+		  { "cache-control", "private" },
+		  { "date", "Mon, 21 Oct 2013 20:13:21 GMT" },
+		  { "location", "https://www.example.com" },
+	  },
+	  4,
+	  { 0x48, 0x03, 0x33, 0x30, 0x37, 0xc1, 0xc0, 0xbf },
+	  8,
+	  222 },
+	{ {
+		  { ":status", "200" },
+		  { "cache-control", "private" },
+		  { "date", "Mon, 21 Oct 2013 20:13:22 GMT" },
+		  { "location", "https://www.example.com" },
+		  { "content-encoding", "gzip" },
+		  { "set-cookie", "foo=ASDJKHQKBZXOQWEOPIUAXQWEOIU; max-age=3600; version=1" },
+	  },
+	  6,
+	  { 0x88, 0xc1, 0x61, 0x1d, 0x4d, 0x6f, 0x6e, 0x2c,
+	    0x20, 0x32, 0x31, 0x20, 0x4f, 0x63, 0x74, 0x20,
+	    0x32, 0x30, 0x31, 0x33, 0x20, 0x32, 0x30, 0x3a,
+	    0x31, 0x33, 0x3a, 0x32, 0x32, 0x20, 0x47, 0x4d,
+	    0x54, 0xc0, 0x5a, 0x04, 0x67, 0x7a, 0x69, 0x70,
+	    0x77, 0x38, 0x66, 0x6f, 0x6f, 0x3d, 0x41, 0x53,
+	    0x44, 0x4a, 0x4b, 0x48, 0x51, 0x4b, 0x42, 0x5a,
+	    0x58, 0x4f, 0x51, 0x57, 0x45, 0x4f, 0x50, 0x49,
+	    0x55, 0x41, 0x58, 0x51, 0x57, 0x45, 0x4f, 0x49,
+	    0x55, 0x3b, 0x20, 0x6d, 0x61, 0x78, 0x2d, 0x61,
+	    0x67, 0x65, 0x3d, 0x33, 0x36, 0x30, 0x30, 0x3b,
+	    0x20, 0x76, 0x65, 0x72, 0x73, 0x69, 0x6f, 0x6e,
+	    0x3d, 0x31 },
+	  98,
+	  215 },
+};
+
+static struct http_hpack_table test_table;
+
+static void test_hpack_verify_decode_blocks(const struct example_header_block *example,
+					    size_t num_examples)
+{
+	for (int i = 0; i < num_examples; i++) {
+		const uint8_t *buf = example[i].encoded;
+		size_t datalen = example[i].encoded_len;
+
+		for (int j = 0; j < example[i].num_fields; j++) {
+			struct http_hpack_header_buf hdr;
+			int ret;
+
+			ret = http_hpack_table_decode_header(&test_table, buf, datalen, &hdr);
+			zassert_true(ret > 0, "Failed to decode header (%d)", ret);
+			zassert_equal(hdr.name_len, strlen(example[i].fields[j].name),
+				      "Wrong decoded header name length");
+			zassert_equal(hdr.value_len, strlen(example[i].fields[j].value),
+				      "Wrong decoded header value length");
+			zassert_mem_equal(hdr.name, example[i].fields[j].name, hdr.name_len,
+					  "Header name wrongly decoded");
+			zassert_mem_equal(hdr.value, example[i].fields[j].value, hdr.value_len,
+					  "Header value wrongly decoded");
+
+			buf += ret;
+			datalen -= ret;
+		}
+
+		zassert_equal(datalen, 0, "Header block not fully decoded");
+		zassert_equal(test_table.size, example[i].table_size, "Wrong table size");
+	}
+}
+
+ZTEST(http2_hpack, test_http2_hpack_dynamic_table_decode)
+{
+	http_hpack_table_init(&test_table, HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE);
+	test_hpack_verify_decode_blocks(test_dynamic_requests,
+					ARRAY_SIZE(test_dynamic_requests));
+
+	http_hpack_table_init(&test_table, 256);
+	test_hpack_verify_decode_blocks(test_dynamic_responses,
+					ARRAY_SIZE(test_dynamic_responses));
+}
+
+ZTEST(http2_hpack, test_http2_hpack_dynamic_table_size_update)
+{
+	/* Size update to 4097 followed by :method GET. */
+	static const uint8_t too_large[] = { 0x3f, 0xe2, 0x1f, 0x82 };
+	/* Size update to 0 followed by :method GET. */
+	static const uint8_t empty[] = { 0x20, 0x82 };
+	struct http_hpack_header_buf hdr;
+	int ret;
+
+	http_hpack_table_init(&test_table, 256);
+	test_hpack_verify_decode_blocks(test_dynamic_responses, 1);
+
+	ret = http_hpack_table_decode_header(&test_table, too_large, sizeof(too_large), &hdr);
+	zassert_equal(ret, -EBADMSG, "Size update above the limit accepted");
+
+	ret = http_hpack_table_decode_header(&test_table, empty, 1, &hdr);
+	zassert_equal(ret, -EAGAIN, "Size update alone should need more data");
+
+	ret = http_hpack_table_decode_header(&test_table, empty, sizeof(empty), &hdr);
+	zassert_equal(ret, sizeof(empty), "Wrong decoding length");
+	zassert_equal(test_table.size, 0, "Table not emptied");
+	zassert_equal(test_table.count, 0, "Table not emptied");
+}
+
+ZTEST(http2_hpack, test_http2_hpack_dynamic_table_encode)
+{
+	static struct http_hpack_table decoder;
+	struct http_hpack_header_buf hdr = {
+		.name = "server",
+		.value = "Zephyr",
+		.name_len = strlen("server"),
+		.value_len = strlen("Zephyr"),
+	};
+	struct http_hpack_header_buf decoded;
+	int ret;
+
+	http_hpack_table_init(&test_table, HTTP_HPACK_DEFAULT_TABLE_SIZE);
+	http_hpack_table_init(&decoder, HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE);
+
+	/* Literal with incremental indexing of the first static entry named server. */
+	ret = http_hpack_table_encode_header(&test_table, test_buf, sizeof(test_buf), &hdr);
+	zassert_true(ret > 1, "Failed to encode header (%d)", ret);
+	zassert_equal(test_buf[0], 0x40 | HTTP_SERVER_HPACK_SERVER, "Header not indexed");
+
+	ret = http_hpack_table_decode_header(&decoder, test_buf, ret, &decoded);
+	zassert_true(ret > 0, "Failed to decode header (%d)", ret);
+	zassert_equal(decoder.size, test_table.size, "Tables out of sync");
+
+	/* Same header field again, sent as the first dynamic table entry. */
+	ret = http_hpack_table_encode_header(&test_table, test_buf, sizeof(test_buf), &hdr);
+	zassert_equal(ret, 1, "Header not sent indexed");
+	zassert_equal(test_buf[0], 0x80 | (HTTP_SERVER_HPACK_WWW_AUTHENTICATE + 1),
+		      "Wrong index");
+
+	ret = http_hpack_table_decode_header(&decoder, test_buf, ret, &decoded);
+	zassert_equal(ret, 1, "Failed to decode header (%d)", ret);
+	zassert_mem_equal(decoded.value, "Zephyr", decoded.value_len, "Wrong value");
+
+	/* The peer disables the table, which has to be signaled and emptied. */
+	http_hpack_table_set_limit(&test_table, 0);
+	zassert_equal(test_table.count, 0, "Table not emptied");
+
+	ret = http_hpack_table_encode_header(&test_table, test_buf, sizeof(test_buf), &hdr);
+	zassert_true(ret > 1, "Failed to encode header (%d)", ret);
+	zassert_equal(test_buf[0], 0x20, "Size update not sent");
+	zassert_equal(test_buf[1] & 0xf0, 0x10, "Header should not be indexed");
+
+	ret = http_hpack_table_decode_header(&decoder, test_buf, ret, &decoded);
+	zassert_true(ret > 0, "Failed to decode header (%d)", ret);
+	zassert_equal(decoder.max_size, 0, "Size update not applied");
+	zassert_equal(decoder.count, 0, "Table not emptied");
+}
+
 ZTEST_SUITE(http2_hpack, NULL, NULL, NULL, NULL, NULL);
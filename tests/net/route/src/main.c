@@ -544,6 +544,68 @@ static void test_route_preference(void)
 	net_route_del(route_entry);
 }
 
+static void test_route_lpm(void)
+{
+	struct net_in6_addr prefix_32 = { { { 0x20, 0x01, 0x0d, 0xb8 } } };
+	struct net_in6_addr prefix_48 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0x1 } } };
+	struct net_in6_addr prefix_64 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0x1, 0, 0x2 } } };
+	struct net_in6_addr dst_64 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0x1, 0, 0x2,
+					   0, 0, 0, 0, 0, 0, 0, 0x5 } } };
+	struct net_in6_addr dst_48 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0x1, 0, 0x3,
+					   0, 0, 0, 0, 0, 0, 0, 0x5 } } };
+	struct net_in6_addr dst_32 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0x2, 0, 0,
+					   0, 0, 0, 0, 0, 0, 0, 0x5 } } };
+	struct net_in6_addr dst_none = { { { 0x20, 0x01, 0x0d, 0xb9, 0, 0, 0, 0,
+					     0, 0, 0, 0, 0, 0, 0, 0x5 } } };
+	struct net_route_entry *route_32, *route_48, *route_64;
+
+	/* The longest prefix is added first, as adding a route whose
+	 * address matches an existing route with the same next hop only
+	 * updates it.
+	 */
+	route_64 = net_route_add(my_iface, &prefix_64, 64, &peer_addr,
+				 NET_IPV6_ND_INFINITE_LIFETIME,
+				 NET_ROUTE_PREFERENCE_LOW);
+	zassert_not_null(route_64, "Route add failed");
+
+	route_48 = net_route_add(my_iface, &prefix_48, 48, &peer_addr,
+				 NET_IPV6_ND_INFINITE_LIFETIME,
+				 NET_ROUTE_PREFERENCE_LOW);
+	zassert_not_null(route_48, "Route add failed");
+
+	route_32 = net_route_add(my_iface, &prefix_32, 32, &peer_addr,
+				 NET_IPV6_ND_INFINITE_LIFETIME,
+				 NET_ROUTE_PREFERENCE_LOW);
+	zassert_not_null(route_32, "Route add failed");
+
+	/* Lookup twice, so that the second one can be served by the cache */
+	for (int i = 0; i < 2; i++) {
+		zassert_equal_ptr(net_route_lookup(my_iface, &dst_64), route_64,
+				  "Longest prefix not matched");
+		zassert_equal_ptr(net_route_lookup(NULL, &dst_48), route_48,
+				  "Longest prefix not matched");
+		zassert_equal_ptr(net_route_lookup(my_iface, &dst_32), route_32,
+				  "Longest prefix not matched");
+		zassert_is_null(net_route_lookup(my_iface, &dst_none),
+				"Route found for unrouted address");
+		zassert_is_null(net_route_lookup(peer_iface, &dst_64),
+				"Route found on the wrong interface");
+	}
+
+	zassert_false(net_route_del(route_64), "Route del failed");
+	zassert_equal_ptr(net_route_lookup(my_iface, &dst_64), route_48,
+			  "Shorter prefix not matched after delete");
+
+	zassert_false(net_route_del(route_32), "Route del failed");
+	zassert_is_null(net_route_lookup(my_iface, &dst_32),
+			"Deleted route found");
+	zassert_equal_ptr(net_route_lookup(my_iface, &dst_48), route_48,
+			  "Longest prefix not matched after delete");
+
+	zassert_false(net_route_del(route_48), "Route del failed");
+	zassert_is_null(net_route_lookup(my_iface, &dst_64),
+			"Deleted route found");
+}
 
 /*test case main entry*/
 ZTEST(route_test_suite, test_route)
@@ -566,6 +628,7 @@ ZTEST(route_test_suite, test_route)
 	test_route_del_many();
 	test_route_lifetime();
 	test_route_preference();
+	test_route_lpm();
 }
 
 ZTEST_SUITE(route_test_suite, NULL, NULL, NULL, NULL, NULL);
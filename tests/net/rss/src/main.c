@@ -0,0 +1,327 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_TC_LOG_LEVEL);
+
+#include <zephyr/types.h>
+#include <string.h>
+#include <zephyr/sys/byteorder.h>
+
+#include <zephyr/ztest.h>
+
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_pkt.h>
+
+#include "net_private.h"
+
+#define QUEUES     CONFIG_NET_TC_RX_RSS_QUEUE_COUNT
+#define FLOW_COUNT 64
+#define PEER_PORT  4242
+
+static struct net_in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct net_in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+
+static struct net_if *test_iface;
+static uint8_t frame[sizeof(struct net_eth_vlan_hdr) + sizeof(struct net_ipv4_hdr) + 8];
+
+struct flow {
+	const struct net_in_addr *src;
+	const struct net_in_addr *dst;
+	uint8_t proto;
+	uint16_t src_port;
+	uint16_t dst_port;
+};
+
+struct eth_context {
+	uint8_t mac_addr[6];
+};
+
+static struct eth_context eth_context;
+
+static void eth_iface_init(struct net_if *iface)
+{
+	const struct device *dev = net_if_get_device(iface);
+	struct eth_context *context = dev->data;
+
+	net_if_set_link_addr(iface, context->mac_addr, sizeof(context->mac_addr),
+			     NET_LINK_ETHERNET);
+
+	ethernet_init(iface);
+}
+
+static int eth_tx(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static struct ethernet_api api_funcs = {
+	.iface_api.init = eth_iface_init,
+	.send = eth_tx,
+};
+
+static int eth_init(const struct device *dev)
+{
+	struct eth_context *context = dev->data;
+
+	/* 00-00-5E-00-53-xx Documentation RFC 7042 */
+	context->mac_addr[0] = 0x00;
+	context->mac_addr[1] = 0x00;
+	context->mac_addr[2] = 0x5E;
+	context->mac_addr[3] = 0x00;
+	context->mac_addr[4] = 0x53;
+	context->mac_addr[5] = 0x01;
+
+	return 0;
+}
+
+ETH_NET_DEVICE_INIT(eth_test, "eth_test", eth_init, NULL, &eth_context, NULL,
+		    CONFIG_ETH_INIT_PRIORITY, &api_funcs, NET_ETH_MTU);
+
+/* Build a received IPv4 frame of the flow, VLAN tagged or not. The
+ * fragment field is given in host order.
+ */
+static struct net_pkt *flow_pkt(const struct flow *flow, bool vlan, uint16_t frag)
+{
+	struct net_ipv4_hdr *ip;
+	struct net_pkt *pkt;
+	size_t len;
+
+	memset(frame, 0, sizeof(frame));
+
+	if (vlan) {
+		struct net_eth_vlan_hdr *hdr = (struct net_eth_vlan_hdr *)frame;
+
+		hdr->vlan.tpid = net_htons(NET_ETH_PTYPE_VLAN);
+		hdr->vlan.tci = net_htons(100);
+		hdr->type = net_htons(NET_ETH_PTYPE_IP);
+		len = sizeof(*hdr);
+	} else {
+		struct net_eth_hdr *hdr = (struct net_eth_hdr *)frame;
+
+		hdr->type = net_htons(NET_ETH_PTYPE_IP);
+		len = sizeof(*hdr);
+	}
+
+	ip = (struct net_ipv4_hdr *)(frame + len);
+	ip->vhl = 0x45;
+	ip->len = net_htons(sizeof(*ip) + 8);
+	sys_put_be16(frag, ip->offset);
+	ip->ttl = 64;
+	ip->proto = flow->proto;
+	memcpy(ip->src, flow->src, sizeof(ip->src));
+	memcpy(ip->dst, flow->dst, sizeof(ip->dst));
+	len += sizeof(*ip);
+
+	/* The ports, or the payload of a fragment which is not the first */
+	sys_put_be16(flow->src_port, &frame[len]);
+	sys_put_be16(flow->dst_port, &frame[len + 2]);
+	len += 8;
+
+	pkt = net_pkt_rx_alloc_with_buffer(test_iface, len, NET_AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate packet");
+	zassert_ok(net_pkt_write(pkt, frame, len), "Cannot write frame");
+
+	return pkt;
+}
+
+/* Return the queue of a frame of the flow, and its hash */
+static int flow_queue(const struct flow *flow, bool vlan, uint16_t frag, uint32_t *hash)
+{
+	struct net_pkt *pkt = flow_pkt(flow, vlan, frag);
+	int queue;
+
+	queue = net_rss_queue(pkt);
+
+	zassert_true(queue >= 0 && queue < QUEUES, "Invalid queue %d", queue);
+	zassert_true(net_pkt_rx_hash_is_valid(pkt), "Hash not recorded");
+
+	if (hash != NULL) {
+		*hash = net_pkt_rx_hash(pkt);
+	}
+
+	net_pkt_unref(pkt);
+
+	return queue;
+}
+
+ZTEST(net_rss, test_same_flow_same_queue)
+{
+	struct flow flow = {
+		.src = &peer_addr,
+		.dst = &my_addr,
+		.proto = NET_IPPROTO_TCP,
+		.src_port = 49152,
+		.dst_port = PEER_PORT,
+	};
+	uint32_t first_hash, hash;
+	int first, queue;
+
+	first = flow_queue(&flow, false, 0, &first_hash);
+
+	for (int i = 0; i < 8; i++) {
+		queue = flow_queue(&flow, false, 0, &hash);
+
+		zassert_equal(queue, first, "Flow moved from queue %d to %d", first, queue);
+		zassert_equal(hash, first_hash, "Flow hash changed");
+	}
+}
+
+ZTEST(net_rss, test_flows_spread)
+{
+	struct flow flow = {
+		.src = &peer_addr,
+		.dst = &my_addr,
+		.proto = NET_IPPROTO_TCP,
+		.dst_port = PEER_PORT,
+	};
+	struct flow reversed = {
+		.src = &my_addr,
+		.dst = &peer_addr,
+		.proto = NET_IPPROTO_TCP,
+		.src_port = PEER_PORT,
+	};
+	unsigned int count[QUEUES] = { 0 };
+	uint32_t hash, reversed_hash;
+
+	/* The flows differ by their source port only */
+	for (int i = 0; i < FLOW_COUNT; i++) {
+		flow.src_port = 49152 + i;
+		count[flow_queue(&flow, false, 0, &hash)]++;
+
+		reversed.dst_port = flow.src_port;
+		(void)flow_queue(&reversed, false, 0, &reversed_hash);
+		zassert_not_equal(hash, reversed_hash,
+				  "Flow and reversed flow share hash 0x%08x", hash);
+	}
+
+	for (int i = 0; i < QUEUES; i++) {
+		zassert_true(count[i] > 0, "No flow on queue %d", i);
+	}
+
+	/* Or by their protocol */
+	flow.src_port = 49152;
+	(void)flow_queue(&flow, false, 0, &hash);
+	flow.proto = NET_IPPROTO_UDP;
+	(void)flow_queue(&flow, false, 0, &reversed_hash);
+	zassert_not_equal(hash, reversed_hash, "TCP and UDP flows share hash 0x%08x", hash);
+}
+
+ZTEST(net_rss, test_ipv4_fragments)
+{
+	struct flow flow = {
+		.src = &peer_addr,
+		.dst = &my_addr,
+		.proto = NET_IPPROTO_UDP,
+		.src_port = 49152,
+		.dst_port = PEER_PORT,
+	};
+	struct flow payload = flow;
+	uint32_t first_hash, hash;
+	int first;
+
+	/* The first fragment holds the ports, the others carry payload where
+	 * the ports would be. They all go to the same queue.
+	 */
+	first = flow_queue(&flow, false, NET_IPV4_MORE_FRAG_MASK, &first_hash);
+
+	payload.src_port = 0x1234;
+	payload.dst_port = 0x5678;
+	zassert_equal(flow_queue(&payload, false, NET_IPV4_MORE_FRAG_MASK | 185, &hash),
+		      first, "Middle fragment on another queue");
+	zassert_equal(hash, first_hash, "Middle fragment hashed on its payload");
+
+	payload.src_port = 0xabcd;
+	zassert_equal(flow_queue(&payload, false, 370, &hash), first,
+		      "Last fragment on another queue");
+	zassert_equal(hash, first_hash, "Last fragment hashed on its payload");
+}
+
+ZTEST(net_rss, test_vlan)
+{
+	struct flow flow = {
+		.src = &peer_addr,
+		.dst = &my_addr,
+		.proto = NET_IPPROTO_TCP,
+		.src_port = 49152,
+		.dst_port = PEER_PORT,
+	};
+	uint32_t hash, vlan_hash;
+	int queue;
+
+	/* The tagged frames of a flow are hashed on the same tuple */
+	for (int i = 0; i < 8; i++) {
+		flow.src_port = 49152 + i;
+
+		queue = flow_queue(&flow, false, 0, &hash);
+		zassert_equal(flow_queue(&flow, true, 0, &vlan_hash), queue,
+			      "VLAN frame on another queue");
+		zassert_equal(vlan_hash, hash, "VLAN header not skipped");
+	}
+}
+
+ZTEST(net_rss, test_driver_hash)
+{
+	struct flow flow = {
+		.src = &peer_addr,
+		.dst = &my_addr,
+		.proto = NET_IPPROTO_TCP,
+		.src_port = 49152,
+		.dst_port = PEER_PORT,
+	};
+	struct net_pkt *pkt;
+	int queue;
+
+	queue = flow_queue(&flow, false, 0, NULL);
+
+	/* The queue given by the driver is used, queue 0 included */
+	for (int i = 0; i < QUEUES; i++) {
+		pkt = flow_pkt(&flow, false, 0);
+		zassert_false(net_pkt_rx_hash_is_valid(pkt), "New packet has a hash");
+
+		net_pkt_set_rx_hash(pkt, (queue + 1 + i) % QUEUES);
+		zassert_equal(net_rss_queue(pkt), (queue + 1 + i) % QUEUES,
+			      "Hash set by the driver not used");
+		zassert_equal(net_pkt_rx_hash(pkt), (queue + 1 + i) % QUEUES,
+			      "Hash set by the driver overwritten");
+
+		net_pkt_unref(pkt);
+	}
+}
+
+ZTEST(net_rss, test_non_ip)
+{
+	struct net_eth_hdr *hdr = (struct net_eth_hdr *)frame;
+	struct net_pkt *pkt;
+
+	memset(frame, 0, sizeof(frame));
+	hdr->type = net_htons(NET_ETH_PTYPE_ARP);
+
+	pkt = net_pkt_rx_alloc_with_buffer(test_iface, sizeof(frame), NET_AF_UNSPEC, 0,
+					   K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate packet");
+	zassert_ok(net_pkt_write(pkt, frame, sizeof(frame)), "Cannot write frame");
+
+	zassert_equal(net_rss_hash(pkt), 0U, "Non IP frame hashed");
+	zassert_equal(net_rss_queue(pkt), 0, "Non IP frame not on queue 0");
+
+	net_pkt_unref(pkt);
+}
+
+static void *rss_setup(void)
+{
+	test_iface = net_if_get_first_by_type(&NET_L2_GET_NAME(ETHERNET));
+	zassert_not_null(test_iface, "No Ethernet interface");
+
+	return NULL;
+}
+
+ZTEST_SUITE(net_rss, NULL, rss_setup, NULL, NULL, NULL);
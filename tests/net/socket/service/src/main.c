@@ -31,10 +31,15 @@ K_SEM_DEFINE(wait_data, 0, UINT_MAX);
 K_SEM_DEFINE(wait_data_tcp, 0, UINT_MAX);
 #define WAIT_TIME 500
 
+/* Thread which called the last UDP callback */
+static k_tid_t handler_thread;
+
 static void server_handler(struct net_socket_service_event *pev)
 {
 	ARG_UNUSED(pev);
 
+	handler_thread = k_current_get();
+
 	k_sem_give(&wait_data);
 }
 
@@ -180,4 +185,134 @@ ZTEST(net_socket_service, test_service_sync)
 			 &tcp_service_sync);
 }
 
+/* Get one UDP packet through the service, and return the thread which called
+ * its callback.
+ */
+static k_tid_t run_udp_service(const struct net_socket_service_desc *udp_service)
+{
+	int ret;
+	int c_sock_udp;
+	int s_sock_udp;
+	struct net_sockaddr_in6 c_addr;
+	struct net_sockaddr_in6 s_addr;
+	ssize_t len;
+	char buf[10];
+	struct zsock_pollfd sock[1];
+
+	prepare_sock_udp_v6(MY_IPV6_ADDR, CLIENT_PORT, &c_sock_udp, &c_addr);
+	prepare_sock_udp_v6(MY_IPV6_ADDR, SERVER_PORT, &s_sock_udp, &s_addr);
+
+	sock[0].fd = s_sock_udp;
+	sock[0].events = ZSOCK_POLLIN;
+
+	ret = net_socket_service_register(udp_service, sock, ARRAY_SIZE(sock), NULL);
+	zassert_equal(ret, 0, "Cannot register udp service (%d)", ret);
+
+	ret = bind(s_sock_udp, (struct net_sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(ret, 0, "bind failed");
+
+	ret = connect(c_sock_udp, (struct net_sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(ret, 0, "connect failed");
+
+	k_sem_reset(&wait_data);
+	handler_thread = NULL;
+
+	len = send(c_sock_udp, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+
+	if (k_sem_take(&wait_data, K_MSEC(WAIT_TIME))) {
+		zassert_true(0, "Timeout while waiting callback");
+	}
+
+	len = recv(s_sock_udp, BUF_AND_SIZE(buf), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid recv len");
+
+	/* Let the callback return and its statistics be updated */
+	k_msleep(10);
+
+	ret = net_socket_service_unregister(udp_service);
+	zassert_equal(ret, 0, "Cannot unregister udp service (%d)", ret);
+
+	ret = close(c_sock_udp);
+	zassert_equal(ret, 0, "close failed");
+
+	ret = close(s_sock_udp);
+	zassert_equal(ret, 0, "close failed");
+
+	return handler_thread;
+}
+
+ZTEST(net_socket_service, test_service_worker)
+{
+	k_tid_t threads[MAX(CONFIG_NET_SOCKETS_SERVICE_WORKERS, 1)];
+	int ret;
+
+	if (CONFIG_NET_SOCKETS_SERVICE_WORKERS == 0) {
+		ret = net_socket_service_set_worker(&udp_service_sync, 0);
+		zassert_equal(ret, -ENOTSUP, "Could set a worker (%d)", ret);
+		ztest_test_skip();
+	}
+
+	ret = net_socket_service_set_worker(&udp_service_sync,
+					    CONFIG_NET_SOCKETS_SERVICE_WORKERS);
+	zassert_equal(ret, -EINVAL, "Could set an invalid worker (%d)", ret);
+
+	/* Each worker calls the callbacks of the services pinned to it */
+	ARRAY_FOR_EACH(threads, i) {
+		ret = net_socket_service_set_worker(&udp_service_sync, i);
+		zassert_equal(ret, 0, "Cannot set worker %zu (%d)", i, ret);
+		zassert_equal(net_socket_service_get_worker(&udp_service_sync), i);
+
+		threads[i] = run_udp_service(&udp_service_sync);
+		zassert_not_null(threads[i], "Callback not called");
+		zassert_not_equal(threads[i], k_current_get());
+
+		for (size_t j = 0; j < i; j++) {
+			zassert_not_equal(threads[i], threads[j],
+					  "Workers %zu and %zu share a thread", i, j);
+		}
+	}
+
+	ret = net_socket_service_set_worker(&udp_service_sync, -1);
+	zassert_equal(ret, 0, "Cannot clear the worker (%d)", ret);
+}
+
+ZTEST(net_socket_service, test_service_stats)
+{
+#if defined(CONFIG_NET_SOCKETS_SERVICE_STATS)
+	struct net_socket_service_stats before[MAX(CONFIG_NET_SOCKETS_SERVICE_WORKERS, 1)];
+	struct net_socket_service_stats after;
+	int worker = net_socket_service_get_worker(&udp_service_sync);
+	int ret;
+
+	ret = net_socket_service_stats_get(ARRAY_SIZE(before), &after);
+	zassert_equal(ret, -EINVAL, "Could get the stats of an invalid worker (%d)", ret);
+
+	ARRAY_FOR_EACH(before, i) {
+		ret = net_socket_service_stats_get(i, &before[i]);
+		zassert_equal(ret, 0, "Cannot get the stats of worker %zu (%d)", i, ret);
+	}
+
+	(void)run_udp_service(&udp_service_sync);
+
+	/* Only the counters of the thread running the service move */
+	ARRAY_FOR_EACH(before, i) {
+		zassert_ok(net_socket_service_stats_get(i, &after));
+
+		if ((int)i != worker) {
+			zassert_equal(after.events, before[i].events,
+				      "Worker %zu called a callback", i);
+			continue;
+		}
+
+		zassert_true(after.events > before[i].events, "No callback counted");
+		zassert_true(after.batches > before[i].batches, "No batch counted");
+		zassert_true(after.max_queue_depth >= 1U, "No queued event counted");
+		zassert_equal(after.queue_depth, 0U, "Events still queued");
+	}
+#else
+	ztest_test_skip();
+#endif /* CONFIG_NET_SOCKETS_SERVICE_STATS */
+}
+
 ZTEST_SUITE(net_socket_service, NULL, NULL, NULL, NULL, NULL);
@@ -2542,6 +2542,52 @@ ZTEST(net_socket_tcp, test_so_keepalive_opt)
 	test_context_cleanup();
 }
 
+ZTEST(net_socket_tcp, test_tcp_congestion_opt)
+{
+	struct net_sockaddr_in bind_addr4;
+	const char *expected;
+	char name[16];
+	net_socklen_t optlen = sizeof(name);
+	int sock, ret;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+		ztest_test_skip();
+	}
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &sock, &bind_addr4);
+
+	expected = IS_ENABLED(CONFIG_NET_TCP_CONGESTION_DEFAULT_CUBIC) ? "cubic" : "newreno";
+	ret = zsock_getsockopt(sock, NET_IPPROTO_TCP, ZSOCK_TCP_CONGESTION, name, &optlen);
+	zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+	zassert_str_equal(name, expected, "getsockopt got invalid value");
+	zassert_equal(optlen, strlen(expected) + 1, "getsockopt got invalid size");
+
+	ret = zsock_setsockopt(sock, NET_IPPROTO_TCP, ZSOCK_TCP_CONGESTION,
+			       "unknown", strlen("unknown"));
+	zassert_equal(ret, -1, "setsockopt should fail");
+	zassert_equal(errno, ENOENT, "setsockopt got invalid errno (%d)", errno);
+
+	ret = zsock_setsockopt(sock, NET_IPPROTO_TCP, ZSOCK_TCP_CONGESTION,
+			       "newreno", strlen("newreno"));
+	zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+	if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_CUBIC)) {
+		ret = zsock_setsockopt(sock, NET_IPPROTO_TCP, ZSOCK_TCP_CONGESTION,
+				       "cubic", sizeof("cubic"));
+		zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+		optlen = sizeof(name);
+		ret = zsock_getsockopt(sock, NET_IPPROTO_TCP, ZSOCK_TCP_CONGESTION,
+				       name, &optlen);
+		zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+		zassert_str_equal(name, "cubic", "getsockopt got invalid value");
+	}
+
+	test_close(sock);
+
+	test_context_cleanup();
+}
+
 static void test_prepare_keepalive_socks(int *c_sock, int *s_sock, int *new_sock)
 {
 	struct net_sockaddr_in c_saddr, s_saddr;
@@ -2926,6 +2972,314 @@ ZTEST(net_socket_tcp, test_zsock_send_all_failure)
 	test_close(sock);
 }
 
+#define RECV_ZC_SEG_LEN 300
+#define RECV_ZC_WIN (2 * RECV_ZC_SEG_LEN)
+#define RECV_ZC_MAX_LOANS 16
+
+static uint8_t recv_zc_buf[RECV_ZC_WIN];
+
+/* Take single fragment loans until len bytes are received, checking them
+ * against expected. Returns the number of loans taken.
+ */
+static int recv_zc_loans(int sock, struct zsock_zc_loan *loans, struct net_iovec *iov,
+			 size_t *offset, const uint8_t *expected, size_t len)
+{
+	size_t total = 0;
+	int n = 0;
+
+	while (total < len) {
+		size_t iovcnt = 1;
+		ssize_t ret;
+
+		zassert_true(n < RECV_ZC_MAX_LOANS, "too many loans");
+
+		ret = zsock_recv_zc(sock, &iov[n], &iovcnt, 0, NULL, NULL, &loans[n]);
+		zassert_true(ret > 0, "recv_zc failed (%d)", errno);
+		zassert_equal(iovcnt, 1, "invalid iovcnt");
+		zassert_equal(loans[n].len, ret, "invalid loan length");
+		zassert_true(total + ret <= len, "too much data");
+		zassert_mem_equal(iov[n].iov_base, expected + total, ret, "invalid data");
+
+		offset[n++] = total;
+		total += ret;
+	}
+
+	return n;
+}
+
+/* Zero-copy reception is only available to kernel mode callers */
+ZTEST(net_socket_tcp, test_v4_recv_zc)
+{
+	struct zsock_zc_loan loans[RECV_ZC_MAX_LOANS];
+	struct net_iovec iov[RECV_ZC_MAX_LOANS];
+	size_t offset[RECV_ZC_MAX_LOANS];
+	struct net_sockaddr_in c_saddr;
+	struct net_sockaddr_in s_saddr;
+	struct net_sockaddr addr;
+	net_socklen_t addrlen = sizeof(addr);
+	int buf_optval = RECV_ZC_WIN;
+	uint8_t rx_buf[RECV_ZC_SEG_LEN];
+	int new_sock2;
+	int new_sock;
+	int c_sock2;
+	int c_sock;
+	int s_sock;
+	int rv;
+	int n;
+
+	for (size_t i = 0; i < sizeof(recv_zc_buf); i++) {
+		recv_zc_buf[i] = (uint8_t)(i * 3U);
+	}
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock, &s_saddr);
+
+	test_bind(s_sock, (struct net_sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+	test_connect(c_sock, (struct net_sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+
+	rv = zsock_setsockopt(new_sock, ZSOCK_SOL_SOCKET, ZSOCK_SO_RCVBUF, &buf_optval,
+			      sizeof(buf_optval));
+	zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+
+	/* Two segments fill the receive window */
+	for (int i = 0; i < 2; i++) {
+		rv = zsock_send(c_sock, recv_zc_buf + i * RECV_ZC_SEG_LEN, RECV_ZC_SEG_LEN,
+				ZSOCK_MSG_DONTWAIT);
+		zassert_equal(rv, RECV_ZC_SEG_LEN, "send failed (%d)", errno);
+		k_msleep(THREAD_SLEEP);
+	}
+
+	/* A segment spans several buffers, each of them loaned on its own */
+	n = recv_zc_loans(new_sock, loans, iov, offset, recv_zc_buf, RECV_ZC_WIN);
+	zassert_true(n > 2, "segments not split in %d loans", n);
+
+	/* The window stays closed while the data is loaned */
+	k_msleep(150);
+
+	rv = zsock_send(c_sock, recv_zc_buf, 1, ZSOCK_MSG_DONTWAIT);
+	zassert_equal(rv, -1, "window opened before the loans are released");
+	zassert_equal(errno, EAGAIN, "Unexpected errno value: %d", errno);
+
+	/* Releasing some of the loans leaves the others intact */
+	for (int i = n - 1; i >= 0; i -= 2) {
+		zsock_recv_zc_release(new_sock, &loans[i]);
+		zassert_is_null(loans[i].pkt, "loan not released");
+	}
+
+	for (int i = n - 2; i >= 0; i -= 2) {
+		zassert_mem_equal(iov[i].iov_base, recv_zc_buf + offset[i], iov[i].iov_len,
+				  "loaned data overwritten");
+		zsock_recv_zc_release(new_sock, &loans[i]);
+		zassert_is_null(loans[i].pkt, "loan not released");
+	}
+
+	/* Then the window opens again */
+	k_msleep(150);
+
+	rv = zsock_send(c_sock, recv_zc_buf, RECV_ZC_SEG_LEN, ZSOCK_MSG_DONTWAIT);
+	zassert_equal(rv, RECV_ZC_SEG_LEN, "window not opened (%d)", errno);
+
+	/* Close the socket with loans outstanding */
+	n = recv_zc_loans(new_sock, loans, iov, offset, recv_zc_buf, RECV_ZC_SEG_LEN);
+	zassert_true(n >= 2, "segment not split in %d loans", n);
+
+	test_close(new_sock);
+
+	zsock_recv_zc_release(new_sock, &loans[0]);
+	zassert_is_null(loans[0].pkt, "loan not released");
+
+	/* The descriptor is likely reused by the next connection, whose
+	 * window must not be credited with the data of the old one.
+	 */
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock2, &c_saddr);
+	test_connect(c_sock2, (struct net_sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_accept(s_sock, &new_sock2, &addr, &addrlen);
+
+	for (int i = 1; i < n; i++) {
+		zsock_recv_zc_release(new_sock, &loans[i]);
+		zassert_is_null(loans[i].pkt, "loan not released");
+	}
+
+	test_send(c_sock2, recv_zc_buf, RECV_ZC_SEG_LEN, 0);
+
+	rv = 0;
+	while (rv < RECV_ZC_SEG_LEN) {
+		ssize_t len = zsock_recv(new_sock2, rx_buf + rv, sizeof(rx_buf) - rv, 0);
+
+		zassert_true(len > 0, "recv failed (%d)", errno);
+		rv += len;
+	}
+
+	zassert_mem_equal(rx_buf, recv_zc_buf, RECV_ZC_SEG_LEN, "invalid data");
+
+	test_close(c_sock2);
+	test_close(new_sock2);
+	test_close(c_sock);
+	test_close(s_sock);
+
+	test_context_cleanup();
+}
+
+#define ZC_FIRST_LEN 3000
+#define ZC_NEXT_LEN 1000
+
+static uint8_t zc_buf[ZC_FIRST_LEN + 2 * ZC_NEXT_LEN];
+
+/* Read the range of completed zero-copy sends, returns false if none is
+ * reported within timeout ms.
+ */
+static bool zc_completion_get(int sock, int timeout, uint32_t *first, uint32_t *last)
+{
+	union {
+		struct net_cmsghdr hdr;
+		unsigned char buf[NET_CMSG_SPACE(sizeof(struct zsock_extended_err))];
+	} cmsgbuf;
+	struct zsock_extended_err err;
+	struct zsock_pollfd pfd = {
+		.fd = sock,
+	};
+	struct net_cmsghdr *cmsg;
+	struct net_msghdr msg;
+	ssize_t len;
+	int rv;
+
+	rv = zsock_poll(&pfd, 1, timeout);
+	zassert_true(rv >= 0, "poll failed (%d)", errno);
+	if (rv == 0) {
+		return false;
+	}
+
+	zassert_true(pfd.revents & ZSOCK_POLLERR, "POLLERR not set");
+
+	memset(&cmsgbuf, 0, sizeof(cmsgbuf));
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_control = &cmsgbuf.buf;
+	msg.msg_controllen = sizeof(cmsgbuf);
+
+	len = zsock_recvmsg(sock, &msg, ZSOCK_MSG_ERRQUEUE);
+	zassert_equal(len, 0, "recvmsg failed (%d)", errno);
+
+	cmsg = NET_CMSG_FIRSTHDR(&msg);
+	zassert_not_null(cmsg, "no completion");
+	zassert_equal(cmsg->cmsg_level, ZSOCK_SOL_SOCKET, "invalid level");
+	zassert_equal(cmsg->cmsg_type, ZSOCK_SCM_ZEROCOPY, "invalid type");
+
+	memcpy(&err, NET_CMSG_DATA(cmsg), sizeof(err));
+	zassert_equal(err.ee_origin, ZSOCK_SO_EE_ORIGIN_ZEROCOPY, "invalid origin");
+	zassert_equal(err.ee_code, 0, "data was copied");
+
+	*first = err.ee_info;
+	*last = err.ee_data;
+
+	return true;
+}
+
+static void zc_recv_check(int sock, const uint8_t *expected, size_t len)
+{
+	static uint8_t rx_buf[ZC_FIRST_LEN];
+	size_t total = 0;
+	ssize_t ret;
+
+	while (total < len) {
+		ret = zsock_recv(sock, rx_buf + total, len - total, 0);
+		zassert_true(ret > 0, "recv failed (%d)", errno);
+		total += ret;
+	}
+
+	zassert_mem_equal(rx_buf, expected, len, "invalid data");
+}
+
+ZTEST(net_socket_tcp, test_v4_send_zerocopy)
+{
+	struct net_sockaddr_in c_saddr;
+	struct net_sockaddr_in s_saddr;
+	struct net_sockaddr addr;
+	net_socklen_t addrlen = sizeof(addr);
+	uint32_t completed;
+	uint32_t first;
+	uint32_t last;
+	int dropped;
+	int optval = 1;
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	int rv;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_CONTEXT_ZEROCOPY);
+
+	for (size_t i = 0; i < sizeof(zc_buf); i++) {
+		zc_buf[i] = (uint8_t)(i * 7U);
+	}
+
+	restore_packet_loss_ratio();
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock, &s_saddr);
+
+	test_bind(s_sock, (struct net_sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+	test_connect(c_sock, (struct net_sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+
+	rv = zsock_setsockopt(c_sock, ZSOCK_SOL_SOCKET, ZSOCK_SO_ZEROCOPY,
+			      &optval, sizeof(optval));
+	zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+
+	/* Send 0, longer than an MSS, is lost along with its first
+	 * retransmission, so it is not acknowledged.
+	 */
+	loopback_set_packet_drop_ratio(1.0f);
+	dropped = loopback_get_num_dropped_packets();
+
+	test_send(c_sock, zc_buf, ZC_FIRST_LEN, ZSOCK_MSG_ZEROCOPY);
+
+	k_msleep(CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT * 2);
+
+	zassert_true(loopback_get_num_dropped_packets() - dropped >= 2,
+		     "data not retransmitted");
+	zassert_false(zc_completion_get(c_sock, 0, &first, &last),
+		      "completion before the data is acknowledged");
+
+	/* The data received is then resent from the application buffer */
+	restore_packet_loss_ratio();
+
+	zc_recv_check(new_sock, zc_buf, ZC_FIRST_LEN);
+
+	zassert_true(zc_completion_get(c_sock, 1000, &first, &last),
+		     "completion not signaled");
+	zassert_equal(first, 0, "invalid first send");
+	zassert_equal(last, 0, "invalid last send");
+
+	/* Sends 1 and 2 complete in order, possibly together */
+	test_send(c_sock, zc_buf + ZC_FIRST_LEN, ZC_NEXT_LEN, ZSOCK_MSG_ZEROCOPY);
+	test_send(c_sock, zc_buf + ZC_FIRST_LEN + ZC_NEXT_LEN, ZC_NEXT_LEN,
+		  ZSOCK_MSG_ZEROCOPY);
+
+	zc_recv_check(new_sock, zc_buf + ZC_FIRST_LEN, ZC_NEXT_LEN);
+	zc_recv_check(new_sock, zc_buf + ZC_FIRST_LEN + ZC_NEXT_LEN, ZC_NEXT_LEN);
+
+	completed = 1;
+	while (completed < 3) {
+		zassert_true(zc_completion_get(c_sock, 1000, &first, &last),
+			     "completion not signaled");
+		zassert_equal(first, completed, "invalid first send");
+		zassert_true(last >= first && last < 3, "invalid last send");
+
+		completed = last + 1;
+	}
+
+	zassert_false(zc_completion_get(c_sock, 0, &first, &last),
+		      "completion reported twice");
+
+	test_close(c_sock);
+	test_close(new_sock);
+	test_close(s_sock);
+
+	test_context_cleanup();
+}
+
 static void after(void *arg)
 {
 	ARG_UNUSED(arg);
@@ -3758,6 +3758,236 @@ ZTEST(net_socket_udp, test_v6_rebinding)
 	test_rebinding_common(NET_AF_INET6);
 }
 
+#define MMSG_COUNT 4
+
+ZTEST_USER(net_socket_udp, test_v4_sendmmsg_recvmmsg)
+{
+	static const char * const data[MMSG_COUNT] = { "one", "two", "three", "four" };
+	static ZTEST_BMEM char bufs[MMSG_COUNT][16];
+	struct net_mmsghdr tx[MMSG_COUNT] = { 0 };
+	struct net_mmsghdr rx[MMSG_COUNT + 1] = { 0 };
+	struct net_iovec tx_io[MMSG_COUNT];
+	struct net_iovec rx_io[MMSG_COUNT + 1];
+	struct net_sockaddr_in client_addr;
+	struct net_sockaddr_in server_addr;
+	char extra[16];
+	int client_sock;
+	int server_sock;
+	int rv;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, CLIENT_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = zsock_bind(server_sock, (struct net_sockaddr *)&server_addr,
+			sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		tx_io[i].iov_base = (void *)data[i];
+		tx_io[i].iov_len = strlen(data[i]);
+		tx[i].msg_hdr.msg_name = &server_addr;
+		tx[i].msg_hdr.msg_namelen = sizeof(server_addr);
+		tx[i].msg_hdr.msg_iov = &tx_io[i];
+		tx[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	rv = zsock_sendmmsg(client_sock, tx, MMSG_COUNT, 0);
+	zassert_equal(rv, MMSG_COUNT, "sendmmsg failed (%d)", errno);
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(tx[i].msg_len, strlen(data[i]), "invalid msg_len");
+	}
+
+	for (int i = 0; i < MMSG_COUNT + 1; i++) {
+		rx_io[i].iov_base = (i < MMSG_COUNT) ? bufs[i] : extra;
+		rx_io[i].iov_len = sizeof(extra);
+		rx[i].msg_hdr.msg_iov = &rx_io[i];
+		rx[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	/* Only the first reception of each call blocks, so there is no wait
+	 * for the fifth datagram that is never sent.
+	 */
+	for (int received = 0; received < MMSG_COUNT; received += rv) {
+		rv = zsock_recvmmsg(server_sock, &rx[received], MMSG_COUNT + 1 - received,
+				    ZSOCK_MSG_WAITFORONE, SYS_FOREVER_MS);
+		zassert_true(rv > 0, "recvmmsg failed (%d)", errno);
+		zassert_true(received + rv <= MMSG_COUNT, "too many datagrams");
+	}
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(rx[i].msg_len, strlen(data[i]), "invalid msg_len");
+		zassert_mem_equal(bufs[i], data[i], strlen(data[i]), "invalid data");
+	}
+
+	rv = zsock_recvmmsg(server_sock, rx, MMSG_COUNT, ZSOCK_MSG_DONTWAIT,
+			    SYS_FOREVER_MS);
+	zassert_equal(rv, -1, "recvmmsg succeeded on an empty socket");
+	zassert_equal(errno, EAGAIN, "invalid errno (%d)", errno);
+
+	rv = zsock_close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = zsock_close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+/* Zero-copy reception is only available to kernel mode callers */
+ZTEST(net_socket_udp, test_v4_recv_zc)
+{
+	static const char data[] = "zero-copy reception of a datagram";
+	struct net_sockaddr_in client_addr;
+	struct net_sockaddr_in server_addr;
+	struct net_sockaddr_in src_addr;
+	net_socklen_t addrlen = sizeof(src_addr);
+	struct zsock_zc_loan loan;
+	struct net_iovec iov[4];
+	size_t iovcnt = ARRAY_SIZE(iov);
+	char buf[sizeof(data)];
+	size_t offset = 0;
+	ssize_t len;
+	int client_sock;
+	int server_sock;
+	int rv;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, CLIENT_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = zsock_bind(client_sock, (struct net_sockaddr *)&client_addr,
+			sizeof(client_addr));
+	zassert_equal(rv, 0, "bind failed");
+	rv = zsock_bind(server_sock, (struct net_sockaddr *)&server_addr,
+			sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	len = zsock_sendto(client_sock, data, sizeof(data), 0,
+			   (struct net_sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(len, sizeof(data), "sendto failed");
+
+	len = zsock_recv_zc(server_sock, iov, &iovcnt, 0,
+			    (struct net_sockaddr *)&src_addr, &addrlen, &loan);
+	zassert_equal(len, sizeof(data), "recv_zc failed (%d)", errno);
+	zassert_equal(loan.len, sizeof(data), "invalid loan length");
+	zassert_true(iovcnt > 0 && iovcnt <= ARRAY_SIZE(iov), "invalid iovcnt");
+	zassert_equal(addrlen, sizeof(src_addr), "invalid addrlen");
+	zassert_equal(src_addr.sin_port, client_addr.sin_port, "invalid source port");
+
+	for (size_t i = 0; i < iovcnt; i++) {
+		zassert_true(offset + iov[i].iov_len <= sizeof(buf), "iovecs too long");
+		memcpy(&buf[offset], iov[i].iov_base, iov[i].iov_len);
+		offset += iov[i].iov_len;
+	}
+
+	zassert_equal(offset, sizeof(data), "iovecs do not cover the datagram");
+	zassert_mem_equal(buf, data, sizeof(data), "invalid data");
+
+	zsock_recv_zc_release(server_sock, &loan);
+	zassert_is_null(loan.pkt, "loan not released");
+
+	iovcnt = ARRAY_SIZE(iov);
+	len = zsock_recv_zc(server_sock, iov, &iovcnt, ZSOCK_MSG_DONTWAIT,
+			    NULL, NULL, &loan);
+	zassert_equal(len, -1, "recv_zc succeeded on an empty socket");
+	zassert_equal(errno, EAGAIN, "invalid errno (%d)", errno);
+
+	rv = zsock_close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = zsock_close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+ZTEST(net_socket_udp, test_v4_send_zerocopy)
+{
+	static const char data[] = "zero-copy transmission of a datagram";
+	union {
+		struct net_cmsghdr hdr;
+		unsigned char buf[NET_CMSG_SPACE(sizeof(struct zsock_extended_err))];
+	} cmsgbuf;
+	struct net_sockaddr_in client_addr;
+	struct net_sockaddr_in server_addr;
+	struct zsock_extended_err err;
+	struct zsock_pollfd pfd;
+	struct net_cmsghdr *cmsg;
+	struct net_msghdr msg;
+	struct net_iovec iov;
+	uint32_t completed = 0;
+	char buf[sizeof(data)];
+	int client_sock;
+	int server_sock;
+	int optval = 1;
+	ssize_t len;
+	int rv;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_CONTEXT_ZEROCOPY);
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, CLIENT_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = zsock_bind(server_sock, (struct net_sockaddr *)&server_addr,
+			sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	rv = zsock_setsockopt(client_sock, ZSOCK_SOL_SOCKET, ZSOCK_SO_ZEROCOPY,
+			      &optval, sizeof(optval));
+	zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+
+	/* Sends 0 and 1 */
+	for (int i = 0; i < 2; i++) {
+		len = zsock_sendto(client_sock, data, sizeof(data), ZSOCK_MSG_ZEROCOPY,
+				   (struct net_sockaddr *)&server_addr,
+				   sizeof(server_addr));
+		zassert_equal(len, sizeof(data), "sendto failed (%d)", errno);
+
+		len = zsock_recv(server_sock, buf, sizeof(buf), 0);
+		zassert_equal(len, sizeof(data), "recv failed");
+		zassert_mem_equal(buf, data, sizeof(data), "invalid data");
+	}
+
+	while (completed < 2) {
+		pfd.fd = client_sock;
+		pfd.events = 0;
+		pfd.revents = 0;
+
+		rv = zsock_poll(&pfd, 1, 1000);
+		zassert_equal(rv, 1, "completion not signaled");
+		zassert_true(pfd.revents & ZSOCK_POLLERR, "POLLERR not set");
+
+		memset(&cmsgbuf, 0, sizeof(cmsgbuf));
+		memset(&msg, 0, sizeof(msg));
+		iov.iov_base = buf;
+		iov.iov_len = sizeof(buf);
+		msg.msg_iov = &iov;
+		msg.msg_iovlen = 1;
+		msg.msg_control = &cmsgbuf.buf;
+		msg.msg_controllen = sizeof(cmsgbuf);
+
+		len = zsock_recvmsg(client_sock, &msg, ZSOCK_MSG_ERRQUEUE);
+		zassert_equal(len, 0, "recvmsg failed (%d)", errno);
+
+		cmsg = NET_CMSG_FIRSTHDR(&msg);
+		zassert_not_null(cmsg, "no completion");
+		zassert_equal(cmsg->cmsg_level, ZSOCK_SOL_SOCKET, "invalid level");
+		zassert_equal(cmsg->cmsg_type, ZSOCK_SCM_ZEROCOPY, "invalid type");
+
+		memcpy(&err, NET_CMSG_DATA(cmsg), sizeof(err));
+		zassert_equal(err.ee_origin, ZSOCK_SO_EE_ORIGIN_ZEROCOPY, "invalid origin");
+		zassert_equal(err.ee_info, completed, "invalid first send");
+		zassert_true(err.ee_data >= err.ee_info && err.ee_data < 2,
+			     "invalid last send");
+
+		completed = err.ee_data + 1;
+	}
+
+	msg.msg_controllen = sizeof(cmsgbuf);
+	len = zsock_recvmsg(client_sock, &msg, ZSOCK_MSG_ERRQUEUE);
+	zassert_equal(len, -1, "completion reported twice");
+	zassert_equal(errno, EAGAIN, "invalid errno (%d)", errno);
+
+	rv = zsock_close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = zsock_close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
 static void after(void *arg)
 {
 	ARG_UNUSED(arg);
@@ -116,6 +116,7 @@ static enum test_case_no {
 	TEST_CLIENT_SEQ_VALIDATION = 19,
 	TEST_SERVER_ACK_VALIDATION = 20,
 	TEST_SERVER_FIN_ACK_AFTER_DATA = 21,
+	TEST_CLIENT_OPTIONS_IPV4 = 22,
 } test_case_no;
 
 static enum test_state t_state;
@@ -143,6 +144,10 @@ static void handle_client_fin_ack_with_data_test(net_sa_family_t af, struct tcph
 static void handle_client_seq_validation_test(net_sa_family_t af, struct tcphdr *th);
 static void handle_server_ack_validation_test(struct net_pkt *pkt);
 static void handle_server_fin_ack_after_data_test(net_sa_family_t af, struct tcphdr *th);
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE) && defined(CONFIG_NET_TCP_TIMESTAMPS) && \
+	defined(CONFIG_NET_TCP_SACK)
+static void handle_client_options_test(struct net_pkt *pkt, struct tcphdr *th);
+#endif
 
 static void verify_flags(struct tcphdr *th, uint8_t flags,
 			 const char *fun, int line)
@@ -238,23 +243,24 @@ static uint8_t tcp_options[20] = {
 	0x01, /* NOP */
 	0x03, 0x03, 0x07 /* Win scale*/ };
 
-static struct net_pkt *tester_prepare_tcp_pkt(net_sa_family_t af,
-					      uint16_t src_port,
-					      uint16_t dst_port,
-					      uint8_t flags,
-					      const uint8_t *data,
-					      size_t len)
+/* Prepare a segment carrying the given options, whose length must be a
+ * multiple of 4, and advertising the given window.
+ */
+static struct net_pkt *tester_prepare_tcp_pkt_opts(net_sa_family_t af,
+						   uint16_t src_port,
+						   uint16_t dst_port,
+						   uint8_t flags,
+						   const uint8_t *opts,
+						   size_t opts_len,
+						   uint16_t win,
+						   const uint8_t *data,
+						   size_t len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct net_pkt *pkt;
 	struct tcphdr *th;
-	uint8_t opts_len = 0;
 	int ret = -EINVAL;
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
-		opts_len = sizeof(tcp_options);
-	}
-
 	/* Allocate buffer */
 	pkt = net_pkt_alloc_with_buffer(net_iface,
 					sizeof(struct tcphdr) + len + opts_len,
@@ -287,14 +293,9 @@ static struct net_pkt *tester_prepare_tcp_pkt(net_sa_family_t af,
 	th->th_sport = src_port;
 	th->th_dport = dst_port;
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
-		th->th_off = 10U;
-	} else {
-		th->th_off = 5U;
-	}
-
+	th->th_off = (sizeof(struct tcphdr) + opts_len) / 4U;
 	th->th_flags = flags;
-	th->th_win = net_htons(NET_IPV6_MTU);
+	th->th_win = net_htons(win);
 	th->th_seq = net_htonl(seq);
 
 	if (ACK & flags) {
@@ -306,9 +307,9 @@ static struct net_pkt *tester_prepare_tcp_pkt(net_sa_family_t af,
 		goto fail;
 	}
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
+	if (opts && opts_len) {
 		/* Add TCP Options */
-		ret = net_pkt_write(pkt, tcp_options, opts_len);
+		ret = net_pkt_write(pkt, opts, opts_len);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -341,6 +342,26 @@ fail:
 	return NULL;
 }
 
+static struct net_pkt *tester_prepare_tcp_pkt(net_sa_family_t af,
+					      uint16_t src_port,
+					      uint16_t dst_port,
+					      uint8_t flags,
+					      const uint8_t *data,
+					      size_t len)
+{
+	const uint8_t *opts = NULL;
+	size_t opts_len = 0;
+
+	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
+		opts = tcp_options;
+		opts_len = sizeof(tcp_options);
+	}
+
+	return tester_prepare_tcp_pkt_opts(af, src_port, dst_port, flags,
+					   opts, opts_len, NET_IPV6_MTU,
+					   data, len);
+}
+
 static struct net_pkt *prepare_syn_packet(net_sa_family_t af, uint16_t src_port,
 					  uint16_t dst_port)
 {
@@ -496,6 +517,12 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 	case TEST_SERVER_FIN_ACK_AFTER_DATA:
 		handle_server_fin_ack_after_data_test(net_pkt_family(pkt), &th);
 		break;
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE) && defined(CONFIG_NET_TCP_TIMESTAMPS) && \
+	defined(CONFIG_NET_TCP_SACK)
+	case TEST_CLIENT_OPTIONS_IPV4:
+		handle_client_options_test(pkt, &th);
+		break;
+#endif
 	default:
 		zassert_true(false, "Undefined test case");
 	}
@@ -3207,4 +3234,360 @@ ZTEST(net_tcp, test_server_fin_ack_after_data)
 	k_sleep(K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY));
 }
 
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE) && defined(CONFIG_NET_TCP_TIMESTAMPS) && \
+	defined(CONFIG_NET_TCP_SACK)
+
+#define OPT_TEST_MSS 112
+#define OPT_TEST_WSCALE 7
+/* Advertised window, scaled to 1024 bytes once the window scale applies */
+#define OPT_TEST_WIN 8
+/* The timestamps option is deducted from the MSS of every data segment */
+#define OPT_TEST_SEG_LEN (OPT_TEST_MSS - 12)
+#define OPT_TEST_SEGS 4
+#define OPT_TEST_RTT_MS 20
+
+static uint16_t opt_dut_port;
+static uint32_t opt_peer_tsval;
+static uint32_t opt_dut_tsval;
+static int opt_seg_cnt;
+static size_t opt_rexmit_cnt;
+
+/* Only the holes below the highest block held by the peer are resent */
+static const uint32_t opt_rexmit_offsets[] = {
+	0, 2 * OPT_TEST_SEG_LEN,
+};
+
+static int read_tcp_options(struct net_pkt *pkt, struct tcphdr *th,
+			    uint8_t *buf, size_t size)
+{
+	size_t len = th->th_off * 4U - sizeof(struct tcphdr);
+	int ret;
+
+	if (len > size) {
+		return -EINVAL;
+	}
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	ret = net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) +
+			   net_pkt_ip_opts_len(pkt) + sizeof(struct tcphdr));
+	if (ret == 0) {
+		ret = net_pkt_read(pkt, buf, len);
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	return ret < 0 ? ret : (int)len;
+}
+
+/* Return the option of the given kind, or NULL if it is not present */
+static const uint8_t *find_tcp_option(const uint8_t *opts, int len, uint8_t kind)
+{
+	while (len > 0 && opts[0] != NET_TCP_END_OPT) {
+		if (opts[0] == NET_TCP_NOP_OPT) {
+			opts++;
+			len--;
+			continue;
+		}
+
+		if (len < 2 || opts[1] < 2 || opts[1] > len) {
+			break;
+		}
+
+		if (opts[0] == kind) {
+			return opts;
+		}
+
+		len -= opts[1];
+		opts += opts[1];
+	}
+
+	return NULL;
+}
+
+/* Check the timestamps option of a segment, which must echo the last
+ * timestamp of the peer, and return the timestamp of the segment.
+ */
+static uint32_t check_ts_option(const uint8_t *opts, int len, uint32_t tsecr)
+{
+	const uint8_t *ts = find_tcp_option(opts, len, NET_TCP_TIMESTAMP_OPT);
+
+	zassert_not_null(ts, "No timestamps option");
+	zassert_equal(ts[1], NET_TCP_TIMESTAMP_SIZE, "Invalid timestamps option");
+	zassert_equal(net_ntohl(UNALIGNED_GET((uint32_t *)(ts + 6))), tsecr,
+		      "TSecr %u, expected %u",
+		      net_ntohl(UNALIGNED_GET((uint32_t *)(ts + 6))), tsecr);
+
+	return net_ntohl(UNALIGNED_GET((uint32_t *)(ts + 2)));
+}
+
+/* Write a timestamps option echoing tsecr, returns its length */
+static size_t put_ts_option(uint8_t *opt, uint32_t tsecr)
+{
+	opt[0] = NET_TCP_NOP_OPT;
+	opt[1] = NET_TCP_NOP_OPT;
+	opt[2] = NET_TCP_TIMESTAMP_OPT;
+	opt[3] = NET_TCP_TIMESTAMP_SIZE;
+	UNALIGNED_PUT(net_htonl(++opt_peer_tsval), (uint32_t *)(opt + 4));
+	UNALIGNED_PUT(net_htonl(tsecr), (uint32_t *)(opt + 8));
+
+	return 12;
+}
+
+/* Send an ACK of ack_seq from the peer, with SACK blocks relative to the
+ * first data byte of the device.
+ */
+static void send_options_ack(uint32_t ack_seq, uint32_t tsecr,
+			     const struct tcp_sack_block *blocks, int cnt)
+{
+	uint8_t opts[40];
+	size_t len = put_ts_option(opts, tsecr);
+	uint32_t old_ack = ack;
+	struct net_pkt *pkt;
+	int ret;
+
+	if (cnt > 0) {
+		opts[len++] = NET_TCP_NOP_OPT;
+		opts[len++] = NET_TCP_NOP_OPT;
+		opts[len++] = NET_TCP_SACK_OPT;
+		opts[len++] = 2 + cnt * NET_TCP_SACK_BLOCK_SIZE;
+
+		for (int i = 0; i < cnt; i++) {
+			UNALIGNED_PUT(net_htonl(ack + blocks[i].start), (uint32_t *)&opts[len]);
+			UNALIGNED_PUT(net_htonl(ack + blocks[i].end), (uint32_t *)&opts[len + 4]);
+			len += NET_TCP_SACK_BLOCK_SIZE;
+		}
+	}
+
+	ack = ack_seq;
+	pkt = tester_prepare_tcp_pkt_opts(NET_AF_INET, net_htons(PEER_PORT), opt_dut_port,
+					  ACK, opts, len, OPT_TEST_WIN, NULL, 0);
+	ack = old_ack;
+	zassert_not_null(pkt, "Cannot create pkt");
+
+	ret = net_recv_data(net_iface, pkt);
+	zassert_equal(ret, 0, "recv data failed (%d)", ret);
+}
+
+static void handle_client_options_test(struct net_pkt *pkt, struct tcphdr *th)
+{
+	uint8_t opts[40];
+	const uint8_t *opt;
+	struct net_pkt *reply;
+	size_t reply_len;
+	uint32_t tsval;
+	int data_len;
+	int len;
+	int ret;
+
+	len = read_tcp_options(pkt, th, opts, sizeof(opts));
+	zassert_true(len >= 0, "Cannot read the options");
+
+	data_len = net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt) -
+		   net_pkt_ip_opts_len(pkt) - th->th_off * 4;
+
+	switch (t_state) {
+	case T_SYN:
+		test_verify_flags(th, SYN);
+
+		/* Every option is offered in the SYN */
+		opt = find_tcp_option(opts, len, NET_TCP_MSS_OPT);
+		zassert_not_null(opt, "No MSS option in SYN");
+		opt = find_tcp_option(opts, len, NET_TCP_WINDOW_SCALE_OPT);
+		zassert_not_null(opt, "No window scale option in SYN");
+		zassert_equal(opt[1], NET_TCP_WINDOW_SCALE_SIZE, "Invalid window scale option");
+		opt = find_tcp_option(opts, len, NET_TCP_SACK_PERM_OPT);
+		zassert_not_null(opt, "No SACK permitted option in SYN");
+		opt_dut_tsval = check_ts_option(opts, len, 0U);
+
+		opt_dut_port = th->th_sport;
+		seq = 0U;
+		ack = net_ntohl(th->th_seq) + 1U;
+
+		/* Answer with all of them, and a window which is not scaled */
+		opts[0] = NET_TCP_MSS_OPT;
+		opts[1] = NET_TCP_MSS_SIZE;
+		UNALIGNED_PUT(net_htons(OPT_TEST_MSS), (uint16_t *)&opts[2]);
+		opts[4] = NET_TCP_NOP_OPT;
+		opts[5] = NET_TCP_WINDOW_SCALE_OPT;
+		opts[6] = NET_TCP_WINDOW_SCALE_SIZE;
+		opts[7] = OPT_TEST_WSCALE;
+		opts[8] = NET_TCP_NOP_OPT;
+		opts[9] = NET_TCP_NOP_OPT;
+		opts[10] = NET_TCP_SACK_PERM_OPT;
+		opts[11] = NET_TCP_SACK_PERM_SIZE;
+		reply_len = 12 + put_ts_option(&opts[12], opt_dut_tsval);
+
+		reply = tester_prepare_tcp_pkt_opts(NET_AF_INET, net_htons(PEER_PORT),
+						    opt_dut_port, SYN | ACK, opts, reply_len,
+						    OPT_TEST_WIN, NULL, 0);
+		zassert_not_null(reply, "Cannot create pkt");
+
+		t_state = T_SYN_ACK;
+
+		ret = net_recv_data(net_iface, reply);
+		zassert_equal(ret, 0, "recv data failed (%d)", ret);
+		break;
+	case T_SYN_ACK:
+		test_verify_flags(th, ACK);
+		(void)check_ts_option(opts, len, opt_peer_tsval);
+		zassert_is_null(find_tcp_option(opts, len, NET_TCP_WINDOW_SCALE_OPT),
+				"Window scale option outside of SYN");
+
+		seq++;
+		t_state = T_DATA;
+		test_sem_give();
+		break;
+	case T_DATA:
+		test_verify_flags(th, PSH | ACK);
+		zassert_equal(data_len, OPT_TEST_SEG_LEN, "Segment of %d bytes", data_len);
+		zassert_equal(net_ntohl(th->th_seq), ack + opt_seg_cnt * OPT_TEST_SEG_LEN,
+			      "Unexpected SEQ %u", net_ntohl(th->th_seq));
+
+		tsval = check_ts_option(opts, len, opt_peer_tsval);
+		if (opt_seg_cnt == 0) {
+			opt_dut_tsval = tsval;
+		}
+
+		if (++opt_seg_cnt == OPT_TEST_SEGS) {
+			t_state = T_DATA_ACK;
+			test_sem_give();
+		}
+		break;
+	case T_DATA_ACK:
+		/* Retransmissions triggered by the duplicate ACKs */
+		test_verify_flags(th, PSH | ACK);
+		zassert_true(opt_rexmit_cnt < ARRAY_SIZE(opt_rexmit_offsets),
+			     "Too many retransmissions");
+		zassert_equal(data_len, OPT_TEST_SEG_LEN, "Segment of %d bytes", data_len);
+		zassert_equal(net_ntohl(th->th_seq) - ack, opt_rexmit_offsets[opt_rexmit_cnt],
+			      "Resent data at %u, expected %u", net_ntohl(th->th_seq) - ack,
+			      opt_rexmit_offsets[opt_rexmit_cnt]);
+		(void)check_ts_option(opts, len, opt_peer_tsval);
+
+		if (++opt_rexmit_cnt == ARRAY_SIZE(opt_rexmit_offsets)) {
+			t_state = T_CLOSING;
+			test_sem_give();
+		}
+		break;
+	case T_CLOSING:
+		zassert_true(false, "Unexpected segment after the retransmissions");
+		break;
+	case T_RST:
+		break;
+	default:
+		zassert_true(false, "%s unexpected state", __func__);
+		return;
+	}
+}
+
+/* Verify the options negotiated by a client connection and their effect.
+ * Test case scenario IPv4
+ *   expect SYN with MSS, window scale, SACK permitted and timestamps,
+ *   send SYN ACK with the same options,
+ *   expect ACK echoing the timestamp,
+ *   send ACK, whose window is scaled,
+ *   expect 4 data segments,
+ *   send 3 duplicate ACKs reporting segments 2 and 4 as received,
+ *   expect segments 1 and 3 to be resent,
+ *   send ACK for all the data, echoing the timestamp of segment 1,
+ *   send RST.
+ *   any failures cause test case to fail.
+ */
+ZTEST(net_tcp, test_client_options_ipv4)
+{
+	/* Reported out of order, they are sorted by the device */
+	static const struct tcp_sack_block sacked[] = {
+		{ 3 * OPT_TEST_SEG_LEN, 4 * OPT_TEST_SEG_LEN },
+		{ OPT_TEST_SEG_LEN, 2 * OPT_TEST_SEG_LEN },
+	};
+	struct net_context *ctx;
+	struct net_pkt *rst;
+	struct tcp *conn;
+	uint32_t srtt;
+	int ret;
+
+	t_state = T_SYN;
+	test_case_no = TEST_CLIENT_OPTIONS_IPV4;
+	seq = ack = 0;
+	opt_peer_tsval = 0;
+	opt_seg_cnt = 0;
+	opt_rexmit_cnt = 0;
+
+	ret = net_context_get(NET_AF_INET, NET_SOCK_STREAM, NET_IPPROTO_TCP, &ctx);
+	zassert_equal(ret, 0, "Failed to get net_context");
+
+	net_context_ref(ctx);
+
+	ret = net_context_connect(ctx, (struct net_sockaddr *)&peer_addr_s,
+				  sizeof(struct net_sockaddr_in), NULL,
+				  K_MSEC(100), NULL);
+	zassert_equal(ret, 0, "Failed to connect to peer");
+
+	/* Peer will release the semaphore after it receives the ACK */
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	conn = ctx->tcp;
+	zassert_true(conn->wscale_ok, "Window scale not negotiated");
+	zassert_true(conn->ts_ok, "Timestamps not negotiated");
+	zassert_true(conn->sack_ok, "SACK not negotiated");
+	zassert_equal(conn->send_wscale, OPT_TEST_WSCALE, "Window scale %u",
+		      conn->send_wscale);
+	zassert_equal(conn->send_win, OPT_TEST_WIN, "Window of the SYN ACK scaled");
+	zassert_true(conn->srtt != 0U, "No RTT sample from the SYN ACK");
+
+	send_options_ack(ack, opt_dut_tsval, NULL, 0);
+	k_msleep(10);
+
+	zassert_equal(conn->send_win, OPT_TEST_WIN << OPT_TEST_WSCALE,
+		      "Window %u not scaled", conn->send_win);
+
+#if defined(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)
+	/* Let all the segments leave at once */
+	k_mutex_lock(&conn->lock, K_FOREVER);
+	conn->ca.cwnd = OPT_TEST_SEGS * OPT_TEST_MSS;
+	k_mutex_unlock(&conn->lock);
+#endif
+
+	ret = net_context_send(ctx, lorem_ipsum, OPT_TEST_SEGS * OPT_TEST_SEG_LEN,
+			       NULL, K_NO_WAIT, NULL);
+	zassert_equal(ret, OPT_TEST_SEGS * OPT_TEST_SEG_LEN,
+		      "Failed to send data to peer %d", ret);
+
+	/* Peer will release the semaphore after it receives all segments */
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	k_msleep(OPT_TEST_RTT_MS);
+
+	for (int i = 0; i < 3; i++) {
+		send_options_ack(ack, opt_dut_tsval, sacked, ARRAY_SIZE(sacked));
+	}
+
+	/* Peer will release the semaphore after the retransmissions */
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	srtt = conn->srtt;
+	send_options_ack(ack + OPT_TEST_SEGS * OPT_TEST_SEG_LEN, opt_dut_tsval, NULL, 0);
+	k_msleep(10);
+
+	zassert_equal(conn->send_data_total, 0, "Data not acknowledged");
+	zassert_true(conn->srtt > srtt, "RTT of %u ms not sampled (srtt %u)",
+		     OPT_TEST_RTT_MS, conn->srtt >> 3);
+
+	t_state = T_RST;
+	rst = tester_prepare_tcp_pkt(NET_AF_INET, net_htons(PEER_PORT), opt_dut_port,
+				     RST, NULL, 0);
+	zassert_not_null(rst, "Cannot create pkt");
+
+	ret = net_recv_data(net_iface, rst);
+	zassert_equal(ret, 0, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(ctx);
+}
+#endif /* CONFIG_NET_TCP_WINDOW_SCALE && CONFIG_NET_TCP_TIMESTAMPS && CONFIG_NET_TCP_SACK */
+
 ZTEST_SUITE(net_tcp, NULL, presetup, NULL, NULL, NULL);
@@ -1363,6 +1363,69 @@ ZTEST(test_utils_fn, test_ip_checksum)
 				      "Mismatch between reference and calculated checksum 3\n");
 		}
 	}
+
+	/* Longer data at all alignments, for the word and vector loops */
+	for (int offset = 0; offset < 8; offset++) {
+		for (int length = 32; length <= CHECKSUM_TEST_LENGTH - offset; length += 61) {
+			sum_got = calc_chksum_ref(length, testdata + offset, length);
+			sum_exp = calc_chksum(length, testdata + offset, length);
+
+			zassert_equal(sum_got, sum_exp,
+				      "Mismatch between reference and calculated checksum 4\n");
+		}
+	}
+}
+
+static uint16_t header_chksum(const uint8_t *data, size_t len)
+{
+	uint16_t sum = calc_chksum(0U, data, len);
+
+	sum = (sum == 0U) ? 0xffff : net_htons(sum);
+
+	return ~sum;
+}
+
+ZTEST(test_utils_fn, test_ip_checksum_update)
+{
+	uint8_t hdr[40];
+	uint16_t chksum;
+	uint16_t from16, to16;
+	uint32_t from32, to32;
+	uint8_t addr[16];
+
+	for (int i = 0; i < sizeof(hdr); i++) {
+		hdr[i] = (uint8_t)(i * 37 + 11);
+	}
+
+	/* Checksum stored at offset 10, as in an IPv4 header */
+	memset(&hdr[10], 0, sizeof(uint16_t));
+	chksum = header_chksum(hdr, sizeof(hdr));
+
+	/* 16-bit field, such as the TTL and protocol */
+	memcpy(&from16, &hdr[8], sizeof(from16));
+	hdr[8]--;
+	memcpy(&to16, &hdr[8], sizeof(to16));
+	chksum = net_chksum_update_16(chksum, from16, to16);
+	zassert_equal(chksum, header_chksum(hdr, sizeof(hdr)),
+		      "Invalid checksum after a 16-bit update");
+
+	/* 32-bit field, such as an IPv4 address */
+	memcpy(&from32, &hdr[12], sizeof(from32));
+	to32 = net_htonl(0xc0000201);
+	memcpy(&hdr[12], &to32, sizeof(to32));
+	chksum = net_chksum_update_32(chksum, from32, to32);
+	zassert_equal(chksum, header_chksum(hdr, sizeof(hdr)),
+		      "Invalid checksum after a 32-bit update");
+
+	/* Longer field, such as an IPv6 address */
+	for (int i = 0; i < sizeof(addr); i++) {
+		addr[i] = (uint8_t)(0xfe - i * 3);
+	}
+
+	chksum = net_chksum_update(chksum, &hdr[20], addr, sizeof(addr));
+	memcpy(&hdr[20], addr, sizeof(addr));
+	zassert_equal(chksum, header_chksum(hdr, sizeof(hdr)),
+		      "Invalid checksum after a 128-bit update");
 }
 
 /* Verify that the net_pkt pointer to the received link layer address
@@ -0,0 +1,285 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/posix/sys/epoll.h>
+#include <zephyr/posix/sys/eventfd.h>
+#include <zephyr/posix/unistd.h>
+#include <zephyr/ztest.h>
+
+/* Time given to the work queue to report an eventfd becoming readable */
+#define READY_TIMEOUT_MS 100
+#define WRITE_DELAY_MS   100
+
+struct epoll_fixture {
+	int epfd;
+	int fd[2];
+};
+
+static struct epoll_fixture test_fixture;
+
+static void add(int epfd, int fd, uint32_t events, uint32_t data)
+{
+	struct epoll_event ev = {
+		.events = events,
+		.data.u32 = data,
+	};
+
+	zassert_ok(epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev), "epoll_ctl(ADD, %d) failed: %d",
+		   fd, errno);
+}
+
+static void mod(int epfd, int fd, uint32_t events, uint32_t data)
+{
+	struct epoll_event ev = {
+		.events = events,
+		.data.u32 = data,
+	};
+
+	zassert_ok(epoll_ctl(epfd, EPOLL_CTL_MOD, fd, &ev), "epoll_ctl(MOD, %d) failed: %d",
+		   fd, errno);
+}
+
+static void expect_event(int epfd, uint32_t events, uint32_t data)
+{
+	struct epoll_event ev[2];
+	int ret;
+
+	ret = epoll_wait(epfd, ev, ARRAY_SIZE(ev), READY_TIMEOUT_MS);
+	zassert_equal(ret, 1, "epoll_wait() returned %d, expected 1 event", ret);
+	zassert_equal(ev[0].events, events, "events 0x%x, expected 0x%x", ev[0].events, events);
+	zassert_equal(ev[0].data.u32, data, "data %u, expected %u", ev[0].data.u32, data);
+}
+
+static void expect_no_event(int epfd, int timeout)
+{
+	struct epoll_event ev[2];
+	int ret;
+
+	ret = epoll_wait(epfd, ev, ARRAY_SIZE(ev), timeout);
+	zassert_equal(ret, 0, "epoll_wait() returned %d, expected no event", ret);
+}
+
+static void make_readable(int fd)
+{
+	zassert_ok(eventfd_write(fd, 1));
+}
+
+static void make_unreadable(int fd)
+{
+	eventfd_t val;
+
+	zassert_ok(eventfd_read(fd, &val));
+}
+
+ZTEST_F(epoll, test_ctl_add_mod_del)
+{
+	struct epoll_event ev = {
+		.events = EPOLLIN,
+	};
+
+	add(fixture->epfd, fixture->fd[0], EPOLLIN, 0);
+
+	zassert_equal(epoll_ctl(fixture->epfd, EPOLL_CTL_ADD, fixture->fd[0], &ev), -1);
+	zassert_equal(errno, EEXIST);
+
+	zassert_equal(epoll_ctl(fixture->epfd, EPOLL_CTL_MOD, fixture->fd[1], &ev), -1);
+	zassert_equal(errno, ENOENT);
+
+	zassert_equal(epoll_ctl(fixture->epfd, EPOLL_CTL_DEL, fixture->fd[1], NULL), -1);
+	zassert_equal(errno, ENOENT);
+
+	/* The modified events and data are reported */
+	make_readable(fixture->fd[0]);
+	expect_event(fixture->epfd, EPOLLIN, 0);
+	mod(fixture->epfd, fixture->fd[0], EPOLLIN, 1);
+	expect_event(fixture->epfd, EPOLLIN, 1);
+	mod(fixture->epfd, fixture->fd[0], EPOLLIN | EPOLLOUT, 2);
+	expect_event(fixture->epfd, EPOLLIN | EPOLLOUT, 2);
+
+	zassert_ok(epoll_ctl(fixture->epfd, EPOLL_CTL_DEL, fixture->fd[0], NULL));
+	expect_no_event(fixture->epfd, 0);
+
+	zassert_equal(epoll_ctl(fixture->epfd, EPOLL_CTL_DEL, fixture->fd[0], NULL), -1);
+	zassert_equal(errno, ENOENT);
+
+	/* A removed descriptor can be added again */
+	add(fixture->epfd, fixture->fd[0], EPOLLIN, 3);
+	expect_event(fixture->epfd, EPOLLIN, 3);
+}
+
+ZTEST_F(epoll, test_ctl_invalid)
+{
+	struct epoll_event ev = {
+		.events = EPOLLIN | EPOLLET,
+	};
+
+	/* Edge triggered notification is not supported */
+	zassert_equal(epoll_ctl(fixture->epfd, EPOLL_CTL_ADD, fixture->fd[0], &ev), -1);
+	zassert_equal(errno, EINVAL);
+
+	add(fixture->epfd, fixture->fd[0], EPOLLIN, 0);
+	zassert_equal(epoll_ctl(fixture->epfd, EPOLL_CTL_MOD, fixture->fd[0], &ev), -1);
+	zassert_equal(errno, EINVAL);
+
+	/* An epoll instance cannot watch itself */
+	ev.events = EPOLLIN;
+	zassert_equal(epoll_ctl(fixture->epfd, EPOLL_CTL_ADD, fixture->epfd, &ev), -1);
+	zassert_equal(errno, EINVAL);
+
+	zassert_equal(epoll_ctl(fixture->fd[0], EPOLL_CTL_ADD, fixture->fd[1], &ev), -1);
+	zassert_equal(errno, EINVAL);
+}
+
+ZTEST_F(epoll, test_level_triggered)
+{
+	add(fixture->epfd, fixture->fd[0], EPOLLIN, 0);
+	add(fixture->epfd, fixture->fd[1], EPOLLIN, 1);
+
+	expect_no_event(fixture->epfd, 0);
+
+	/* A ready descriptor is reported until it is no longer ready */
+	make_readable(fixture->fd[0]);
+	expect_event(fixture->epfd, EPOLLIN, 0);
+	expect_event(fixture->epfd, EPOLLIN, 0);
+
+	make_unreadable(fixture->fd[0]);
+	expect_no_event(fixture->epfd, 0);
+
+	/* And again once it is ready again */
+	make_readable(fixture->fd[1]);
+	expect_event(fixture->epfd, EPOLLIN, 1);
+	make_unreadable(fixture->fd[1]);
+	expect_no_event(fixture->epfd, 0);
+}
+
+ZTEST_F(epoll, test_oneshot)
+{
+	add(fixture->epfd, fixture->fd[0], EPOLLIN | EPOLLONESHOT, 0);
+
+	make_readable(fixture->fd[0]);
+	expect_event(fixture->epfd, EPOLLIN, 0);
+
+	/* Disabled after the first report, although still ready */
+	expect_no_event(fixture->epfd, READY_TIMEOUT_MS);
+
+	/* Until it is armed again */
+	mod(fixture->epfd, fixture->fd[0], EPOLLIN | EPOLLONESHOT, 1);
+	expect_event(fixture->epfd, EPOLLIN, 1);
+	expect_no_event(fixture->epfd, 0);
+}
+
+ZTEST_F(epoll, test_close)
+{
+	int fd;
+
+	add(fixture->epfd, fixture->fd[0], EPOLLIN, 0);
+	make_readable(fixture->fd[0]);
+
+	/* Closing a descriptor removes it from the interest list */
+	zassert_ok(close(fixture->fd[0]));
+	expect_no_event(fixture->epfd, READY_TIMEOUT_MS);
+
+	/* So that a new descriptor, likely with the same number, can be added */
+	fd = eventfd(0, EFD_NONBLOCK);
+	zassert_true(fd >= 0, "eventfd() failed: %d", errno);
+	fixture->fd[0] = fd;
+
+	add(fixture->epfd, fd, EPOLLIN, 1);
+	expect_no_event(fixture->epfd, 0);
+	make_readable(fd);
+	expect_event(fixture->epfd, EPOLLIN, 1);
+
+	/* Closing the instance is not blocked by the descriptors it watches */
+	zassert_ok(close(fixture->epfd));
+	fixture->epfd = -1;
+	make_unreadable(fd);
+}
+
+static void write_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	(void)eventfd_write(test_fixture.fd[0], 1);
+}
+
+static K_WORK_DELAYABLE_DEFINE(write_work, write_work_handler);
+
+ZTEST_F(epoll, test_timeout)
+{
+	struct epoll_event ev;
+	int64_t start;
+	int ret;
+
+	add(fixture->epfd, fixture->fd[0], EPOLLIN, 0);
+
+	/* A timeout of 0 does not wait */
+	start = k_uptime_get();
+	expect_no_event(fixture->epfd, 0);
+	zassert_true(k_uptime_get() - start < WRITE_DELAY_MS);
+
+	/* A positive one waits that long */
+	start = k_uptime_get();
+	expect_no_event(fixture->epfd, WRITE_DELAY_MS);
+	zassert_true(k_uptime_get() - start >= WRITE_DELAY_MS);
+
+	/* And -1 until an event is ready */
+	start = k_uptime_get();
+	k_work_schedule(&write_work, K_MSEC(WRITE_DELAY_MS));
+
+	ret = epoll_wait(fixture->epfd, &ev, 1, -1);
+	zassert_equal(ret, 1, "epoll_wait() returned %d, expected 1 event", ret);
+	zassert_equal(ev.events, EPOLLIN);
+	zassert_true(k_uptime_get() - start >= WRITE_DELAY_MS);
+}
+
+ZTEST_F(epoll, test_wait_invalid)
+{
+	struct epoll_event ev;
+
+	zassert_equal(epoll_wait(fixture->epfd, &ev, 0, 0), -1);
+	zassert_equal(errno, EINVAL);
+
+	zassert_equal(epoll_wait(fixture->fd[0], &ev, 1, 0), -1);
+	zassert_equal(errno, EINVAL);
+}
+
+static void *setup(void)
+{
+	return &test_fixture;
+}
+
+static void before(void *arg)
+{
+	struct epoll_fixture *f = arg;
+
+	f->epfd = epoll_create1(0);
+	zassert_true(f->epfd >= 0, "epoll_create1() failed: %d", errno);
+
+	ARRAY_FOR_EACH(f->fd, i) {
+		f->fd[i] = eventfd(0, EFD_NONBLOCK);
+		zassert_true(f->fd[i] >= 0, "eventfd() failed: %d", errno);
+	}
+}
+
+static void after(void *arg)
+{
+	struct epoll_fixture *f = arg;
+
+	(void)k_work_cancel_delayable(&write_work);
+
+	if (f->epfd >= 0) {
+		(void)close(f->epfd);
+	}
+
+	ARRAY_FOR_EACH(f->fd, i) {
+		(void)close(f->fd[i]);
+	}
+}
+
+ZTEST_SUITE(epoll, NULL, setup, before, after, NULL);